@@ -74,6 +74,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/InitConfig/InitConfig.cpp
     src/opm/parser/eclipse/EclipseState/IOConfig/IOConfig.cpp
     src/opm/parser/eclipse/EclipseState/IOConfig/RestartConfig.cpp
+    src/opm/parser/eclipse/EclipseState/LoadReport.cpp
     src/opm/parser/eclipse/EclipseState/Runspec.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/ActionAST.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/ActionContext.cpp
@@ -83,6 +84,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Schedule/WellConnections.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Events.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Group.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/GroupHierarchy.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/GroupTree.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/MessageLimits.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/MSW/Compsegs.cpp
@@ -93,6 +95,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Schedule/Schedule.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/SummaryState.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/SummaryStore.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/TimeMap.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Tuning.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/Well.cpp
@@ -108,6 +111,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.cpp
     src/opm/parser/eclipse/EclipseState/Tables/ColumnSchema.cpp
     src/opm/parser/eclipse/EclipseState/Tables/JFunc.cpp
+    src/opm/parser/eclipse/EclipseState/Tables/PvtEvaluator.cpp
     src/opm/parser/eclipse/EclipseState/Tables/PvtxTable.cpp
     src/opm/parser/eclipse/EclipseState/Tables/SimpleTable.cpp
     src/opm/parser/eclipse/EclipseState/Tables/PolyInjTables.cpp
@@ -120,6 +124,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/UDQConfig.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQ.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQExpression.cpp
+    src/opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.cpp
     src/opm/parser/eclipse/Parser/ErrorGuard.cpp
@@ -128,6 +133,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/Parser/ParserEnums.cpp
     src/opm/parser/eclipse/Parser/ParserItem.cpp
     src/opm/parser/eclipse/Parser/ParserKeyword.cpp
+    src/opm/parser/eclipse/Parser/ParserProfile.cpp
     src/opm/parser/eclipse/Parser/ParserRecord.cpp
     src/opm/parser/eclipse/RawDeck/RawKeyword.cpp
     src/opm/parser/eclipse/RawDeck/RawRecord.cpp
@@ -155,6 +161,7 @@ if(ENABLE_ECL_OUTPUT)
           src/opm/output/eclipse/DoubHEAD.cpp
           src/opm/output/eclipse/EclipseGridInspector.cpp
           src/opm/output/eclipse/EclipseIO.cpp
+          src/opm/output/eclipse/FortranWriter.cpp
           src/opm/output/eclipse/InteHEAD.cpp
           src/opm/output/eclipse/libECLRestart.cpp
           src/opm/output/eclipse/LinearisedOutputTable.cpp
@@ -213,10 +220,12 @@ if(ENABLE_ECL_INPUT)
     tests/parser/MultiRegTests.cpp
     tests/parser/MultisegmentWellTests.cpp
     tests/parser/MULTREGTScannerTests.cpp
+    tests/parser/NamePatternIndexTests.cpp
     tests/parser/OrderedMapTests.cpp
     tests/parser/ParseContextTests.cpp
     tests/parser/ParseContext_EXIT1.cpp
     tests/parser/PORVTests.cpp
+    tests/parser/PvtEvaluatorTests.cpp
     tests/parser/RawKeywordTests.cpp
     tests/parser/RestartConfigTests.cpp
     tests/parser/RunspecTests.cpp
@@ -228,6 +237,7 @@ if(ENABLE_ECL_INPUT)
     tests/parser/StarTokenTests.cpp
     tests/parser/StringTests.cpp
     tests/parser/SummaryConfigTests.cpp
+    tests/parser/SummaryStoreTests.cpp
     tests/parser/TabdimsTests.cpp
     tests/parser/TableColumnTests.cpp
     tests/parser/TableContainerTests.cpp
@@ -240,6 +250,7 @@ if(ENABLE_ECL_INPUT)
     tests/parser/UDQTests.cpp
     tests/parser/UnitTests.cpp
     tests/parser/ValueTests.cpp
+    tests/parser/VFPEvaluatorTests.cpp
     tests/parser/WellSolventTests.cpp
     tests/parser/WellTracerTests.cpp
     tests/parser/WellTests.cpp
@@ -252,6 +263,7 @@ if(ENABLE_ECL_OUTPUT)
           #tests/test_AggregateMSWData.cpp
           tests/test_CharArrayNullTerm.cpp
           tests/test_EclipseIO.cpp
+          tests/test_FortranWriter.cpp
           tests/test_DoubHEAD.cpp
           tests/test_InteHEAD.cpp
           tests/test_LinearisedOutputTable.cpp
@@ -296,6 +308,13 @@ if(ENABLE_ECL_INPUT)
   list (APPEND EXAMPLE_SOURCE_FILES
     examples/opmi.cpp
     examples/opmpack.cpp
+    examples/parserbench.cpp
+    examples/vfpbench.cpp
+  )
+endif()
+if(ENABLE_ECL_OUTPUT)
+  list (APPEND EXAMPLE_SOURCE_FILES
+    examples/fmtoutbench.cpp
   )
 endif()
 
@@ -324,6 +343,7 @@ list( APPEND PUBLIC_HEADER_FILES
       opm/common/OpmLog/OpmLog.hpp
       opm/common/OpmLog/StreamLog.hpp
       opm/common/OpmLog/TimerLog.hpp
+      opm/common/utility/MessageBuffer.hpp
       opm/common/utility/numeric/cmp.hpp
       opm/common/utility/platform_dependent/disable_warnings.h
       opm/common/utility/platform_dependent/reenable_warnings.h
@@ -361,6 +381,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/Parser/Parser.hpp
        opm/parser/eclipse/Parser/ParserRecord.hpp
        opm/parser/eclipse/Parser/ParserKeyword.hpp
+       opm/parser/eclipse/Parser/ParserProfile.hpp
        opm/parser/eclipse/Parser/InputErrorAction.hpp
        opm/parser/eclipse/Parser/ParserEnums.hpp
        opm/parser/eclipse/Parser/ParseContext.hpp
@@ -368,6 +389,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/InitConfig/InitConfig.hpp
        opm/parser/eclipse/EclipseState/InitConfig/Equil.hpp
        opm/parser/eclipse/EclipseState/Util/Value.hpp
+       opm/parser/eclipse/EclipseState/Util/NamePatternIndex.hpp
        opm/parser/eclipse/EclipseState/Util/OrderedMap.hpp
        opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp
        opm/parser/eclipse/EclipseState/Edit/EDITNNC.hpp
@@ -416,6 +438,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Tables/Aqudims.hpp
        opm/parser/eclipse/EclipseState/Tables/JFunc.hpp
        opm/parser/eclipse/EclipseState/Tables/TableIndex.hpp
+       opm/parser/eclipse/EclipseState/Tables/PvtEvaluator.hpp
        opm/parser/eclipse/EclipseState/Tables/PvtgTable.hpp
        opm/parser/eclipse/EclipseState/Tables/Tabdims.hpp
        opm/parser/eclipse/EclipseState/Tables/TableSchema.hpp
@@ -451,6 +474,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Tables/Sof3Table.hpp
        opm/parser/eclipse/EclipseState/Tables/SgofTable.hpp
        opm/parser/eclipse/EclipseState/EclipseState.hpp
+       opm/parser/eclipse/EclipseState/LoadReport.hpp
        opm/parser/eclipse/EclipseState/EclipseConfig.hpp
        opm/parser/eclipse/EclipseState/Aquancon.hpp
        opm/parser/eclipse/EclipseState/AquiferCT.hpp
@@ -460,12 +484,14 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Schedule/Actions.hpp
        opm/parser/eclipse/EclipseState/Schedule/ActionX.hpp
        opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp
+       opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.hpp
        opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp
        opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp
        opm/parser/eclipse/EclipseState/Schedule/Well.hpp
        opm/parser/eclipse/EclipseState/Schedule/WellInjectionProperties.hpp
        opm/parser/eclipse/EclipseState/Schedule/DynamicVector.hpp
        opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp
+       opm/parser/eclipse/EclipseState/Schedule/SummaryStore.hpp
        opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp
        opm/parser/eclipse/EclipseState/Schedule/WellEconProductionLimits.hpp
        opm/parser/eclipse/EclipseState/Schedule/WellPolymerProperties.hpp
@@ -476,6 +502,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Schedule/Events.hpp
        opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp
        opm/parser/eclipse/EclipseState/Schedule/OilVaporizationProperties.hpp
+       opm/parser/eclipse/EclipseState/Schedule/GroupHierarchy.hpp
        opm/parser/eclipse/EclipseState/Schedule/GroupTree.hpp
        opm/parser/eclipse/EclipseState/Schedule/Connection.hpp
        opm/parser/eclipse/EclipseState/Schedule/DynamicState.hpp
@@ -524,7 +551,9 @@ if(ENABLE_ECL_OUTPUT)
         opm/output/eclipse/EclipseGridInspector.hpp
         opm/output/eclipse/EclipseIO.hpp
         opm/output/eclipse/EclipseIOUtil.hpp
+        opm/output/eclipse/FortranWriter.hpp
         opm/output/eclipse/InteHEAD.hpp
+        opm/output/eclipse/LazyRestartValue.hpp
         opm/output/eclipse/libECLRestart.hpp
         opm/output/eclipse/LinearisedOutputTable.hpp
         opm/output/eclipse/LogiHEAD.hpp
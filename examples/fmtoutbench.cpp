@@ -0,0 +1,188 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Throughput of the formatted (FMTOUT) output.
+
+  Usage: fmtoutbench [--cells N] [--repeat N] [--dir DIR]
+
+  A REAL, a DOUB and an INTE keyword with one value per cell are written
+  to a file in DIR, first with the formatted libecl writer - ecl_kw
+  fwrite() to a formatted fortio, which is how the formatted INIT and
+  restart files used to be written - and then with the FortranWriter,
+  both formatted and unformatted. The fastest of --repeat runs is
+  reported, and the files of the two formatted writers are compared.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ert/ecl/EclKW.hpp>
+#include <ert/ecl/FortIO.hpp>
+
+#include <opm/output/eclipse/FortranWriter.hpp>
+
+
+namespace {
+
+    struct Config {
+        std::size_t cells = 1000000;
+        std::size_t repeat = 3;
+        std::string dir = ".";
+    };
+
+
+    struct Data {
+        std::vector<float> real;
+        std::vector<double> doub;
+        std::vector<int> inte;
+    };
+
+
+    Data makeData(std::size_t cells) {
+        Data data;
+        for (std::size_t i = 0; i < cells; i++) {
+            const double x = std::sin(0.001 * i) * std::pow(10.0, static_cast<int>(i % 13) - 4);
+            data.real.push_back(static_cast<float>(x));
+            data.doub.push_back(x * 1.0000001);
+            data.inte.push_back(static_cast<int>(i % 7919) - 100);
+        }
+        return data;
+    }
+
+
+    void writeLibecl(const std::string& filename, const Data& data) {
+        ERT::FortIO fortio(filename, std::ios_base::out, true);
+        ERT::EclKW<float>("REAL", data.real).fwrite(fortio);
+        ERT::EclKW<double>("DOUB", data.doub).fwrite(fortio);
+        ERT::EclKW<int>("INTE", data.inte).fwrite(fortio);
+        fortio.close();
+    }
+
+
+    void writeFortran(const std::string& filename, const Data& data, Opm::out::FortranWriter::Format format) {
+        std::FILE* stream = std::fopen(filename.c_str(), "wb");
+        if (!stream)
+            throw std::runtime_error("Could not open " + filename);
+
+        Opm::out::FortranWriter writer(stream, format);
+        writer.write("REAL", data.real);
+        writer.write("DOUB", data.doub, true);
+        writer.write("INTE", data.inte);
+        std::fclose(stream);
+    }
+
+
+    double bestOf(std::size_t repeat, const std::function<void()>& run) {
+        double best = 0;
+        for (std::size_t i = 0; i < repeat; i++) {
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (i == 0 || seconds < best)
+                best = seconds;
+        }
+        return best;
+    }
+
+
+    std::string contents(const std::string& filename) {
+        std::ifstream stream(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+
+    Config parseArgs(int argc, char** argv) {
+        Config config;
+        for (int arg = 1; arg < argc; arg++) {
+            const std::string option = argv[arg];
+            if (arg + 1 >= argc)
+                throw std::invalid_argument("Missing value for option: " + option);
+
+            const std::string value = argv[++arg];
+            if (option == "--cells")
+                config.cells = std::strtoul(value.c_str(), nullptr, 10);
+            else if (option == "--repeat")
+                config.repeat = std::max<std::size_t>(1, std::strtoul(value.c_str(), nullptr, 10));
+            else if (option == "--dir")
+                config.dir = value;
+            else
+                throw std::invalid_argument("Unknown option: " + option);
+        }
+        return config;
+    }
+
+}
+
+
+int main(int argc, char** argv) {
+    using Format = Opm::out::FortranWriter::Format;
+
+    const auto config = parseArgs(argc, argv);
+    const auto data = makeData(config.cells);
+    const std::string libecl_file = config.dir + "/fmtoutbench-libecl.FINIT";
+    const std::string formatted_file = config.dir + "/fmtoutbench-writer.FINIT";
+    const std::string unformatted_file = config.dir + "/fmtoutbench-writer.INIT";
+
+    struct Run {
+        std::string name;
+        std::string filename;
+        double seconds;
+    };
+
+    std::vector<Run> runs = {
+        { "libecl formatted", libecl_file,
+          bestOf(config.repeat, [&]() { writeLibecl(libecl_file, data); }) },
+        { "FortranWriter formatted", formatted_file,
+          bestOf(config.repeat, [&]() { writeFortran(formatted_file, data, Format::Formatted); }) },
+        { "FortranWriter unformatted", unformatted_file,
+          bestOf(config.repeat, [&]() { writeFortran(unformatted_file, data, Format::Unformatted); }) }
+    };
+
+    std::cout << config.cells << " cells, REAL + DOUB + INTE" << std::endl
+              << std::left << std::setw(28) << "Writer" << std::right
+              << std::setw(12) << "MB" << std::setw(12) << "Time [ms]"
+              << std::setw(12) << "MB/s" << std::setw(12) << "Speedup" << std::endl;
+
+    for (const auto& run : runs) {
+        const double mb = contents(run.filename).size() / (1024.0 * 1024.0);
+        std::cout << std::left << std::setw(28) << run.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << mb
+                  << std::setw(12) << 1000 * run.seconds
+                  << std::setw(12) << mb / run.seconds
+                  << std::setprecision(2) << std::setw(12) << runs[0].seconds / run.seconds << std::endl;
+    }
+
+    const bool identical = contents(libecl_file) == contents(formatted_file);
+    std::cout << "Formatted files are " << (identical ? "identical" : "different") << std::endl;
+
+    for (const auto& run : runs)
+        std::remove(run.filename.c_str());
+}
@@ -0,0 +1,394 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  End to end benchmark of the input and output layers, driven by the
+  mock simulator.
+
+  Usage: msim_benchmark [nx ny nz [num_wells [num_connections [num_summary [num_steps]]]]]
+
+  A synthetic three phase deck with an nx x ny x nz grid, num_wells
+  producers with num_connections vertical connections each, the first
+  num_summary summary keywords of a fixed list and num_steps report steps
+  of 30 days is written as MSIM_BENCHMARK.DATA in the current directory,
+  and then run with msim. Restart and RFT output is requested at every
+  report step.
+
+  The time spent in each phase - parsing, building the EclipseState, the
+  Schedule and the SummaryConfig, and writing the INIT, EGRID, summary,
+  restart and RFT files - is written as JSON on stdout, along with the
+  total time of the run. Output phases which run once per time step are
+  summed, and for the phases which produce a file the file size and the
+  throughput are included.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <opm/msim/msim.hpp>
+#include <opm/output/data/Solution.hpp>
+#include <opm/output/data/Wells.hpp>
+#include <opm/parser/eclipse/EclipseState/LoadReport.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Units/Units.hpp>
+
+
+namespace {
+
+    struct Config {
+        std::size_t nx = 20;
+        std::size_t ny = 20;
+        std::size_t nz = 10;
+        std::size_t wells = 10;
+        std::size_t connections = 5;
+        std::size_t summary = 17;
+        std::size_t steps = 12;
+    };
+
+    const std::string case_name = "MSIM_BENCHMARK";
+
+    const std::vector<std::string> well_keywords = {
+        "WOPR", "WWPR", "WGPR", "WBHP", "WOPT", "WWPT", "WGPT", "WGOR", "WWCT"
+    };
+
+    const std::vector<std::string> field_keywords = {
+        "FOPR", "FWPR", "FGPR", "FOPT", "FWPT", "FGPT", "FGOR", "FWCT"
+    };
+
+    const char* props_section = R"(
+PROPS
+PVTW
+    4017.55 1.038 3.22E-6 0.318 0.0 /
+ROCK
+    14.7 3E-6 /
+SWOF
+0.12  0                      1       0
+0.18  4.64876033057851E-008  1       0
+0.24  0.000000186            0.997   0
+0.3   4.18388429752066E-007  0.98    0
+0.36  7.43801652892562E-007  0.7     0
+0.42  1.16219008264463E-006  0.35    0
+0.48  1.67355371900826E-006  0.2     0
+0.54  2.27789256198347E-006  0.09    0
+0.6   2.97520661157025E-006  0.021   0
+0.66  3.7654958677686E-006   0.01    0
+0.72  4.64876033057851E-006  0.001   0
+0.78  0.000005625            0.0001  0
+0.84  6.69421487603306E-006  0       0
+0.91  8.05914256198347E-006  0       0
+1     0.00001                0       0 /
+SGOF
+0     0      1       0
+0.001 0      1       0
+0.02  0      0.997   0
+0.05  0.005  0.980   0
+0.12  0.025  0.700   0
+0.2   0.075  0.350   0
+0.25  0.125  0.200   0
+0.3   0.190  0.090   0
+0.4   0.410  0.021   0
+0.45  0.60   0.010   0
+0.5   0.72   0.001   0
+0.6   0.87   0.0001  0
+0.7   0.94   0.000   0
+0.85  0.98   0.000   0
+0.88  0.984  0.000   0 /
+DENSITY
+    53.66 64.49 0.0533 /
+PVDG
+14.700  166.666  0.008000
+264.70  12.0930  0.009600
+514.70  6.27400  0.011200
+1014.7  3.19700  0.014000
+2014.7  1.61400  0.018900
+2514.7  1.29400  0.020800
+3014.7  1.08000  0.022800
+4014.7  0.81100  0.026800
+5014.7  0.64900  0.030900
+9014.7  0.38600  0.047000 /
+PVTO
+0.0010  14.7    1.0620  1.0400 /
+0.0905  264.7   1.1500  0.9750 /
+0.1800  514.7   1.2070  0.9100 /
+0.3710  1014.7  1.2950  0.8300 /
+0.6360  2014.7  1.4350  0.6950 /
+0.7750  2514.7  1.5000  0.6410 /
+0.9300  3014.7  1.5650  0.5940 /
+1.2700  4014.7  1.6950  0.5100
+        9014.7  1.5790  0.7400 /
+1.6180  5014.7  1.8270  0.4490
+        9014.7  1.7370  0.6310 /
+/
+
+SOLUTION
+EQUIL
+    8400 4800 8450 0 8300 0 1 0 0 /
+RSVD
+8300 1.270
+8450 1.270 /
+)";
+
+
+    std::string well_name(std::size_t well) {
+        return "P" + std::to_string(well + 1);
+    }
+
+
+    std::size_t num_summary_vectors(const Config& config) {
+        std::size_t vectors = 0;
+        for (std::size_t kw = 0; kw < config.summary; kw++)
+            vectors += (kw < well_keywords.size()) ? config.wells : 1;
+        return vectors;
+    }
+
+
+    std::string make_deck(const Config& config) {
+        const std::size_t cells = config.nx * config.ny * config.nz;
+        std::ostringstream deck;
+
+        deck << "RUNSPEC\n"
+             << "DIMENS\n " << config.nx << " " << config.ny << " " << config.nz << " /\n"
+             << "EQLDIMS\n/\n"
+             << "TABDIMS\n/\n"
+             << "OIL\nGAS\nWATER\nDISGAS\nFIELD\n"
+             << "START\n 1 'JAN' 2015 /\n"
+             << "WELLDIMS\n " << config.wells << " " << config.connections << " 1 " << config.wells << " /\n"
+             << "UNIFOUT\n\n";
+
+        deck << "GRID\n"
+             << "INIT\n"
+             << "DX\n " << cells << "*1000 /\n"
+             << "DY\n " << cells << "*1000 /\n"
+             << "DZ\n " << cells << "*20 /\n"
+             << "TOPS\n " << config.nx * config.ny << "*8325 /\n"
+             << "PORO\n " << cells << "*0.3 /\n"
+             << "PERMX\n " << cells << "*200 /\n"
+             << "PERMY\n " << cells << "*200 /\n"
+             << "PERMZ\n " << cells << "*20 /\n";
+
+        deck << props_section;
+
+        deck << "\nSUMMARY\n";
+        for (std::size_t kw = 0; kw < config.summary; kw++) {
+            if (kw < well_keywords.size())
+                deck << well_keywords[kw] << "\n/\n";
+            else
+                deck << field_keywords[kw - well_keywords.size()] << "\n";
+        }
+
+        deck << "\nSCHEDULE\n"
+             << "RPTRST\n 'BASIC=1' /\n"
+             << "WELSPECS\n";
+        for (std::size_t well = 0; well < config.wells; well++)
+            deck << " '" << well_name(well) << "' 'G1' "
+                 << well % config.nx + 1 << " " << (well / config.nx) % config.ny + 1 << " 8400 'OIL' /\n";
+        deck << "/\n";
+
+        deck << "COMPDAT\n";
+        for (std::size_t well = 0; well < config.wells; well++)
+            deck << " '" << well_name(well) << "' 2* 1 " << config.connections << " 'OPEN' 2* 0.5 /\n";
+        deck << "/\n";
+
+        deck << "WCONPROD\n 'P*' 'OPEN' 'ORAT' 20000 4* 1000 /\n/\n"
+             << "WRFTPLT\n 'P*' 'REPT' /\n/\n"
+             << "TSTEP\n " << config.steps << "*30 /\n"
+             << "END\n";
+
+        return deck.str();
+    }
+
+
+    std::size_t file_size(const std::string& filename) {
+        std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+        return stream ? static_cast<std::size_t>(stream.tellg()) : 0;
+    }
+
+
+    /*
+      The files written in each phase; the phases which are not listed
+      here do not produce a file.
+    */
+    std::size_t phase_bytes(const std::string& phase) {
+        if (phase == "Parse")
+            return file_size(case_name + ".DATA");
+
+        if (phase == "INIT")
+            return file_size(case_name + ".INIT");
+
+        if (phase == "EGRID")
+            return file_size(case_name + ".EGRID");
+
+        if (phase == "Summary")
+            return file_size(case_name + ".SMSPEC") + file_size(case_name + ".UNSMRY");
+
+        if (phase == "Restart")
+            return file_size(case_name + ".UNRST");
+
+        if (phase == "RFT")
+            return file_size(case_name + ".RFT");
+
+        return 0;
+    }
+
+
+    struct PhaseSummary {
+        std::string name;
+        std::size_t calls = 0;
+        double seconds = 0;
+        double min = 0;
+        double max = 0;
+    };
+
+
+    std::vector<PhaseSummary> summarize(const Opm::LoadReport& report) {
+        std::vector<PhaseSummary> summaries;
+        for (const auto& phase : report.phases()) {
+            auto iter = std::find_if(summaries.begin(), summaries.end(),
+                                     [&phase](const PhaseSummary& s) { return s.name == phase.name; });
+            if (iter == summaries.end()) {
+                PhaseSummary summary;
+                summary.name = phase.name;
+                summary.min = phase.seconds;
+                summary.max = phase.seconds;
+                summaries.push_back(summary);
+                iter = summaries.end() - 1;
+            }
+
+            iter->calls += 1;
+            iter->seconds += phase.seconds;
+            iter->min = std::min(iter->min, phase.seconds);
+            iter->max = std::max(iter->max, phase.seconds);
+        }
+        return summaries;
+    }
+
+
+    void write_json(std::ostream& os, const Config& config, std::size_t deck_bytes, const Opm::LoadReport& report, double total) {
+        os << std::setprecision(6)
+           << "{\n"
+           << "  \"deck\": {\n"
+           << "    \"nx\": " << config.nx << ",\n"
+           << "    \"ny\": " << config.ny << ",\n"
+           << "    \"nz\": " << config.nz << ",\n"
+           << "    \"cells\": " << config.nx * config.ny * config.nz << ",\n"
+           << "    \"wells\": " << config.wells << ",\n"
+           << "    \"connections\": " << config.wells * config.connections << ",\n"
+           << "    \"summary_keywords\": " << config.summary << ",\n"
+           << "    \"summary_vectors\": " << num_summary_vectors(config) << ",\n"
+           << "    \"report_steps\": " << config.steps << ",\n"
+           << "    \"bytes\": " << deck_bytes << "\n"
+           << "  },\n"
+           << "  \"phases\": [";
+
+        const auto summaries = summarize(report);
+        for (std::size_t p = 0; p < summaries.size(); p++) {
+            const auto& phase = summaries[p];
+            const std::size_t bytes = phase_bytes(phase.name);
+
+            os << (p == 0 ? "\n" : ",\n")
+               << "    {\"name\": \"" << phase.name << "\""
+               << ", \"calls\": " << phase.calls
+               << ", \"seconds\": " << phase.seconds
+               << ", \"min\": " << phase.min
+               << ", \"max\": " << phase.max;
+
+            if (bytes > 0) {
+                os << ", \"bytes\": " << bytes;
+                if (phase.seconds > 0)
+                    os << ", \"mb_per_second\": " << bytes / (1024.0 * 1024.0 * phase.seconds);
+            }
+            os << "}";
+        }
+
+        os << "\n  ],\n"
+           << "  \"total_seconds\": " << total << ",\n"
+           << "  \"resident_mb\": " << Opm::LoadReport::residentMemory() / (1024.0 * 1024.0) << "\n"
+           << "}" << std::endl;
+    }
+
+}
+
+
+int main(int argc, char** argv) {
+    Config config;
+    std::vector<std::size_t*> args = { &config.nx, &config.ny, &config.nz, &config.wells,
+                                       &config.connections, &config.summary, &config.steps };
+    for (int arg = 1; arg < argc && arg <= static_cast<int>(args.size()); arg++)
+        *args[arg - 1] = std::strtoul(argv[arg], nullptr, 10);
+
+    config.connections = std::max<std::size_t>(1, std::min(config.connections, config.nz));
+    config.summary = std::min(config.summary, well_keywords.size() + field_keywords.size());
+    config.wells = std::max<std::size_t>(1, config.wells);
+
+    const std::string deck_file = case_name + ".DATA";
+    const std::string deck_string = make_deck(config);
+    {
+        std::ofstream stream(deck_file);
+        stream << deck_string;
+    }
+
+    Opm::LoadReport report;
+    Opm::msim msim(deck_file, Opm::Parser(), Opm::ParseContext(), &report);
+
+    msim.solution("PRESSURE", [](const Opm::EclipseState& es, const Opm::Schedule&, Opm::data::Solution& sol, size_t, double seconds_elapsed) {
+            const auto& grid = es.getInputGrid();
+            if (!sol.has("PRESSURE"))
+                sol.insert("PRESSURE", Opm::UnitSystem::measure::pressure, std::vector<double>(grid.getNumActive()), Opm::data::TargetType::RESTART_SOLUTION);
+
+            auto& data = sol.data("PRESSURE");
+            std::fill(data.begin(), data.end(), 300e5 - seconds_elapsed);
+        });
+
+    for (const auto& field : {"SWAT", "SGAS"}) {
+        const std::string name = field;
+        msim.solution(name, [name](const Opm::EclipseState& es, const Opm::Schedule&, Opm::data::Solution& sol, size_t report_step, double) {
+                const auto& grid = es.getInputGrid();
+                if (!sol.has(name))
+                    sol.insert(name, Opm::UnitSystem::measure::identity, std::vector<double>(grid.getNumActive()), Opm::data::TargetType::RESTART_SOLUTION);
+
+                auto& data = sol.data(name);
+                std::fill(data.begin(), data.end(), 0.2 + 0.01 * (report_step % 10));
+            });
+    }
+
+    const auto rate = [](double value) {
+        return [value](const Opm::EclipseState&, const Opm::Schedule&, const Opm::data::Solution&, size_t, double) {
+            return -value * Opm::unit::cubic(Opm::unit::meter) / Opm::unit::day;
+        };
+    };
+    for (std::size_t well = 0; well < config.wells; well++) {
+        msim.well_rate(well_name(well), Opm::data::Rates::opt::oil, rate(1000));
+        msim.well_rate(well_name(well), Opm::data::Rates::opt::wat, rate(100));
+        msim.well_rate(well_name(well), Opm::data::Rates::opt::gas, rate(50000));
+    }
+
+    {
+        Opm::LoadReport::Timer timer(&report, "Run");
+        msim.run();
+    }
+
+    write_json(std::cout, config, deck_string.size(), report, report.elapsed());
+}
@@ -18,34 +18,66 @@
 */
 
 #include <iostream>
+#include <memory>
+#include <string>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
-#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/LoadReport.hpp>
 #include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 
 
-inline void loadDeck( const char * deck_file) {
+/*
+  Usage: opmi [-p] [-t] DECK1 [DECK2 ...]
+
+    -p : Build the EclipseState with the parallel construction mode.
+    -t : Print the time and memory used by each phase of loading the deck.
+*/
+
+inline void loadDeck( const char * deck_file, bool parallel, bool timing) {
     Opm::ParseContext parseContext;
     Opm::ErrorGuard errors;
     Opm::Parser parser;
+    Opm::LoadReport report;
+    Opm::LoadReport* report_ptr = timing ? &report : nullptr;
 
     std::cout << "Loading deck: " << deck_file << " ..... "; std::cout.flush();
-    auto deck = parser.parseFile(deck_file, parseContext, errors);
+    auto deck = [&]() {
+        Opm::LoadReport::Timer timer(report_ptr, "Parser");
+        return parser.parseFile(deck_file, parseContext, errors);
+    }();
     std::cout << "parse complete - creating EclipseState .... ";  std::cout.flush();
-    Opm::EclipseState state( deck, parseContext, errors );
-    Opm::Schedule schedule( deck, state.getInputGrid(), state.get3DProperties(), state.runspec(), parseContext, errors);
-    Opm::SummaryConfig summary( deck, schedule, state.getTableManager( ), parseContext, errors );
+    Opm::EclipseState state( deck, parseContext, errors, report_ptr, parallel );
+    std::unique_ptr<Opm::Schedule> schedule;
+    {
+        Opm::LoadReport::Timer timer(report_ptr, "Schedule");
+        schedule.reset( new Opm::Schedule( deck, state.getInputGrid(), state.get3DProperties(), state.runspec(), parseContext, errors) );
+    }
+    {
+        Opm::LoadReport::Timer timer(report_ptr, "SummaryConfig");
+        Opm::SummaryConfig summary( deck, *schedule, state.getTableManager( ), parseContext, errors );
+    }
     std::cout << "complete." << std::endl;
+
+    if (timing)
+        std::cout << report;
 }
 
 
 int main(int argc, char** argv) {
-    for (int iarg = 1; iarg < argc; iarg++)
-        loadDeck( argv[iarg] );
+    bool parallel = false;
+    bool timing = false;
+    for (int iarg = 1; iarg < argc; iarg++) {
+        const std::string arg = argv[iarg];
+        if (arg == "-p")
+            parallel = true;
+        else if (arg == "-t")
+            timing = true;
+        else
+            loadDeck( argv[iarg], parallel, timing );
+    }
 }
-
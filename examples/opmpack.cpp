@@ -26,6 +26,7 @@
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/InputErrorAction.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 
 
 inline void pack_deck( const char * deck_file, std::ostream& os) {
@@ -34,8 +35,10 @@ inline void pack_deck( const char * deck_file, std::ostream& os) {
     Opm::Parser parser;
 
     auto deck = parser.parseFile(deck_file, parseContext, errors);
-    os << deck;
-
+    Opm::DeckOutput out(os);
+    out.packed = true;
+    deck.write(out);
+    out.flush();
 }
 
 
@@ -43,7 +46,9 @@ void print_help_and_exit() {
     const char * help_text = R"(
 The opmpack program will load a deck, resolve all include
 files and then print it out again on stdout. All comments
-will be stripped and the value types will be validated.
+will be stripped and the value types will be validated. Runs
+of equal values are written as N*value, and numbers are
+written with the fewest digits which give the same value.
 
 By passing the option -o you can redirect the output to a file
 or a directory.
@@ -0,0 +1,332 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Profile of the Parser, with the cost attributed to each keyword and
+  each input file.
+
+  Usage: parserbench [--json] [--repeat N] [--cells N] [--wells N] [--steps N] [DATA file ...]
+
+  Two synthetic decks are parsed with Parser::parseString(): a GRID deck
+  with explicit PORO, PERMX, PERMY, PERMZ, NTG and ACTNUM values for the
+  given number of cells, and a SCHEDULE deck with the given number of
+  wells and report steps. The DATA files on the command line, e.g. the
+  checked-in tests/SPE1CASE1.DATA and tests/SPE9_CP_PACKED.DATA, are
+  parsed with Parser::parseFile().
+
+  Every case is parsed --repeat times and the fastest run is reported,
+  either as a table or as JSON. The time of each keyword is split in the
+  Tokenize, Scan, Keyword and AddKeyword stages of the ParserProfile, and
+  the heap allocations of each stage are counted with a replacement
+  operator new.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/ParserProfile.hpp>
+
+
+namespace {
+
+    std::atomic<std::size_t> allocation_count(0);
+
+}
+
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+
+namespace {
+
+    struct Config {
+        bool json = false;
+        std::size_t repeat = 3;
+        std::size_t cells = 1000000;
+        std::size_t wells = 200;
+        std::size_t steps = 100;
+        std::vector<std::string> files;
+    };
+
+
+    struct Case {
+        std::string name;
+        std::string input;      // Deck string, or file name when from_file
+        bool from_file;
+    };
+
+
+    struct Result {
+        std::string name;
+        std::size_t keywords;
+        double seconds;
+        std::size_t allocations;
+        Opm::ParserProfile profile;
+    };
+
+
+    void writeValues(std::ostream& deck, const std::string& keyword, std::size_t n, double first, double step, std::size_t period) {
+        deck << keyword << "\n";
+        for (std::size_t i = 0; i < n; i++) {
+            deck << first + step * (i % period) << ((i % 8 == 7) ? "\n" : " ");
+            if (i % 4000 == 3999)
+                deck << "-- line comment inside the data\n";
+        }
+        deck << "/\n\n";
+    }
+
+
+    std::string gridDeck(std::size_t cells) {
+        const std::size_t nx = 100;
+        const std::size_t ny = 100;
+        const std::size_t nz = std::max<std::size_t>(1, cells / (nx * ny));
+        const std::size_t n = nx * ny * nz;
+
+        std::ostringstream deck;
+        deck << "RUNSPEC\nDIMENS\n " << nx << " " << ny << " " << nz << " /\nOIL\nWATER\nMETRIC\n\n"
+             << "GRID\n"
+             << "DX\n " << n << "*100 /\n"
+             << "DY\n " << n << "*100 /\n"
+             << "DZ\n " << n << "*5 /\n"
+             << "TOPS\n " << nx * ny << "*2000 /\n\n";
+
+        writeValues(deck, "PORO", n, 0.15, 0.001, 97);
+        writeValues(deck, "PERMX", n, 100, 0.5, 113);
+        writeValues(deck, "PERMY", n, 100, 0.5, 113);
+        writeValues(deck, "PERMZ", n, 10, 0.05, 113);
+        writeValues(deck, "NTG", n, 0.5, 0.005, 101);
+        writeValues(deck, "ACTNUM", n, 1, 0, 1);
+        return deck.str();
+    }
+
+
+    std::string scheduleDeck(std::size_t wells, std::size_t steps) {
+        static const char* months[] = { "JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                        "JUL", "AUG", "SEP", "OCT", "NOV", "DEC" };
+        std::ostringstream deck;
+        deck << "SCHEDULE\n\nWELSPECS\n";
+        for (std::size_t w = 0; w < wells; w++)
+            deck << " 'W" << w + 1 << "' 'G" << w % 10 + 1 << "' " << w % 100 + 1 << " " << w / 100 + 1 << " 1* 'OIL' /\n";
+        deck << "/\n\nCOMPDAT\n";
+        for (std::size_t w = 0; w < wells; w++)
+            deck << " 'W" << w + 1 << "' 2* 1 10 'OPEN' 2* 0.2 /\n";
+        deck << "/\n\n";
+
+        for (std::size_t step = 0; step < steps; step++) {
+            deck << "WCONPROD\n";
+            for (std::size_t w = 0; w < wells; w++)
+                deck << " 'W" << w + 1 << "' 'OPEN' 'ORAT' " << 1000 + (w + step) % 500 << " 4* 100 /\n";
+            deck << "/\n\nWELTARG\n";
+            for (std::size_t w = 0; w < wells; w += 4)
+                deck << " 'W" << w + 1 << "' 'BHP' " << 90 + step % 20 << " /\n";
+            deck << "/\n\nDATES\n " << 1 + step % 28 << " '" << months[(step / 28) % 12] << "' " << 2020 + step / 336 << " /\n/\n\n";
+        }
+        return deck.str();
+    }
+
+
+    Result runCase(const Case& c) {
+        Result result;
+        result.name = c.name;
+
+        Opm::Parser parser;
+        Opm::ParseContext parseContext;
+        Opm::ErrorGuard errors;
+        result.profile.setAllocationCounter([]() { return allocation_count.load(std::memory_order_relaxed); });
+
+        const std::size_t allocations = allocation_count.load();
+        const auto start = std::chrono::steady_clock::now();
+        const auto deck = c.from_file
+            ? parser.parseFile(c.input, parseContext, errors, &result.profile)
+            : parser.parseString(c.input, parseContext, errors, &result.profile);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.allocations = allocation_count.load() - allocations;
+        result.keywords = deck.size();
+        errors.clear();
+
+        return result;
+    }
+
+
+    Result bestOf(const Case& c, std::size_t repeat) {
+        Result best = runCase(c);
+        for (std::size_t i = 1; i < repeat; i++) {
+            auto result = runCase(c);
+            if (result.seconds < best.seconds)
+                best = std::move(result);
+        }
+        return best;
+    }
+
+
+    std::string quoted(const std::string& s) {
+        std::string q = "\"";
+        for (char c : s) {
+            if (c == '"' || c == '\\')
+                q += '\\';
+            q += c;
+        }
+        return q + "\"";
+    }
+
+
+    void writeCostJSON(std::ostream& os, const std::string& name, const Opm::ParserProfile::Cost& cost) {
+        os << "{\"name\": " << quoted(name)
+           << ", \"count\": " << cost.count
+           << ", \"records\": " << cost.records
+           << ", \"tokens\": " << cost.tokens
+           << ", \"bytes\": " << cost.bytes;
+        for (std::size_t stage = 0; stage < Opm::ParserProfile::num_stages; stage++) {
+            const auto& stage_name = Opm::ParserProfile::stageName(static_cast<Opm::ParserProfile::Stage>(stage));
+            os << ", \"" << stage_name << "\": {\"seconds\": " << cost.seconds[stage]
+               << ", \"allocations\": " << cost.allocations[stage] << "}";
+        }
+        os << ", \"seconds\": " << cost.totalSeconds() << "}";
+    }
+
+
+    void writeJSON(std::ostream& os, const std::vector<Result>& results) {
+        os << std::setprecision(6) << "{\n  \"cases\": [";
+        for (std::size_t r = 0; r < results.size(); r++) {
+            const auto& result = results[r];
+            const auto total = result.profile.total();
+            std::size_t bytes = 0;
+            for (const auto& file : result.profile.files())
+                bytes += file.second.bytes;
+
+            os << (r == 0 ? "\n" : ",\n")
+               << "    {\n"
+               << "      \"name\": " << quoted(result.name) << ",\n"
+               << "      \"deck_keywords\": " << result.keywords << ",\n"
+               << "      \"bytes\": " << bytes << ",\n"
+               << "      \"seconds\": " << result.seconds << ",\n"
+               << "      \"mb_per_second\": " << bytes / (1024.0 * 1024.0 * result.seconds) << ",\n"
+               << "      \"records_per_second\": " << total.records / result.seconds << ",\n"
+               << "      \"allocations\": " << result.allocations << ",\n"
+               << "      \"total\": ";
+            writeCostJSON(os, "Total", total);
+
+            os << ",\n      \"keywords\": [";
+            bool first = true;
+            for (const auto& pair : result.profile.keywords()) {
+                os << (first ? "\n        " : ",\n        ");
+                writeCostJSON(os, pair.first, pair.second);
+                first = false;
+            }
+
+            os << "\n      ],\n      \"files\": [";
+            first = true;
+            for (const auto& pair : result.profile.files()) {
+                os << (first ? "\n        " : ",\n        ");
+                writeCostJSON(os, pair.first, pair.second);
+                first = false;
+            }
+            os << "\n      ]\n    }";
+        }
+        os << "\n  ]\n}" << std::endl;
+    }
+
+
+    void writeTable(std::ostream& os, const std::vector<Result>& results) {
+        for (const auto& result : results) {
+            std::size_t bytes = 0;
+            for (const auto& file : result.profile.files())
+                bytes += file.second.bytes;
+
+            os << "== " << result.name << ": " << result.keywords << " keywords, "
+               << std::fixed << std::setprecision(3) << result.seconds << " s, "
+               << std::setprecision(1) << bytes / (1024.0 * 1024.0 * result.seconds) << " MB/s, "
+               << result.allocations << " allocations" << std::endl;
+            result.profile.write(os);
+            os << std::endl;
+        }
+    }
+
+
+    Config parseArgs(int argc, char** argv) {
+        Config config;
+        for (int arg = 1; arg < argc; arg++) {
+            const std::string option = argv[arg];
+            const auto value = [&]() -> std::size_t {
+                if (arg + 1 >= argc)
+                    throw std::invalid_argument("Missing value for option: " + option);
+                return std::strtoul(argv[++arg], nullptr, 10);
+            };
+
+            if (option == "--json")
+                config.json = true;
+            else if (option == "--repeat")
+                config.repeat = std::max<std::size_t>(1, value());
+            else if (option == "--cells")
+                config.cells = value();
+            else if (option == "--wells")
+                config.wells = value();
+            else if (option == "--steps")
+                config.steps = value();
+            else
+                config.files.push_back(option);
+        }
+        return config;
+    }
+}
+
+
+int main(int argc, char** argv) {
+    const auto config = parseArgs(argc, argv);
+
+    std::vector<Case> cases;
+    if (config.cells > 0)
+        cases.push_back({ "GRID " + std::to_string(config.cells) + " cells", gridDeck(config.cells), false });
+    if (config.wells > 0 && config.steps > 0)
+        cases.push_back({ "SCHEDULE " + std::to_string(config.wells) + " wells x " + std::to_string(config.steps) + " steps",
+                          scheduleDeck(config.wells, config.steps), false });
+    for (const auto& file : config.files)
+        cases.push_back({ file, file, true });
+
+    std::vector<Result> results;
+    for (const auto& c : cases)
+        results.push_back(bestOf(c, config.repeat));
+
+    if (config.json)
+        writeJSON(std::cout, results);
+    else
+        writeTable(std::cout, results);
+}
@@ -0,0 +1,100 @@
+/*
+   Copyright 2018 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+#include "DeviationStatistics.hpp"
+
+#include <algorithm>
+#include <utility>
+
+
+namespace {
+    struct HeapOrder {
+        bool operator()(const DeviationRecord& a, const DeviationRecord& b) const {
+            // std::push_heap() builds a max-heap; invert to keep the
+            // smallest retained deviation at the front.
+            return TopDeviations::smallerDeviation(b.dev, a.dev);
+        }
+    };
+}
+
+
+void DeviationStatistics::merge(const DeviationStatistics& other) {
+    numAbs      += other.numAbs;
+    numRel      += other.numRel;
+    numFailures += other.numFailures;
+    numNegative += other.numNegative;
+    sumAbs      += other.sumAbs;
+    sumRel      += other.sumRel;
+    maxAbs       = std::max(maxAbs, other.maxAbs);
+    maxRel       = std::max(maxRel, other.maxRel);
+}
+
+
+
+bool TopDeviations::smallerDeviation(const Deviation& a, const Deviation& b) {
+    if (a.rel != b.rel) {
+        return a.rel < b.rel;
+    }
+    return a.abs < b.abs;
+}
+
+
+
+bool TopDeviations::accepts(const Deviation& dev) const {
+    if (maxSize == 0) {
+        return false;
+    }
+    if (heap.size() < maxSize) {
+        return true;
+    }
+    return smallerDeviation(heap.front().dev, dev);
+}
+
+
+
+void TopDeviations::add(DeviationRecord record) {
+    if (!accepts(record.dev)) {
+        return;
+    }
+    if (heap.size() == maxSize) {
+        std::pop_heap(heap.begin(), heap.end(), HeapOrder());
+        heap.pop_back();
+    }
+    heap.push_back(std::move(record));
+    std::push_heap(heap.begin(), heap.end(), HeapOrder());
+}
+
+
+
+void TopDeviations::merge(const TopDeviations& other) {
+    for (const auto& record : other.heap) {
+        add(record);
+    }
+}
+
+
+
+std::vector<DeviationRecord> TopDeviations::sorted() const {
+    std::vector<DeviationRecord> records(heap);
+    std::sort(records.begin(), records.end(),
+              [](const DeviationRecord& a, const DeviationRecord& b)
+              {
+                  return smallerDeviation(b.dev, a.dev);
+              });
+    return records;
+}
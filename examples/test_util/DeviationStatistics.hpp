@@ -0,0 +1,110 @@
+/*
+   Copyright 2018 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+#ifndef DEVIATION_STATISTICS_HPP
+#define DEVIATION_STATISTICS_HPP
+
+#include "Deviation.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*! \brief A single deviation together with its location in the compared files.
+ */
+struct DeviationRecord {
+    std::string keyword;     //!< Keyword name
+    int occurrence1 = -1;    //!< Keyword occurrence in first file
+    int occurrence2 = -1;    //!< Keyword occurrence in second file
+    size_t kw_size = 0;      //!< Number of elements in keyword
+    size_t cell = 0;         //!< Element index
+    double value1 = 0;       //!< Value in first file
+    double value2 = 0;       //!< Value in second file
+    Deviation dev;           //!< Deviation between value1 and value2
+};
+
+/*! \brief Running summary statistics of deviations.
+    \details Keeps counts, sums and maxima only, so that the memory
+             requirement is independent of the number of values compared.
+             The counters are public so that comparison kernels can
+             accumulate into block local scalars and fold them in once.
+ */
+struct DeviationStatistics {
+    size_t numAbs = 0;       //!< Number of valid absolute deviations
+    size_t numRel = 0;       //!< Number of valid relative deviations
+    size_t numFailures = 0;  //!< Number of value pairs exceeding the tolerances
+    size_t numNegative = 0;  //!< Number of disallowed negative values
+    double sumAbs = 0;
+    double sumRel = 0;
+    double maxAbs = 0;
+    double maxRel = 0;
+
+    //! \brief Account for one deviation. Invalid (-1) components are ignored.
+    void add(const Deviation& dev) {
+        if (dev.abs != -1) {
+            ++numAbs;
+            sumAbs += dev.abs;
+            if (dev.abs > maxAbs) maxAbs = dev.abs;
+        }
+        if (dev.rel != -1) {
+            ++numRel;
+            sumRel += dev.rel;
+            if (dev.rel > maxRel) maxRel = dev.rel;
+        }
+    }
+
+    //! \brief Combine with statistics collected elsewhere, e.g. by another thread.
+    void merge(const DeviationStatistics& other);
+
+    //! \brief Average of the absolute deviations, zero if none.
+    double averageAbs() const { return (numAbs == 0) ? 0 : sumAbs/numAbs; }
+    //! \brief Average of the relative deviations, zero if none.
+    double averageRel() const { return (numRel == 0) ? 0 : sumRel/numRel; }
+};
+
+/*! \brief Bounded collection of the largest deviations seen.
+    \details Deviations are ranked by relative deviation, then by absolute
+             deviation. At most capacity() records are retained.
+ */
+class TopDeviations {
+    public:
+        explicit TopDeviations(size_t capacity = 10) : maxSize(capacity) {}
+
+        size_t capacity() const { return maxSize; }
+        size_t size() const { return heap.size(); }
+        bool empty() const { return heap.empty(); }
+
+        //! \brief Whether a record with this deviation would currently be retained.
+        bool accepts(const Deviation& dev) const;
+        //! \brief Insert record, evicting the smallest retained deviation if full.
+        void add(DeviationRecord record);
+        //! \brief Insert all records retained by other.
+        void merge(const TopDeviations& other);
+        //! \brief The retained records, largest deviation first.
+        std::vector<DeviationRecord> sorted() const;
+
+        //! \brief Ordering used for ranking deviations.
+        static bool smallerDeviation(const Deviation& a, const Deviation& b);
+
+    private:
+        size_t maxSize;
+        std::vector<DeviationRecord> heap; //!< Min-heap on smallerDeviation().
+};
+
+#endif
@@ -160,6 +160,8 @@ ECLFilesComparator::ECLFilesComparator(int file_type_arg, const std::string& bas
         OPM_THROW(std::invalid_argument, "Unsupported filetype sent to ECLFilesComparator's constructor."
                 << "Only unified restart (.UNRST), initial (.INIT) and .RFT files are supported.");
     }
+    fileName1 = file1;
+    fileName2 = file2;
     ecl_file1 = ecl_file_open(file1.c_str(), 0);
     ecl_file2 = ecl_file_open(file2.c_str(), 0);
     ecl_grid1 = ecl_grid_load_case(basename1.c_str());
@@ -51,6 +51,7 @@ class ECLFilesComparator {
         ecl_grid_type* ecl_grid1 = nullptr;
         ecl_file_type* ecl_file2 = nullptr;
         ecl_grid_type* ecl_grid2 = nullptr;
+        std::string fileName1, fileName2; //!< Full names of the compared files.
         std::vector<std::string> keywords1, keywords2;
         bool throwOnError = true; //!< Throw on first error
         bool analysis = false; //!< Perform full error analysis
@@ -20,10 +20,16 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 #include <set>
 
+#include <ert/ecl/ecl_endian_flip.h>
 #include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_util.h>
+#include <ert/ecl/fortio.h>
 #include <ert/ecl/ecl_grid.h>
 #include <ert/ecl/ecl_type.h>
 
@@ -42,6 +48,172 @@
   }
 
 
+namespace {
+    // Number of values handled per block in streaming comparisons.
+    // Blocks are the unit of work distributed among threads.
+    const size_t streamBlockSize = 1 << 16;
+
+    using FortIOPtr = std::unique_ptr<fortio_type, decltype(&fortio_fclose)>;
+    using EclKWPtr  = std::unique_ptr<ecl_kw_type, decltype(&ecl_kw_free)>;
+
+    FortIOPtr openReader(const std::string& fileName) {
+        bool fmt_file = false;
+        if (!ecl_util_fmt_file(fileName.c_str(), &fmt_file)) {
+            OPM_THROW(std::invalid_argument, "Could not determine format of file: " << fileName);
+        }
+        FortIOPtr fortio(fortio_open_reader(fileName.c_str(), fmt_file, ECL_ENDIAN_FLIP), &fortio_fclose);
+        if (!fortio) {
+            OPM_THROW(std::invalid_argument, "Error opening file: " << fileName);
+        }
+        return fortio;
+    }
+
+    EclKWPtr readKeyword(fortio_type* fortio) {
+        return EclKWPtr(ecl_kw_fread_alloc(fortio), &ecl_kw_free);
+    }
+
+    struct Tolerances {
+        double abs;
+        double rel;
+        bool allowNegativeValues;
+    };
+
+    /*
+      Compares values1[begin, end) to values2[begin, end).  The common
+      case of all values within tolerance is handled by a single branch
+      free pass which only accumulates the statistics, and which the
+      compiler is free to vectorize.  Only blocks with failures are
+      revisited to locate the offending values.
+    */
+    template <typename T1, typename T2>
+    void compareBlock(const T1* values1, const T2* values2,
+                      const size_t begin, const size_t end,
+                      const Tolerances& tol,
+                      const DeviationRecord& location,
+                      DeviationStatistics& stats,
+                      TopDeviations& top,
+                      size_t& firstNegative) {
+        const double negLimit = tol.allowNegativeValues ? -HUGE_VAL : -tol.abs;
+        const double clamp    = tol.allowNegativeValues ? -HUGE_VAL : 0.0;
+
+        size_t numAbs = 0, numRel = 0, numFailures = 0, numNegative = 0;
+        double sumAbs = 0, sumRel = 0, maxAbs = 0, maxRel = 0;
+
+        for (size_t cell = begin; cell < end; ++cell) {
+            const double raw1 = values1[cell];
+            const double raw2 = values2[cell];
+            numNegative += (raw1 < negLimit) + (raw2 < negLimit);
+
+            const double val1 = std::abs(std::max(raw1, clamp));
+            const double val2 = std::abs(std::max(raw2, clamp));
+            const double largest = std::max(val1, val2);
+            const double absDev = std::abs(val1 - val2);
+            const bool hasAbs = largest != 0;
+            const bool hasRel = val1 != 0 && val2 != 0;
+            const double relDev = hasRel ? absDev/largest : 0.0;
+
+            numAbs += hasAbs;
+            numRel += hasRel;
+            sumAbs += hasAbs ? absDev : 0.0;
+            sumRel += relDev;
+            maxAbs = std::max(maxAbs, hasAbs ? absDev : 0.0);
+            maxRel = std::max(maxRel, relDev);
+            numFailures += hasAbs && hasRel && absDev > tol.abs && relDev > tol.rel;
+        }
+
+        stats.numAbs      += numAbs;
+        stats.numRel      += numRel;
+        stats.numFailures += numFailures;
+        stats.numNegative += numNegative;
+        stats.sumAbs      += sumAbs;
+        stats.sumRel      += sumRel;
+        stats.maxAbs       = std::max(stats.maxAbs, maxAbs);
+        stats.maxRel       = std::max(stats.maxRel, maxRel);
+
+        if (numFailures == 0 && numNegative == 0) {
+            return;
+        }
+
+        for (size_t cell = begin; cell < end; ++cell) {
+            double val1 = values1[cell];
+            double val2 = values2[cell];
+            if (!tol.allowNegativeValues) {
+                if ((val1 < negLimit || val2 < negLimit) && cell < firstNegative) {
+                    firstNegative = cell;
+                }
+                val1 = std::max(val1, 0.0);
+                val2 = std::max(val2, 0.0);
+            }
+            const Deviation dev = ECLFilesComparator::calculateDeviations(val1, val2);
+            if (dev.abs > tol.abs && dev.rel > tol.rel && top.accepts(dev)) {
+                DeviationRecord record(location);
+                record.cell   = cell;
+                record.value1 = val1;
+                record.value2 = val2;
+                record.dev    = dev;
+                top.add(std::move(record));
+            }
+        }
+    }
+
+    template <typename T1, typename T2>
+    void compareValues(const T1* values1, const T2* values2,
+                       const size_t numValues,
+                       const Tolerances& tol,
+                       const DeviationRecord& location,
+                       DeviationStatistics& stats,
+                       TopDeviations& top,
+                       size_t& firstNegative) {
+        const std::ptrdiff_t numBlocks = (numValues + streamBlockSize - 1) / streamBlockSize;
+
+#ifdef _OPENMP
+#pragma omp parallel if (numBlocks > 1)
+#endif
+        {
+            DeviationStatistics localStats;
+            TopDeviations localTop(top.capacity());
+            size_t localNegative = numValues;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (std::ptrdiff_t block = 0; block < numBlocks; ++block) {
+                const size_t begin = block * streamBlockSize;
+                const size_t end   = std::min(begin + streamBlockSize, numValues);
+                compareBlock(values1, values2, begin, end, tol, location,
+                             localStats, localTop, localNegative);
+            }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            {
+                stats.merge(localStats);
+                top.merge(localTop);
+                firstNegative = std::min(firstNegative, localNegative);
+            }
+        }
+    }
+
+    template <typename T1>
+    void compareValues(const T1* values1, const ecl_kw_type* ecl_kw2,
+                       const size_t numValues,
+                       const Tolerances& tol,
+                       const DeviationRecord& location,
+                       DeviationStatistics& stats,
+                       TopDeviations& top,
+                       size_t& firstNegative) {
+        if (ecl_type_get_type(ecl_kw_get_data_type(ecl_kw2)) == ECL_DOUBLE_TYPE) {
+            compareValues(values1, ecl_kw_get_double_ptr(ecl_kw2), numValues, tol, location, stats, top, firstNegative);
+        }
+        else {
+            compareValues(values1, ecl_kw_get_float_ptr(ecl_kw2), numValues, tol, location, stats, top, firstNegative);
+        }
+    }
+}
+
+
+
 void ECLRegressionTest::printResultsForKeyword(const std::string& keyword) const {
     std::cout << "Deviation results for keyword " << keyword << " of type "
         << ecl_type_get_name(ecl_file_iget_named_data_type(ecl_file1, keyword.c_str(), 0))
@@ -60,7 +232,16 @@ void ECLRegressionTest::boolComparisonForOccurrence(const std::string& keyword,
                                                     int occurrence1, int occurrence2) const {
     ecl_kw_type* ecl_kw1 = nullptr;
     ecl_kw_type* ecl_kw2 = nullptr;
-    const unsigned int numCells = getEclKeywordData(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
+    getEclKeywordData(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
+    boolComparison(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
+}
+
+
+
+void ECLRegressionTest::boolComparison(const ecl_kw_type* ecl_kw1, const ecl_kw_type* ecl_kw2,
+                                       const std::string& keyword,
+                                       int occurrence1, int occurrence2) const {
+    const size_t numCells = ecl_kw_get_size(ecl_kw1);
     for (size_t cell = 0; cell < numCells; cell++) {
         bool data1 = ecl_kw_iget_bool(ecl_kw1, cell);
         bool data2 = ecl_kw_iget_bool(ecl_kw2, cell);
@@ -77,7 +258,16 @@ void ECLRegressionTest::charComparisonForOccurrence(const std::string& keyword,
                                                     int occurrence1, int occurrence2) const {
     ecl_kw_type* ecl_kw1 = nullptr;
     ecl_kw_type* ecl_kw2 = nullptr;
-    const unsigned int numCells = getEclKeywordData(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
+    getEclKeywordData(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
+    charComparison(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
+}
+
+
+
+void ECLRegressionTest::charComparison(const ecl_kw_type* ecl_kw1, const ecl_kw_type* ecl_kw2,
+                                       const std::string& keyword,
+                                       int occurrence1, int occurrence2) const {
+    const size_t numCells = ecl_kw_get_size(ecl_kw1);
     for (size_t cell = 0; cell < numCells; cell++) {
         std::string data1(ecl_kw_iget_char_ptr(ecl_kw1, cell));
         std::string data2(ecl_kw_iget_char_ptr(ecl_kw2, cell));
@@ -94,13 +284,21 @@ void ECLRegressionTest::intComparisonForOccurrence(const std::string& keyword,
                                                    int occurrence1, int occurrence2) const {
     ecl_kw_type* ecl_kw1 = nullptr;
     ecl_kw_type* ecl_kw2 = nullptr;
-    const unsigned int numCells = getEclKeywordData(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
-    std::vector<int> values1(numCells), values2(numCells);
-    ecl_kw_get_memcpy_int_data(ecl_kw1, values1.data());
-    ecl_kw_get_memcpy_int_data(ecl_kw2, values2.data());
-    for (size_t cell = 0; cell < values1.size(); cell++) {
+    getEclKeywordData(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
+    intComparison(ecl_kw1, ecl_kw2, keyword, occurrence1, occurrence2);
+}
+
+
+
+void ECLRegressionTest::intComparison(const ecl_kw_type* ecl_kw1, const ecl_kw_type* ecl_kw2,
+                                      const std::string& keyword,
+                                      int occurrence1, int occurrence2) const {
+    const size_t numCells = ecl_kw_get_size(ecl_kw1);
+    const int* values1 = ecl_kw_get_int_ptr(ecl_kw1);
+    const int* values2 = ecl_kw_get_int_ptr(ecl_kw2);
+    for (size_t cell = 0; cell < numCells; cell++) {
         if (values1[cell] != values2[cell]) {
-            printValuesForCell(keyword, occurrence1, occurrence2, values1.size(), cell, values1[cell], values2[cell]);
+            printValuesForCell(keyword, occurrence1, occurrence2, numCells, cell, values1[cell], values2[cell]);
             HANDLE_ERROR(std::runtime_error, "Values of int type differ.");
         }
     }
@@ -119,7 +317,7 @@ void ECLRegressionTest::doubleComparisonForOccurrence(const std::string& keyword
 
     auto it = std::find(keywordDisallowNegatives.begin(), keywordDisallowNegatives.end(), keyword);
     for (size_t cell = 0; cell < values1.size(); cell++) {
-        deviationsForCell(values1[cell], values2[cell], keyword, occurrence1, occurrence2, cell, it == keywordDisallowNegatives.end());
+        deviationsForCell(values1[cell], values2[cell], keyword, occurrence1, occurrence2, values1.size(), cell, it == keywordDisallowNegatives.end());
     }
 }
 
@@ -171,6 +369,166 @@ void ECLRegressionTest::deviationsForCell(double val1, double val2,
 
 
 
+void ECLRegressionTest::streamingDoubleComparison(const ecl_kw_type* ecl_kw1, const ecl_kw_type* ecl_kw2,
+                                                  const std::string& keyword,
+                                                  int occurrence1, int occurrence2) {
+    const size_t numCells = ecl_kw_get_size(ecl_kw1);
+    const auto it = std::find(keywordDisallowNegatives.begin(), keywordDisallowNegatives.end(), keyword);
+    const Tolerances tol { getAbsTolerance(), getRelTolerance(), it == keywordDisallowNegatives.end() };
+
+    DeviationRecord location;
+    location.keyword     = keyword;
+    location.occurrence1 = occurrence1;
+    location.occurrence2 = occurrence2;
+    location.kw_size     = numCells;
+
+    // The worst deviation of this occurrence is always retained, for error reporting.
+    DeviationStatistics stats;
+    TopDeviations top(std::max(topDeviations.capacity(), size_t(1)));
+    size_t firstNegative = numCells;
+
+    if (ecl_type_get_type(ecl_kw_get_data_type(ecl_kw1)) == ECL_DOUBLE_TYPE) {
+        compareValues(ecl_kw_get_double_ptr(ecl_kw1), ecl_kw2, numCells, tol, location, stats, top, firstNegative);
+    }
+    else {
+        compareValues(ecl_kw_get_float_ptr(ecl_kw1), ecl_kw2, numCells, tol, location, stats, top, firstNegative);
+    }
+
+    keywordStatistics[keyword].merge(stats);
+    topDeviations.merge(top);
+
+    if (stats.numNegative > 0) {
+        const double val1 = ecl_kw_iget_as_double(ecl_kw1, firstNegative);
+        const double val2 = ecl_kw_iget_as_double(ecl_kw2, firstNegative);
+        printValuesForCell(keyword, occurrence1, occurrence2, numCells, firstNegative, val1, val2);
+        HANDLE_ERROR(std::runtime_error, stats.numNegative << " negative value(s) "
+                << "which in absolute value exceed the absolute tolerance of " << tol.abs << ".");
+        // Not thrown: count every negative value, as the non-streaming comparison does.
+        num_errors += stats.numNegative - 1;
+    }
+
+    if (stats.numFailures > 0 && !analysis) {
+        const DeviationRecord worst = top.sorted().front();
+        printValuesForCell(keyword, occurrence1, occurrence2, numCells, worst.cell, worst.value1, worst.value2);
+        HANDLE_ERROR(std::runtime_error, "Deviations exceed tolerances for " << stats.numFailures << " value(s)."
+                << "\nThe largest absolute deviation is " << worst.dev.abs << ", and the tolerance limit is " << tol.abs << "."
+                << "\nThe largest relative deviation is " << worst.dev.rel << ", and the tolerance limit is " << tol.rel << ".");
+        // Not thrown: count every failing value, as the non-streaming comparison does.
+        num_errors += stats.numFailures - 1;
+    }
+}
+
+
+
+void ECLRegressionTest::streamingResults(const std::string& keyword) {
+    const std::set<std::string> known(keywords1.begin(), keywords1.end());
+    std::map<std::string, int> occurrences;
+
+    FortIOPtr fortio1 = openReader(fileName1);
+    FortIOPtr fortio2 = openReader(fileName2);
+    EclKWPtr ecl_kw1 = readKeyword(fortio1.get());
+    EclKWPtr ecl_kw2 = readKeyword(fortio2.get());
+
+    while (ecl_kw1) {
+        const std::string header(ecl_kw_get_header(ecl_kw1.get()));
+        if (acceptExtraKeywords) {
+            while (ecl_kw2 && known.count(ecl_kw_get_header(ecl_kw2.get())) == 0) {
+                ecl_kw2 = readKeyword(fortio2.get());
+            }
+        }
+        if (!ecl_kw2 || header != ecl_kw_get_header(ecl_kw2.get())) {
+            OPM_THROW(std::runtime_error, "Keyword " << header << " (occurrence " << occurrences[header] << ")"
+                      << " is not matched by the same keyword in the second file."
+                      << "\nStreaming comparison requires the keywords to appear in the same order in both files.");
+        }
+
+        const int occurrence = occurrences[header]++;
+        if (keyword.empty() || header == keyword) {
+            const size_t numCells1 = ecl_kw_get_size(ecl_kw1.get());
+            const size_t numCells2 = ecl_kw_get_size(ecl_kw2.get());
+            if (numCells1 != numCells2) {
+                OPM_THROW(std::runtime_error, "For keyword " << header << ":"
+                        << "\nOccurrence " << occurrence
+                        << "\nCells in first file: " << numCells1
+                        << "\nCells in second file: " << numCells2
+                        << "\nThe number of cells differ.");
+            }
+
+            const ecl_type_enum type1 = ecl_type_get_type(ecl_kw_get_data_type(ecl_kw1.get()));
+            const ecl_type_enum type2 = ecl_type_get_type(ecl_kw_get_data_type(ecl_kw2.get()));
+            const bool numeric1 = type1 == ECL_DOUBLE_TYPE || type1 == ECL_FLOAT_TYPE;
+            const bool numeric2 = type2 == ECL_DOUBLE_TYPE || type2 == ECL_FLOAT_TYPE;
+            if (type1 != type2 && !(numeric1 && numeric2)) {
+                OPM_THROW(std::runtime_error, "For keyword " << header << ":"
+                        << "\nOccurrence " << occurrence
+                        << "\nThe keyword types differ.");
+            }
+
+            switch(type1) {
+                case ECL_DOUBLE_TYPE:
+                case ECL_FLOAT_TYPE:
+                    streamingDoubleComparison(ecl_kw1.get(), ecl_kw2.get(), header, occurrence, occurrence);
+                    break;
+                case ECL_INT_TYPE:
+                    intComparison(ecl_kw1.get(), ecl_kw2.get(), header, occurrence, occurrence);
+                    break;
+                case ECL_CHAR_TYPE:
+                    charComparison(ecl_kw1.get(), ecl_kw2.get(), header, occurrence, occurrence);
+                    break;
+                case ECL_BOOL_TYPE:
+                    boolComparison(ecl_kw1.get(), ecl_kw2.get(), header, occurrence, occurrence);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        ecl_kw1 = readKeyword(fortio1.get());
+        ecl_kw2 = readKeyword(fortio2.get());
+    }
+
+    if (ecl_kw2 && !acceptExtraKeywords) {
+        OPM_THROW(std::runtime_error, "Second file contains more keywords than the first file, starting with "
+                  << ecl_kw_get_header(ecl_kw2.get()) << ".");
+    }
+
+    printStreamingResults();
+}
+
+
+
+void ECLRegressionTest::printStreamingResults() const {
+    for (const auto& iter : keywordStatistics) {
+        const DeviationStatistics& stats = iter.second;
+        std::cout << "Deviation results for keyword " << iter.first << ":\n";
+        std::cout << "Average absolute deviation = " << stats.averageAbs() << std::endl;
+        std::cout << "Maximum absolute deviation = " << stats.maxAbs       << std::endl;
+        std::cout << "Average relative deviation = " << stats.averageRel() << std::endl;
+        std::cout << "Maximum relative deviation = " << stats.maxRel       << std::endl;
+        if (stats.numFailures > 0) {
+            std::cout << "Fails for " << stats.numFailures << " entries" << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    if (topDeviations.empty()) {
+        return;
+    }
+
+    std::cout << "Largest deviations exceeding tolerances:" << std::endl;
+    std::cout.precision(7);
+    for (const auto& record : topDeviations.sorted()) {
+        std::cout << "\t" << std::setw(8) << std::left << record.keyword
+                  << " occurrence " << record.occurrence1
+                  << " index " << record.cell
+                  << ": (" << record.value1 << ", " << record.value2 << ")"
+                  << " abs = " << std::scientific << record.dev.abs
+                  << " rel = " << record.dev.rel << std::defaultfloat << std::endl;
+    }
+}
+
+
+
 void ECLRegressionTest::gridCompare(const bool volumecheck) const {
     double absTolerance = getAbsTolerance();
     double relTolerance = getRelTolerance();
@@ -248,6 +606,11 @@ void ECLRegressionTest::results() {
         }
     }
 
+    if (streaming && !onlyLastOccurrence) {
+        streamingResults("");
+        return;
+    }
+
     for (const auto& it : keywords1)
         resultsForKeyword(it);
 
@@ -288,6 +651,10 @@ void ECLRegressionTest::resultsForKeyword(const std::string& keyword) {
                 << "\nKeyword occurrences in second file: " << occurrences2
                 << "\nThe number of occurrences differ.");
     }
+    if (streaming && !onlyLastOccurrence) {
+        streamingResults(keyword);
+        return;
+    }
     // Assuming keyword type is constant for every occurrence:
     const ecl_type_enum kw_type = ecl_type_get_type( ecl_file_iget_named_data_type(ecl_file1, keyword.c_str(), 0) );
     switch(kw_type) {
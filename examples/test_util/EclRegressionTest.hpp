@@ -20,6 +20,7 @@
 #ifndef ECLREGRESSIONTEST_HPP
 #define ECLREGRESSIONTEST_HPP
 
+#include "DeviationStatistics.hpp"
 #include "EclFilesComparator.hpp"
 
 /*! \brief A class for executing a regression test for two ECLIPSE files.
@@ -43,6 +44,15 @@ class ECLRegressionTest: public ECLFilesComparator {
         // Accept extra keywords in the restart file of the 'new' simulation.
         bool acceptExtraKeywords = false;
 
+        // Read and compare the files one keyword at a time, keeping only
+        // summary statistics and the largest deviations.
+        bool streaming = false;
+
+        // Largest deviations over all keywords, and per keyword summary
+        // statistics, collected in streaming mode.
+        TopDeviations topDeviations;
+        std::map<std::string, DeviationStatistics> keywordStatistics;
+
 
         // Prints results stored in absDeviation and relDeviation.
         void printResultsForKeyword(const std::string& keyword) const;
@@ -59,6 +69,21 @@ class ECLRegressionTest: public ECLFilesComparator {
         // if allowNegativeValues is passed as false, an exception will be thrown when the absolute value
         // of a negative value exceeds absTolerance. If no exceptions are thrown, the absolute and relative deviations are added to absDeviation and relDeviation.
         void deviationsForCell(double val1, double val2, const std::string& keyword, int occurrence1, int occurrence2, size_t kw_size, size_t cell, bool allowNegativeValues = true);
+
+        // Comparisons of already loaded keyword data, shared by the
+        // ecl_file based and the streaming comparisons.
+        void boolComparison(const ecl_kw_type* ecl_kw1, const ecl_kw_type* ecl_kw2, const std::string& keyword, int occurrence1, int occurrence2) const;
+        void charComparison(const ecl_kw_type* ecl_kw1, const ecl_kw_type* ecl_kw2, const std::string& keyword, int occurrence1, int occurrence2) const;
+        void intComparison(const ecl_kw_type* ecl_kw1, const ecl_kw_type* ecl_kw2, const std::string& keyword, int occurrence1, int occurrence2) const;
+
+        // Streaming counterpart of doubleComparisonForOccurrence(). The values are compared block-wise, in parallel
+        // if OpenMP is enabled, and only accumulated into keywordStatistics and topDeviations.
+        void streamingDoubleComparison(const ecl_kw_type* ecl_kw1, const ecl_kw_type* ecl_kw2, const std::string& keyword, int occurrence1, int occurrence2);
+        // Reads both files sequentially, one keyword at a time, and compares every occurrence of
+        // the given keyword, or of all keywords if the keyword is empty.
+        void streamingResults(const std::string& keyword);
+        // Prints keywordStatistics and topDeviations.
+        void printStreamingResults() const;
     public:
         //! \brief Sets up the regression test.
         //! \param[in] file_type Specifies which filetype to be compared, possible inputs are UNRSTFILE, INITFILE and RFTFILE.
@@ -78,6 +103,22 @@ class ECLRegressionTest: public ECLFilesComparator {
         // in the new simulation.
         void setAcceptExtraKeywords(bool acceptExtraKeywordsArg) { this->acceptExtraKeywords = acceptExtraKeywordsArg; }
 
+        //! \brief Option to compare the files in streaming mode.
+        //! \details In streaming mode the two files are read sequentially, one keyword at a time, and only
+        //! summary statistics (average and maximum deviations) and the largest deviations are kept. The keywords
+        //! must appear in the same order in both files. Median deviations are not available in this mode, and
+        //! onlyLastOccurrence comparisons always use the regular code path.
+        void setStreaming(bool streamingArg) { this->streaming = streamingArg; }
+
+        //! \brief Number of largest deviations reported in streaming mode.
+        void setMaxReportedDeviations(size_t num) { this->topDeviations = TopDeviations(num); }
+
+        //! \brief Per keyword summary statistics collected in streaming mode.
+        const std::map<std::string, DeviationStatistics>& getKeywordStatistics() const { return keywordStatistics; }
+
+        //! \brief Largest deviations over all keywords collected in streaming mode.
+        const TopDeviations& getTopDeviations() const { return topDeviations; }
+
         //! \brief Compares grid properties of the two cases.
         // gridCompare() checks if both the number of active and global cells in the two cases are the same. If they are, and volumecheck is true, all cells are looped over to calculate the cell volume deviation for the two cases. If the both the relative and absolute deviation exceeds the tolerances, an exception is thrown.
         void gridCompare(const bool volumecheck) const;
@@ -41,6 +41,7 @@ static void printHelp() {
         << "4. Relative tolerance (between 0 and 1)\n\n"
         << "In addition, the program takes these options (which must be given before the arguments):\n\n"
         << "-a Run a full analysis of errors.\n"
+        << "-B Compare all summary vectors in bulk: read all vectors up front and compare them in parallel. Only for the summary regression test.\n"
         << "-g Will print the vector with the greatest error ratio.\n"
         << "-h Print help and exit.\n"
         << "-i Execute integration test (regression test is default).\n"
@@ -55,6 +56,9 @@ static void printHelp() {
         << "-P Print common and uncommon keywords in both cases and exit. Can not be used in combination with -p.\n"
         << "-R Will allow comparison between a restarted simulation and a normal simulation for summary regression tests. The files must end at the same time.\n"
         << "-s int Sets the number of spikes that are allowed for each keyword in summary integration tests.\n"
+        << "-S Compare restart, initial and RFT files in streaming mode, reading one keyword at a time. Only average and maximum deviations and the largest\n"
+        << "   deviations are reported. Requires the keywords to appear in the same order in both files. Only for the regression test.\n"
+        << "-N int Sets the number of largest deviations reported in streaming mode (default 10).\n"
         << "-t Specify ECLIPSE filetype to compare (unified restart is default). Can not be used in combination with -i or -I. Different possible arguments are:\n"
         << "    -t UNRST \t Compare two unified restart files (.UNRST). This the default value, so it is the same as not passing option -t.\n"
         << "    -t INIT  \t Compare two initial files (.INIT).\n"
@@ -135,17 +139,23 @@ int main(int argc, char** argv) {
     bool acceptExtraKeywords     = false;
     bool analysis                = false;
     bool volumecheck             = true;
+    bool streaming               = false;
+    bool bulkSummary             = false;
     char* keyword                = nullptr;
     char* fileTypeCstr           = nullptr;
     const char* mainVariable     = nullptr;
     int c                        = 0;
     int spikeLimit               = -1;
+    int maxReportedDeviations    = -1;
 
-    while ((c = getopt(argc, argv, "hiIk:alnpPt:VRgs:m:vKx")) != -1) {
+    while ((c = getopt(argc, argv, "hiIk:aBlnN:pPt:VRgs:Sm:vKx")) != -1) {
         switch (c) {
             case 'a':
               analysis = true;
               break;
+            case 'B':
+                bulkSummary = true;
+                break;
             case 'g':
                 findGreatestErrorRatio = true;
                 throwTooGreatErrorRatio = false;
@@ -176,6 +186,9 @@ int main(int argc, char** argv) {
             case 'n':
                 throwOnError = false;
                 break;
+            case 'N':
+                maxReportedDeviations = atoi(optarg);
+                break;
             case 'p':
                 printKeywords = true;
                 break;
@@ -189,6 +202,9 @@ int main(int argc, char** argv) {
                 allowSpikes = true;
                 spikeLimit = atof(optarg);
                 break;
+            case 'S':
+                streaming = true;
+                break;
             case 't':
                 specificFileType = true;
                 fileTypeCstr = optarg;
@@ -203,7 +219,7 @@ int main(int argc, char** argv) {
                 acceptExtraKeywords = true;
                 break;
             case '?':
-                if (optopt == 'k' || optopt == 'm' || optopt == 's') {
+                if (optopt == 'k' || optopt == 'm' || optopt == 's' || optopt == 'N') {
                     std::cerr << "Option " << optopt << " requires a keyword as argument, see manual (-h) for more information." << std::endl;
                     return EXIT_FAILURE;
                 }
@@ -222,7 +238,8 @@ int main(int argc, char** argv) {
     int argOffset = optind;
     if ((printKeywords && printKeywordsDifference) ||
         (integrationTest && specificFileType)      ||
-        (integrationTest && onlyLastOccurrence)) {
+        (integrationTest && onlyLastOccurrence)    ||
+        (integrationTest && streaming)) {
         std::cerr << "Error: Options given which can not be combined. "
             << "Please see the manual (-h) for more information." << std::endl;
         return EXIT_FAILURE;
@@ -282,6 +299,7 @@ int main(int argc, char** argv) {
                 compare.setPrintKeywords(printKeywords);
                 compare.setIsRestartFile(restartFile);
                 compare.setAllowDifferentNumberOfKeywords(acceptExtraKeywords);
+                compare.setBulkMode(bulkSummary);
                 if(specificKeyword){
                     compare.getRegressionTest(keyword);
                 }
@@ -350,6 +368,10 @@ int main(int argc, char** argv) {
             comparator.throwOnErrors(throwOnError);
             comparator.doAnalysis(analysis);
             comparator.setAcceptExtraKeywords(acceptExtraKeywords);
+            comparator.setStreaming(streaming);
+            if (maxReportedDeviations >= 0) {
+                comparator.setMaxReportedDeviations(maxReportedDeviations);
+            }
             if (printKeywords) {
                 comparator.printKeywords();
                 return 0;
@@ -157,6 +157,43 @@ void SummaryComparator::getDeviation(size_t refIndex, size_t &checkIndex, Deviat
 }
 
 
+void SummaryComparator::loadColumns(const ecl_sum_type* ecl_sum,
+                                    const std::vector<std::string>& keywords,
+                                    SummaryColumns& columns){
+    const int numSteps = ecl_sum_get_data_length(ecl_sum);
+    columns.numSteps = numSteps;
+    columns.data.resize(keywords.size() * columns.numSteps);
+
+    double* dest = columns.data.data();
+    for (const auto& keyword : keywords){
+        const int paramsIndex = ecl_sum_get_general_var_params_index(ecl_sum, keyword.c_str());
+        for (int time_index = 0; time_index < numSteps; time_index++){
+            *dest++ = ecl_sum_iget(ecl_sum, time_index, paramsIndex);
+        }
+    }
+}
+
+
+std::vector<size_t> SummaryComparator::alignTimeAxes(const std::vector<double>& referenceTime,
+                                                     const std::vector<double>& checkTime){
+    std::vector<size_t> alignment(referenceTime.size(), 0);
+    if (checkTime.empty()){
+        return alignment;
+    }
+    // Same traversal as getDeviation(): skip check steps before the
+    // reference time, then use the first step at or after it.
+    size_t checkIndex = 0;
+    for (size_t refIndex = 0; refIndex < referenceTime.size(); refIndex++){
+        while (checkIndex < checkTime.size() && checkTime[checkIndex] < referenceTime[refIndex]){
+            checkIndex++;
+        }
+        alignment[refIndex] = std::min(checkIndex, checkTime.size() - 1);
+        checkIndex++;
+    }
+    return alignment;
+}
+
+
 void SummaryComparator::printUnits(){
     std::vector<double> timeVec1, timeVec2;
     setTimeVecs(timeVec1, timeVec2);  // Sets the time vectors, they are equal for all keywords (WPOR:PROD01 etc)
@@ -108,6 +108,23 @@ class SummaryComparator {
                              const std::vector<double> &dataVec1,
                              const std::vector<double> &dataVec2);
 
+        //! \brief Summary vectors of one file in columnar form.
+        //! \details The value of vector k at time step t is stored at data[k*numSteps + t].
+        struct SummaryColumns {
+            size_t numSteps = 0;
+            std::vector<double> data;
+
+            const double* column(size_t k) const { return data.data() + k*numSteps; }
+        };
+
+        //! \brief Reads the vectors of the given keywords for all time steps of a file.
+        //! \param[in] ecl_sum The file to read from.
+        //! \param[in] keywords Keywords of the vectors to read, all of which must exist in the file.
+        //! \param[out] columns Holds the vectors, in the order of keywords, on return.
+        static void loadColumns(const ecl_sum_type* ecl_sum,
+                                const std::vector<std::string>& keywords,
+                                SummaryColumns& columns);
+
         //! \brief Returns the relative tolerance.
         double getRelTolerance(){return this->relativeTolerance;}
 
@@ -172,6 +189,13 @@ class SummaryComparator {
         //! \brief Returns a value based on the unit step principle.
         static double unitStep(double value){return value;}
 
+        //! \brief Aligns two time axes once for all vectors.
+        //! \param[in] referenceTime The time steps of the reference file, see #referenceVec.
+        //! \param[in] checkTime The time steps of the file to check, see #checkVec.
+        //! \return For every reference time step, the index of the check time step getDeviation() compares it to.
+        static std::vector<size_t> alignTimeAxes(const std::vector<double>& referenceTime,
+                                                 const std::vector<double>& checkTime);
+
         //! \brief Set whether to throw on errors or not.
         void throwOnErrors(bool dothrow) { throwOnError = dothrow; }
 
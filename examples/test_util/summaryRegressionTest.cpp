@@ -20,6 +20,9 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <ert/ecl/ecl_sum.hpp>
 #include <ert/util/stringlist.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <string>
 
 void SummaryRegressionTest::getRegressionTest(){
@@ -53,8 +56,32 @@ void SummaryRegressionTest::getRegressionTest(){
     }
 
 
-    //Iterates over all keywords from the restricted file, use iterator "ivar". Searches for a  match in the file with more keywords, use the iterator "jvar".
     bool throwAtEnd = false;
+    if (bulkMode) {
+        std::vector<std::string> keywordsLong;
+        keywordsLong.reserve(stringlist_get_size(keysLong));
+        for (int jvar = 0; jvar < stringlist_get_size(keysLong); jvar++){
+            keywordsLong.emplace_back(stringlist_iget(keysLong, jvar));
+        }
+        std::sort(keywordsLong.begin(), keywordsLong.end());
+
+        std::vector<std::string> keywords;
+        keywords.reserve(stringlist_get_size(keysShort));
+        for (; ivar < stringlist_get_size(keysShort); ivar++){
+            std::string keywordString(stringlist_iget(keysShort, ivar));
+            if (!std::binary_search(keywordsLong.begin(), keywordsLong.end(), keywordString)){
+                std::cout << "Could not find keyword: " << keywordString << std::endl;
+                OPM_THROW(std::runtime_error, "No match on keyword");
+            }
+            if (isRestartFile && keywordString.substr(3,1)=="T"){
+                continue;
+            }
+            keywords.push_back(keywordString);
+        }
+        throwAtEnd = !checkKeywordsInBulk(timeVec1, timeVec2, keywords);
+    }
+
+    //Iterates over all keywords from the restricted file, use iterator "ivar". Searches for a  match in the file with more keywords, use the iterator "jvar".
     while(ivar < stringlist_get_size(keysShort)){
         const char* keyword = stringlist_iget(keysShort, ivar);
         std::string keywordString(keyword);
@@ -166,7 +193,88 @@ bool SummaryRegressionTest::startTest(const char* keyword){
     bool result = true;
     for (size_t ivar = 0; ivar < referenceVec->size(); ivar++){
         getDeviation(ivar, jvar, deviation);//Reads from the protected member variables in the super class.
-        result = checkDeviation(deviation, keyword,ivar, jvar);
+        result &= checkDeviation(deviation, keyword,ivar, jvar);
+    }
+
+    return result;
+}
+
+bool SummaryRegressionTest::checkKeywordsInBulk(const std::vector<double>& timeVec1,
+                                                const std::vector<double>& timeVec2,
+                                                const std::vector<std::string>& keywords){
+    // Same choice of reference as chooseReference().
+    const bool firstIsReference = timeVec1.size() <= timeVec2.size();
+    const std::vector<double>& refTime   = firstIsReference ? timeVec1 : timeVec2;
+    const std::vector<double>& checkTime = firstIsReference ? timeVec2 : timeVec1;
+
+    SummaryColumns refColumns, checkColumns;
+    loadColumns(firstIsReference ? ecl_sum1 : ecl_sum2, keywords, refColumns);
+    loadColumns(firstIsReference ? ecl_sum2 : ecl_sum1, keywords, checkColumns);
+
+    const std::vector<size_t> alignment = alignTimeAxes(refTime, checkTime);
+    const size_t numSteps = refTime.size();
+    const double absTol = getAbsTolerance();
+    const double relTol = getRelTolerance();
+
+    // Time steps exceeding the tolerances, per keyword.
+    std::vector<std::vector<size_t>> failures(keywords.size());
+
+    if (numSteps > 0 && !checkTime.empty()) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<double> aligned(numSteps);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+            for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(keywords.size()); k++){
+                const double* refData   = refColumns.column(k);
+                const double* checkData = checkColumns.column(k);
+                for (size_t i = 0; i < numSteps; i++){
+                    aligned[i] = checkData[alignment[i]];
+                }
+
+                // Branch free pass over the aligned columns, see calculateDeviations().
+                size_t numFailures = 0;
+                for (size_t i = 0; i < numSteps; i++){
+                    const double absDev  = std::abs(refData[i] - aligned[i]);
+                    const double largest = std::max(std::abs(refData[i]), std::abs(aligned[i]));
+                    numFailures += (absDev > absTol) && (absDev > relTol*largest) && (largest != 0);
+                }
+                if (numFailures == 0){
+                    continue;
+                }
+
+                for (size_t i = 0; i < numSteps; i++){
+                    const Deviation dev = calculateDeviations(refData[i], aligned[i]);
+                    if (dev.rel > relTol && dev.abs > absTol){
+                        failures[k].push_back(i);
+                    }
+                }
+            }
+        }
+    }
+
+    bool result = true;
+    for (size_t k = 0; k < keywords.size(); k++){
+        if (failures[k].empty()){
+            continue;
+        }
+        // Report through the single keyword code path to keep the output format.
+        const std::vector<double> refData(refColumns.column(k), refColumns.column(k) + refColumns.numSteps);
+        const std::vector<double> checkData(checkColumns.column(k), checkColumns.column(k) + checkColumns.numSteps);
+        referenceVec     = &refTime;
+        referenceDataVec = &refData;
+        checkVec         = &checkTime;
+        checkDataVec     = &checkData;
+        for (const size_t refIndex : failures[k]){
+            const size_t checkIndex = alignment[refIndex];
+            const Deviation dev = calculateDeviations(refData[refIndex], checkData[checkIndex]);
+            result &= checkDeviation(dev, keywords[k].c_str(), refIndex, checkIndex + 1);
+        }
+        referenceVec = referenceDataVec = checkVec = checkDataVec = nullptr;
     }
 
     return result;
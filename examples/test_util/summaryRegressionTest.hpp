@@ -47,7 +47,17 @@ class SummaryRegressionTest: public SummaryComparator {
         //! \return True if check passed, false otherwise.
         bool checkDeviation(Deviation deviation, const char* keyword, int refIndex, int checkIndex);
 
+        //! \brief The regression test for many keywords at once
+        //! \param[in] timeVec1 The time steps of file 1.
+        //! \param[in] timeVec2 The time steps of file 2.
+        //! \param[in] keywords The keywords common for both files which are to be compared.
+        //! \details Loads all the vectors of both files in columnar form, aligns the time axes once and computes the deviations of all vectors in parallel. \n Deviations exceeding the tolerances are reported through checkDeviation(), in keyword and time step order, as in the test for a single keyword.
+        //! \return True if check passed, false otherwise.
+        bool checkKeywordsInBulk(const std::vector<double>& timeVec1, const std::vector<double>& timeVec2,
+                                 const std::vector<std::string>& keywords);
+
         bool isRestartFile = false; //!< Private member variable, when true the files that are being compared is a restart file vs a normal file
+        bool bulkMode = false; //!< Private member variable, when true all keywords are compared by checkKeywordsInBulk()
 
         /// Whether or not to require that the two files have the same
         /// number of keywords.  Throw exception if not.
@@ -76,6 +86,11 @@ class SummaryRegressionTest: public SummaryComparator {
         //! \param[in] boolean Boolean value
         void setIsRestartFile(bool boolean){this->isRestartFile = boolean;}
 
+        //! \brief This function sets the private member variable bulkMode
+        //! \param[in] boolean Boolean value
+        //! \details In bulk mode getRegressionTest() reads all vectors up front and compares them in parallel. This uses memory proportional to the size of both summary files, but is much faster for files with many vectors.
+        void setBulkMode(bool boolean){this->bulkMode = boolean;}
+
         /// \brief Dynamically control whether or not to require equal
         ///    number of keywords (vectors) in the two result sets.
         ///
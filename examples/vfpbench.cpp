@@ -0,0 +1,197 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Benchmark of the VFPProdEvaluator against a straightforward multilinear
+  interpolation which searches the axes and indexes the multi_array of
+  the VFPProdTable directly.
+
+  Usage: vfpbench [num_wells [num_iterations]]
+
+  Each iteration evaluates the bottom hole pressure of all wells, with
+  the well coordinates drifting slowly between iterations as they would
+  between Newton iterations in a simulator.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
+
+
+namespace {
+
+    std::vector<double> makeAxis(std::size_t n, double first, double last) {
+        std::vector<double> axis(n);
+        for (std::size_t i = 0; i < n; i++)
+            axis[i] = first + (last - first) * i / std::max<std::size_t>(n - 1, 1);
+        return axis;
+    }
+
+
+    Opm::VFPProdTable makeTable() {
+        const auto flo = makeAxis(30, 0, 1000);
+        const auto thp = makeAxis(10, 10e5, 100e5);
+        const auto wfr = makeAxis(8, 0, 0.9);
+        const auto gfr = makeAxis(8, 50, 500);
+        const auto alq = makeAxis(4, 0, 10);
+
+        Opm::VFPProdTable::extents shape;
+        shape[0] = thp.size();
+        shape[1] = wfr.size();
+        shape[2] = gfr.size();
+        shape[3] = alq.size();
+        shape[4] = flo.size();
+        Opm::VFPProdTable::array_type data(shape);
+        for (std::size_t t = 0; t < thp.size(); t++)
+            for (std::size_t w = 0; w < wfr.size(); w++)
+                for (std::size_t g = 0; g < gfr.size(); g++)
+                    for (std::size_t a = 0; a < alq.size(); a++)
+                        for (std::size_t f = 0; f < flo.size(); f++)
+                            data[t][w][g][a][f] = thp[t] + 1e3*flo[f]*(1 + wfr[w]) - 10*gfr[g] + std::sqrt(flo[f]*(1 + alq[a]));
+
+        return Opm::VFPProdTable(1, 2000.0,
+                                 Opm::VFPProdTable::FLO_LIQ,
+                                 Opm::VFPProdTable::WFR_WCT,
+                                 Opm::VFPProdTable::GFR_GOR,
+                                 Opm::VFPProdTable::ALQ_GRAT,
+                                 flo, thp, wfr, gfr, alq, data);
+    }
+
+
+    struct NaiveInterval {
+        std::size_t index;
+        double factor;
+    };
+
+    NaiveInterval naiveSearch(const std::vector<double>& axis, double x) {
+        if (axis.size() == 1)
+            return {0, 0.0};
+
+        const auto upper = std::upper_bound(axis.begin(), axis.end(), x);
+        std::size_t i = upper - axis.begin();
+        i = (i == 0) ? 0 : std::min(i - 1, axis.size() - 2);
+        return {i, (x - axis[i]) / (axis[i + 1] - axis[i])};
+    }
+
+    double naiveBhp(const Opm::VFPProdTable& table, const Opm::VFPProdEvaluator::Point& p) {
+        const auto& data = table.getTable();
+        const auto f = naiveSearch(table.getFloAxis(), p.flo);
+        const auto t = naiveSearch(table.getTHPAxis(), p.thp);
+        const auto w = naiveSearch(table.getWFRAxis(), p.wfr);
+        const auto g = naiveSearch(table.getGFRAxis(), p.gfr);
+        const auto a = naiveSearch(table.getALQAxis(), p.alq);
+
+        double value = 0;
+        for (int it = 0; it < 2; it++)
+            for (int iw = 0; iw < 2; iw++)
+                for (int ig = 0; ig < 2; ig++)
+                    for (int ia = 0; ia < 2; ia++)
+                        for (int ifl = 0; ifl < 2; ifl++) {
+                            const double weight = (it ? t.factor : 1 - t.factor) *
+                                                  (iw ? w.factor : 1 - w.factor) *
+                                                  (ig ? g.factor : 1 - g.factor) *
+                                                  (ia ? a.factor : 1 - a.factor) *
+                                                  (ifl ? f.factor : 1 - f.factor);
+                            value += weight * data[t.index + it][w.index + iw][g.index + ig][a.index + ia][f.index + ifl];
+                        }
+        return value;
+    }
+
+
+    template <typename Func>
+    double timeIt(Func&& func) {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+}
+
+
+int main(int argc, char** argv) {
+    const std::size_t num_wells = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    const std::size_t num_iter = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+    const auto table = makeTable();
+    const Opm::VFPProdEvaluator eval(table);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::vector<Opm::VFPProdEvaluator::Point> points(num_wells);
+    for (auto& p : points)
+        p = { 1000*unit(gen), 10e5 + 90e5*unit(gen), 0.9*unit(gen), 50 + 450*unit(gen), 10*unit(gen) };
+    const auto initial_points = points;
+
+    auto drift = [&points](std::size_t iter) {
+        const double scale = 1 + 1e-3 * ((iter % 2) ? 1 : -1);
+        for (auto& p : points)
+            p.flo *= scale;
+    };
+
+    double checksum_naive = 0;
+    double checksum_single = 0;
+    double checksum_batch = 0;
+
+    const double t_naive = timeIt([&]() {
+            for (std::size_t iter = 0; iter < num_iter; iter++) {
+                drift(iter);
+                for (const auto& p : points)
+                    checksum_naive += naiveBhp(table, p);
+            }
+        });
+
+    points = initial_points;
+    std::vector<Opm::VFPHint> hints(num_wells);
+    const double t_single = timeIt([&]() {
+            for (std::size_t iter = 0; iter < num_iter; iter++) {
+                drift(iter);
+                for (std::size_t w = 0; w < num_wells; w++) {
+                    const auto& p = points[w];
+                    checksum_single += eval.bhp(p.flo, p.thp, p.wfr, p.gfr, p.alq, &hints[w]).value;
+                }
+            }
+        });
+
+    points = initial_points;
+    std::vector<Opm::VFPEvaluation> results;
+    const double t_batch = timeIt([&]() {
+            for (std::size_t iter = 0; iter < num_iter; iter++) {
+                drift(iter);
+                eval.bhp(points, results, hints);
+                for (const auto& r : results)
+                    checksum_batch += r.value;
+            }
+        });
+
+    const double num_eval = static_cast<double>(num_wells * num_iter);
+    std::cout << "Wells: " << num_wells << "  iterations: " << num_iter << std::endl;
+    std::cout << "naive multi_array (value only)    : " << 1e9 * t_naive / num_eval << " ns/eval" << std::endl;
+    std::cout << "VFPProdEvaluator, hinted          : " << 1e9 * t_single / num_eval << " ns/eval" << std::endl;
+    std::cout << "VFPProdEvaluator, batch           : " << 1e9 * t_batch / num_eval << " ns/eval" << std::endl;
+    std::cout << "relative checksum difference      : "
+              << std::abs(checksum_single - checksum_naive) / std::abs(checksum_naive) << " / "
+              << std::abs(checksum_batch - checksum_naive) / std::abs(checksum_naive) << std::endl;
+}
@@ -18,6 +18,7 @@
 namespace Opm {
 
 class EclipseIO;
+class LoadReport;
 
 
 class msim {
@@ -29,6 +30,15 @@ public:
     msim(const std::string& deck_file);
     msim(const std::string& deck_file, const Parser& parser, const ParseContext& parse_context);
 
+    /*
+      When a report is given the time used to parse the deck and to build
+      the EclipseState, the Schedule and the SummaryConfig is recorded in
+      it, and run() records the time spent writing the INIT, EGRID,
+      summary, restart and RFT files. The report must outlive the msim
+      object.
+    */
+    msim(const std::string& deck_file, const Parser& parser, const ParseContext& parse_context, LoadReport* report);
+
     void well_rate(const std::string& well, data::Rates::opt rate, std::function<well_rate_function> func);
     void solution(const std::string& field, std::function<solution_function> func);
     void run();
@@ -38,7 +48,9 @@ private:
     void run_step(data::Solution& sol, data::Wells& well_data, size_t report_step, double dt, EclipseIO& io) const;
     void output(size_t report_step, bool substep, double seconds_elapsed, const data::Solution& sol, const data::Wells& well_data, EclipseIO& io) const;
     void simulate(data::Solution& sol, data::Wells& well_data, size_t report_step, double seconds_elapsed, double time_step) const;
+    void connections(const data::Solution& sol, data::Wells& well_data, size_t report_step) const;
 
+    LoadReport* report;
     Deck deck;
     EclipseState state;
     Schedule schedule;
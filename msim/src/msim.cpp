@@ -24,21 +24,48 @@
 #include <opm/output/data/Solution.hpp>
 #include <opm/output/data/Wells.hpp>
 
+#include <opm/parser/eclipse/EclipseState/LoadReport.hpp>
+#include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/msim/msim.hpp>
 
 namespace Opm {
 
-msim::msim(const std::string& deck_file, const Parser& parser, const ParseContext& parse_context) :
-    deck(parser.parseFile(deck_file, parse_context)),
-    state(deck, parse_context),
-    schedule(deck, state.getInputGrid(), state.get3DProperties(), state.runspec(), parse_context),
-    summary_config(deck, schedule, state.getTableManager(), parse_context)
+namespace {
+
+    template <typename T, typename Build>
+    T timed(LoadReport* report, const std::string& phase, Build&& build) {
+        LoadReport::Timer timer(report, phase);
+        return build();
+    }
+
+}
+
+
+msim::msim(const std::string& deck_file, const Parser& parser, const ParseContext& parse_context, LoadReport* report_) :
+    report(report_),
+    deck(timed<Deck>(report_, "Parse", [&] {
+                ErrorGuard errors;
+                return parser.parseFile(deck_file, parse_context, errors); })),
+    state(timed<EclipseState>(report_, "EclipseState", [&] {
+                ErrorGuard errors;
+                return EclipseState(this->deck, parse_context, errors); })),
+    schedule(timed<Schedule>(report_, "Schedule", [&] {
+                ErrorGuard errors;
+                return Schedule(this->deck, this->state, parse_context, errors); })),
+    summary_config(timed<SummaryConfig>(report_, "SummaryConfig", [&] {
+                ErrorGuard errors;
+                return SummaryConfig(this->deck, this->schedule, this->state.getTableManager(), parse_context, errors); }))
 {
 }
 
 
+msim::msim(const std::string& deck_file, const Parser& parser, const ParseContext& parse_context) :
+    msim(deck_file, parser, parse_context, nullptr)
+{}
+
+
 msim::msim(const std::string& deck_file) :
     msim(deck_file, Parser(), ParseContext())
 {}
@@ -50,6 +77,7 @@ void msim::run() {
     data::Solution sol;
     data::Wells well_data;
 
+    io.setLoadReport(this->report);
     io.writeInitial();
     for (size_t report_step = 1; report_step < this->schedule.size(); report_step++) {
         double time_step = std::min(week, 0.5*this->schedule.stepLength(report_step - 1));
@@ -115,6 +143,49 @@ void msim::simulate(data::Solution& sol, data::Wells& well_data, size_t report_s
             well.rates.set(rate, func(this->state, this->schedule, sol, report_step, seconds_elapsed + time_step));
         }
     }
+
+    this->connections(sol, well_data, report_step);
+}
+
+
+/*
+  The output layer expects one data::Connection for every open connection
+  of the wells in the well data, in the order of the schedule. The cell
+  values are taken from the PRESSURE, SWAT and SGAS solutions when they
+  are present.
+*/
+void msim::connections(const data::Solution& sol, data::Wells& well_data, size_t report_step) const {
+    const auto& grid = this->state.getInputGrid();
+    const auto cell_value = [&sol](const std::string& field, size_t active_index) {
+        if (!sol.has(field))
+            return 0.0;
+
+        const auto& values = sol.data(field);
+        return active_index < values.size() ? values[active_index] : 0.0;
+    };
+
+    for (auto& well_pair : well_data) {
+        auto& well = well_pair.second;
+        well.connections.clear();
+        if (!this->schedule.hasWell(well_pair.first))
+            continue;
+
+        const auto* sched_well = this->schedule.getWell(well_pair.first);
+        for (const auto& connection : sched_well->getActiveConnections(report_step, grid)) {
+            if (connection.state() != WellCompletion::StateEnum::OPEN)
+                continue;
+
+            const size_t global_index = grid.getGlobalIndex(connection.getI(), connection.getJ(), connection.getK());
+            const size_t active_index = grid.activeIndex(global_index);
+
+            data::Connection conn{};
+            conn.index = global_index;
+            conn.cell_pressure = cell_value("PRESSURE", active_index);
+            conn.cell_saturation_water = cell_value("SWAT", active_index);
+            conn.cell_saturation_gas = cell_value("SGAS", active_index);
+            well.connections.push_back(conn);
+        }
+    }
 }
 
 
@@ -0,0 +1,112 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MESSAGE_BUFFER_HPP
+#define OPM_MESSAGE_BUFFER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+/*
+  Contiguous byte buffer implementing the MessageBufferType interface
+  used by the pack()/unpack() and write()/read() templates, e.g. in
+  Deck, DynamicState and data::Wells. Values are stored in native byte
+  order, so a buffer can be passed between processes on the same
+  platform, e.g. with MPI_Bcast of data() and size(), or stored in a
+  cache file which is read back on the same platform.
+*/
+class MessageBuffer {
+public:
+    MessageBuffer() = default;
+
+    explicit MessageBuffer(std::vector<char> data) :
+        m_data(std::move(data))
+    {}
+
+    template <class T>
+    void write(const T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                      "MessageBuffer can only write arithmetic and enum types");
+
+        const char* begin = reinterpret_cast<const char*>(&value);
+        m_data.insert(m_data.end(), begin, begin + sizeof(T));
+    }
+
+    void write(const std::string& value) {
+        unsigned int size = value.size();
+        this->write(size);
+        m_data.insert(m_data.end(), value.begin(), value.end());
+    }
+
+    template <class T>
+    void read(T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                      "MessageBuffer can only read arithmetic and enum types");
+
+        std::memcpy(&value, this->consume(sizeof(T)), sizeof(T));
+    }
+
+    void read(std::string& value) {
+        unsigned int size;
+        this->read(size);
+        const char* begin = this->consume(size);
+        value.assign(begin, begin + size);
+    }
+
+    const char* data() const {
+        return m_data.data();
+    }
+
+    std::size_t size() const {
+        return m_data.size();
+    }
+
+    /// Number of bytes which have not been read yet.
+    std::size_t remaining() const {
+        return m_data.size() - m_pos;
+    }
+
+    const std::vector<char>& bytes() const {
+        return m_data;
+    }
+
+private:
+    const char* consume(std::size_t size) {
+        if (size > this->remaining())
+            throw std::out_of_range("Read past the end of MessageBuffer");
+
+        const char* ptr = m_data.data() + m_pos;
+        m_pos += size;
+        return ptr;
+    }
+
+    std::vector<char> m_data;
+    std::size_t m_pos = 0;
+};
+
+}
+
+#endif
@@ -26,8 +26,10 @@
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -146,6 +148,45 @@ namespace Opm {
         void read(MessageBufferType& buffer);
     };
 
+    /*
+      Map from the global cell index of the connections of a well to their
+      position in the connections vector. The map is built on the first
+      lookup, and it is rebuilt when the vector has been resized or
+      reallocated since then, or when a position no longer holds the
+      connection it was built for. A lookup which misses does not rebuild
+      the map - misses are common, e.g. for the cells without data - so
+      after overwriting a connection in place with the connection of
+      another cell, call clear(). A lookup may build the map, so
+      concurrent lookups in the same well must be synchronized by the
+      caller.
+    */
+    class ConnectionIndex {
+    public:
+        // A copy starts out empty; the copied map would be rebuilt for
+        // the connections of the copy anyway. A move keeps the map, since
+        // the connections vector it was built for moves along with it.
+        ConnectionIndex() = default;
+        ConnectionIndex(const ConnectionIndex&) {}
+        ConnectionIndex(ConnectionIndex&&) = default;
+        ConnectionIndex& operator=(const ConnectionIndex&) { this->clear(); return *this; }
+        ConnectionIndex& operator=(ConnectionIndex&&) = default;
+
+        inline const Connection* find(const std::vector< Connection >& connections,
+                                      Connection::global_index index) const;
+        inline void clear();
+
+        /// The number of times the map has been built.
+        std::size_t num_builds() const { return this->builds; }
+
+    private:
+        inline void build(const std::vector< Connection >& connections) const;
+
+        mutable std::unordered_map< Connection::global_index, std::size_t > slots;
+        mutable const Connection* data = nullptr;
+        mutable std::size_t size = 0;
+        mutable std::size_t builds = 0;
+    };
+
     struct Well {
         Rates rates;
         double bhp;
@@ -154,7 +195,14 @@ namespace Opm {
         int control;
         std::vector< Connection > connections;
         std::unordered_map<std::size_t, Segment> segments;
+        ConnectionIndex connection_index;   // Not part of the serialized data
+
         inline bool flowing() const noexcept;
+
+        /// The connection in the cell with the global index, or nullptr.
+        inline const Connection* find_connection(Connection::global_index index) const;
+        inline Connection* find_connection(Connection::global_index index);
+
         template <class MessageBufferType>
         void write(MessageBufferType& buffer) const;
         template <class MessageBufferType>
@@ -162,8 +210,150 @@ namespace Opm {
     };
 
 
-    class WellRates : public std::map<std::string , Well> {
+    /*
+      The results of the wells, by well name. The wells are stored in one
+      vector in the order they were added - which is the schedule order
+      when the simulator fills in the wells of the schedule one by one -
+      and the position of a well in that vector is its slot. A hash map
+      from the name to the slot gives constant time lookup by name.
+
+      The class has the interface of the std::map<std::string, Well> it
+      replaces: find(), count(), at(), operator[], emplace(), erase() and
+      iteration over std::pair<const std::string, Well> elements, except
+      that the iteration is in slot order instead of alphabetical order.
+      Code which needs the wells in a particular order - the restart and
+      summary output use the order of the schedule wells - must look them
+      up by name rather than rely on the iteration order. The serialized
+      format is unchanged, except that the wells are written in slot order.
+
+      Since the wells are stored contiguously, erase() moves every well
+      after the erased one down one slot, which is linear in the number of
+      wells, and invalidates the iterators and slots from that position.
+    */
+    class WellRates {
     public:
+        using key_type = std::string;
+        using mapped_type = Well;
+        using value_type = std::pair< const std::string, Well >;
+        using size_type = std::size_t;
+        using iterator = std::vector< value_type >::iterator;
+        using const_iterator = std::vector< value_type >::const_iterator;
+
+        static const size_type npos = static_cast< size_type >( -1 );
+
+        WellRates() = default;
+        WellRates(const WellRates&) = default;
+        WellRates(WellRates&&) = default;
+        // The elements have a const key, so the assignment is copy and swap.
+        WellRates& operator=(WellRates other) { this->swap( other ); return *this; }
+
+        iterator begin() { return this->wells.begin(); }
+        iterator end() { return this->wells.end(); }
+        const_iterator begin() const { return this->wells.begin(); }
+        const_iterator end() const { return this->wells.end(); }
+        const_iterator cbegin() const { return this->wells.cbegin(); }
+        const_iterator cend() const { return this->wells.cend(); }
+
+        size_type size() const { return this->wells.size(); }
+        bool empty() const { return this->wells.empty(); }
+        void reserve(size_type n) {
+            if( n > this->wells.capacity() ) this->grow( n );
+            this->slots.reserve( n );
+        }
+        void clear() { this->wells.clear(); this->slots.clear(); }
+        void swap(WellRates& other) { this->wells.swap( other.wells ); this->slots.swap( other.slots ); }
+
+        /// The slot of the well, or npos.
+        size_type slot(const std::string& well_name) const {
+            const auto itr = this->slots.find( well_name );
+            return itr == this->slots.end() ? npos : itr->second;
+        }
+
+        /// The well in a slot, i.e. begin()[ slot ].
+        value_type& at_slot(size_type slot) { return this->wells.at( slot ); }
+        const value_type& at_slot(size_type slot) const { return this->wells.at( slot ); }
+
+        iterator find(const std::string& well_name) {
+            const auto pos = this->slot( well_name );
+            return pos == npos ? this->end() : this->begin() + pos;
+        }
+
+        const_iterator find(const std::string& well_name) const {
+            const auto pos = this->slot( well_name );
+            return pos == npos ? this->end() : this->begin() + pos;
+        }
+
+        size_type count(const std::string& well_name) const {
+            return this->slots.count( well_name );
+        }
+
+        Well& at(const std::string& well_name) {
+            const auto pos = this->slot( well_name );
+            if( pos == npos )
+                throw std::out_of_range( "No results for well: " + well_name );
+
+            return this->wells[ pos ].second;
+        }
+
+        const Well& at(const std::string& well_name) const {
+            return const_cast< WellRates* >( this )->at( well_name );
+        }
+
+        Well& operator[](const std::string& well_name) {
+            return this->emplace( well_name, Well{} ).first->second;
+        }
+
+        /// Add the well unless there already is a well with that name.
+        template <typename... Args>
+        std::pair< iterator, bool > emplace(const std::string& well_name, Args&&... args) {
+            const auto pos = this->slot( well_name );
+            if( pos != npos )
+                return { this->begin() + pos, false };
+
+            if( this->wells.size() == this->wells.capacity() )
+                this->grow( std::max< size_type >( 8, 2 * this->wells.size() ) );
+
+            this->wells.emplace_back( std::piecewise_construct,
+                                      std::forward_as_tuple( well_name ),
+                                      std::forward_as_tuple( std::forward< Args >( args )... ) );
+            this->slots.emplace( well_name, this->wells.size() - 1 );
+            return { this->end() - 1, true };
+        }
+
+        std::pair< iterator, bool > insert(const value_type& value) {
+            return this->emplace( value.first, value.second );
+        }
+
+        /// Remove the well; the wells in the slots after it move down one
+        /// slot, which is O(n) in the number of wells after it.
+        iterator erase(const_iterator pos) {
+            const auto index = static_cast< size_type >( pos - this->cbegin() );
+
+            // The elements are not assignable, so the tail is rebuilt.
+            std::vector< value_type > tail;
+            tail.reserve( this->wells.size() - index - 1 );
+            for( auto i = index + 1; i < this->wells.size(); ++i )
+                tail.emplace_back( std::move( this->wells[ i ] ) );
+
+            this->slots.erase( this->wells[ index ].first );
+            while( this->wells.size() > index )
+                this->wells.pop_back();
+
+            for( auto& value : tail ) {
+                this->slots[ value.first ] = this->wells.size();
+                this->wells.emplace_back( std::move( value ) );
+            }
+
+            return this->begin() + index;
+        }
+
+        size_type erase(const std::string& well_name) {
+            const auto pos = this->slot( well_name );
+            if( pos == npos ) return 0;
+
+            this->erase( this->cbegin() + pos );
+            return 1;
+        }
 
         double get(const std::string& well_name , Rates::opt m) const {
             const auto& well = this->find( well_name );
@@ -177,13 +367,8 @@ namespace Opm {
             const auto& witr = this->find( well_name );
             if( witr == this->end() ) return 0.0;
 
-            const auto& well = witr->second;
-            const auto& connection = std::find_if( well.connections.begin() ,
-                                                   well.connections.end() ,
-                                                   [=]( const Connection& c ) {
-                                                        return c.index == connection_grid_index; });
-
-            if( connection == well.connections.end() )
+            const auto* connection = witr->second.find_connection( connection_grid_index );
+            if( connection == nullptr )
                 return 0.0;
 
             return connection->rates.get( m, 0.0 );
@@ -205,15 +390,33 @@ namespace Opm {
         void read(MessageBufferType& buffer) {
             unsigned int size;
             buffer.read(size);
+            this->reserve(this->size() + size);
             for (size_t i = 0; i < size; ++i) {
                 std::string name;
                 buffer.read(name);
                 Well well;
                 well.read(buffer);
-                this->emplace(name, well);
+                this->emplace(name, std::move(well));
             }
         }
 
+    private:
+        /*
+          The pair with the const key is copied, not moved, when the
+          vector reallocates, which would copy the connections of every
+          well. The wells are therefore moved to the new storage here.
+        */
+        void grow(size_type capacity) {
+            std::vector< value_type > grown;
+            grown.reserve( capacity );
+            for( auto& value : this->wells )
+                grown.emplace_back( std::move( value ) );
+
+            this->wells.swap( grown );
+        }
+
+        std::vector< value_type > wells;
+        std::unordered_map< std::string, size_type > slots;
     };
 
     using Wells = WellRates;    
@@ -304,6 +507,51 @@ namespace Opm {
         return this->rates.any();
     }
 
+    inline const Connection* Well::find_connection(Connection::global_index index) const {
+        return this->connection_index.find( this->connections, index );
+    }
+
+    inline Connection* Well::find_connection(Connection::global_index index) {
+        const auto* connection = this->connection_index.find( this->connections, index );
+        return connection ? &this->connections[ connection - this->connections.data() ] : nullptr;
+    }
+
+    inline void ConnectionIndex::build(const std::vector< Connection >& connections) const {
+        this->slots.clear();
+        this->slots.reserve( connections.size() );
+        for (std::size_t slot = 0; slot < connections.size(); ++slot)
+            this->slots.emplace( connections[ slot ].index, slot );
+
+        this->data = connections.data();
+        this->size = connections.size();
+        this->builds++;
+    }
+
+    inline const Connection* ConnectionIndex::find(const std::vector< Connection >& connections,
+                                                   Connection::global_index index) const {
+        if (connections.data() != this->data || connections.size() != this->size)
+            this->build( connections );
+
+        auto slot = this->slots.find( index );
+        if (slot == this->slots.end())
+            return nullptr;
+
+        if (connections[ slot->second ].index != index) {
+            this->build( connections );
+            slot = this->slots.find( index );
+            if (slot == this->slots.end())
+                return nullptr;
+        }
+
+        return &connections[ slot->second ];
+    }
+
+    inline void ConnectionIndex::clear() {
+        this->slots.clear();
+        this->data = nullptr;
+        this->size = 0;
+    }
+
     template <class MessageBufferType>
     void Rates::write(MessageBufferType& buffer) const {
             buffer.write(this->mask);
@@ -426,6 +674,7 @@ namespace Opm {
             auto& comp = this->connections[ i ];
             comp.read(buffer);
         }
+        this->connection_index.clear();
 
         // Segment information (if applicable)
         const auto nSeg = [&buffer]() -> unsigned int
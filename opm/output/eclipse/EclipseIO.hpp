@@ -39,6 +39,7 @@
 namespace Opm {
 
 class EclipseState;
+class LoadReport;
 class SummaryConfig;
 class Schedule;
 
@@ -168,6 +169,11 @@ public:
      *
      *  3. The dimension of the keyword must have specified in the
      *     hardcoded static map misc_units in Summary.cpp.
+     *
+     * The block vectors (BPR, BSWAT, ...) are taken from the cell fields
+     * of the solution in value when they are not passed in
+     * block_summary_values. A value the simulator passes in
+     * block_summary_values always takes precedence over the solution.
      */
 
     void writeTimeStep( int report_step,
@@ -221,6 +227,16 @@ public:
     RestartValue loadRestart(const std::vector<RestartKey>& solution_keys, const std::vector<RestartKey>& extra_keys = {}) const;
 
 
+    /*
+      Record the time spent writing the INIT, EGRID, summary, restart
+      and RFT files as the phases "INIT", "EGRID", "Summary", "Restart"
+      and "RFT" of the report; writeTimeStep() adds a new phase for every
+      call. Pass nullptr to stop the recording. The report must outlive
+      the EclipseIO object.
+    */
+    void setLoadReport(LoadReport* report);
+
+
     EclipseIO( const EclipseIO& ) = delete;
     ~EclipseIO();
 
@@ -0,0 +1,154 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FORTRAN_WRITER_HPP
+#define OPM_FORTRAN_WRITER_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+namespace Opm { namespace out {
+
+    /*
+      Writer for keywords in the ECLIPSE file format, i.e. the INIT, EGRID
+      and restart files. A keyword is written as a header record with the
+      name, the number of elements and the type, followed by the data in
+      records of at most 1000 elements.
+
+      In unformatted files every record is enclosed in big-endian byte
+      counts, and all the values are big-endian. In formatted files (the
+      FMTOUT keyword) a record is text with a fixed number of columns per
+      line: six integers, four REAL values as 0.ddddddddE+XX or three DOUB
+      values as 0.ddddddddddddddD+XX. The text is identical to what libecl
+      writes, but the digits are generated with integer arithmetic instead
+      of one fprintf() call per value.
+
+      The data records are encoded in batches, and the records of one
+      batch are encoded in parallel when OpenMP is available. The
+      selection of the active cells, the conversion from SI units, the
+      narrowing to float and the byte swapping are all done while
+      encoding a record, so the input is never copied and the memory
+      used by the writer is bounded by the batch size, whatever the size
+      of the grid.
+
+      The writer appends to a stream it does not own. It can be mixed
+      with other writers of the same FILE - like the libecl fortio layer -
+      since they all go through the same stdio buffer.
+    */
+    class FortranWriter {
+    public:
+        /*
+          Linear conversion y = scale * x + offset which is applied to
+          floating point values before they are written. A conversion
+          built from a unit system applies UnitSystem::from_si() itself,
+          so the values are bit for bit those of converting the data
+          vector with the unit system; the unit system must outlive the
+          conversion.
+        */
+        struct Conversion {
+            Conversion();
+            Conversion(double scale, double offset);
+
+            /// The conversion of UnitSystem::from_si() for the measure.
+            Conversion(const UnitSystem& units, UnitSystem::measure m);
+
+            double operator()(double x) const {
+                if (this->units)
+                    return this->units->from_si(this->measure, x);
+
+                // No offset is added to a pure scaling, which keeps the sign of -0.
+                return this->offset == 0.0 ? this->scale * x : this->scale * x + this->offset;
+            }
+
+            double scale;
+            double offset;
+            const UnitSystem* units = nullptr;
+            UnitSystem::measure measure = UnitSystem::measure::identity;
+        };
+
+        enum class Format {
+            Unformatted,
+            Formatted
+        };
+
+        static const std::size_t block_size = 1000;
+
+        explicit FortranWriter(std::FILE* stream, std::size_t batch_records = 64);
+        FortranWriter(std::FILE* stream, Format format, std::size_t batch_records = 64);
+
+        void write(const std::string& keyword, const std::vector<int>& data);
+        void write(const std::string& keyword, const std::vector<float>& data);
+
+        /// Written as REAL, or as DOUB when double_precision is true.
+        void write(const std::string& keyword,
+                   const std::vector<double>& data,
+                   bool double_precision = false,
+                   const Conversion& conversion = Conversion());
+
+        /// Keyword without data, like STARTSOL and ENDSOL.
+        void writeMessage(const std::string& keyword);
+
+        /*
+          Write only data[cells[i]] - typically the active cells of a
+          property with one value per cell of the global grid.
+        */
+        void writeCells(const std::string& keyword,
+                        const std::vector<int>& data,
+                        const std::vector<int>& cells);
+
+        void writeCells(const std::string& keyword,
+                        const std::vector<double>& data,
+                        const std::vector<int>& cells,
+                        bool double_precision = false,
+                        const Conversion& conversion = Conversion());
+
+        /*
+          Write all the elements of data, where the elements which are
+          not listed in the sorted cells vector are written as zero. This
+          is how the PORV keyword of the INIT file is written.
+        */
+        void writeMasked(const std::string& keyword,
+                         const std::vector<double>& data,
+                         const std::vector<int>& cells,
+                         const Conversion& conversion = Conversion());
+
+        std::size_t bytesWritten() const;
+
+    private:
+        template <typename Out, typename Fill>
+        void writeData(const std::string& keyword, const char* type, std::size_t size, Fill fill);
+
+        void writeHeader(const std::string& keyword, const char* type, std::size_t size);
+        void writeBuffer(std::size_t size);
+
+        std::FILE* stream;
+        Format format;
+        std::size_t batch_records;
+        std::size_t bytes_written = 0;
+        std::vector<unsigned char> buffer;
+    };
+
+}
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*
+  Copyright (c) 2018 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LAZY_RESTART_VALUE_HPP
+#define LAZY_RESTART_VALUE_HPP
+
+#include <opm/output/data/Wells.hpp>
+#include <opm/output/eclipse/RestartValue.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class EclipseGrid;
+class EclipseState;
+class Schedule;
+
+namespace RestartIO {
+
+/*
+  The LazyRestartValue class is an alternative to RestartIO::load() for
+  callers which only need a subset of the solution fields, or only a
+  subset of the cells, from a restart file.
+
+  The constructor opens the restart file, positions itself at the
+  requested report step and validates the requested solution keys
+  against the keyword headers only: missing required keys and keys with
+  the wrong number of elements are reported immediately, exactly as
+  RestartIO::load() would, but no array data is read.
+
+  The array data for a solution field is read from file, converted to
+  double precision and converted to SI units the first time the field is
+  requested through data(); the converted values are then cached in the
+  object.  The overload of data() taking a list of active cell indices
+  converts only the requested cells and does not populate the cache.
+  The well data is similarly restored on the first call to wells().
+
+  The object keeps references to the EclipseState, EclipseGrid and
+  Schedule instances passed to the constructor; they must outlive the
+  LazyRestartValue.  The class is not thread safe - concurrent calls to
+  data() or wells() on the same object must be synchronized by the
+  caller.
+*/
+
+class LazyRestartValue
+{
+public:
+    LazyRestartValue(const std::string&             filename,
+                     int                            report_step,
+                     const std::vector<RestartKey>& solution_keys,
+                     const EclipseState&            es,
+                     const EclipseGrid&             grid,
+                     const Schedule&                schedule);
+
+    ~LazyRestartValue();
+
+    LazyRestartValue(const LazyRestartValue& rhs) = delete;
+    LazyRestartValue(LazyRestartValue&& rhs);
+
+    LazyRestartValue& operator=(const LazyRestartValue& rhs) = delete;
+    LazyRestartValue& operator=(LazyRestartValue&& rhs);
+
+    /// Whether or not solution vector 'key' was requested and is
+    /// available in the restart file.
+    bool has(const std::string& key) const;
+
+    /// Names of all available solution vectors, in the order of the
+    /// 'solution_keys' passed to the constructor.
+    std::vector<std::string> keys() const;
+
+    /// Whether or not solution vector 'key' has been decoded and cached.
+    bool loaded(const std::string& key) const;
+
+    /// Full solution vector (one value per active cell) in SI units.
+    /// Decoded on first access.  Throws std::invalid_argument if the
+    /// vector is not available.
+    const std::vector<double>& data(const std::string& key) const;
+
+    /// Solution vector values, in SI units, of the active cells in
+    /// 'active_cells' only.  Does not decode or cache the full vector.
+    std::vector<double>
+    data(const std::string&      key,
+         const std::vector<int>& active_cells) const;
+
+    /// Well and connection state, restored on first access.
+    const data::Wells& wells() const;
+
+    /// Convert to a fully populated RestartValue.  Decodes all
+    /// remaining solution vectors.
+    RestartValue toRestartValue() const;
+
+private:
+    class Impl;
+
+    std::unique_ptr<Impl> pImpl_;
+};
+
+}} // Opm::RestartIO
+
+#endif // LAZY_RESTART_VALUE_HPP
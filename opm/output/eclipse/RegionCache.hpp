@@ -32,6 +32,11 @@ namespace out {
     public:
         RegionCache() = default;
         RegionCache(const Eclipse3DProperties& properties, const EclipseGrid& grid, const Schedule& schedule);
+
+        /*
+          The (well name, active index) pairs of the connections in the
+          region; the connections of one well are consecutive.
+        */
         const std::vector<std::pair<std::string,size_t>>& connections( int region_id ) const;
 
     private:
@@ -28,7 +28,9 @@
 
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryStore.hpp>
 
+#include <opm/output/data/Solution.hpp>
 #include <opm/output/data/Wells.hpp>
 #include <opm/output/eclipse/RegionCache.hpp>
 
@@ -57,12 +59,70 @@ class Summary {
                            const std::map<std::string, std::vector<double>>& region_values = {},
                            const std::map<std::pair<std::string, int>, double>& block_values = {});
 
+        /*
+          As above, with the block vectors (BPR, BSWAT, ...) which are
+          not passed in block_values gathered from the fields of the
+          solution - with one value per active cell in SI units. When a
+          block vector is both in block_values and in the solution, the
+          value in block_values is used.
+        */
+        void add_timestep(int report_step,
+                           double secs_elapsed,
+                           const EclipseState& es,
+                           const Schedule& schedule,
+                           const data::Wells&,
+                           const data::Solution& solution,
+                           const std::map<std::string, double>& single_values,
+                           const std::map<std::string, std::vector<double>>& region_values = {},
+                           const std::map<std::pair<std::string, int>, double>& block_values = {});
+
+        /*
+          Evaluate the summary vectors of the timestep into the restart
+          vectors, like add_timestep(), without adding the timestep to
+          the summary file or the store. A call on a substep - the same
+          report step and schedule as the previous call - does not
+          allocate.
+        */
+        void eval(int report_step,
+                  double secs_elapsed,
+                  const EclipseState& es,
+                  const Schedule& schedule,
+                  const data::Wells&,
+                  const data::Solution& solution,
+                  const std::map<std::string, double>& single_values,
+                  const std::map<std::string, std::vector<double>>& region_values = {},
+                  const std::map<std::pair<std::string, int>, double>& block_values = {});
+
         void write();
 
         ~Summary();
 
         const SummaryState& get_restart_vectors() const;
 
+        /*
+          The number of times the schedule wells and efficiency factors
+          of the keyword handlers have been rebuilt; once per report step,
+          the substeps reuse them.
+        */
+        std::size_t scratch_rebuilds() const;
+
+        /*
+          The schedule wells are only looked up again when the report
+          step or the address of the schedule changes. Call this after
+          modifying the schedule in place, or when passing another
+          schedule which may have the address of the previous one.
+        */
+        void schedule_changed();
+
+        /*
+          Keep the values of every timestep in memory: add_timestep()
+          appends a row with the restart vectors to the store, and the
+          time column holds the elapsed seconds. The store is empty
+          until it is enabled; enabling it again discards the rows.
+        */
+        void enable_store(std::size_t chunk_rows = 256, bool compress = true);
+        const SummaryStore& get_store() const;
+
     private:
         class keyword_handlers;
 
@@ -72,6 +132,8 @@ class Summary {
         std::unique_ptr< keyword_handlers > handlers;
         double prev_time_elapsed = 0;
         SummaryState prev_state;
+        SummaryStore store;
+        bool store_enabled = false;
 };
 
 }
@@ -565,6 +565,7 @@ const char * ecl_file_kw_get_header( const ::Opm::RestartIO::ecl_file_kw_type *
 
 bool   ecl_kw_fskip_data__( ::Opm::RestartIO::ecl_data_type, int, fortio_type *);
 ::Opm::RestartIO::ecl_data_type   ecl_file_kw_get_data_type(const ::Opm::RestartIO::ecl_file_kw_type * file_kw);
+int    ecl_file_kw_get_size(const ::Opm::RestartIO::ecl_file_kw_type * file_kw);
 ::Opm::RestartIO::ecl_file_kw_type * ecl_file_view_iget_file_kw( const ::Opm::RestartIO::ecl_file_view_type * ecl_file_view , int global_index);
 ::Opm::RestartIO::ecl_file_view_type * ecl_file_get_restart_view( ::Opm::RestartIO::ecl_file_type * ecl_file , 
 								  int input_index, int report_step , time_t sim_time, double sim_days);
@@ -20,9 +20,13 @@
 #ifndef DECK_HPP
 #define DECK_HPP
 
+#include <cstddef>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <stdexcept>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -55,11 +59,82 @@ namespace Opm {
      * use-after-free.
      */
     class DeckOutput;
+    class Section;
+
+    /*
+      Deck wide index of the keyword positions. Every distinct keyword
+      name is given an integer id when it is first added, and for each id
+      the positions of the keyword in the deck are stored in increasing
+      order. The index is shared by the Deck and all the views of it, and
+      the occurrences within a view - e.g. a Section - are found with a
+      binary search in the positions.
+    */
+    class DeckIndex {
+        public:
+            static const std::size_t npos = static_cast< std::size_t >( -1 );
+
+            void add( const std::string& keyword, std::size_t position );
+
+            /// The id of the keyword, or npos if it is not in the deck.
+            std::size_t id( const std::string& keyword ) const;
+            const std::vector< std::size_t >& positions( std::size_t id ) const;
+            std::size_t size() const;
+
+        private:
+            std::unordered_map< std::string, std::size_t > ids;
+            std::vector< std::vector< std::size_t > > keyword_positions;
+    };
 
     class DeckView {
         public:
             typedef std::vector< DeckKeyword >::const_iterator const_iterator;
 
+            /*
+              The occurrences of one keyword in the view, in deck order.
+              The range points into the deck index, so creating and
+              iterating over it does not allocate.
+            */
+            class Occurrences {
+                public:
+                    class iterator {
+                        public:
+                            using iterator_category = std::forward_iterator_tag;
+                            using value_type = DeckKeyword;
+                            using difference_type = std::ptrdiff_t;
+                            using pointer = const DeckKeyword*;
+                            using reference = const DeckKeyword&;
+
+                            iterator( const_iterator base, const std::size_t* pos ) :
+                                base( base ), pos( pos )
+                            {}
+
+                            reference operator*() const { return *( this->base + *this->pos ); }
+                            pointer operator->() const { return &**this; }
+                            iterator& operator++() { ++this->pos; return *this; }
+                            iterator operator++( int ) { auto tmp = *this; ++this->pos; return tmp; }
+                            bool operator==( const iterator& other ) const { return this->pos == other.pos; }
+                            bool operator!=( const iterator& other ) const { return this->pos != other.pos; }
+
+                        private:
+                            const_iterator base;
+                            const std::size_t* pos;
+                    };
+
+                    Occurrences( const_iterator base, const std::size_t* first, const std::size_t* last );
+
+                    iterator begin() const;
+                    iterator end() const;
+                    std::size_t size() const;
+                    bool empty() const;
+                    const DeckKeyword& at( std::size_t index ) const;
+                    const DeckKeyword& back() const;
+
+                private:
+                    const_iterator base;
+                    const std::size_t* first;
+                    const std::size_t* last;
+            };
+
             bool hasKeyword( const DeckKeyword& keyword ) const;
             bool hasKeyword( const std::string& keyword ) const;
             template< class Keyword >
@@ -86,6 +161,12 @@ namespace Opm {
                 return getKeywordList( Keyword::keywordName );
             }
 
+            Occurrences occurrences( const std::string& keyword ) const;
+            template< class Keyword >
+            Occurrences occurrences() const {
+                return occurrences( Keyword::keywordName );
+            }
+
             size_t count(const std::string& keyword) const;
             size_t size() const;
 
@@ -94,19 +175,19 @@ namespace Opm {
 
 
         protected:
-            void add( const DeckKeyword*, const_iterator, const_iterator );
-
-            const std::vector< size_t >& offsets( const std::string& ) const;
-
-            DeckView( const_iterator first, const_iterator last );
-            explicit DeckView( std::pair< const_iterator, const_iterator > );
+            /*
+              View of the keywords at positions [first, last) of the deck
+              whose first keyword is base.
+            */
+            DeckView( std::shared_ptr< const DeckIndex > index, const_iterator base, std::size_t first, std::size_t last );
 
-            void reinit( const_iterator, const_iterator );
+            void reset( std::shared_ptr< const DeckIndex > index, const_iterator base, std::size_t first, std::size_t last );
 
         private:
-            const_iterator first;
-            const_iterator last;
-            std::map< std::string, std::vector< size_t > > keywordMap;
+            std::shared_ptr< const DeckIndex > index;
+            const_iterator base;
+            std::size_t first;
+            std::size_t last;
 
     };
 
@@ -116,6 +197,8 @@ namespace Opm {
             using DeckView::hasKeyword;
             using DeckView::getKeyword;
             using DeckView::getKeywordList;
+            using DeckView::occurrences;
+            using DeckView::Occurrences;
             using DeckView::count;
             using DeckView::size;
             using DeckView::begin;
@@ -130,6 +213,7 @@ namespace Opm {
             Deck( std::initializer_list< std::string > );
 
             Deck( const Deck& );
+            Deck( Deck&& );
 
             //! \brief Deleted assignment operator.
             Deck& operator=(const Deck& rhs) = delete;
@@ -153,15 +237,69 @@ namespace Opm {
             iterator end();
             void write( DeckOutput& output ) const ;
             friend std::ostream& operator<<(std::ostream& os, const Deck& deck);
+
+            /*
+              Binary serialization of the complete deck, e.g. for parsing
+              the deck on one process and broadcasting it to the others.
+              The MessageBufferType must provide read() and write() for
+              arithmetic types and std::string, like MessageBuffer in
+              opm/common/utility/MessageBuffer.hpp. unpack() can only be
+              called on an empty deck. Only the deck is serialized; every
+              process builds the EclipseState, Schedule and SummaryConfig
+              from the unpacked deck.
+            */
+            template <class MessageBufferType>
+            void pack(MessageBufferType& buffer) const;
+            template <class MessageBufferType>
+            void unpack(MessageBufferType& buffer);
         private:
+            friend class Section;
+
             Deck( std::vector< DeckKeyword >&& );
+            Deck( std::vector< DeckKeyword >&&, std::shared_ptr< DeckIndex > );
+            void rebuildIndex();
 
             std::vector< DeckKeyword > keywordList;
+            std::shared_ptr< DeckIndex > keywordIndex;
             UnitSystem defaultUnits;
             UnitSystem activeUnits;
 
             std::string m_dataFile;
             std::string input_path;
     };
+
+
+    template <class MessageBufferType>
+    void Deck::pack(MessageBufferType& buffer) const {
+        this->defaultUnits.pack(buffer);
+        this->activeUnits.pack(buffer);
+        buffer.write(this->m_dataFile);
+        buffer.write(this->input_path);
+
+        unsigned int size = this->keywordList.size();
+        buffer.write(size);
+        for (const auto& keyword : this->keywordList)
+            keyword.pack(buffer);
+    }
+
+    template <class MessageBufferType>
+    void Deck::unpack(MessageBufferType& buffer) {
+        if (!this->keywordList.empty())
+            throw std::invalid_argument("Can only unpack into an empty deck");
+
+        this->defaultUnits.unpack(buffer);
+        this->activeUnits.unpack(buffer);
+        buffer.read(this->m_dataFile);
+        buffer.read(this->input_path);
+
+        unsigned int size;
+        buffer.read(size);
+        this->keywordList.reserve(size);
+        for (unsigned int i = 0; i < size; i++) {
+            this->keywordList.emplace_back( std::string() );
+            this->keywordList.back().unpack(buffer);
+        }
+        this->rebuildIndex();
+    }
 }
 #endif  /* DECK_HPP */
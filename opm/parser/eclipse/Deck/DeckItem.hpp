@@ -65,6 +65,11 @@ namespace Opm {
         template< typename T > const std::vector< T >& getData() const;
         const std::vector< double >& getSIDoubleData() const;
 
+        // The SI data are converted lazily on first access; convertToSI()
+        // does the conversion up front, so the item can subsequently be
+        // read concurrently from several threads.
+        void convertToSI() const;
+
         void push_back( int );
         void push_back( double );
         void push_back( std::string );
@@ -106,6 +111,11 @@ namespace Opm {
         bool operator==(const DeckItem& other) const;
         bool operator!=(const DeckItem& other) const;
 
+        template <class MessageBufferType>
+        void pack(MessageBufferType& buffer) const;
+        template <class MessageBufferType>
+        void unpack(MessageBufferType& buffer);
+
     private:
         std::vector< double > dval;
         std::vector< int > ival;
@@ -125,6 +135,81 @@ namespace Opm {
         template< typename T > void push_default( T );
         template< typename T > void write_vector(DeckOutput& writer, const std::vector<T>& data) const;
     };
+
+
+    /*
+      The SI converted values are a cache which is recreated on demand,
+      and are not packed.
+    */
+    template <class MessageBufferType>
+    void DeckItem::pack(MessageBufferType& buffer) const {
+        buffer.write(this->item_name);
+        buffer.write(static_cast<int>(this->type));
+
+        unsigned int size = this->dval.size();
+        buffer.write(size);
+        for (double value : this->dval)
+            buffer.write(value);
+
+        size = this->ival.size();
+        buffer.write(size);
+        for (int value : this->ival)
+            buffer.write(value);
+
+        size = this->sval.size();
+        buffer.write(size);
+        for (const auto& value : this->sval)
+            buffer.write(value);
+
+        size = this->defaulted.size();
+        buffer.write(size);
+        for (bool value : this->defaulted)
+            buffer.write(static_cast<char>(value));
+
+        size = this->dimensions.size();
+        buffer.write(size);
+        for (const auto& dim : this->dimensions)
+            dim.pack(buffer);
+    }
+
+    template <class MessageBufferType>
+    void DeckItem::unpack(MessageBufferType& buffer) {
+        buffer.read(this->item_name);
+        int type_value;
+        buffer.read(type_value);
+        this->type = static_cast<type_tag>(type_value);
+
+        unsigned int size;
+        buffer.read(size);
+        this->dval.resize(size);
+        for (auto& value : this->dval)
+            buffer.read(value);
+
+        buffer.read(size);
+        this->ival.resize(size);
+        for (auto& value : this->ival)
+            buffer.read(value);
+
+        buffer.read(size);
+        this->sval.resize(size);
+        for (auto& value : this->sval)
+            buffer.read(value);
+
+        buffer.read(size);
+        this->defaulted.resize(size);
+        for (unsigned int i = 0; i < size; i++) {
+            char value;
+            buffer.read(value);
+            this->defaulted[i] = (value != 0);
+        }
+
+        buffer.read(size);
+        this->dimensions.resize(size);
+        for (auto& dim : this->dimensions)
+            dim.unpack(buffer);
+
+        this->SIdata.clear();
+    }
 }
 #endif  /* DECKITEM_HPP */
 
@@ -77,6 +77,11 @@ namespace Opm {
         bool operator!=(const DeckKeyword& other) const;
 
         friend std::ostream& operator<<(std::ostream& os, const DeckKeyword& keyword);
+
+        template <class MessageBufferType>
+        void pack(MessageBufferType& buffer) const;
+        template <class MessageBufferType>
+        void unpack(MessageBufferType& buffer);
     private:
         std::string m_keywordName;
         std::string m_fileName;
@@ -87,6 +92,42 @@ namespace Opm {
         bool m_isDataKeyword;
         bool m_slashTerminated;
     };
+
+
+    template <class MessageBufferType>
+    void DeckKeyword::pack(MessageBufferType& buffer) const {
+        buffer.write(this->m_keywordName);
+        buffer.write(this->m_fileName);
+        buffer.write(this->m_lineNumber);
+        buffer.write(static_cast<char>(this->m_knownKeyword));
+        buffer.write(static_cast<char>(this->m_isDataKeyword));
+        buffer.write(static_cast<char>(this->m_slashTerminated));
+
+        unsigned int size = this->m_recordList.size();
+        buffer.write(size);
+        for (const auto& record : this->m_recordList)
+            record.pack(buffer);
+    }
+
+    template <class MessageBufferType>
+    void DeckKeyword::unpack(MessageBufferType& buffer) {
+        char flag;
+        buffer.read(this->m_keywordName);
+        buffer.read(this->m_fileName);
+        buffer.read(this->m_lineNumber);
+        buffer.read(flag);
+        this->m_knownKeyword = (flag != 0);
+        buffer.read(flag);
+        this->m_isDataKeyword = (flag != 0);
+        buffer.read(flag);
+        this->m_slashTerminated = (flag != 0);
+
+        unsigned int size;
+        buffer.read(size);
+        this->m_recordList.resize(size);
+        for (auto& record : this->m_recordList)
+            record.unpack(buffer);
+    }
 }
 
 #endif  /* DECKKEYWORD_HPP */
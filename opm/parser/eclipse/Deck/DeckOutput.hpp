@@ -43,10 +43,25 @@ namespace Opm {
         void write_string(const std::string& s);
         template <typename T> void write(const T& value);
 
+        /*
+          Write any output held back in packed mode to the stream; the
+          destructor flushes as well.
+        */
+        void flush();
+
         std::string item_sep = " ";        // Separator between items on a row.
         size_t      columns = 16;          // The maximum number of columns on a record.
         std::string record_indent = "   "; // The indentation when starting a new line.
         std::string keyword_sep = "\n\n";  // The separation between keywords;
+
+        /*
+          Packed output, as written by opmpack: the output is collected
+          in a buffer and written to the stream in large blocks, doubles
+          are written with the fewest digits which read back to the same
+          value, and runs of equal numbers are written as N*value. Set it
+          before anything is written.
+        */
+        bool packed = false;
     private:
         std::ostream& os;
         size_t default_count;
@@ -54,9 +69,19 @@ namespace Opm {
         bool record_on;
         int org_precision;
 
+        std::string buffer;
+        std::string run_value;             // The number repeated in the current run ...
+        size_t run_count = 0;              // ... and the length of the run.
+
         template <typename T> void write_value(const T& value);
         void write_sep( );
         void set_precision(int precision);
+
+        void put(const char* s, size_t size);
+        void put(const std::string& s);
+        void put(char c);
+        void write_run( );
+        void write_packed(const std::string& token, bool repeatable);
     };
 }
 
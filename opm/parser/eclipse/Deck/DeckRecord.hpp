@@ -70,11 +70,34 @@ namespace Opm {
         bool operator==(const DeckRecord& other) const;
         bool operator!=(const DeckRecord& other) const;
 
+        template <class MessageBufferType>
+        void pack(MessageBufferType& buffer) const;
+        template <class MessageBufferType>
+        void unpack(MessageBufferType& buffer);
+
     private:
         std::vector< DeckItem > m_items;
 
     };
 
+
+    template <class MessageBufferType>
+    void DeckRecord::pack(MessageBufferType& buffer) const {
+        unsigned int size = this->m_items.size();
+        buffer.write(size);
+        for (const auto& item : this->m_items)
+            item.pack(buffer);
+    }
+
+    template <class MessageBufferType>
+    void DeckRecord::unpack(MessageBufferType& buffer) {
+        unsigned int size;
+        buffer.read(size);
+        this->m_items.resize(size);
+        for (auto& item : this->m_items)
+            item.unpack(buffer);
+    }
+
 }
 #endif  /* DECKRECORD_HPP */
 
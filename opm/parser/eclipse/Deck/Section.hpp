@@ -21,6 +21,7 @@
 #define SECTION_HPP
 
 #include <string>
+#include <utility>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 
@@ -53,6 +54,8 @@ class Section : public DeckView {
                                          bool ensureKeywordSectionAffiliation = false);
 
     private:
+        Section( const Deck& deck, const std::string& startKeyword, std::pair< std::size_t, std::size_t > range );
+
         std::string section_name;
         const UnitSystem& units;
 
@@ -50,6 +50,7 @@ namespace Opm {
     class EclipseGrid;
     class InitConfig;
     class IOConfig;
+    class LoadReport;
     class ParseContext;
     class RestartConfig;
     class Section;
@@ -71,6 +72,17 @@ namespace Opm {
         EclipseState(const Deck& deck , const ParseContext& parseContext, ErrorGuard& errors);
         EclipseState(const Deck& deck);
 
+        /*
+          Construction with a timing report: the time and memory used by
+          each construction phase is added to the report, which can be
+          nullptr. With parallel == true the TableManager and the
+          EclipseGrid, which only depend on the deck, are built
+          concurrently with OpenMP; all the other members are built in
+          sequence, as they depend on these two, on the ErrorGuard or on
+          each other.
+        */
+        EclipseState(const Deck& deck , const ParseContext& parseContext, ErrorGuard& errors, LoadReport* report, bool parallel);
+
         const IOConfig& getIOConfig() const;
         IOConfig& getIOConfig();
 
@@ -112,6 +124,9 @@ namespace Opm {
         const Runspec& runspec() const;
 
     private:
+        struct DeckComponents;
+        EclipseState(const Deck& deck , const ParseContext& parseContext, ErrorGuard& errors, DeckComponents&& components, LoadReport* report);
+
         void initIOConfigPostSchedule(const Deck& deck);
         void initTransMult();
         void initFaults(const Deck& deck);
@@ -0,0 +1,98 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_LOAD_REPORT_HPP
+#define OPM_LOAD_REPORT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      The LoadReport collects the wall clock time and the change in
+      resident memory for each phase of building the input objects from a
+      Deck, i.e. the members of the EclipseState, the Schedule and so on.
+      The EclipseIO can record the output phases in the same way.
+
+      The phases are recorded with the RAII Timer class; a Timer with a
+      nullptr report does nothing, so code can be instrumented
+      unconditionally. Phases can be recorded from several threads, but
+      when phases run concurrently the memory change of each phase will
+      also include the allocations done by the other phases.
+    */
+    class LoadReport {
+    public:
+        struct Phase {
+            std::string name;
+            double start;                // Seconds since the report was created
+            double seconds;
+            std::int64_t memory;         // Change in resident memory, in bytes
+        };
+
+        class Timer {
+        public:
+            Timer(LoadReport* report, const std::string& phase);
+            ~Timer();
+
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+
+        private:
+            LoadReport* m_report;
+            std::string m_phase;
+            std::chrono::steady_clock::time_point m_start;
+            std::size_t m_memory;
+        };
+
+        LoadReport();
+
+        void add(const Phase& phase);
+        const std::vector<Phase>& phases() const;
+        const Phase& getPhase(const std::string& name) const;
+        bool hasPhase(const std::string& name) const;
+
+        /// Seconds since the report was created.
+        double elapsed() const;
+
+        /// Seconds from the start of the first phase to the end of the
+        /// last; when phases have run concurrently this is less than the
+        /// sum of the phase times.
+        double wallTime() const;
+
+        void write(std::ostream& os) const;
+
+        /// The current resident set size of the process in bytes, or zero
+        /// on platforms where it is not available.
+        static std::size_t residentMemory();
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+        std::mutex m_mutex;
+        std::vector<Phase> m_phases;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const LoadReport& report);
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GROUP_HIERARCHY_HPP
+#define OPM_GROUP_HIERARCHY_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class GroupTree;
+
+/*
+  The GroupHierarchy is an immutable, integer indexed view of a
+  GroupTree. The groups are numbered in sorted name order, i.e. the same
+  order as GroupTree::children() returns them, and for each group the
+  parent, the children and the chain of ancestors up to FIELD are
+  precomputed. The children and the ancestors are stored in compressed
+  arrays, and the lookups return a pair of pointers into those arrays so
+  no allocations are done when traversing the hierarchy.
+
+  The Schedule compiles one GroupHierarchy for every distinct GroupTree
+  and shares it between all the report steps where the tree is unchanged.
+*/
+
+class GroupHierarchy {
+public:
+    static constexpr int NO_PARENT = -1;
+
+    class Range {
+    public:
+        Range(const std::size_t* first, const std::size_t* last) :
+            m_first(first),
+            m_last(last)
+        {}
+
+        const std::size_t* begin() const { return m_first; }
+        const std::size_t* end() const { return m_last; }
+        std::size_t size() const { return m_last - m_first; }
+        bool empty() const { return m_first == m_last; }
+        std::size_t operator[](std::size_t i) const { return m_first[i]; }
+
+    private:
+        const std::size_t* m_first;
+        const std::size_t* m_last;
+    };
+
+    explicit GroupHierarchy(const GroupTree& tree);
+
+    std::size_t size() const;
+    bool exists(const std::string& name) const;
+    std::size_t index(const std::string& name) const;
+    const std::string& name(std::size_t index) const;
+
+    /// Index of the parent group, or NO_PARENT for FIELD.
+    int parent(std::size_t index) const;
+    Range children(std::size_t index) const;
+
+    /// The group itself followed by its parent, grandparent and so on,
+    /// ending with FIELD.
+    Range ancestors(std::size_t index) const;
+
+    /// The groups below index, in the order of a depth first traversal
+    /// where the children of a group are visited in index order.
+    std::vector<std::size_t> descendants(std::size_t index) const;
+
+    bool operator==(const GroupHierarchy& other) const;
+    bool operator!=(const GroupHierarchy& other) const;
+
+private:
+    void checkIndex(std::size_t index) const;
+
+    std::vector<std::string> m_names;
+    std::vector<int> m_parent;
+    std::vector<std::size_t> m_child_offset;
+    std::vector<std::size_t> m_children;
+    std::vector<std::size_t> m_ancestor_offset;
+    std::vector<std::size_t> m_ancestors;
+};
+
+}
+
+#endif
@@ -26,6 +26,8 @@
 
 namespace Opm {
 
+class GroupHierarchy;
+
 class GroupTree {
     public:
         void update( const std::string& name);
@@ -56,6 +58,7 @@ class GroupTree {
 
         std::vector< group > groups = { group { "FIELD", "" } };
         friend bool operator<( const std::string&, const group& );
+        friend class GroupHierarchy;
         std::vector< group >::iterator find( const std::string& );
 	std::map<std::string , size_t> m_nameSeqIndMap;
 	std::map<size_t, std::string > m_seqIndNameMap;
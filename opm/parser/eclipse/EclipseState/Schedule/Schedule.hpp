@@ -28,11 +28,13 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/DynamicVector.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Events.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Group.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/GroupHierarchy.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/GroupTree.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/OilVaporizationProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Tuning.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+#include <opm/parser/eclipse/EclipseState/Util/NamePatternIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Util/OrderedMap.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/MessageLimits.hpp>
 #include <opm/parser/eclipse/EclipseState/Runspec.hpp>
@@ -47,6 +49,7 @@ namespace Opm
 
     class Actions;
     class Deck;
+    class DeckItem;
     class DeckKeyword;
     class DeckRecord;
     class EclipseGrid;
@@ -137,6 +140,7 @@ namespace Opm
         void evalAction(const SummaryState& summary_state, size_t timeStep);
 
         const GroupTree& getGroupTree(size_t t) const;
+        const GroupHierarchy& getGroupHierarchy(size_t t) const;
         size_t numGroups() const;
         size_t numGroups(size_t timeStep) const;
         bool hasGroup(const std::string& groupName) const;
@@ -164,7 +168,10 @@ namespace Opm
         TimeMap m_timeMap;
         OrderedMap< Well > m_wells;
         OrderedMap< Group > m_groups;
+        NamePatternIndex m_wellNameIndex;
+        NamePatternIndex m_groupNameIndex;
         DynamicState< GroupTree > m_rootGroupTree;
+        DynamicState< std::shared_ptr< const GroupHierarchy > > m_groupHierarchy;
         DynamicState< OilVaporizationProperties > m_oilvaporizationproperties;
         Events m_events;
         DynamicVector< Deck > m_modifierDeck;
@@ -178,6 +185,9 @@ namespace Opm
         WellProducer::ControlModeEnum m_controlModeWHISTCTL;
         Actions actions;
 
+        struct WellTask;
+        struct WellPass;
+
         std::vector< Well* > getWells(const std::string& wellNamePattern);
         std::vector< Group* > getGroups(const std::string& groupNamePattern);
 
@@ -186,61 +196,60 @@ namespace Opm
         void iterateScheduleSection(const ParseContext& parseContext ,  ErrorGuard& errors, const SCHEDULESection& , const EclipseGrid& grid,
                                     const Eclipse3DProperties& eclipseProperties);
         bool handleGroupFromWELSPECS(const std::string& groupName, GroupTree& newTree) const;
+        void updateGroupHierarchy();
         void addGroup(const std::string& groupName , size_t timeStep);
         void addWell(const std::string& wellName, const DeckRecord& record, size_t timeStep, WellCompletion::CompletionOrderEnum wellCompletionOrder);
         void handleCOMPORD(const ParseContext& parseContext, ErrorGuard& errors, const DeckKeyword& compordKeyword, size_t currentStep);
-        void handleWELSPECS( const SCHEDULESection&, size_t, size_t  );
-        void handleWCONProducer( const DeckKeyword& keyword, size_t currentStep, bool isPredictionMode,  const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWCONHIST( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWCONPROD( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWGRUPCON( const DeckKeyword& keyword, size_t currentStep);
-        void handleCOMPDAT( const DeckKeyword& keyword,  size_t currentStep, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleCOMPLUMP( const DeckKeyword& keyword,  size_t currentStep );
-        void handleWELSEGS( const DeckKeyword& keyword, size_t currentStep);
-        void handleCOMPSEGS( const DeckKeyword& keyword, size_t currentStep, const EclipseGrid& grid);
-        void handleWCONINJE( const SCHEDULESection&,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWPOLYMER( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWSOLVENT( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWTRACER( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWTEMP( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWPMITAB( const DeckKeyword& keyword,  const size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWSKPTAB( const DeckKeyword& keyword,  const size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWINJTEMP( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWCONINJH( const SCHEDULESection&,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWELOPEN( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors );
-        void handleWELTARG( const SCHEDULESection&,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
+        void handleWELSPECS( const SCHEDULESection&, size_t, size_t, WellPass& wellPass );
+        void handleWELSPECS( Well& well, const DeckRecord& record, const DeckKeyword& keyword, size_t currentStep, bool new_well );
+        void handleWCONProducer( Well& well, const DeckRecord& record, size_t currentStep, bool isPredictionMode, WellProducer::ControlModeEnum controlModeWHISTCTL );
+        void handleWGRUPCON( Well& well, const DeckRecord& record, size_t currentStep );
+        void handleCOMPDAT( Well& well, const DeckRecord& record, size_t currentStep, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties );
+        void handleWCONINJE( Well& well, const DeckRecord& record, size_t currentStep, const UnitSystem& unit_system );
+        void handleWPOLYMER( Well& well, const DeckRecord& record, size_t currentStep );
+        void handleWSOLVENT( Well& well, const DeckRecord& record, size_t currentStep );
+        void handleWTRACER( Well& well, const DeckRecord& record, size_t currentStep );
+        void handleWTEMP( Well& well, const DeckItem& temperature, size_t currentStep );
+        void handleWPMITAB( Well& well, const DeckRecord& record, const size_t currentStep );
+        void handleWSKPTAB( Well& well, const DeckRecord& record, const size_t currentStep );
+        void handleWCONINJH( Well& well, const DeckRecord& record, size_t currentStep, const UnitSystem& unit_system );
+        void handleWELOPEN( Well& well, const DeckRecord& record, size_t currentStep );
+        void handleWELTARG( Well& well, const DeckRecord& record, size_t currentStep, const UnitSystem& unit_system );
         void handleGCONINJE( const SCHEDULESection&,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
         void handleGCONPROD( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
         void handleGEFAC( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
-        void handleWEFAC( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
         void handleTUNING( const DeckKeyword& keyword, size_t currentStep);
         void handleGRUPTREE( const DeckKeyword& keyword, size_t currentStep);
         void handleGRUPNET( const DeckKeyword& keyword, size_t currentStep);
         void handleWRFT( const DeckKeyword& keyword, size_t currentStep);
         void handleWTEST( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
         void handleWRFTPLT( const DeckKeyword& keyword, size_t currentStep);
-        void handleWPIMULT( const DeckKeyword& keyword, size_t currentStep);
         void handleDRSDT( const DeckKeyword& keyword, size_t currentStep);
         void handleDRVDT( const DeckKeyword& keyword, size_t currentStep);
         void handleDRSDTR( const DeckKeyword& keyword, size_t currentStep);
         void handleDRVDTR( const DeckKeyword& keyword, size_t currentStep);
         void handleVAPPARS( const DeckKeyword& keyword, size_t currentStep);
-        void handleWECON( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors);
         void handleWHISTCTL(const ParseContext& parseContext, ErrorGuard& errors, const DeckKeyword& keyword);
         void handleMESSAGES(const DeckKeyword& keyword, size_t currentStep);
         void handleVFPPROD(const DeckKeyword& vfpprodKeyword, const UnitSystem& unit_system, size_t currentStep);
         void handleVFPINJ(const DeckKeyword& vfpprodKeyword, const UnitSystem& unit_system, size_t currentStep);
         void checkUnhandledKeywords( const SCHEDULESection& ) const;
-        void checkIfAllConnectionsIsShut(size_t currentStep);
+        void checkIfAllConnectionsIsShut(Well& well, size_t currentStep);
         void handleKeyword(size_t& currentStep,
                            const SCHEDULESection& section,
                            size_t keywordIdx,
                            const DeckKeyword& keyword,
                            const ParseContext& parseContext, ErrorGuard& errors,
-                           const EclipseGrid& grid,
-                           const Eclipse3DProperties& eclipseProperties,
                            const UnitSystem& unit_system,
-                           std::vector<std::pair<const DeckKeyword*, size_t > >& rftProperties);
+                           std::vector<std::pair<const DeckKeyword*, size_t > >& rftProperties,
+                           WellPass& wellPass);
+        void addWellTasks(WellPass& wellPass, const WellTask& task, const std::string& wellItem, bool requireMatch, const ParseContext& parseContext, ErrorGuard& errors);
+        void checkWellRecord(const WellTask& task, const DeckRecord& record) const;
+        void addNamedWellTasks(WellPass& wellPass, const WellTask& task);
+        void applyWellTasks(const WellPass& wellPass, const UnitSystem& unit_system, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties);
+        void applyWellTasks(const WellPass& wellPass, size_t wellIndex, size_t& keywordIdx, const UnitSystem& unit_system, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties);
+        void applyWellTask(Well& well, const WellTask& task, const UnitSystem& unit_system, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties);
+        void addEvent( ScheduleEvents::Events event, size_t reportStep );
 
         static double convertInjectionRateToSI(double rawRate, WellInjector::TypeEnum wellType, const Opm::UnitSystem &unitSystem);
         static double convertInjectionRateToSI(double rawRate, Phase wellPhase, const Opm::UnitSystem &unitSystem);
@@ -20,7 +20,10 @@
 #ifndef SUMMARY_STATE_H
 #define SUMMARY_STATE_H
 
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -63,7 +66,36 @@ namespace Opm{
 
 class SummaryState {
 public:
-    typedef std::unordered_map<std::string, double>::const_iterator const_iterator;
+    /*
+      The values are stored in a dense vector, and every key is given a
+      fixed slot in that vector the first time it is seen. Code which
+      updates or reads the same keys repeatedly - like the Summary object
+      for every timestep - can look up the slots once with add_key() or
+      index(), and then use the slot based set(), get() and has() methods
+      which do not hash any strings.
+    */
+    static const std::size_t npos;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const std::string&, double>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator(const SummaryState& state, std::size_t slot);
+
+        value_type operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+    private:
+        void skip_undefined();
+
+        const SummaryState* state;
+        std::size_t slot;
+    };
 
     double get(const std::string&) const;
     bool has(const std::string& key) const;
@@ -74,14 +106,38 @@ public:
     bool has_well_var(const std::string& well, const std::string& var) const;
     double get_well_var(const std::string& well, const std::string& var) const;
 
+    /*
+      Slot based access. The add_key() methods register the key - without
+      assigning a value - and return the slot, index() returns npos for
+      unknown keys.
+    */
+    std::size_t add_key(const std::string& key);
+    std::size_t add_key(const ecl::smspec_node& node);
+    std::size_t add_well_key(const std::string& well, const std::string& var);
+    std::size_t index(const std::string& key) const;
+    const std::string& key(std::size_t slot) const;
+    void set(std::size_t slot, double value);
+    bool has(std::size_t slot) const;
+    double get(std::size_t slot) const;
+    std::size_t num_slots() const;
+
+    /*
+      Remove all the values and keep the slots; the Summary object does
+      this at the start of every timestep.
+    */
+    void clear_values();
+
     std::vector<std::string> wells(const std::string& var) const;
     const_iterator begin() const;
     const_iterator end() const;
 private:
-    std::unordered_map<std::string,double> values;
+    std::unordered_map<std::string, std::size_t> slots;
+    std::vector<std::string> keys;
+    std::vector<double> values;
+    std::vector<bool> defined;
 
     // The first key is the variable and the second key is the well.
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> well_values;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::size_t>> well_slots;
 };
 
 }
@@ -0,0 +1,132 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SUMMARY_STORE_H
+#define SUMMARY_STORE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+class SummaryState;
+
+/*
+  The SummaryStore keeps the summary values of all the timesteps in
+  memory, whereas the SummaryState only holds the values of the latest
+  timestep. It is a table with one row per timestep and one column per
+  summary vector, and the columns follow the slots of the SummaryState
+  it is fed from: column i holds the values of st.key(i). A key which
+  appears in a later timestep gets a new column, and the rows before
+  that - and the rows where the key has no value - hold NaN.
+
+  The table is append only. Every column is stored in chunks of
+  chunk_rows() rows; when the chunks of a row are full they are sealed
+  and, if compression is enabled, packed. A packed chunk holds a single
+  value if all its values are equal, otherwise each value is stored as
+  the nonzero bytes of its xor with the previous value - which is short
+  for the slowly varying series of a simulation. The packing is exact.
+
+      SummaryStore store;
+
+      store.append(report_step, secs_elapsed, st);
+      ...
+      const auto range = store.rows(t0, t1);
+      const auto wopr = store.get("WOPR:OP_1", range.first, range.second);
+*/
+
+class SummaryStore {
+public:
+    static const std::size_t npos;
+
+    /*
+      Called with the column, the first row and the values of the
+      consecutive rows of a chunk.
+    */
+    using Visitor = std::function<void(std::size_t column, std::size_t first_row,
+                                       const double* values, std::size_t count)>;
+
+    explicit SummaryStore(std::size_t chunk_rows = 256, bool compress = true);
+
+    /*
+      Append a row with the current values of the state; secs_elapsed
+      must not decrease from one row to the next.
+    */
+    void append(int report_step, double secs_elapsed, const SummaryState& st);
+
+    std::size_t num_rows() const;
+    std::size_t num_columns() const;
+    std::size_t chunk_rows() const;
+
+    std::size_t index(const std::string& key) const;
+    const std::string& key(std::size_t column) const;
+    bool has(const std::string& key) const;
+
+    const std::vector<double>& times() const;
+    const std::vector<int>& report_steps() const;
+
+    /*
+      The rows [first, last) with first_time <= secs_elapsed <=
+      last_time, for the range queries of get().
+    */
+    std::pair<std::size_t, std::size_t> rows(double first_time, double last_time) const;
+
+    double get(std::size_t column, std::size_t row) const;
+    double get(const std::string& key, std::size_t row) const;
+    std::vector<double> get(std::size_t column, std::size_t first_row, std::size_t last_row) const;
+    std::vector<double> get(const std::string& key, std::size_t first_row, std::size_t last_row) const;
+
+    /*
+      Visit all the chunks of the table, column by column in row order.
+      The values of a chunk which is not packed are passed without
+      copying; a packed chunk is unpacked to a buffer which is only
+      valid during the call.
+    */
+    void export_table(const Visitor& visitor) const;
+
+    /// The number of bytes held by the chunks.
+    std::size_t memory_usage() const;
+
+private:
+    struct Chunk {
+        std::vector<double> values;          // Empty when packed
+        std::vector<unsigned char> packed;
+    };
+
+    void add_column(const std::string& key);
+    void seal(Chunk& chunk) const;
+    const double* chunk_values(const Chunk& chunk, std::vector<double>& buffer) const;
+    std::size_t column_index(const std::string& key) const;
+
+    std::size_t rows_per_chunk;
+    bool compress;
+
+    std::vector<double> time_column;
+    std::vector<int> step_column;
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, std::size_t> columns;
+    std::vector<std::vector<Chunk>> chunks;   // Indexed by column, then by chunk
+};
+
+}
+#endif
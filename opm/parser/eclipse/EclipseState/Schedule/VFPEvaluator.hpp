@@ -0,0 +1,151 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARSER_ECLIPSE_ECLIPSESTATE_SCHEDULE_VFPEVALUATOR_HPP_
+#define OPM_PARSER_ECLIPSE_ECLIPSESTATE_SCHEDULE_VFPEVALUATOR_HPP_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+    class VFPInjTable;
+    class VFPProdTable;
+
+/**
+ * Result of a VFP table evaluation: the interpolated bottom hole pressure
+ * and its partial derivatives with respect to the table coordinates. For
+ * injection tables the wfr, gfr and alq derivatives are zero.
+ */
+struct VFPEvaluation {
+    double value = 0.0;
+    double dflo = 0.0;
+    double dthp = 0.0;
+    double dwfr = 0.0;
+    double dgfr = 0.0;
+    double dalq = 0.0;
+};
+
+
+/**
+ * Position in the table of the previous evaluation. Passing the same hint
+ * to consecutive evaluations for the same well lets the axis search start
+ * from the previously used interval instead of bisecting the full axis.
+ */
+struct VFPHint {
+    std::array<std::size_t, 5> index = {{ 0, 0, 0, 0, 0 }};
+};
+
+
+/**
+ * Evaluation engine for VFPPROD tables. The table data is copied into a
+ * flat array with precomputed strides, and evaluated with multilinear
+ * interpolation in the five table dimensions. Coordinates outside the
+ * axis range are linearly extrapolated from the first or last interval.
+ *
+ * All coordinates are in SI units, with the same sign convention as the
+ * axes of the VFPProdTable, i.e. production rates are positive.
+ */
+class VFPProdEvaluator {
+public:
+    struct Point {
+        double flo;
+        double thp;
+        double wfr;
+        double gfr;
+        double alq;
+    };
+
+    explicit VFPProdEvaluator(const VFPProdTable& table);
+
+    int getTableNum() const {
+        return m_table_num;
+    }
+
+    /**
+     * Bottom hole pressure and derivatives at the given coordinate. The
+     * hint is used as starting point for the axis search, and updated with
+     * the intervals found.
+     */
+    VFPEvaluation bhp(double flo, double thp, double wfr, double gfr, double alq, VFPHint* hint = nullptr) const;
+
+    /**
+     * Tubing head pressure which gives the bottom hole pressure bhp, i.e.
+     * the inverse of bhp() with respect to thp. The bhp values along the
+     * thp axis are interpolated in the other dimensions and the thp value
+     * is found by linear interpolation between them; outside the table the
+     * first or last interval is extrapolated.
+     */
+    double thp(double flo, double wfr, double gfr, double alq, double bhp, VFPHint* hint = nullptr) const;
+
+    /**
+     * Evaluate all points in one pass. If hints is non-empty it must have
+     * the same size as points; hint i is used and updated for point i.
+     */
+    void bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& results, std::vector<VFPHint>& hints) const;
+    void bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& results) const;
+
+    /**
+     * Batch version of thp(); the thp member of the points is ignored and
+     * bhp[i] is the bottom hole pressure for point i.
+     */
+    void thp(const std::vector<Point>& points, const std::vector<double>& bhp, std::vector<double>& results) const;
+
+private:
+    int m_table_num;
+    std::array<std::vector<double>, 5> m_axes;     // flo, thp, wfr, gfr, alq
+    std::array<std::size_t, 5> m_strides;          // flo, thp, wfr, gfr, alq
+    std::vector<double> m_data;
+};
+
+
+/**
+ * Evaluation engine for VFPINJ tables; see VFPProdEvaluator.
+ */
+class VFPInjEvaluator {
+public:
+    struct Point {
+        double flo;
+        double thp;
+    };
+
+    explicit VFPInjEvaluator(const VFPInjTable& table);
+
+    int getTableNum() const {
+        return m_table_num;
+    }
+
+    VFPEvaluation bhp(double flo, double thp, VFPHint* hint = nullptr) const;
+    double thp(double flo, double bhp, VFPHint* hint = nullptr) const;
+
+    void bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& results, std::vector<VFPHint>& hints) const;
+    void bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& results) const;
+    void thp(const std::vector<Point>& points, const std::vector<double>& bhp, std::vector<double>& results) const;
+
+private:
+    int m_table_num;
+    std::array<std::vector<double>, 2> m_axes;     // flo, thp
+    std::array<std::size_t, 2> m_strides;          // flo, thp
+    std::vector<double> m_data;
+};
+
+}
+
+#endif
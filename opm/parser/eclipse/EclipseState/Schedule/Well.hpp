@@ -123,6 +123,7 @@ namespace Opm {
         const WellConnections& getConnections() const;
         WellConnections getActiveConnections(size_t timeStep, const EclipseGrid& grid) const;
         WellConnections * newWellConnections(size_t time_step);
+        WellConnections * copyWellConnections(size_t time_step);
         void updateWellConnections(size_t time_step, WellConnections * new_set );
 
         /* The rate of a given phase under the following assumptions:
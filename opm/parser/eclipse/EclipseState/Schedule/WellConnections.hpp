@@ -21,17 +21,35 @@
 #ifndef CONNECTIONSET_HPP_
 #define CONNECTIONSET_HPP_
 
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
 #include <opm/parser/eclipse/EclipseState/Schedule/Connection.hpp>
 
 namespace Opm {
     class EclipseGrid;
     class Eclipse3DProperties;
+
+    /*
+      The connections are stored in fixed size chunks which are shared
+      between copies of the WellConnections object; copying a connection
+      set is therefore proportional to the number of chunks and not the
+      number of connections. A chunk is only cloned when a connection in
+      it is modified while the chunk is still shared with another
+      connection set, hence the connection sets of consecutive report
+      steps share all the chunks which are not touched by the keywords
+      applied in between.
+    */
     class WellConnections {
     public:
         WellConnections() = default;
         WellConnections(int headI, int headJ);
         // cppcheck-suppress noExplicitConstructor
         WellConnections(const WellConnections& src, const EclipseGrid& grid);
+        /// Share the connections of src, with a new well head position.
+        WellConnections(const WellConnections& src, int headI, int headJ);
         void addConnection(int i, int j , int k ,
                            double depth,
                            WellCompletion::StateEnum state ,
@@ -48,7 +66,34 @@ namespace Opm {
                            const bool defaultSatTabId = true);
         void loadCOMPDAT(const DeckRecord& record, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties, std::size_t& totNC);
 
-        using const_iterator = std::vector< Connection >::const_iterator;
+        class const_iterator {
+            public:
+                using difference_type = std::ptrdiff_t;
+                using value_type = Connection;
+                using pointer = const Connection*;
+                using reference = const Connection&;
+                using iterator_category = std::forward_iterator_tag;
+
+                const_iterator() = default;
+
+                reference operator*() const { return this->set->get(this->pos); }
+                pointer operator->() const { return &this->set->get(this->pos); }
+
+                const_iterator& operator++() { ++this->pos; return *this; }
+                const_iterator operator++( int ) { const_iterator copy( *this ); ++this->pos; return copy; }
+
+                bool operator==( const const_iterator& rhs ) const { return this->pos == rhs.pos; }
+                bool operator!=( const const_iterator& rhs ) const { return this->pos != rhs.pos; }
+
+            private:
+                const_iterator( const WellConnections* set_arg, std::size_t pos_arg ) :
+                    set( set_arg ), pos( pos_arg ) {}
+
+                const WellConnections* set = nullptr;
+                std::size_t pos = 0;
+
+                friend class WellConnections;
+        };
 
         void add( Connection );
         size_t size() const;
@@ -56,12 +101,17 @@ namespace Opm {
         const Connection& get(size_t index) const;
         const Connection& getFromIJK(const int i, const int j, const int k) const;
         Connection& getFromIJK(const int i, const int j, const int k);
+        /// Modifiable reference to connection 'index'; clones the chunk
+        /// containing the connection if it is shared with another set.
+        Connection& getMutable(size_t index);
+
+        const_iterator begin() const { return const_iterator( this, 0 ); }
+        const_iterator end() const { return const_iterator( this, this->m_size ); }
+
+        std::size_t totNoConn() const { return this->m_size; }
+        /// Number of storage chunks shared with 'other'.
+        std::size_t sharedChunks(const WellConnections& other) const;
 
-        const_iterator begin() const { return this->m_connections.begin(); }
-        const_iterator end() const { return this->m_connections.end(); }
-        
-        std::size_t totNoConn() const { return this->m_connections.size(); }
-        
         void filter(const EclipseGrid& grid);
         bool allConnectionsShut() const;
         /// Order connections irrespective of input order.
@@ -99,9 +149,14 @@ namespace Opm {
                            const bool defaultSatTabId = true);
 
         size_t findClosestConnection(int oi, int oj, double oz, size_t start_pos);
+        void swapConnections(size_t index1, size_t index2);
+
+        using Chunk = std::vector< Connection >;
+        static const std::size_t chunkSize = 64;
 
         int headI, headJ;
-        std::vector< Connection > m_connections;
+        std::size_t m_size = 0;
+        std::vector< std::shared_ptr< Chunk > > m_chunks;
     };
 }
 
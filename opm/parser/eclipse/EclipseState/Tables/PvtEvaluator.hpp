@@ -0,0 +1,190 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef OPM_PARSER_PVT_EVALUATOR_HPP
+#define OPM_PARSER_PVT_EVALUATOR_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+  The classes in this file are compiled, read-only versions of the PVT
+  tables held by the TableManager, intended for evaluating fluid
+  properties in a simulator. They give the same results as
+  SimpleTable::evaluate() and PvtxTable::evaluate(), i.e. linear
+  interpolation which is clamped to the end points of the table, but:
+
+    1. The column is given by an integer handle which is resolved once
+       with column(), instead of a column name for every evaluation.
+
+    2. The tables are stored as flat arrays of node values and interval
+       slopes, so an evaluation is one interval search and one
+       multiply-add.
+
+    3. The batch evaluation methods locate the intervals for all the
+       arguments with a branch free counting loop over the table nodes,
+       which the compiler can vectorize across the arguments.
+
+    4. Derivatives can be returned along with the values; outside the
+       range of the table the derivative is zero.
+*/
+
+namespace Opm {
+
+    class PvtxTable;
+    class SimpleTable;
+    class TableManager;
+    struct PvtwTable;
+
+    /*
+      Compiled one dimensional table, i.e. PVDO, PVDG or one of the
+      undersaturated tables of PVTO/PVTG. The first column is the
+      argument.
+    */
+    class CompiledPvtTable {
+    public:
+        explicit CompiledPvtTable(const SimpleTable& table);
+
+        size_t numRows() const;
+        size_t numColumns() const;
+
+        /// Handle for the column 'name'; throws std::invalid_argument if
+        /// there is no such column.
+        size_t column(const std::string& name) const;
+
+        double evaluate(size_t column, double arg) const;
+        double evaluate(size_t column, double arg, double& derivative) const;
+
+        void evaluate(size_t column, const std::vector<double>& args, std::vector<double>& values) const;
+        void evaluate(size_t column, const std::vector<double>& args, std::vector<double>& values, std::vector<double>& derivatives) const;
+
+    private:
+        std::vector<std::string> m_names;
+        std::vector<double> m_args;
+        std::vector<std::vector<double>> m_values;
+        std::vector<std::vector<double>> m_slopes;
+    };
+
+
+    /*
+      Compiled PVTO or PVTG table. The outer argument is RS for PVTO and
+      P for PVTG; the inner argument is the first column of the
+      undersaturated tables, i.e. P for PVTO and RV for PVTG. The
+      undersaturated tables of all the outer nodes are stored back to back
+      in the same flat arrays.
+    */
+    class CompiledPvtxTable {
+    public:
+        explicit CompiledPvtxTable(const PvtxTable& table);
+
+        size_t size() const;
+
+        /// Handle for the undersaturated column 'name'; throws
+        /// std::invalid_argument if there is no such column.
+        size_t column(const std::string& name) const;
+
+        double evaluate(size_t column, double outerArg, double innerArg) const;
+        double evaluate(size_t column, double outerArg, double innerArg, double& dOuter, double& dInner) const;
+
+        void evaluate(size_t column,
+                      const std::vector<double>& outerArgs,
+                      const std::vector<double>& innerArgs,
+                      std::vector<double>& values) const;
+
+        void evaluate(size_t column,
+                      const std::vector<double>& outerArgs,
+                      const std::vector<double>& innerArgs,
+                      std::vector<double>& values,
+                      std::vector<double>& dOuter,
+                      std::vector<double>& dInner) const;
+
+        const CompiledPvtTable& getSaturatedTable() const;
+
+    private:
+        double evaluate(size_t column, double outerArg, double innerArg, double* dOuter, double* dInner) const;
+
+        std::vector<std::string> m_names;
+        std::vector<double> m_outer;
+        std::vector<size_t> m_offsets;
+        std::vector<double> m_inner;
+        std::vector<std::vector<double>> m_values;
+        std::vector<std::vector<double>> m_slopes;
+        CompiledPvtTable m_saturated;
+    };
+
+
+    /*
+      Water properties from PVTW, for all PVT regions:
+
+         B_w(p)  = B_ref / (1 + X + X^2/2)           X = c (p - p_ref)
+         mu_w(p) = mu_ref (1 + X + X^2/2) / (1 + Y + Y^2/2)
+                                                     Y = (c - c_v) (p - p_ref)
+    */
+    class CompiledPvtwTable {
+    public:
+        explicit CompiledPvtwTable(const PvtwTable& table);
+
+        size_t size() const;
+
+        double formationVolumeFactor(size_t region, double pressure) const;
+        double formationVolumeFactor(size_t region, double pressure, double& derivative) const;
+        double viscosity(size_t region, double pressure) const;
+        double viscosity(size_t region, double pressure, double& derivative) const;
+
+        void formationVolumeFactor(size_t region, const std::vector<double>& pressure, std::vector<double>& values) const;
+        void formationVolumeFactor(size_t region, const std::vector<double>& pressure, std::vector<double>& values, std::vector<double>& derivatives) const;
+        void viscosity(size_t region, const std::vector<double>& pressure, std::vector<double>& values) const;
+        void viscosity(size_t region, const std::vector<double>& pressure, std::vector<double>& values, std::vector<double>& derivatives) const;
+
+    private:
+        struct PvtwCoefficients;
+        PvtwCoefficients coefficients(size_t region) const;
+
+        std::vector<double> m_refPressure;
+        std::vector<double> m_volumeFactor;
+        std::vector<double> m_compressibility;
+        std::vector<double> m_viscosity;
+        std::vector<double> m_viscosibility;
+    };
+
+
+    /*
+      All the PVT tables of a TableManager in compiled form, one table per
+      PVT region.
+    */
+    class CompiledPvtTables {
+    public:
+        explicit CompiledPvtTables(const TableManager& tables);
+
+        const std::vector<CompiledPvtxTable>& getPvtoTables() const;
+        const std::vector<CompiledPvtxTable>& getPvtgTables() const;
+        const std::vector<CompiledPvtTable>& getPvdoTables() const;
+        const std::vector<CompiledPvtTable>& getPvdgTables() const;
+        const CompiledPvtwTable& getPvtwTable() const;
+
+    private:
+        std::vector<CompiledPvtxTable> m_pvto;
+        std::vector<CompiledPvtxTable> m_pvtg;
+        std::vector<CompiledPvtTable> m_pvdo;
+        std::vector<CompiledPvtTable> m_pvdg;
+        CompiledPvtwTable m_pvtw;
+    };
+}
+
+#endif
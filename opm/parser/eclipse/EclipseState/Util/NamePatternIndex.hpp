@@ -0,0 +1,93 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_NAME_PATTERN_INDEX_HPP
+#define OPM_NAME_PATTERN_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Opm {
+
+/*
+  Sorted index of the names stored in an OrderedMap, used to resolve
+  well and group name patterns of the form 'PREFIX*' without testing
+  every name against the pattern. The index maps names to their
+  insertion index in the OrderedMap; the matches are returned in
+  insertion order, i.e. the same order as a linear scan of the
+  OrderedMap would produce.
+
+  Resolved patterns are memoized until the next insert().
+*/
+
+class NamePatternIndex {
+public:
+    void insert(const std::string& name, std::size_t index) {
+        m_names[name] = index;
+        m_cache.clear();
+    }
+
+    std::size_t size() const {
+        return m_names.size();
+    }
+
+    /*
+      A pattern can be resolved through the index if it ends with a
+      single '*' and the prefix does not contain any other character
+      which is special to fnmatch().
+    */
+    static bool isPrefixPattern(const std::string& pattern) {
+        if (pattern.empty() || pattern.back() != '*')
+            return false;
+
+        return pattern.find_first_of("*?[\\") == pattern.size() - 1;
+    }
+
+    /*
+      Insertion indices of all names matching the prefix pattern, in
+      ascending order. The pattern must satisfy isPrefixPattern().
+    */
+    const std::vector<std::size_t>& match(const std::string& pattern) const {
+        auto cached = m_cache.find(pattern);
+        if (cached != m_cache.end())
+            return cached->second;
+
+        const std::string prefix = pattern.substr(0, pattern.size() - 1);
+        std::vector<std::size_t> indices;
+        for (auto iter = m_names.lower_bound(prefix);
+             iter != m_names.end() && iter->first.compare(0, prefix.size(), prefix) == 0;
+             ++iter)
+            indices.push_back(iter->second);
+
+        std::sort(indices.begin(), indices.end());
+        return m_cache.emplace(pattern, std::move(indices)).first->second;
+    }
+
+private:
+    std::map<std::string, std::size_t> m_names;
+    mutable std::unordered_map<std::string, std::vector<std::size_t>> m_cache;
+};
+}
+
+#endif
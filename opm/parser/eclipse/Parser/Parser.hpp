@@ -40,6 +40,7 @@ namespace Opm {
     class Deck;
     class ParseContext;
     class ErrorGuard;
+    class ParserProfile;
     class RawKeyword;
 
     /// The hub of the parsing process.
@@ -59,10 +60,21 @@ namespace Opm {
 
         Deck parseFile(const std::string& datafile);
 
+        /// As parseFile() above, and the time spent on each keyword and
+        /// each file is added to the profile.
+        Deck parseFile(const std::string &dataFile,
+                       const ParseContext&,
+                       ErrorGuard& errors,
+                       ParserProfile* profile) const;
+
         Deck parseString(const std::string &data,
                          const ParseContext&,
                          ErrorGuard& errors) const;
         Deck parseString(const std::string &data) const;
+        Deck parseString(const std::string &data,
+                         const ParseContext&,
+                         ErrorGuard& errors,
+                         ParserProfile* profile) const;
 
         Deck parseStream(std::unique_ptr<std::istream>&& inputStream , const ParseContext& parseContext, ErrorGuard& errors) const;
 
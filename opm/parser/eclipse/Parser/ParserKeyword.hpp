@@ -39,6 +39,7 @@ namespace Opm {
     class ParseContext;
     class ErrorGuard;
     class ParserDoubleItem;
+    class ParserProfile;
     class RawKeyword;
     class string_view;
     class ErrorGuard;
@@ -124,7 +125,10 @@ namespace Opm {
         SectionNameSet::const_iterator validSectionNamesBegin() const;
         SectionNameSet::const_iterator validSectionNamesEnd() const;
 
-        DeckKeyword parse(const ParseContext& parseContext, ErrorGuard& errors, std::shared_ptr< RawKeyword > rawKeyword) const;
+        /// When a profile is given the time spent scanning the records and
+        /// building the DeckKeyword is added to it.
+        DeckKeyword parse(const ParseContext& parseContext, ErrorGuard& errors, std::shared_ptr< RawKeyword > rawKeyword,
+                          ParserProfile* profile = nullptr) const;
         enum ParserKeywordSizeEnum getSizeType() const;
         const KeywordSize& getKeywordSize() const;
         bool isDataKeyword() const;
@@ -0,0 +1,130 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARSER_PROFILE_HPP
+#define OPM_PARSER_PROFILE_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+namespace Opm {
+
+    /*
+      The ParserProfile attributes the time spent by the Parser to the
+      keywords and to the files they are read from. The parsing of one
+      keyword is split in four stages:
+
+        Tokenize:   Reading the lines of the keyword and splitting them in
+                    records and tokens, i.e. building the RawKeyword.
+
+        Scan:       ParserRecord::parse(), i.e. ParserItem::scan() for
+                    all the items of the records.
+
+        Keyword:    The rest of ParserKeyword::parse(), i.e. building the
+                    DeckKeyword from the scanned records.
+
+        AddKeyword: Deck::addKeyword().
+
+      The profile is filled by passing it to Parser::parseFile() or
+      Parser::parseString(); with a nullptr profile the parser does no
+      extra work. When an allocation counter is installed - typically a
+      counter maintained by a replacement operator new in a benchmark
+      program - the number of allocations is recorded for each stage as
+      well.
+    */
+    class ParserProfile {
+    public:
+        enum class Stage {
+            Tokenize = 0,
+            Scan = 1,
+            Keyword = 2,
+            AddKeyword = 3
+        };
+
+        static constexpr std::size_t num_stages = 4;
+
+        struct Cost {
+            std::size_t count = 0;       // Number of keywords
+            std::size_t records = 0;
+            std::size_t tokens = 0;
+            std::size_t bytes = 0;
+            std::array<double, num_stages> seconds{};
+            std::array<std::size_t, num_stages> allocations{};
+
+            double totalSeconds() const;
+            std::size_t totalAllocations() const;
+            Cost& operator+=(const Cost& other);
+        };
+
+        /*
+          Measures one stage; a Sample of a nullptr profile does not read
+          the clock.
+        */
+        class Sample {
+        public:
+            explicit Sample(const ParserProfile* profile);
+
+            double seconds() const;
+            std::size_t allocations() const;
+
+        private:
+            const ParserProfile* m_profile;
+            std::chrono::steady_clock::time_point m_start;
+            std::size_t m_allocations = 0;
+        };
+
+        void setAllocationCounter(std::function<std::size_t()> counter);
+
+        void add(const std::string& keyword, const std::string& file, Stage stage, const Sample& sample);
+        void add(const std::string& keyword, const std::string& file, Stage stage, double seconds, std::size_t allocations);
+        void addKeyword(const std::string& keyword, const std::string& file, std::size_t records, std::size_t tokens, std::size_t bytes);
+        void addFile(const std::string& file, std::size_t bytes);
+
+        /// Cost of each keyword, summed over all occurrences.
+        const std::map<std::string, Cost>& keywords() const;
+
+        /// Cost of the keywords read from each file, where the bytes are
+        /// the size of the file. Keywords from parseString() have an empty
+        /// file name.
+        const std::map<std::string, Cost>& files() const;
+
+        Cost total() const;
+
+        static const std::string& stageName(Stage stage);
+
+        /// The keywords sorted on total time, most expensive first.
+        void write(std::ostream& os, std::size_t max_keywords = 25) const;
+
+    private:
+        std::size_t allocationCount() const;
+
+        std::function<std::size_t()> m_allocationCounter;
+        std::map<std::string, Cost> m_keywords;
+        std::map<std::string, Cost> m_files;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const ParserProfile& profile);
+}
+
+#endif
@@ -43,11 +43,31 @@ namespace Opm {
         bool operator==( const Dimension& ) const;
         bool operator!=( const Dimension& ) const;
 
+        template <class MessageBufferType>
+        void pack(MessageBufferType& buffer) const;
+        template <class MessageBufferType>
+        void unpack(MessageBufferType& buffer);
+
     private:
         std::string m_name;
         double m_SIfactor;
         double m_SIoffset;
     };
+
+
+    template <class MessageBufferType>
+    void Dimension::pack(MessageBufferType& buffer) const {
+        buffer.write(this->m_name);
+        buffer.write(this->m_SIfactor);
+        buffer.write(this->m_SIoffset);
+    }
+
+    template <class MessageBufferType>
+    void Dimension::unpack(MessageBufferType& buffer) {
+        buffer.read(this->m_name);
+        buffer.read(this->m_SIfactor);
+        buffer.read(this->m_SIoffset);
+    }
 }
 
 
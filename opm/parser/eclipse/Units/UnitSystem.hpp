@@ -105,6 +105,11 @@ namespace Opm {
         static UnitSystem newLAB();
         static UnitSystem newPVT_M();
         static UnitSystem newINPUT();
+
+        template <class MessageBufferType>
+        void pack(MessageBufferType& buffer) const;
+        template <class MessageBufferType>
+        void unpack(MessageBufferType& buffer);
     private:
         Dimension parseFactor( const std::string& ) const;
 
@@ -116,6 +121,36 @@ namespace Opm {
         const double* measure_table_to_si;
         const char* const*  unit_name_table;
     };
+
+
+    /*
+      The conversion tables are static, and are restored from the unit
+      type; only the dimensions which have been added to the unit system
+      are packed explicitly.
+    */
+    template <class MessageBufferType>
+    void UnitSystem::pack(MessageBufferType& buffer) const {
+        buffer.write(static_cast<int>(this->m_unittype));
+        unsigned int size = this->m_dimensions.size();
+        buffer.write(size);
+        for (const auto& pair : this->m_dimensions)
+            pair.second.pack(buffer);
+    }
+
+    template <class MessageBufferType>
+    void UnitSystem::unpack(MessageBufferType& buffer) {
+        int unit_type;
+        buffer.read(unit_type);
+        *this = UnitSystem( static_cast<UnitType>(unit_type) );
+
+        unsigned int size;
+        buffer.read(size);
+        for (unsigned int i = 0; i < size; i++) {
+            Dimension dim;
+            dim.unpack(buffer);
+            this->addDimension(dim);
+        }
+    }
 }
 
 
@@ -21,6 +21,7 @@
 #include <opm/common/OpmLog/Logger.hpp>
 #include <opm/common/OpmLog/StreamLog.hpp>
 #include <iostream>
+#include <mutex>
 #include <errno.h>  // For errno
 #include <stdio.h>  // For fileno() and stdout
 
@@ -41,6 +42,17 @@
 namespace Opm {
 
     namespace {
+        /*
+          The Logger and its backends are not thread safe; messages can be
+          added from parallel sections, e.g. when the Schedule is built.
+        */
+        std::mutex& messageMutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+
         bool stdoutIsTerminal()
         {
             const int errno_save = errno; // For playing nice with C error handling.
@@ -65,12 +77,14 @@ namespace Opm {
 
 
     void OpmLog::addMessage(int64_t messageFlag , const std::string& message) {
+        std::lock_guard<std::mutex> lock( messageMutex() );
         if (m_logger)
             m_logger->addMessage( messageFlag , message );
     }
 
 
     void OpmLog::addTaggedMessage(int64_t messageFlag, const std::string& tag, const std::string& message) {
+        std::lock_guard<std::mutex> lock( messageMutex() );
         if (m_logger)
             m_logger->addTaggedMessage( messageFlag, tag, message );
     }
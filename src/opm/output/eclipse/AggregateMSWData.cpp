@@ -498,7 +498,7 @@ namespace {
 		const auto& welSegSet = well.getWellSegments(rptStep);
 		const auto& welConns = well.getActiveConnections(rptStep, grid);
 		const auto& wname     = well.name();
-		const auto wPKey = "WBHP:"  + wname;
+		const auto wbhp = smry.index("WBHP:" + wname);
 		const auto& wRatesIt =  wr.find(wname);
 		bool haveWellRes = wRatesIt != wr.end();
 		//
@@ -514,11 +514,17 @@ namespace {
 		  sSFR = getSegmentSetFlowRates(welSegSet, wRatesIt->second.connections, welConns, units);
 		  
 		  }
-		auto get = [&smry, &wname, &stringSegNum](const std::string& vector)
+		auto value = [&smry](const std::size_t slot)
+		{
+		    return smry.has(slot) ? smry.get(slot) : 0.0;
+		};
+
+		// The segment vectors have one key per segment, which is
+		// looked up once per segment.
+		auto get = [&smry, &wname, &stringSegNum, &value](const std::string& vector)
 		{
 		    // 'stringSegNum' is one-based (1 .. #segments inclusive)
-		    const auto key = vector + ':' + wname + ':' + stringSegNum;
-		    return smry.has(key) ? smry.get(key) : 0.0;
+		    return value(smry.index(vector + ':' + wname + ':' + stringSegNum));
 		};
 
 		// Treat the top segment individually
@@ -548,7 +554,7 @@ namespace {
 		    temp_w = sSFR.swfr[segNumber]*0.1;
 		    temp_g = sSFR.sgfr[segNumber]*gfactor;
 		    //Item 12 Segment pressure - use well flow bhp
-		    rSeg[11] = (smry.has(wPKey)) ? smry.get(wPKey) :0.0;
+		    rSeg[11] = value(wbhp);
 		}
 		else {
 		    // Note: Segment flow rates and pressure from 'smry' have correct
@@ -604,7 +610,7 @@ namespace {
 			temp_w = sSFR.swfr[segNumber]*0.1;
 			temp_g = sSFR.sgfr[segNumber]*gfactor;
 			//Item 12 Segment pressure - use well flow bhp
-			rSeg[iS +  11] = (smry.has(wPKey)) ? smry.get(wPKey) :0.0;
+			rSeg[iS +  11] = value(wbhp);
 		    }
 		    else {
 			// Note: Segment flow rates and pressure from 'smry' have correct
@@ -36,6 +36,7 @@
 #include <opm/parser/eclipse/Units/Units.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
@@ -612,39 +613,72 @@ namespace {
             xWell[Ix::BHPTarget] = units.from_si(M::pressure, bhpTarget);
         }
 
+        /*
+          The slots in the SummaryState of the summary vectors of a well
+          which go to the XWEL array. The keys are looked up once per well,
+          and the values are read by slot.
+        */
+        class WellVectors {
+        public:
+            enum Vector : std::size_t {
+                WOPR, WWPR, WGPR, WVPR, WBHP, WWCT, WGOR,
+                WOPT, WWPT, WGPT, WVPT,
+                WWIR, WWIT, WWVIR,
+                WGIR, WGIT, WGVIR,
+                NumVectors
+            };
+
+            WellVectors(const ::Opm::SummaryState& smry_arg, const std::string& well)
+                : smry(smry_arg)
+            {
+                static const char* const names[NumVectors] = {
+                    "WOPR", "WWPR", "WGPR", "WVPR", "WBHP", "WWCT", "WGOR",
+                    "WOPT", "WWPT", "WGPT", "WVPT",
+                    "WWIR", "WWIT", "WWVIR",
+                    "WGIR", "WGIT", "WGVIR",
+                };
+
+                for (std::size_t v = 0; v < NumVectors; ++v)
+                    this->slots[v] = this->smry.index(names[v] + (':' + well));
+            }
+
+            double operator()(const Vector v) const
+            {
+                const auto slot = this->slots[v];
+
+                return this->smry.has(slot) ? this->smry.get(slot) : 0.0;
+            }
+
+        private:
+            const ::Opm::SummaryState& smry;
+            std::array<std::size_t, NumVectors> slots;
+        };
+
         template <class XWellArray>
-        void assignProducer(const std::string&         well,
-                            const ::Opm::SummaryState& smry,
+        void assignProducer(const WellVectors&         get,
 			    const bool  ecl_compatible_rst, 
                             XWellArray&                xWell)
         {
             using Ix = ::Opm::RestartIO::Helpers::VectorItems::XWell::index;
 
-            auto get = [&smry, &well](const std::string& vector)
-            {
-                const auto key = vector + ':' + well;
-
-                return smry.has(key) ? smry.get(key) : 0.0;
-            };
-
-            xWell[Ix::OilPrRate] = get("WOPR");
-            xWell[Ix::WatPrRate] = get("WWPR");
-            xWell[Ix::GasPrRate] = get("WGPR");
+            xWell[Ix::OilPrRate] = get(WellVectors::WOPR);
+            xWell[Ix::WatPrRate] = get(WellVectors::WWPR);
+            xWell[Ix::GasPrRate] = get(WellVectors::WGPR);
 
             xWell[Ix::LiqPrRate] = xWell[Ix::OilPrRate]
                                  + xWell[Ix::WatPrRate];
 
-            xWell[Ix::VoidPrRate] = get("WVPR");
+            xWell[Ix::VoidPrRate] = get(WellVectors::WVPR);
 
-            xWell[Ix::FlowBHP] = get("WBHP");
-            xWell[Ix::WatCut]  = get("WWCT");
-            xWell[Ix::GORatio] = get("WGOR");
+            xWell[Ix::FlowBHP] = get(WellVectors::WBHP);
+            xWell[Ix::WatCut]  = get(WellVectors::WWCT);
+            xWell[Ix::GORatio] = get(WellVectors::WGOR);
 
 	    if (ecl_compatible_rst) {
-		xWell[Ix::OilPrTotal]  = get("WOPT");
-		xWell[Ix::WatPrTotal]  = get("WWPT");
-		xWell[Ix::GasPrTotal]  = get("WGPT");
-		xWell[Ix::VoidPrTotal] = get("WVPT");
+		xWell[Ix::OilPrTotal]  = get(WellVectors::WOPT);
+		xWell[Ix::WatPrTotal]  = get(WellVectors::WWPT);
+		xWell[Ix::GasPrTotal]  = get(WellVectors::WGPT);
+		xWell[Ix::VoidPrTotal] = get(WellVectors::WVPT);
 	    }
             // Not fully characterised.
             xWell[Ix::item37] = xWell[Ix::WatPrRate];
@@ -652,61 +686,45 @@ namespace {
         }
 
         template <class XWellArray>
-        void assignWaterInjector(const std::string&         well,
-                                 const ::Opm::SummaryState& smry,
+        void assignWaterInjector(const WellVectors&         get,
 				 const bool  ecl_compatible_rst, 
                                  XWellArray&                xWell)
         {
             using Ix = ::Opm::RestartIO::Helpers::VectorItems::XWell::index;
 
-            auto get = [&smry, &well](const std::string& vector)
-            {
-                const auto key = vector + ':' + well;
-
-                return smry.has(key) ? smry.get(key) : 0.0;
-            };
-
             // Injection rates reported as negative, cumulative
             // totals as positive.
-            xWell[Ix::WatPrRate] = -get("WWIR");
+            xWell[Ix::WatPrRate] = -get(WellVectors::WWIR);
             xWell[Ix::LiqPrRate] = xWell[Ix::WatPrRate];
 
-            xWell[Ix::FlowBHP] = get("WBHP");
+            xWell[Ix::FlowBHP] = get(WellVectors::WBHP);
   
 	    if (ecl_compatible_rst) {
-		xWell[Ix::WatInjTotal] = get("WWIT");
+		xWell[Ix::WatInjTotal] = get(WellVectors::WWIT);
 	    }
 
             xWell[Ix::item37] = xWell[Ix::WatPrRate];
             xWell[Ix::item82] = xWell[Ix::WatInjTotal];
 
-            xWell[Ix::WatVoidPrRate] = -get("WWVIR");
+            xWell[Ix::WatVoidPrRate] = -get(WellVectors::WWVIR);
         }
 
         template <class XWellArray>
-        void assignGasInjector(const std::string&         well,
-                               const ::Opm::SummaryState& smry,
+        void assignGasInjector(const WellVectors&         get,
 			       const bool  ecl_compatible_rst, 
                                XWellArray&                xWell)
         {
             using Ix = ::Opm::RestartIO::Helpers::VectorItems::XWell::index;
 
-            auto get = [&smry, &well](const std::string& vector)
-            {
-                const auto key = vector + ':' + well;
-
-                return smry.has(key) ? smry.get(key) : 0.0;
-            };
-
             // Injection rates reported as negative production rates,
             // cumulative injection totals as positive.
-            xWell[Ix::GasPrRate]  = -get("WGIR");
-            xWell[Ix::VoidPrRate] = -get("WGVIR");
+            xWell[Ix::GasPrRate]  = -get(WellVectors::WGIR);
+            xWell[Ix::VoidPrRate] = -get(WellVectors::WGVIR);
 
-            xWell[Ix::FlowBHP] = get("WBHP");
+            xWell[Ix::FlowBHP] = get(WellVectors::WBHP);
 
 	    if (ecl_compatible_rst) {
-		xWell[Ix::GasInjTotal] = get("WGIT");
+		xWell[Ix::GasInjTotal] = get(WellVectors::WGIT);
 	    }
 
             xWell[Ix::GasFVF] = (std::abs(xWell[Ix::GasPrRate]) > 0.0)
@@ -729,8 +747,10 @@ namespace {
 			    const bool                 ecl_compatible_rst,
                             XWellArray&                xWell)
         {
+            const WellVectors get(smry, well.name());
+
             if (well.isProducer(sim_step)) {
-                assignProducer(well.name(), smry, ecl_compatible_rst, xWell);
+                assignProducer(get, ecl_compatible_rst, xWell);
             }
             else if (well.isInjector(sim_step)) {
                 using IType = ::Opm::WellInjector::TypeEnum;
@@ -744,16 +764,16 @@ namespace {
                     break;
 
                 case IType::WATER:
-                    assignWaterInjector(well.name(), smry, ecl_compatible_rst, xWell);
+                    assignWaterInjector(get, ecl_compatible_rst, xWell);
                     break;
 
                 case IType::GAS:
-                    assignGasInjector(well.name(), smry, ecl_compatible_rst, xWell);
+                    assignGasInjector(get, ecl_compatible_rst, xWell);
                     break;
 
                 case IType::MULTI:
-                    assignWaterInjector(well.name(), smry, ecl_compatible_rst, xWell);
-                    assignGasInjector  (well.name(), smry, ecl_compatible_rst, xWell);
+                    assignWaterInjector(get, ecl_compatible_rst, xWell);
+                    assignGasInjector  (get, ecl_compatible_rst, xWell);
                     break;
                 }
             }
@@ -30,6 +30,7 @@
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/IOConfig/IOConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/LoadReport.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/WellConnections.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
@@ -37,6 +38,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/Utility/Functional.hpp>
 
+#include <opm/output/eclipse/FortranWriter.hpp>
 #include <opm/output/eclipse/RestartIO.hpp>
 #include <opm/output/eclipse/Summary.hpp>
 #include <opm/output/eclipse/Tables.hpp>
@@ -92,26 +94,83 @@ void writeKeyword( ERT::FortIO& fortio ,
 
 }
 
+/*
+  The FortranWriter appends to the stream of the fortio, in the format -
+  formatted or unformatted - of the fortio.
+*/
+out::FortranWriter fortranWriter( ERT::FortIO& fortio ) {
+    const auto format = fortio_fmt_file( fortio.get() )
+        ? out::FortranWriter::Format::Formatted
+        : out::FortranWriter::Format::Unformatted;
 
+    return out::FortranWriter( fortio_get_FILE( fortio.get() ), format );
+}
+
+/*
+  Write the values of the active cells, where data has either one value
+  per active cell or one value per cell in the global grid. The values
+  are written with the FortranWriter directly from the input vector.
+*/
+void writeActive( ERT::FortIO& fortio ,
+                  const EclipseGrid& grid,
+                  const std::string& keywordName,
+                  const std::vector<int>& data ) {
+
+    auto writer = fortranWriter( fortio );
+    if (data.size() == grid.getNumActive())
+        writer.write( keywordName, data );
+    else if (data.size() == grid.getCartesianSize())
+        writer.writeCells( keywordName, data, grid.getActiveMap() );
+    else
+        throw std::invalid_argument("Input vector must have full size");
+}
 
+void writeActive( ERT::FortIO& fortio ,
+                  const EclipseGrid& grid,
+                  const std::string& keywordName,
+                  const std::vector<double>& data,
+                  const out::FortranWriter::Conversion& conversion = out::FortranWriter::Conversion() ) {
+
+    auto writer = fortranWriter( fortio );
+    if (data.size() == grid.getNumActive())
+        writer.write( keywordName, data, false, conversion );
+    else if (data.size() == grid.getCartesianSize())
+        writer.writeCells( keywordName, data, grid.getActiveMap(), false, conversion );
+    else
+        throw std::invalid_argument("Input vector must have full size");
+}
 
 
+
+
+
+/*
+  The RFT file is opened at the first report step with RFT or PLT output,
+  and is kept open until the EclipseIO is destroyed. It is flushed after
+  every report step, so it can be read while the simulation runs.
+*/
 class RFT {
     public:
     RFT( const std::string&  output_dir,
          const std::string&  basename,
          bool format );
 
-        void writeTimeStep( std::vector< const Well* >,
+        void writeTimeStep( const std::vector< const Well* >& wells,
                             const EclipseGrid& grid,
                             int report_step,
                             time_t current_time,
                             double days,
                             const UnitSystem& units,
-                            data::Wells wellData);
+                            const data::Wells& wellData);
     private:
+        double cellDepth( const EclipseGrid& grid, size_t global_index );
+
         std::string filename;
         bool fmt_file;
+        ERT::ert_unique_ptr< fortio_type, fortio_fclose > fortio;
+
+        // The depths of the cells with RFT connections, from the grid.
+        std::unordered_map< size_t, double > depths;
 };
 
 
@@ -123,39 +182,55 @@ class RFT {
 {}
 
 
-void RFT::writeTimeStep( std::vector< const Well* > wells,
+double RFT::cellDepth( const EclipseGrid& grid, size_t global_index ) {
+    auto depth = this->depths.find( global_index );
+    if (depth == this->depths.end())
+        depth = this->depths.emplace( global_index, grid.getCellDepth( global_index ) ).first;
+
+    return depth->second;
+}
+
+
+void RFT::writeTimeStep( const std::vector< const Well* >& wells,
                          const EclipseGrid& grid,
                          int report_step,
                          time_t current_time,
                          double days,
                          const UnitSystem& units,
-                         data::Wells wellDatas) {
+                         const data::Wells& wellDatas) {
     using rft = ERT::ert_unique_ptr< ecl_rft_node_type, ecl_rft_node_free >;
 
-    fortio_type * fortio;
     int first_report_step = report_step;
 
     for (const auto* well : wells)
         first_report_step = std::min( first_report_step, well->firstRFTOutput());
 
-    if (report_step > first_report_step)
-        fortio = fortio_open_append( filename.c_str() , fmt_file , ECL_ENDIAN_FLIP );
-    else
-        fortio = fortio_open_writer( filename.c_str() , fmt_file , ECL_ENDIAN_FLIP );
+    /*
+      The file is created at the first RFT step, and a restarted run
+      appends to it. The old file is closed before it is opened again,
+      so no buffered output is written after the truncation.
+    */
+    if (!this->fortio || report_step <= first_report_step) {
+        this->fortio.reset( );
+        if (report_step > first_report_step)
+            this->fortio.reset( fortio_open_append( filename.c_str() , fmt_file , ECL_ENDIAN_FLIP ) );
+        else
+            this->fortio.reset( fortio_open_writer( filename.c_str() , fmt_file , ECL_ENDIAN_FLIP ) );
+    }
 
     for ( const auto& well : wells ) {
         if( !( well->getRFTActive( report_step )
             || well->getPLTActive( report_step ) ) )
             continue;
 
-        auto* rft_node = ecl_rft_node_alloc_new( well->name().c_str(), "RFT",
-                current_time, days );
-
         const auto& wellData = wellDatas.at(well->name());
 
         if (wellData.connections.empty())
             continue;
 
+        rft ecl_node( ecl_rft_node_alloc_new( well->name().c_str(), "RFT",
+                                              current_time, days ) );
+
         for( const auto& connection : well->getConnections( report_step ) ) {
 
             const size_t i = size_t( connection.getI() );
@@ -165,30 +240,25 @@ void RFT::writeTimeStep( std::vector< const Well* > wells,
             if( !grid.cellActive( i, j, k ) ) continue;
 
             const auto index = grid.getGlobalIndex( i, j, k );
-            const double depth = grid.getCellDepth( i, j, k );
-
-            const auto& connectionData = std::find_if( wellData.connections.begin(),
-                                                   wellData.connections.end(),
-                                                   [=]( const data::Connection& c ) {
-                                                        return c.index == index;
-                                                   } );
+            const auto* connectionData = wellData.find_connection( index );
+            if (connectionData == nullptr)
+                continue;
 
-
-            const double press = units.from_si(UnitSystem::measure::pressure,connectionData->cell_pressure);
+            const double depth = this->cellDepth( grid, index );
+            const double press = units.from_si(UnitSystem::measure::pressure, connectionData->cell_pressure);
             const double satwat = units.from_si(UnitSystem::measure::identity, connectionData->cell_saturation_water);
             const double satgas = units.from_si(UnitSystem::measure::identity, connectionData->cell_saturation_gas);
 
             auto* cell = ecl_rft_cell_alloc_RFT(
                             i, j, k, depth, press, satwat, satgas );
 
-            ecl_rft_node_append_cell( rft_node, cell );
+            ecl_rft_node_append_cell( ecl_node.get(), cell );
         }
 
-        rft ecl_node( rft_node );
-        ecl_rft_node_fwrite( ecl_node.get(), fortio, units.getEclType() );
+        ecl_rft_node_fwrite( ecl_node.get(), this->fortio.get(), units.getEclType() );
     }
 
-    fortio_fclose( fortio );
+    fortio_fflush( this->fortio.get() );
 }
 
 inline std::string uppercase( std::string x ) {
@@ -214,6 +284,7 @@ class EclipseIO::Impl {
         out::Summary summary;
         RFT rft;
         bool output_enabled;
+        LoadReport* report;
 };
 
 EclipseIO::Impl::Impl( const EclipseState& eclipseState,
@@ -228,6 +299,7 @@ EclipseIO::Impl::Impl( const EclipseState& eclipseState,
     , summary( eclipseState, summary_config, grid , schedule )
     , rft( outputDir.c_str(), baseName.c_str(), es.getIOConfig().getFMTOUT() )
     , output_enabled( eclipseState.getIOConfig().getOutputEnabled() )
+    , report( nullptr )
 {}
 
 
@@ -255,12 +327,6 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
     {
 
         const auto& opm_data = this->es.get3DProperties().getDoubleGridProperty("PORV").getData();
-        auto ecl_data = opm_data;
-
-        for (size_t global_index = 0; global_index < opm_data.size(); global_index++)
-            if (!this->grid.cellActive( global_index ))
-                ecl_data[global_index] = 0;
-
 
         ecl_init_file_fwrite_header( fortio.get(),
                                      this->grid.c_ptr(),
@@ -269,8 +335,9 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
                                      this->es.runspec( ).eclPhaseMask( ),
                                      this->schedule.posixStartTime( ));
 
-        units.from_si( UnitSystem::measure::volume, ecl_data );
-        writeKeyword( fortio, "PORV" , ecl_data );
+        auto writer = fortranWriter( fortio );
+        writer.writeMasked( "PORV", opm_data, this->grid.getActiveMap(),
+                            { units, UnitSystem::measure::volume } );
     }
 
     // Writing quantities which are calculated by the grid to the INIT file.
@@ -300,10 +367,9 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
         for (const auto& kw_pair : doubleKeywords) {
             if (properties.hasKeyword( kw_pair.first)) {
                 const auto& opm_property = properties.getKeyword(kw_pair.first);
-                auto ecl_data = opm_property.compressedCopy( this->grid );
 
-                units.from_si( kw_pair.second, ecl_data );
-                writeKeyword( fortio, kw_pair.first, ecl_data );
+                writeActive( fortio, this->grid, kw_pair.first, opm_property.getData(),
+                             { units, kw_pair.second } );
             }
         }
     }
@@ -311,10 +377,8 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
 
     // Write properties which have been initialized by the simulator.
     {
-        for (const auto& prop : simProps) {
-            auto ecl_data = this->grid.compressedVector( prop.second.data );
-            writeKeyword( fortio, prop.first, ecl_data );
-        }
+        for (const auto& prop : simProps)
+            writeActive( fortio, this->grid, prop.first, prop.second.data );
     }
 
     // Write tables
@@ -341,10 +405,8 @@ void EclipseIO::Impl::writeINITFile( const data::Solution& simProps, std::map<st
         properties.assertKeyword("EQLNUM");
         properties.assertKeyword("FIPNUM");
 
-        for (const auto& property : properties) {
-            auto ecl_data = property.compressedCopy( this->grid );
-            writeKeyword( fortio , property.getKeywordName() , ecl_data );
-        }
+        for (const auto& property : properties)
+            writeActive( fortio, this->grid, property.getKeywordName(), property.getData() );
     }
 
 
@@ -399,11 +461,15 @@ void EclipseIO::writeInitial( data::Solution simProps, std::map<std::string, std
         const IOConfig& ioConfig = es.cfg().io();
 
         simProps.convertFromSI( es.getUnits() );
-        if( ioConfig.getWriteINITFile() )
+        if( ioConfig.getWriteINITFile() ) {
+            LoadReport::Timer timer( this->impl->report, "INIT" );
             this->impl->writeINITFile( simProps , int_data, nnc );
+        }
 
-        if( ioConfig.getWriteEGRIDFile( ) )
+        if( ioConfig.getWriteEGRIDFile( ) ) {
+            LoadReport::Timer timer( this->impl->report, "EGRID" );
             this->impl->writeEGRIDFile( nnc );
+        }
     }
 
 }
@@ -437,11 +503,13 @@ void EclipseIO::writeTimeStep(int report_step,
       very intial report_step==0 call, which is only garbage.
     */
     if (report_step > 0) {
+        LoadReport::Timer timer( this->impl->report, "Summary" );
         this->impl->summary.add_timestep( report_step,
                                           secs_elapsed,
                                           es,
                                           schedule,
                                           value.wells ,
+                                          value.solution,
                                           single_summary_values ,
                                           region_summary_values,
                                           block_summary_values);
@@ -455,6 +523,7 @@ void EclipseIO::writeTimeStep(int report_step,
     */
     if(!isSubstep && restart.getWriteRestartFile(report_step))
     {
+        LoadReport::Timer timer( this->impl->report, "Restart" );
         std::string filename = ERT::EclFilename( this->impl->outputDir,
                                                  this->impl->baseName,
                                                  ioConfig.getUNIFOUT() ? ECL_UNIFIED_RESTART_FILE : ECL_RESTART_FILE,
@@ -475,6 +544,7 @@ void EclipseIO::writeTimeStep(int report_step,
         std::vector<const Well*> sched_wells = this->impl->schedule.getWells( report_step );
         const auto rft_active = [report_step] (const Well* w) { return w->getRFTActive( report_step ) || w->getPLTActive( report_step ); };
         if (std::any_of(sched_wells.begin(), sched_wells.end(), rft_active)) {
+            LoadReport::Timer timer( this->impl->report, "RFT" );
             this->impl->rft.writeTimeStep( sched_wells,
                                            grid,
                                            report_step,
@@ -503,6 +573,10 @@ RestartValue EclipseIO::loadRestart(const std::vector<RestartKey>& solution_keys
     return RestartIO::load( filename , report_step , solution_keys , es, grid , schedule, extra_keys);
 }
 
+void EclipseIO::setLoadReport(LoadReport* report) {
+    this->impl->report = report;
+}
+
 EclipseIO::EclipseIO( const EclipseState& es,
                       EclipseGrid grid,
                       const Schedule& schedule,
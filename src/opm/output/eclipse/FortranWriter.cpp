@@ -0,0 +1,498 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/output/eclipse/FortranWriter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace Opm { namespace out {
+
+namespace {
+
+    /*
+      The values are stored byte by byte, which gives big-endian output
+      on any host; compilers turn this into a byte swapping store.
+    */
+    inline void store(unsigned char* p, std::uint32_t v) {
+        p[0] = static_cast<unsigned char>(v >> 24);
+        p[1] = static_cast<unsigned char>(v >> 16);
+        p[2] = static_cast<unsigned char>(v >> 8);
+        p[3] = static_cast<unsigned char>(v);
+    }
+
+    inline void store(unsigned char* p, std::uint64_t v) {
+        store(p, static_cast<std::uint32_t>(v >> 32));
+        store(p + 4, static_cast<std::uint32_t>(v));
+    }
+
+    inline void store(unsigned char* p, int v) {
+        store(p, static_cast<std::uint32_t>(v));
+    }
+
+    inline void store(unsigned char* p, float v) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &v, sizeof bits);
+        store(p, bits);
+    }
+
+    inline void store(unsigned char* p, double v) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof bits);
+        store(p, bits);
+    }
+
+    std::int32_t recordSize(std::size_t bytes) {
+        if (bytes > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+            throw std::invalid_argument("Fortran record of " + std::to_string(bytes) + " bytes is too large");
+
+        return static_cast<std::int32_t>(bytes);
+    }
+
+
+    template <typename Out>
+    std::size_t encodeRecord(unsigned char* p, const Out* values, std::size_t n) {
+        const std::int32_t bytes = recordSize(n * sizeof(Out));
+
+        store(p, bytes);
+        p += 4;
+        for (std::size_t i = 0; i < n; i++, p += sizeof(Out))
+            store(p, values[i]);
+        store(p, bytes);
+
+        return 8 + n * sizeof(Out);
+    }
+
+
+    /*
+      Layout of the formatted files: the number of values on one line and
+      the maximum width of one value.
+    */
+    template <typename Out> struct Text;
+
+    template <> struct Text<int> {
+        static const std::size_t columns = 6;
+        static const std::size_t width = 12;        // " %11d"
+    };
+
+    template <> struct Text<float> {
+        static const std::size_t columns = 4;
+        static const std::size_t width = 18;        // "  -0.ddddddddE+XXX"
+    };
+
+    template <> struct Text<double> {
+        static const std::size_t columns = 3;
+        static const std::size_t width = 24;        // "  -0.ddddddddddddddD+XXX"
+    };
+
+
+    template <typename Out>
+    std::size_t maxRecordChars() {
+        const std::size_t lines = (FortranWriter::block_size + Text<Out>::columns - 1) / Text<Out>::columns;
+        return FortranWriter::block_size * Text<Out>::width + lines;
+    }
+
+
+    const double powers_of_ten[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const double negative_powers_of_ten[] = {
+        1e-0,  1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8,  1e-9,  1e-10, 1e-11,
+        1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18, 1e-19, 1e-20, 1e-21, 1e-22
+    };
+
+    const int max_table_power = 22;
+
+
+    /*
+      The same value as std::pow(10.0, k), which is exact for 0 <= k <= 22
+      and correctly rounded otherwise.
+    */
+    double powerOfTen(int k) {
+        if (k >= 0 && k <= max_table_power)
+            return powers_of_ten[k];
+
+        if (k < 0 && k >= -max_table_power)
+            return negative_powers_of_ten[-k];
+
+        return std::pow(10.0, k);
+    }
+
+
+    /*
+      The value x * 10^digits rounded to an integer like printf() does it,
+      i.e. from the exact binary value of x with ties to even. The product
+      is split in a rounded part and the exact rounding error, so the
+      rounding can be decided without any loss of precision.
+    */
+    std::uint64_t roundScaled(double x, int digits) {
+        const double scale = powers_of_ten[digits];
+        const double product = x * scale;
+        const double error = std::fma(x, scale, -product);
+
+        const double whole = std::floor(product);
+        const double half = (product - whole) - 0.5;
+        auto n = static_cast<std::uint64_t>(whole);
+
+        if (half > -error || (half == -error && (n & 1) == 1))
+            n += 1;
+
+        return n;
+    }
+
+
+    char* writeDigits(char* p, std::uint64_t value, std::size_t count) {
+        for (std::size_t i = count; i > 0; i--) {
+            p[i - 1] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        return p + count;
+    }
+
+
+    /*
+      Write x as 0.ddddE+XX with the given number of digits, with the
+      same result as the __fprintf_scientific() function of libecl: the
+      exponent is ceil(log10(|x|)), the mantissa x / 10^exponent is
+      rounded by the rules of printf() - also when that gives 1.0000 - and
+      zero is written as 0.0000E+00.
+    */
+    template <int digits>
+    char* writeScientific(char* p, double x, char exponent_char) {
+        *p++ = ' ';
+        *p++ = ' ';
+
+        if (!std::isfinite(x)) {
+            const char* text = std::isnan(x) ? "nan" : (x < 0 ? "-inf" : "inf");
+            const std::size_t length = std::strlen(text);
+            p = static_cast<char*>(std::memset(p, ' ', digits + 3 - length)) + digits + 3 - length;
+            p = static_cast<char*>(std::memcpy(p, text, length)) + length;
+            *p++ = exponent_char;
+            *p++ = '+';
+            *p++ = '0';
+            *p++ = '0';
+            return p;
+        }
+
+        std::uint64_t mantissa = 0;
+        int exponent = 0;
+        if (x != 0) {
+            exponent = static_cast<int>(std::ceil(std::log10(std::fabs(x))));
+            double arg = std::fabs(x) / powerOfTen(exponent);
+            if (arg == 1.0) {
+                arg *= 0.10;
+                exponent += 1;
+            }
+            mantissa = roundScaled(arg, digits);
+        }
+
+        const std::uint64_t scale = static_cast<std::uint64_t>(powers_of_ten[digits]);
+        *p++ = (x < 0) ? '-' : ' ';
+        *p++ = static_cast<char>('0' + mantissa / scale);
+        *p++ = '.';
+        p = writeDigits(p, mantissa % scale, digits);
+
+        *p++ = exponent_char;
+        *p++ = exponent < 0 ? '-' : '+';
+        const unsigned int abs_exponent = static_cast<unsigned int>(exponent < 0 ? -exponent : exponent);
+        return writeDigits(p, abs_exponent, abs_exponent < 100 ? 2 : 3);
+    }
+
+
+    char* writeText(char* p, int value) {
+        char digits[11];
+        std::uint32_t magnitude = value < 0 ? 0u - static_cast<std::uint32_t>(value) : static_cast<std::uint32_t>(value);
+        std::size_t count = 0;
+        do {
+            digits[10 - count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+
+        if (value < 0)
+            digits[10 - count++] = '-';
+
+        p = static_cast<char*>(std::memset(p, ' ', 12 - count)) + 12 - count;
+        return static_cast<char*>(std::memcpy(p, digits + 11 - count, count)) + count;
+    }
+
+
+    char* writeText(char* p, float value) {
+        return writeScientific<8>(p, value, 'E');
+    }
+
+
+    char* writeText(char* p, double value) {
+        return writeScientific<14>(p, value, 'D');
+    }
+
+
+    template <typename Out>
+    std::size_t formatRecord(unsigned char* data, const Out* values, std::size_t n) {
+        char* p = reinterpret_cast<char*>(data);
+        for (std::size_t i = 0; i < n; i++) {
+            p = writeText(p, values[i]);
+            if (i % Text<Out>::columns == Text<Out>::columns - 1 || i == n - 1)
+                *p++ = '\n';
+        }
+        return p - reinterpret_cast<char*>(data);
+    }
+
+}
+
+
+    FortranWriter::Conversion::Conversion() :
+        Conversion(1.0, 0.0)
+    {}
+
+
+    FortranWriter::Conversion::Conversion(double scale_arg, double offset_arg) :
+        scale(scale_arg),
+        offset(offset_arg)
+    {}
+
+
+    FortranWriter::Conversion::Conversion(const UnitSystem& units_arg, UnitSystem::measure m) :
+        scale(units_arg.from_si(m, 1.0) - units_arg.from_si(m, 0.0)),
+        offset(units_arg.from_si(m, 0.0)),
+        units(&units_arg),
+        measure(m)
+    {}
+
+
+    const std::size_t FortranWriter::block_size;
+
+
+    FortranWriter::FortranWriter(std::FILE* stream_arg, std::size_t batch_records_arg) :
+        FortranWriter(stream_arg, Format::Unformatted, batch_records_arg)
+    {}
+
+
+    FortranWriter::FortranWriter(std::FILE* stream_arg, Format format_arg, std::size_t batch_records_arg) :
+        stream(stream_arg),
+        format(format_arg),
+        batch_records(std::max<std::size_t>(1, batch_records_arg))
+    {
+        if (!this->stream)
+            throw std::invalid_argument("FortranWriter needs an open stream");
+    }
+
+
+    void FortranWriter::writeBuffer(std::size_t size) {
+        if (std::fwrite(this->buffer.data(), 1, size, this->stream) != size)
+            throw std::runtime_error("Writing Fortran records failed");
+
+        this->bytes_written += size;
+    }
+
+
+    void FortranWriter::writeHeader(const std::string& keyword, const char* type, std::size_t size) {
+        if (keyword.size() > 8)
+            throw std::invalid_argument("Keyword '" + keyword + "' is longer than eight characters");
+
+        if (size > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+            throw std::invalid_argument("Keyword '" + keyword + "' has too many elements");
+
+        if (this->format == Format::Formatted) {
+            char header[64];
+            const int length = std::snprintf(header, sizeof header, " '%-8s' %11d '%-4s'\n",
+                                             keyword.c_str(), static_cast<int>(size), type);
+            this->buffer.assign(header, header + length);
+            this->writeBuffer(length);
+            return;
+        }
+
+        this->buffer.resize(24);
+        auto* p = this->buffer.data();
+
+        store(p, 16);
+        std::memset(p + 4, ' ', 8);
+        std::memcpy(p + 4, keyword.data(), keyword.size());
+        store(p + 12, static_cast<int>(size));
+        std::memcpy(p + 16, type, 4);
+        store(p + 20, 16);
+
+        this->writeBuffer(24);
+    }
+
+
+    /*
+      The fill(first, last, values) functor puts the output values of
+      elements [first, last) in values; the records of a batch are filled
+      and encoded independently of each other. Every record is encoded in
+      its own slot of the buffer, and the formatted records, which are
+      shorter than the slot, are moved together before the batch is
+      written.
+    */
+    template <typename Out, typename Fill>
+    void FortranWriter::writeData(const std::string& keyword, const char* type, std::size_t size, Fill fill) {
+        this->writeHeader(keyword, type, size);
+        if (size == 0)
+            return;
+
+        const bool formatted = (this->format == Format::Formatted);
+        const std::size_t record_bytes = formatted ? maxRecordChars<Out>() : 8 + block_size * sizeof(Out);
+        const std::size_t num_records = (size + block_size - 1) / block_size;
+        std::vector<std::size_t> lengths(std::min(num_records, this->batch_records));
+
+        for (std::size_t batch_first = 0; batch_first < num_records; batch_first += this->batch_records) {
+            const std::size_t batch_last = std::min(num_records, batch_first + this->batch_records);
+            const std::ptrdiff_t batch_size = batch_last - batch_first;
+
+            this->buffer.resize(batch_size * record_bytes);
+            auto* data = this->buffer.data();
+            auto* length = lengths.data();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (batch_size * block_size > 16384)
+#endif
+            for (std::ptrdiff_t r = 0; r < batch_size; r++) {
+                const std::size_t first = (batch_first + r) * block_size;
+                const std::size_t last = std::min(size, first + block_size);
+
+                Out values[block_size];
+                fill(first, last, values);
+
+                auto* p = data + r * record_bytes;
+                length[r] = formatted
+                    ? formatRecord(p, values, last - first)
+                    : encodeRecord(p, values, last - first);
+            }
+
+            std::size_t end = 0;
+            for (std::ptrdiff_t r = 0; r < batch_size; r++) {
+                if (end != r * record_bytes)
+                    std::memmove(data + end, data + r * record_bytes, length[r]);
+                end += length[r];
+            }
+            this->writeBuffer(end);
+        }
+    }
+
+
+    void FortranWriter::write(const std::string& keyword, const std::vector<int>& data) {
+        this->writeData<int>(keyword, "INTE", data.size(),
+                             [&data](std::size_t first, std::size_t last, int* values) {
+                                 std::copy(data.begin() + first, data.begin() + last, values);
+                             });
+    }
+
+
+    void FortranWriter::write(const std::string& keyword, const std::vector<float>& data) {
+        this->writeData<float>(keyword, "REAL", data.size(),
+                               [&data](std::size_t first, std::size_t last, float* values) {
+                                   std::copy(data.begin() + first, data.begin() + last, values);
+                               });
+    }
+
+
+    void FortranWriter::write(const std::string& keyword,
+                              const std::vector<double>& data,
+                              bool double_precision,
+                              const Conversion& conversion) {
+        const Conversion convert = conversion;
+        const double* src = data.data();
+
+        if (double_precision)
+            this->writeData<double>(keyword, "DOUB", data.size(),
+                                    [=](std::size_t first, std::size_t last, double* values) {
+                                        for (std::size_t i = first; i < last; i++)
+                                            values[i - first] = convert(src[i]);
+                                    });
+        else
+            this->writeData<float>(keyword, "REAL", data.size(),
+                                   [=](std::size_t first, std::size_t last, float* values) {
+                                       for (std::size_t i = first; i < last; i++)
+                                           values[i - first] = static_cast<float>(convert(src[i]));
+                                   });
+    }
+
+
+    void FortranWriter::writeMessage(const std::string& keyword) {
+        this->writeHeader(keyword, "MESS", 0);
+    }
+
+
+    void FortranWriter::writeCells(const std::string& keyword,
+                                   const std::vector<int>& data,
+                                   const std::vector<int>& cells) {
+        const int* src = data.data();
+        const int* index = cells.data();
+
+        this->writeData<int>(keyword, "INTE", cells.size(),
+                             [=](std::size_t first, std::size_t last, int* values) {
+                                 for (std::size_t i = first; i < last; i++)
+                                     values[i - first] = src[index[i]];
+                             });
+    }
+
+
+    void FortranWriter::writeCells(const std::string& keyword,
+                                   const std::vector<double>& data,
+                                   const std::vector<int>& cells,
+                                   bool double_precision,
+                                   const Conversion& conversion) {
+        const Conversion convert = conversion;
+        const double* src = data.data();
+        const int* index = cells.data();
+
+        if (double_precision)
+            this->writeData<double>(keyword, "DOUB", cells.size(),
+                                    [=](std::size_t first, std::size_t last, double* values) {
+                                        for (std::size_t i = first; i < last; i++)
+                                            values[i - first] = convert(src[index[i]]);
+                                    });
+        else
+            this->writeData<float>(keyword, "REAL", cells.size(),
+                                   [=](std::size_t first, std::size_t last, float* values) {
+                                       for (std::size_t i = first; i < last; i++)
+                                           values[i - first] = static_cast<float>(convert(src[index[i]]));
+                                   });
+    }
+
+
+    void FortranWriter::writeMasked(const std::string& keyword,
+                                    const std::vector<double>& data,
+                                    const std::vector<int>& cells,
+                                    const Conversion& conversion) {
+        const Conversion convert = conversion;
+        const double* src = data.data();
+
+        this->writeData<float>(keyword, "REAL", data.size(),
+                               [=, &cells](std::size_t first, std::size_t last, float* values) {
+                                   std::fill(values, values + (last - first), 0.0f);
+
+                                   auto cell = std::lower_bound(cells.begin(), cells.end(), static_cast<int>(first));
+                                   for (; cell != cells.end() && static_cast<std::size_t>(*cell) < last; ++cell)
+                                       values[*cell - first] = static_cast<float>(convert(src[*cell]));
+                               });
+    }
+
+
+    std::size_t FortranWriter::bytesWritten() const {
+        return this->bytes_written;
+    }
+
+}
+}
@@ -23,6 +23,7 @@
 
 #include <opm/output/eclipse/RestartIO.hpp>
 
+#include <opm/output/eclipse/LazyRestartValue.hpp>
 #include <opm/output/eclipse/RestartValue.hpp>
 
 #include <opm/output/eclipse/VectorItems/connection.hpp>
@@ -41,6 +42,7 @@
 #include <cmath>
 #include <cstddef>
 #include <exception>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -212,6 +214,55 @@ namespace {
         return sol;
     }
 
+    // Affine map from the unit system of the restart file to SI,
+    // to_si(x) = scale*x + offset, evaluated once per vector rather than
+    // once per element.
+    struct SIConversion
+    {
+        SIConversion(const Opm::UnitSystem&           usys,
+                     const Opm::UnitSystem::measure   dim)
+            : offset(usys.to_si(dim, 0.0))
+            , scale (usys.to_si(dim, 1.0) - offset)
+        {}
+
+        double offset;
+        double scale;
+    };
+
+    template <typename T>
+    void convertFullVector(const T*            src,
+                           const std::size_t   n,
+                           const SIConversion& conv,
+                           double*             dst)
+    {
+        const auto scale  = conv.scale;
+        const auto offset = conv.offset;
+
+        // Restart vectors are one value per active cell; only fan out to
+        // multiple threads for grids large enough to amortize the cost.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (n > 100000)
+#endif
+        for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(n); ++i) {
+            dst[i] = scale*static_cast<double>(src[i]) + offset;
+        }
+    }
+
+    template <typename T>
+    void convertSubset(const T*                src,
+                       const std::vector<int>& cells,
+                       const SIConversion&     conv,
+                       double*                 dst)
+    {
+        const auto scale  = conv.scale;
+        const auto offset = conv.offset;
+        const auto n      = cells.size();
+
+        for (auto i = 0*n; i < n; ++i) {
+            dst[i] = scale*static_cast<double>(src[cells[i]]) + offset;
+        }
+    }
+
     void restoreExtra(const RestartFileView&              rst_view,
                       const std::vector<Opm::RestartKey>& extra_keys,
                       const Opm::UnitSystem&              usys,
@@ -646,3 +697,301 @@ namespace Opm { namespace RestartIO  {
         return rst_value;
     }
 }} // Opm::RestartIO
+
+namespace Opm { namespace RestartIO {
+
+    class LazyRestartValue::Impl
+    {
+    public:
+        explicit Impl(const std::string&             filename,
+                      const int                      report_step,
+                      const std::vector<RestartKey>& solution_keys,
+                      const EclipseState&            es,
+                      const EclipseGrid&             grid,
+                      const Schedule&                schedule);
+
+        bool has(const std::string& key) const
+        {
+            return this->index_.find(key) != this->index_.end();
+        }
+
+        std::vector<std::string> keys() const;
+
+        bool loaded(const std::string& key) const
+        {
+            return this->field(key).decoded;
+        }
+
+        const std::vector<double>& data(const std::string& key);
+
+        std::vector<double>
+        data(const std::string&      key,
+             const std::vector<int>& active_cells) const;
+
+        const data::Wells& wells();
+
+        RestartValue toRestartValue();
+
+    private:
+        struct Field
+        {
+            RestartKey          key;
+            bool                decoded;
+            std::vector<double> values;
+        };
+
+        RestartFileView     rst_view_;
+        const EclipseState& es_;
+        const EclipseGrid&  grid_;
+        const Schedule&     schedule_;
+        std::size_t         numcells_;
+
+        std::vector<Field>                           fields_;
+        std::unordered_map<std::string, std::size_t> index_;
+
+        bool        wells_loaded_ = false;
+        data::Wells wells_;
+
+        const Field& field(const std::string& key) const;
+        Field& field(const std::string& key);
+
+        const ecl_kw_type* keyword(const Field& f) const;
+    };
+
+    LazyRestartValue::Impl::Impl(const std::string&             filename,
+                                 const int                      report_step,
+                                 const std::vector<RestartKey>& solution_keys,
+                                 const EclipseState&            es,
+                                 const EclipseGrid&             grid,
+                                 const Schedule&                schedule)
+        : rst_view_(filename, report_step)
+        , es_      (es)
+        , grid_    (grid)
+        , schedule_(schedule)
+        , numcells_(grid.getNumActive())
+    {
+        for (const auto& value : solution_keys) {
+            const auto& vector = value.key;
+
+            if (! ecl_file_view_has_kw(this->rst_view_, vector.c_str())) {
+                throwIfMissingRequired(value);
+
+                // Requested vector not available, but caller does not
+                // actually require the vector for restart purposes.
+                // Skip this.
+                continue;
+            }
+
+            // Consult keyword header only.  Array data is not loaded
+            // until the vector is requested.
+            const auto* file_kw =
+                ecl_file_view_iget_named_file_kw(this->rst_view_, vector.c_str(), 0);
+
+            if (ecl_file_kw_get_size(file_kw) != static_cast<int>(this->numcells_)) {
+                throw std::runtime_error {
+                    "Restart file: Could not restore "
+                    + std::string(ecl_file_kw_get_header(file_kw))
+                    + ", mismatched number of cells"
+                };
+            }
+
+            if (this->has(vector)) {
+                continue;
+            }
+
+            this->index_.emplace(vector, this->fields_.size());
+            this->fields_.push_back(Field{ value, false, {} });
+        }
+    }
+
+    std::vector<std::string> LazyRestartValue::Impl::keys() const
+    {
+        auto names = std::vector<std::string>{};
+        names.reserve(this->fields_.size());
+
+        for (const auto& f : this->fields_) {
+            names.push_back(f.key.key);
+        }
+
+        return names;
+    }
+
+    const std::vector<double>&
+    LazyRestartValue::Impl::data(const std::string& key)
+    {
+        auto& f = this->field(key);
+
+        if (f.decoded) {
+            return f.values;
+        }
+
+        const auto* kw   = this->keyword(f);
+        const auto  conv = SIConversion{ this->es_.getUnits(), f.key.dim };
+
+        f.values.resize(this->numcells_);
+
+        if (ecl_type_get_type(ecl_kw_get_data_type(kw)) == ECL_DOUBLE_TYPE) {
+            convertFullVector(ecl_kw_get_type_ptr<double>(kw, ECL_DOUBLE_TYPE),
+                              this->numcells_, conv, f.values.data());
+        }
+        else {
+            convertFullVector(ecl_kw_get_type_ptr<float>(kw, ECL_FLOAT_TYPE),
+                              this->numcells_, conv, f.values.data());
+        }
+
+        f.decoded = true;
+
+        return f.values;
+    }
+
+    std::vector<double>
+    LazyRestartValue::Impl::data(const std::string&      key,
+                                 const std::vector<int>& active_cells) const
+    {
+        const auto& f = this->field(key);
+
+        for (const auto& cell : active_cells) {
+            if ((cell < 0) || (static_cast<std::size_t>(cell) >= this->numcells_)) {
+                throw std::out_of_range {
+                    "Active cell index " + std::to_string(cell)
+                    + " out of range for restart vector '" + key + "'"
+                };
+            }
+        }
+
+        auto values = std::vector<double>(active_cells.size());
+
+        if (f.decoded) {
+            std::transform(active_cells.begin(), active_cells.end(),
+                           values.begin(),
+                           [&f](const int cell) { return f.values[cell]; });
+
+            return values;
+        }
+
+        const auto* kw   = this->keyword(f);
+        const auto  conv = SIConversion{ this->es_.getUnits(), f.key.dim };
+
+        if (ecl_type_get_type(ecl_kw_get_data_type(kw)) == ECL_DOUBLE_TYPE) {
+            convertSubset(ecl_kw_get_type_ptr<double>(kw, ECL_DOUBLE_TYPE),
+                          active_cells, conv, values.data());
+        }
+        else {
+            convertSubset(ecl_kw_get_type_ptr<float>(kw, ECL_FLOAT_TYPE),
+                          active_cells, conv, values.data());
+        }
+
+        return values;
+    }
+
+    const data::Wells& LazyRestartValue::Impl::wells()
+    {
+        if (! this->wells_loaded_) {
+            this->wells_ = ecl_file_view_has_kw(this->rst_view_, "OPM_XWEL")
+                ? restore_wells_opm(this->rst_view_, this->es_, this->grid_, this->schedule_)
+                : restore_wells_ecl(this->rst_view_, this->es_, this->grid_, this->schedule_);
+
+            this->wells_loaded_ = true;
+        }
+
+        return this->wells_;
+    }
+
+    RestartValue LazyRestartValue::Impl::toRestartValue()
+    {
+        data::Solution sol(/* init_si = */ true);
+
+        for (const auto& f : this->fields_) {
+            sol.insert(f.key.key, f.key.dim, this->data(f.key.key),
+                       data::TargetType::RESTART_SOLUTION);
+        }
+
+        return RestartValue{ std::move(sol), this->wells() };
+    }
+
+    const LazyRestartValue::Impl::Field&
+    LazyRestartValue::Impl::field(const std::string& key) const
+    {
+        auto pos = this->index_.find(key);
+
+        if (pos == this->index_.end()) {
+            throw std::invalid_argument {
+                "Restart vector '" + key + "' is not available"
+            };
+        }
+
+        return this->fields_[pos->second];
+    }
+
+    LazyRestartValue::Impl::Field&
+    LazyRestartValue::Impl::field(const std::string& key)
+    {
+        const auto& f = static_cast<const Impl&>(*this).field(key);
+
+        return this->fields_[&f - this->fields_.data()];
+    }
+
+    const ecl_kw_type*
+    LazyRestartValue::Impl::keyword(const Field& f) const
+    {
+        // Loads (and endian converts) the array data on first use.
+        return this->rst_view_.getKeyword(f.key.key.c_str());
+    }
+
+    // =================================================================
+
+    LazyRestartValue::LazyRestartValue(const std::string&             filename,
+                                       int                            report_step,
+                                       const std::vector<RestartKey>& solution_keys,
+                                       const EclipseState&            es,
+                                       const EclipseGrid&             grid,
+                                       const Schedule&                schedule)
+        : pImpl_(new Impl(filename, report_step, solution_keys,
+                          es, grid, schedule))
+    {}
+
+    LazyRestartValue::~LazyRestartValue() = default;
+
+    LazyRestartValue::LazyRestartValue(LazyRestartValue&& rhs) = default;
+
+    LazyRestartValue&
+    LazyRestartValue::operator=(LazyRestartValue&& rhs) = default;
+
+    bool LazyRestartValue::has(const std::string& key) const
+    {
+        return this->pImpl_->has(key);
+    }
+
+    std::vector<std::string> LazyRestartValue::keys() const
+    {
+        return this->pImpl_->keys();
+    }
+
+    bool LazyRestartValue::loaded(const std::string& key) const
+    {
+        return this->pImpl_->loaded(key);
+    }
+
+    const std::vector<double>&
+    LazyRestartValue::data(const std::string& key) const
+    {
+        return this->pImpl_->data(key);
+    }
+
+    std::vector<double>
+    LazyRestartValue::data(const std::string&      key,
+                           const std::vector<int>& active_cells) const
+    {
+        return this->pImpl_->data(key, active_cells);
+    }
+
+    const data::Wells& LazyRestartValue::wells() const
+    {
+        return this->pImpl_->wells();
+    }
+
+    RestartValue LazyRestartValue::toRestartValue() const
+    {
+        return this->pImpl_->toRestartValue();
+    }
+}} // Opm::RestartIO
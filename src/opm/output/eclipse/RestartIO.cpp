@@ -28,6 +28,7 @@
 #include <opm/output/eclipse/AggregateWellData.hpp>
 #include <opm/output/eclipse/AggregateConnectionData.hpp>
 #include <opm/output/eclipse/AggregateMSWData.hpp>
+#include <opm/output/eclipse/FortranWriter.hpp>
 #include <opm/output/eclipse/WriteRestartHelpers.hpp>
 
 #include <opm/output/eclipse/libECLRestart.hpp>
@@ -138,15 +139,8 @@ namespace {
 
                 const auto active_index = grid.activeIndex(i, j, k);
 
-                const auto& connection =
-                    std::find_if(well.connections.begin(),
-                                 well.connections.end(),
-                        [active_index](const data::Connection& c)
-                    {
-                        return c.index == active_index;
-                    });
-
-                if (connection == well.connections.end()) {
+                const auto* connection = well.find_connection(active_index);
+                if (connection == nullptr) {
                     xwel.insert( xwel.end(), rs_size, 0.0 );
                     continue;
                 }
@@ -218,38 +212,6 @@ namespace {
         return rst_file;
     }
 
-    ert_unique_ptr<ecl_kw_type, ecl_kw_free>
-    make_ecl_kw_pointer(const std::string&         kw,
-                        const std::vector<double>& data,
-                        const bool                 write_double)
-    {
-        auto kw_ptr = Opm::RestartIO::
-            ert_unique_ptr< ::Opm::RestartIO::ecl_kw_type, ecl_kw_free>{};
-
-        if (write_double) {
-            ::Opm::RestartIO::ecl_kw_type* ecl_kw =
-                ::Opm::RestartIO::ecl_kw_alloc(kw.c_str(), data.size(), ECL_DOUBLE);
-
-            ::Opm::RestartIO::ecl_kw_set_memcpy_data(ecl_kw , data.data());
-
-            kw_ptr.reset(ecl_kw);
-        }
-        else {
-            ::Opm::RestartIO::ecl_kw_type* ecl_kw = ::Opm::RestartIO::
-                ecl_kw_alloc(kw.c_str(), data.size(), ECL_FLOAT);
-
-            float* float_data = ecl_kw_get_type_ptr<float>(ecl_kw, ECL_FLOAT_TYPE);
-
-            for (auto n = data.size(), i = 0*n; i < n; ++i) {
-                float_data[i] = static_cast<float>(data[i]);
-            }
-
-            kw_ptr.reset(ecl_kw);
-        }
-
-        return kw_ptr;
-    }
-
     template <typename T>
     void write_kw(::Opm::RestartIO::ecl_rst_file_type* rst_file,
                   const std::string&                   keyword,
@@ -379,6 +341,15 @@ namespace {
         write_kw(rst_file, "XCON", connectionData.getXConn());
     }
 
+    out::FortranWriter fortranWriter(::Opm::RestartIO::ecl_rst_file_type* rst_file)
+    {
+        const auto format = rst_file->fmt_file
+            ? out::FortranWriter::Format::Formatted
+            : out::FortranWriter::Format::Unformatted;
+
+        return out::FortranWriter(fortio_get_FILE(rst_file->fortio), format);
+    }
+
     void writeSolution(ecl_rst_file_type*  rst_file,
                        const RestartValue& value,
                        const bool                ecl_compatible_rst,
@@ -386,21 +357,16 @@ namespace {
     {
         ecl_rst_file_start_solution(rst_file);
 
-        auto write = [rst_file]
-            (const std::string&         key,
-             const std::vector<double>& data,
-             const bool                 write_double) -> void
-        {
-            auto kw = make_ecl_kw_pointer(key, data, write_double);
-            ::Opm::RestartIO::ecl_rst_file_add_kw(rst_file, kw.get());
-        };
+        // The solution vectors are written straight to the file, without
+        // the copies made by an intermediate ecl_kw.
+        auto writer = fortranWriter(rst_file);
 
         for (const auto& elm : value.solution) {
 	  if (ecl_compatible_rst && (elm.first == "TEMP")) continue;
 
             if (elm.second.target == data::TargetType::RESTART_SOLUTION)
             {
-                write(elm.first, elm.second.data, write_double_arg);
+                writer.write(elm.first, elm.second.data, write_double_arg);
             }
         }
 
@@ -409,7 +375,7 @@ namespace {
             if (extraInSolution(key)) {
                 // Observe that the extra data is unconditionally
                 // output as double precision.
-                write(key, elm.second, true);
+                writer.write(key, elm.second, true);
             }
         }
 
@@ -419,7 +385,7 @@ namespace {
 
         for (const auto& elm : value.solution) {
             if (elm.second.target == data::TargetType::RESTART_AUXILIARY) {
-                write(elm.first, elm.second.data, write_double_arg);
+                writer.write(elm.first, elm.second.data, write_double_arg);
             }
         }
     }
@@ -430,12 +396,11 @@ namespace {
         for (const auto& extra_value : extra_data) {
             const std::string& key = extra_value.first.key;
             const std::vector<double>& data = extra_value.second;
-            if (! extraInSolution(key)) {
-                ecl_kw_type * ecl_kw = ecl_kw_alloc_new_shared( key.c_str() , data.size() , ECL_DOUBLE , const_cast<double *>(data.data()));
-                ecl_rst_file_add_kw( rst_file , ecl_kw);
-                ecl_kw_free( ecl_kw );
-            }
+            if (extraInSolution(key))
+                continue;
 
+            auto writer = fortranWriter(rst_file);
+            writer.write(key, data, true);
         }
     }
 
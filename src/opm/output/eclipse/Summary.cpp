@@ -40,6 +40,7 @@
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
+#include <opm/output/data/Solution.hpp>
 #include <opm/output/eclipse/Summary.hpp>
 #include <opm/output/eclipse/RegionCache.hpp>
 
@@ -294,7 +295,7 @@ struct fn_args {
     const data::Wells& wells;
     const out::RegionCache& regionCache;
     const EclipseGrid& grid;
-    const std::vector< std::pair< std::string, double > > eff_factors;
+    const std::vector< std::pair< std::string, double > >& eff_factors;
 };
 
 /* Since there are several enums in opm scattered about more-or-less
@@ -344,7 +345,7 @@ measure rate_unit< rt::well_potential_gas >() { return measure::gas_surface_rate
 
 double efac( const std::vector<std::pair<std::string,double>>& eff_factors, const std::string& name ) {
     auto it = std::find_if( eff_factors.begin(), eff_factors.end(),
-                            [&] ( const std::pair< std::string, double > elem )
+                            [&] ( const std::pair< std::string, double >& elem )
                             { return elem.first == name; }
                           );
 
@@ -357,7 +358,8 @@ inline quantity rate( const fn_args& args ) {
 
     for( const auto* sched_well : args.schedule_wells ) {
         const auto& name = sched_well->name();
-        if( args.wells.count( name ) == 0 ) continue;
+        const auto well_itr = args.wells.find( name );
+        if( well_itr == args.wells.end() ) continue;
 
         double eff_fac = efac( args.eff_factors, name );
 
@@ -365,7 +367,7 @@ inline quantity rate( const fn_args& args ) {
                              ? sched_well->getPolymerProperties( args.sim_step ).m_polymerConcentration
                              : 1;
 
-        const auto v = args.wells.at(name).rates.get(phase, 0.0) * eff_fac * concentration;
+        const auto v = well_itr->second.rates.get(phase, 0.0) * eff_fac * concentration;
 
         if( ( v > 0 ) == injection )
             sum += v;
@@ -383,9 +385,10 @@ inline quantity flowing( const fn_args& args ) {
     const auto ts = args.sim_step;
     auto pred = [&wells,ts]( const Well* w ) {
         const auto& name = w->name();
-        return w->isInjector( ts ) == injection
-            && wells.count( name ) > 0
-            && wells.at( name ).flowing();
+        if( w->isInjector( ts ) != injection ) return false;
+
+        const auto well_itr = wells.find( name );
+        return well_itr != wells.end() && well_itr->second.flowing();
     };
 
     return { double( std::count_if( args.schedule_wells.begin(),
@@ -406,16 +409,12 @@ inline quantity crate( const fn_args& args ) {
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well->name();
-    if( args.wells.count( name ) == 0 ) return zero;
-
-    const auto& well_data = args.wells.at( name );
-    const auto& completion = std::find_if( well_data.connections.begin(),
-                                           well_data.connections.end(),
-                                           [=]( const data::Connection& c ) {
-                                                return c.index == global_index;
-                                           } );
+    const auto well_itr = args.wells.find( name );
+    if( well_itr == args.wells.end() ) return zero;
 
-    if( completion == well_data.connections.end() ) return zero;
+    const auto& well_data = well_itr->second;
+    const auto* completion = well_data.find_connection( global_index );
+    if( completion == nullptr ) return zero;
 
     double eff_fac = efac( args.eff_factors, name );
     double concentration = polymer
@@ -442,9 +441,10 @@ inline quantity srate( const fn_args& args ) {
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well->name();
-    if( args.wells.count( name ) == 0 ) return zero;
+    const auto well_itr = args.wells.find( name );
+    if( well_itr == args.wells.end() ) return zero;
 
-    const auto& well_data = args.wells.at( name );
+    const auto& well_data = well_itr->second;
 
     const auto& segment = well_data.segments.find(segNumber);
 
@@ -502,9 +502,10 @@ inline quantity spr ( const fn_args& args ) {
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well->name();
-    if( args.wells.count( name ) == 0 ) return zero;
+    const auto well_itr = args.wells.find( name );
+    if( well_itr == args.wells.end() ) return zero;
 
-    const auto& well_data = args.wells.at( name );
+    const auto& well_data = well_itr->second;
 
     const auto& segment = well_data.segments.find(segNumber);
 
@@ -635,18 +636,38 @@ quantity region_rate( const fn_args& args ) {
     double sum = 0;
     const auto& well_connections = args.regionCache.connections( args.num );
 
-    for (const auto& pair : well_connections) {
+    /*
+      The connections of a well are consecutive in the region cache;
+      look the well and its efficiency factor up once per run.
+    */
+    auto conn = well_connections.begin();
+    while (conn != well_connections.end()) {
+        const auto& name = conn->first;
+        const auto end = std::find_if( conn, well_connections.end(),
+                                       [&name]( const std::pair< std::string, size_t >& c )
+                                       { return c.first != name; } );
+
+        const auto well = args.wells.find( name );
+        if (well == args.wells.end()) {
+            conn = end;
+            continue;
+        }
 
-        double eff_fac = efac( args.eff_factors, pair.first );
+        const double eff_fac = efac( args.eff_factors, name );
+        for (; conn != end; ++conn) {
+            const auto* connection = well->second.find_connection( conn->second );
+            if (connection == nullptr)
+                continue;
 
-        double rate = args.wells.get( pair.first , pair.second , phase ) * eff_fac;
+            double rate = connection->rates.get( phase, 0.0 ) * eff_fac;
 
-        // We are asking for the production rate in an injector - or
-        // opposite. We just clamp to zero.
-        if ((rate > 0) != injection)
-            rate = 0;
+            // We are asking for the production rate in an injector - or
+            // opposite. We just clamp to zero.
+            if ((rate > 0) != injection)
+                rate = 0;
 
-        sum += rate;
+            sum += rate;
+        }
     }
 
     if( injection )
@@ -1033,13 +1054,24 @@ static const std::unordered_map< std::string, UnitSystem::measure> region_units
   {"RWIP"     , UnitSystem::measure::volume }
 };
 
-static const std::unordered_map< std::string, UnitSystem::measure> block_units = {
-  {"BPR"        , UnitSystem::measure::pressure},
-  {"BPRESSUR"   , UnitSystem::measure::pressure},
-  {"BSWAT"      , UnitSystem::measure::identity},
-  {"BWSAT"      , UnitSystem::measure::identity},
-  {"BSGAS"      , UnitSystem::measure::identity},
-  {"BGSAS"      , UnitSystem::measure::identity},
+/*
+  The unit of a block vector, and the solution field it is taken from when
+  the simulator does not pass the value in the block_values argument of
+  add_timestep(). A block vector without a field must be passed by the
+  simulator.
+*/
+struct block_vector {
+    UnitSystem::measure unit;
+    std::string field;
+};
+
+static const std::unordered_map< std::string, block_vector > block_units = {
+  {"BPR"        , { UnitSystem::measure::pressure, "PRESSURE" } },
+  {"BPRESSUR"   , { UnitSystem::measure::pressure, "PRESSURE" } },
+  {"BSWAT"      , { UnitSystem::measure::identity, "SWAT" } },
+  {"BWSAT"      , { UnitSystem::measure::identity, "SWAT" } },
+  {"BSGAS"      , { UnitSystem::measure::identity, "SGAS" } },
+  {"BGSAS"      , { UnitSystem::measure::identity, "SGAS" } },
 };
 
 inline std::vector< const Well* > find_wells( const Schedule& schedule,
@@ -1098,13 +1130,42 @@ class Summary::keyword_handlers {
     public:
         using fn = ofun;
         std::vector< std::pair< const ecl::smspec_node*, fn > > handlers;
-        std::map< std::string, const ecl::smspec_node* > single_value_nodes;
-        std::map< std::pair <std::string, int>, const ecl::smspec_node* > region_nodes;
-        std::map< std::pair <std::string, int>, const ecl::smspec_node* > block_nodes;
+        std::map< std::string, std::size_t > single_value_slots;
+        std::map< std::pair <std::string, int>, std::size_t > region_slots;
+        std::map< std::pair <std::string, int>, std::size_t > block_slots;
+
+        // The block vectors of each solution field: the active index of
+        // the cell and the slot of every vector, gathered in one pass.
+        struct block_gather {
+            UnitSystem::measure unit;
+            std::vector< std::size_t > active_index;
+            std::vector< std::size_t > slot;
+        };
+        std::map< std::string, block_gather > block_plan;
+
+        // Slots in the SummaryState for the handlers, npos for a handler
+        // which duplicates an earlier one, and the slots which are written
+        // to the ecl_sum file.
+        std::vector< std::size_t > handler_slots;
+        std::vector< std::size_t > output_slots;
+
+        // The value of every cumulative total at the previous timestep.
+        std::vector< double > handler_totals;
 
         // Memory management for restart-related summary vectors
         // that are not requested in SUMMARY section.
         std::vector<std::unique_ptr<ecl::smspec_node>> rstvec_backing_store;
+
+        // The schedule wells and efficiency factors of every handler only
+        // depend on the schedule and the report step. They are kept from
+        // one add_timestep() call to the next and only rebuilt when the
+        // step or the schedule object changes, or after schedule_changed(),
+        // so the substeps of a report step do not allocate.
+        const Schedule* scratch_schedule = nullptr;
+        int scratch_step = -1;
+        std::size_t scratch_rebuilds = 0;
+        std::vector< std::vector< const Well* > > handler_wells;
+        std::vector< std::vector< std::pair< std::string, double > > > handler_efac;
 };
 
 Summary::Summary( const EclipseState& st,
@@ -1184,10 +1245,10 @@ Summary::Summary( const EclipseState& st,
                 continue;
             }
             auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), st.getUnits().name( single_value_pair->second ), 0);
-            this->handlers->single_value_nodes.emplace( keyword, nodeptr );
+            this->handlers->single_value_slots.emplace( keyword, this->prev_state.add_key( *nodeptr ) );
         } else if (region_pair != region_units.end()) {
             auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.num(), st.getUnits().name( region_pair->second ), 0);
-            this->handlers->region_nodes.emplace( std::make_pair(keyword, node.num()), nodeptr );
+            this->handlers->region_slots.emplace( std::make_pair(keyword, node.num()), this->prev_state.add_key( *nodeptr ) );
         } else if (block_pair != block_units.end()) {
             if (node.type() != ECL_SMSPEC_BLOCK_VAR)
                 continue;
@@ -1196,8 +1257,18 @@ Summary::Summary( const EclipseState& st,
             if (!this->grid.cellActive(global_index))
                 continue;
 
-            auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.num(), st.getUnits().name( block_pair->second ), 0 );
-            this->handlers->block_nodes.emplace( std::make_pair(keyword, node.num()), nodeptr );
+            const auto& block = block_pair->second;
+            auto* nodeptr = ecl_smspec_add_node( smspec, keyword.c_str(), node.num(), st.getUnits().name( block.unit ), 0 );
+            const auto slot = this->prev_state.add_key( *nodeptr );
+            this->handlers->block_slots.emplace( std::make_pair(keyword, node.num()), slot );
+
+            if (block.field.empty())
+                continue;
+
+            auto& gather = this->handlers->block_plan[ block.field ];
+            gather.unit = block.unit;
+            gather.active_index.push_back( this->grid.activeIndex( global_index ) );
+            gather.slot.push_back( slot );
         } else if (funs_pair != funs.end()) {
             auto node_type = node.type();
 
@@ -1283,10 +1354,28 @@ Summary::Summary( const EclipseState& st,
         }
     }
 
+    std::vector< bool > handled( this->prev_state.num_slots(), false );
     for (const auto& pair : this->handlers->handlers) {
         const auto * nodeptr = pair.first;
+        const auto slot = this->prev_state.add_key(*nodeptr);
+        handled.resize( this->prev_state.num_slots(), false );
+
+        if (handled[slot]) {
+            this->handlers->handler_slots.push_back( SummaryState::npos );
+            continue;
+        }
+
+        handled[slot] = true;
+        this->handlers->handler_slots.push_back( slot );
         if (nodeptr->is_total())
-            this->prev_state.add(*nodeptr, 0);
+            this->prev_state.set(slot, 0);
+    }
+
+    this->handlers->handler_totals.assign( this->handlers->handlers.size(), 0.0 );
+
+    for (std::size_t slot = 0; slot < this->prev_state.num_slots(); slot++) {
+        if (ecl_sum_has_key(this->ecl_sum.get(), this->prev_state.key(slot).c_str()))
+            this->handlers->output_slots.push_back( slot );
     }
 }
 
@@ -1323,7 +1412,27 @@ well_efficiency_factors( const ecl::smspec_node* node,
 
     const bool is_group = (var_type == ECL_SMSPEC_GROUP_VAR);
     const bool is_rate = !node->is_total();
-    const auto &groupTree = schedule.getGroupTree(sim_step);
+    const auto& hierarchy = schedule.getGroupHierarchy(sim_step);
+
+    /*
+      The efficiency factor of every group in the hierarchy is looked up
+      once, the ancestor chain of each well is then a walk over integer
+      indices. Groups in the tree which are not in the schedule end the
+      chain, as does the group of a group rate vector.
+    */
+    const size_t stop_index = (is_group && is_rate && hierarchy.exists(node->get_wgname()))
+        ? hierarchy.index(node->get_wgname())
+        : hierarchy.size();
+    std::vector< double > group_factor( hierarchy.size(), 1.0 );
+    std::vector< bool > in_schedule( hierarchy.size(), false );
+    for( size_t g = 0; g < hierarchy.size(); g++ ) {
+        const auto& name = hierarchy.name( g );
+        if( !schedule.hasGroup( name ) )
+            continue;
+
+        in_schedule[g] = true;
+        group_factor[g] = schedule.getGroup( name ).getGroupEfficiencyFactor( sim_step );
+    }
 
     for( const auto* well : schedule_wells ) {
         double eff_factor = well->getEfficiencyFactor(sim_step);
@@ -1331,19 +1440,15 @@ well_efficiency_factors( const ecl::smspec_node* node,
         if ( !well->hasBeenDefined( sim_step ) )
             continue;
 
-        const auto* group_node = &schedule.getGroup(well->getGroupName(sim_step));
+        const auto& group_name = well->getGroupName(sim_step);
+        if( !schedule.hasGroup( group_name ) )
+            throw std::invalid_argument("No such group: " + group_name);
 
-        while(true){
-            if((   is_group
-                && is_rate
-                && group_node->name() == node->get_wgname() ))
+        for( size_t group_index : hierarchy.ancestors( hierarchy.index( group_name ) ) ) {
+            if( group_index == stop_index || !in_schedule[group_index] )
                 break;
-            eff_factor *= group_node->getGroupEfficiencyFactor( sim_step );
 
-            const auto& parent = groupTree.parent( group_node->name() );
-            if( !schedule.hasGroup( parent ) )
-                break;
-            group_node = &schedule.getGroup( parent );
+            eff_factor *= group_factor[group_index];
         }
         efac.emplace_back( well->name(), eff_factor );
     }
@@ -1359,6 +1464,19 @@ void Summary::add_timestep( int report_step,
                             const std::map<std::string, double>& single_values,
                             const std::map<std::string, std::vector<double>>& region_values,
                             const std::map<std::pair<std::string, int>, double>& block_values) {
+    this->add_timestep( report_step, secs_elapsed, es, schedule, wells, data::Solution{},
+                        single_values, region_values, block_values );
+}
+
+void Summary::eval( int report_step,
+                     double secs_elapsed,
+                     const EclipseState& es,
+                     const Schedule& schedule,
+                     const data::Wells& wells ,
+                     const data::Solution& solution,
+                     const std::map<std::string, double>& single_values,
+                     const std::map<std::string, std::vector<double>>& region_values,
+                     const std::map<std::pair<std::string, int>, double>& block_values) {
 
     if (secs_elapsed < this->prev_time_elapsed) {
         const auto& usys    = es.getUnits();
@@ -1375,9 +1493,23 @@ void Summary::add_timestep( int report_step,
         };
     }
 
-    auto* tstep = ecl_sum_add_tstep( this->ecl_sum.get(), report_step, secs_elapsed );
     const double duration = secs_elapsed - this->prev_time_elapsed;
-    SummaryState st;
+
+    /*
+      The values are updated in place, with the slots which were assigned
+      in the constructor. The state only holds the values of this
+      timestep, so the previous values of the cumulative totals are kept
+      aside before the values are cleared; the totals are accumulated on
+      them.
+    */
+    auto& st = this->prev_state;
+    auto& handlers = *this->handlers;
+    for( std::size_t h = 0; h < handlers.handlers.size(); h++ ) {
+        const auto slot = handlers.handler_slots[h];
+        if (slot != SummaryState::npos && smspec_node_is_total(handlers.handlers[h].first))
+            handlers.handler_totals[h] = st.has(slot) ? st.get(slot) : 0.0;
+    }
+    st.clear_values();
 
     /* report_step is the number of the file we are about to write - i.e. for instance CASE.S$report_step
      * for the data in a non-unified summary file.
@@ -1385,79 +1517,128 @@ void Summary::add_timestep( int report_step,
      * necessary to use when consulting the Schedule object. */
     const auto sim_step = std::max( 0, report_step - 1 );
 
-    for( auto& f : this->handlers->handlers ) {
-        const int num = smspec_node_get_num( f.first );
+    if (handlers.scratch_step != sim_step || handlers.scratch_schedule != &schedule) {
+        handlers.handler_wells.resize( handlers.handlers.size() );
+        handlers.handler_efac.resize( handlers.handlers.size() );
+
+        for( std::size_t h = 0; h < handlers.handlers.size(); h++ ) {
+            if (handlers.handler_slots[h] == SummaryState::npos)
+                continue;
 
-        const auto schedule_wells = find_wells( schedule, f.first, sim_step, this->regionCache );
-        auto eff_factors = well_efficiency_factors( f.first, schedule, schedule_wells, sim_step );
+            const auto* node = handlers.handlers[h].first;
+            handlers.handler_wells[h] = find_wells( schedule, node, sim_step, this->regionCache );
+            handlers.handler_efac[h] = well_efficiency_factors( node, schedule, handlers.handler_wells[h], sim_step );
+        }
+
+        handlers.scratch_schedule = &schedule;
+        handlers.scratch_step = sim_step;
+        handlers.scratch_rebuilds++;
+    }
+
+    for( std::size_t h = 0; h < handlers.handlers.size(); h++ ) {
+        const auto& f = handlers.handlers[h];
+        const auto slot = handlers.handler_slots[h];
+        if (slot == SummaryState::npos)
+            continue;
 
-        const auto val = f.second( { schedule_wells,
+        const int num = smspec_node_get_num( f.first );
+
+        const auto val = f.second( { handlers.handler_wells[h],
                                      duration,
                                      sim_step,
                                      num,
                                      wells,
                                      this->regionCache,
                                      this->grid,
-                                     eff_factors});
+                                     handlers.handler_efac[h]});
 
         double unit_applied_val = es.getUnits().from_si( val.unit, val.value );
-        if (smspec_node_is_total(f.first)) {
-            const auto* genkey = smspec_node_get_gen_key1( f.first );
-            unit_applied_val += this->prev_state.get(genkey);
-        }
+        if (smspec_node_is_total(f.first))
+            unit_applied_val += handlers.handler_totals[h];
 
-        st.add(*f.first, unit_applied_val);
+        st.set(slot, unit_applied_val);
     }
 
     for( const auto& value_pair : single_values ) {
-        const std::string key = value_pair.first;
-        const auto node_pair = this->handlers->single_value_nodes.find( key );
-        if (node_pair != this->handlers->single_value_nodes.end()) {
+        const std::string& key = value_pair.first;
+        const auto slot_pair = this->handlers->single_value_slots.find( key );
+        if (slot_pair != this->handlers->single_value_slots.end()) {
             const auto unit = single_values_units.at( key );
             double si_value = value_pair.second;
             double output_value = es.getUnits().from_si(unit , si_value );
-            st.add(*node_pair->second, output_value);
+            st.set(slot_pair->second, output_value);
         }
     }
 
     for( const auto& value_pair : region_values ) {
-        const std::string key = value_pair.first;
+        const std::string& key = value_pair.first;
         for (size_t reg = 0; reg < value_pair.second.size(); ++reg) {
-            const auto node_pair = this->handlers->region_nodes.find( std::make_pair(key, reg+1) );
-            if (node_pair != this->handlers->region_nodes.end()) {
-                const auto * nodeptr = node_pair->second;
+            const auto slot_pair = this->handlers->region_slots.find( std::make_pair(key, reg+1) );
+            if (slot_pair != this->handlers->region_slots.end()) {
                 const auto unit = region_units.at( key );
 
-                assert (smspec_node_get_num( nodeptr ) - 1 == static_cast<int>(reg));
                 double si_value = value_pair.second[reg];
                 double output_value = es.getUnits().from_si(unit , si_value );
-                st.add(*nodeptr, output_value);
+                st.set(slot_pair->second, output_value);
             }
         }
     }
 
+    /*
+      The block vectors are gathered from the solution fields with the
+      active indices of the plan; a value in block_values takes
+      precedence and is set after this.
+    */
+    for( const auto& plan_pair : this->handlers->block_plan ) {
+        if( !solution.has( plan_pair.first ) ) continue;
+
+        const auto& data = solution.data( plan_pair.first );
+        if( data.size() != this->grid.getNumActive() ) continue;
+
+        const auto& gather = plan_pair.second;
+        for( std::size_t i = 0; i < gather.slot.size(); ++i )
+            st.set( gather.slot[i], es.getUnits().from_si( gather.unit, data[ gather.active_index[i] ] ) );
+    }
+
     for( const auto& value_pair : block_values ) {
-        const std::pair<std::string, int> key = value_pair.first;
-        const auto node_pair = this->handlers->block_nodes.find( key );
-        if (node_pair != this->handlers->block_nodes.end()) {
-            const auto * nodeptr = node_pair->second;
-            const auto unit = block_units.at( key.first );
+        const std::pair<std::string, int>& key = value_pair.first;
+        const auto slot_pair = this->handlers->block_slots.find( key );
+        if (slot_pair != this->handlers->block_slots.end()) {
+            const auto unit = block_units.at( key.first ).unit;
             double si_value = value_pair.second;
             double output_value = es.getUnits().from_si(unit , si_value );
-            st.add(*nodeptr, output_value);
+            st.set(slot_pair->second, output_value);
         }
     }
 
-    for (const auto& pair: st) {
-        const auto* key = pair.first.c_str();
+    this->prev_time_elapsed = secs_elapsed;
+}
 
-        if (ecl_sum_has_key(this->ecl_sum.get(), key)) {
-            ecl_sum_tstep_set_from_key(tstep, key, pair.second);
-        }
+void Summary::add_timestep( int report_step,
+                            double secs_elapsed,
+                            const EclipseState& es,
+                            const Schedule& schedule,
+                            const data::Wells& wells ,
+                            const data::Solution& solution,
+                            const std::map<std::string, double>& single_values,
+                            const std::map<std::string, std::vector<double>>& region_values,
+                            const std::map<std::pair<std::string, int>, double>& block_values) {
+    this->eval( report_step, secs_elapsed, es, schedule, wells, solution,
+                single_values, region_values, block_values );
+
+    const auto& st = this->prev_state;
+    auto* tstep = ecl_sum_add_tstep( this->ecl_sum.get(), report_step, secs_elapsed );
+    for (const auto slot : this->handlers->output_slots) {
+        if (st.has(slot))
+            ecl_sum_tstep_set_from_key(tstep, st.key(slot).c_str(), st.get(slot));
     }
 
-    this->prev_state = st;
-    this->prev_time_elapsed = secs_elapsed;
+    if (this->store_enabled)
+        this->store.append(report_step, secs_elapsed, st);
+}
+
+void Summary::schedule_changed() {
+    this->handlers->scratch_step = -1;
 }
 
 void Summary::write() {
@@ -1471,4 +1652,17 @@ const SummaryState& Summary::get_restart_vectors() const
     return this->prev_state;
 }
 
+std::size_t Summary::scratch_rebuilds() const {
+    return this->handlers->scratch_rebuilds;
+}
+
+void Summary::enable_store(std::size_t chunk_rows, bool compress) {
+    this->store = SummaryStore( chunk_rows, compress );
+    this->store_enabled = true;
+}
+
+const SummaryStore& Summary::get_store() const {
+    return this->store;
+}
+
 }} // namespace Opm::out
@@ -1710,6 +1710,10 @@ static void inv_map_add_kw( ::Opm::RestartIO::inv_map_type * map , const ::Opm::
   return file_kw->data_type;
 }
 
+int ecl_file_kw_get_size(const ::Opm::RestartIO::ecl_file_kw_type * file_kw) {
+  return file_kw->kw_size;
+}
+
 static void ecl_file_kw_assert_kw( const ::Opm::RestartIO::ecl_file_kw_type * file_kw ) {
   if(!::Opm::RestartIO::ecl_type_is_equal(
               ::Opm::RestartIO::ecl_file_kw_get_data_type(file_kw),
@@ -27,33 +27,90 @@
 
 namespace Opm {
 
-    bool DeckView::hasKeyword( const DeckKeyword& keyword ) const {
-        auto key = this->keywordMap.find( keyword.name() );
+    const std::size_t DeckIndex::npos;
+
+    void DeckIndex::add( const std::string& keyword, std::size_t position ) {
+        const auto pair = this->ids.emplace( keyword, this->keyword_positions.size() );
+        if( pair.second )
+            this->keyword_positions.emplace_back();
+
+        this->keyword_positions[ pair.first->second ].push_back( position );
+    }
+
+    std::size_t DeckIndex::id( const std::string& keyword ) const {
+        const auto iter = this->ids.find( keyword );
+        if( iter == this->ids.end() )
+            return npos;
 
-        if( key == this->keywordMap.end() ) return false;
+        return iter->second;
+    }
+
+    const std::vector< std::size_t >& DeckIndex::positions( std::size_t id ) const {
+        return this->keyword_positions.at( id );
+    }
+
+    std::size_t DeckIndex::size() const {
+        return this->keyword_positions.size();
+    }
 
-        for( auto index : key->second )
-            if( &this->getKeyword( index ) == &keyword ) return true;
+
+    DeckView::Occurrences::Occurrences( const_iterator base_arg, const std::size_t* first_arg, const std::size_t* last_arg ) :
+        base( base_arg ), first( first_arg ), last( last_arg )
+    {}
+
+    DeckView::Occurrences::iterator DeckView::Occurrences::begin() const {
+        return iterator( this->base, this->first );
+    }
+
+    DeckView::Occurrences::iterator DeckView::Occurrences::end() const {
+        return iterator( this->base, this->last );
+    }
+
+    std::size_t DeckView::Occurrences::size() const {
+        return this->last - this->first;
+    }
+
+    bool DeckView::Occurrences::empty() const {
+        return this->first == this->last;
+    }
+
+    const DeckKeyword& DeckView::Occurrences::at( std::size_t index ) const {
+        if( index >= this->size() )
+            throw std::out_of_range("Keyword occurrence " + std::to_string( index ) + " is out of range.");
+
+        return *( this->base + this->first[ index ] );
+    }
+
+    const DeckKeyword& DeckView::Occurrences::back() const {
+        return this->at( this->size() - 1 );
+    }
+
+
+    bool DeckView::hasKeyword( const DeckKeyword& keyword ) const {
+        for( const auto& kw : this->occurrences( keyword.name() ) )
+            if( &kw == &keyword ) return true;
 
         return false;
     }
 
     bool DeckView::hasKeyword( const std::string& keyword ) const {
-        return this->keywordMap.find( keyword ) != this->keywordMap.end();
+        return !this->occurrences( keyword ).empty();
     }
 
     const DeckKeyword& DeckView::getKeyword( const std::string& keyword, size_t index ) const {
-        if( !this->hasKeyword( keyword ) )
+        const auto kw = this->occurrences( keyword );
+        if( kw.empty() )
             throw std::invalid_argument("Keyword " + keyword + " not in deck.");
 
-        return this->getKeyword( this->offsets( keyword ).at( index ) );
+        return kw.at( index );
     }
 
     const DeckKeyword& DeckView::getKeyword( const std::string& keyword ) const {
-        if( !this->hasKeyword( keyword ) )
+        const auto kw = this->occurrences( keyword );
+        if( kw.empty() )
             throw std::invalid_argument("Keyword " + keyword + " not in deck.");
 
-        return this->getKeyword( this->offsets( keyword ).back() );
+        return kw.back();
     }
 
     const DeckKeyword& DeckView::getKeyword( size_t index ) const {
@@ -64,82 +121,85 @@ namespace Opm {
     }
 
     size_t DeckView::count( const std::string& keyword ) const {
-        if( !this->hasKeyword( keyword ) ) return 0;
-
-        return this->offsets( keyword ).size();
-   }
+        return this->occurrences( keyword ).size();
+    }
 
     const std::vector< const DeckKeyword* > DeckView::getKeywordList( const std::string& keyword ) const {
-        if( !hasKeyword( keyword ) ) return {};
-
-        const auto& indices = this->offsets( keyword );
+        const auto kw = this->occurrences( keyword );
 
         std::vector< const DeckKeyword* > ret;
-        ret.reserve( indices.size() );
+        ret.reserve( kw.size() );
 
-        for( size_t i : indices )
-            ret.push_back( &this->getKeyword( i ) );
+        for( const auto& k : kw )
+            ret.push_back( &k );
 
         return ret;
     }
 
+    DeckView::Occurrences DeckView::occurrences( const std::string& keyword ) const {
+        const auto id = this->index->id( keyword );
+        if( id == DeckIndex::npos )
+            return Occurrences( this->base, nullptr, nullptr );
+
+        const auto& positions = this->index->positions( id );
+        const auto* begin = positions.data();
+        const auto* end = begin + positions.size();
+
+        /*
+          The Deck itself covers all the positions; only a Section and
+          other partial views need to search for their own range.
+        */
+        if( this->first > 0 || ( !positions.empty() && positions.back() >= this->last ) ) {
+            begin = std::lower_bound( begin, end, this->first );
+            end = std::lower_bound( begin, end, this->last );
+        }
+
+        return Occurrences( this->base, begin, end );
+    }
+
     size_t DeckView::size() const {
-        return std::distance( this->begin(), this->end() );
+        return this->last - this->first;
     }
 
     DeckView::const_iterator DeckView::begin() const {
-        return this->first;
+        return this->base + this->first;
     }
 
     DeckView::const_iterator DeckView::end() const {
-        return this->last;
+        return this->base + this->last;
     }
 
-    void DeckView::add( const DeckKeyword* kw, const_iterator f, const_iterator l ) {
-        this->keywordMap[ kw->name() ].push_back( std::distance( f, l ) - 1 );
-        this->first = f;
-        this->last = l;
-    }
-
-    static const std::vector< size_t > empty_indices = {};
-    const std::vector< size_t >& DeckView::offsets( const std::string& keyword ) const {
-        if( !hasKeyword( keyword ) ) return empty_indices;
+    DeckView::DeckView( std::shared_ptr< const DeckIndex > index_arg, const_iterator base_arg, std::size_t first_arg, std::size_t last_arg ) :
+        index( std::move( index_arg ) ),
+        base( base_arg ),
+        first( first_arg ),
+        last( last_arg )
+    {}
 
-        return this->keywordMap.find( keyword )->second;
+    void DeckView::reset( std::shared_ptr< const DeckIndex > index_arg, const_iterator base_arg, std::size_t first_arg, std::size_t last_arg ) {
+        this->index = std::move( index_arg );
+        this->base = base_arg;
+        this->first = first_arg;
+        this->last = last_arg;
     }
 
-    DeckView::DeckView( const_iterator first_arg, const_iterator last_arg ) :
-        first( first_arg ), last( last_arg )
-    {
-        size_t index = 0;
-        for( const auto& kw : *this )
-            this->keywordMap[ kw.name() ].push_back( index++ );
-    }
 
-    void DeckView::reinit( const_iterator first_arg, const_iterator last_arg ) {
-        this->first = first_arg;
-        this->last = last_arg;
+    namespace {
 
-        this->keywordMap.clear();
+        std::shared_ptr< DeckIndex > makeIndex( const std::vector< DeckKeyword >& keywords ) {
+            auto index = std::make_shared< DeckIndex >();
+            for( size_t pos = 0; pos < keywords.size(); pos++ )
+                index->add( keywords[ pos ].name(), pos );
 
-        size_t index = 0;
-        for( const auto& kw : *this )
-            this->keywordMap[ kw.name() ].push_back( index++ );
-    }
+            return index;
+        }
 
-    DeckView::DeckView( std::pair< const_iterator, const_iterator > limits ) :
-        DeckView( limits.first, limits.second )
-    {}
+    }
 
     Deck::Deck() : Deck( std::vector< DeckKeyword >() ) {}
 
     Deck::Deck( std::vector< DeckKeyword >&& x ) :
-        DeckView( x.begin(), x.end() ),
-        keywordList( std::move( x ) ),
-        defaultUnits( UnitSystem::newMETRIC() ),
-        activeUnits( UnitSystem::newMETRIC() ),
-        m_dataFile(""),
-        input_path("")
+        Deck( std::move( x ), makeIndex( x ) )
     {
         /*
          * If multiple unit systems are requested, metric is preferred over
@@ -156,6 +216,16 @@ namespace Opm {
             this->activeUnits = UnitSystem::newMETRIC();
     }
 
+    Deck::Deck( std::vector< DeckKeyword >&& x, std::shared_ptr< DeckIndex > index ) :
+        DeckView( index, x.begin(), 0, x.size() ),
+        keywordList( std::move( x ) ),
+        keywordIndex( std::move( index ) ),
+        defaultUnits( UnitSystem::newMETRIC() ),
+        activeUnits( UnitSystem::newMETRIC() ),
+        m_dataFile(""),
+        input_path("")
+    {}
+
     Deck::Deck( std::initializer_list< DeckKeyword > ilist ) :
         Deck( std::vector< DeckKeyword >( ilist ) )
     {}
@@ -165,22 +235,39 @@ namespace Opm {
     {}
 
     Deck::Deck( const Deck& d ) :
-        DeckView( d.begin(), d.begin() ),
-        keywordList( d.keywordList ),
-        defaultUnits( d.defaultUnits ),
-        activeUnits( d.activeUnits ),
-        m_dataFile( d.m_dataFile ),
-        input_path( d.input_path ) {
-        this->reinit(this->keywordList.begin(), this->keywordList.end());
+        Deck( std::vector< DeckKeyword >( d.keywordList ), std::make_shared< DeckIndex >( *d.keywordIndex ) )
+    {
+        this->defaultUnits = d.defaultUnits;
+        this->activeUnits = d.activeUnits;
+        this->m_dataFile = d.m_dataFile;
+        this->input_path = d.input_path;
     }
 
-    void Deck::addKeyword( DeckKeyword&& keyword ) {
-        this->keywordList.push_back( std::move( keyword ) );
+    /*
+      The keywords and the index are moved, and the moved from deck is left
+      empty.
+    */
+    Deck::Deck( Deck&& d ) :
+        Deck( std::move( d.keywordList ), std::move( d.keywordIndex ) )
+    {
+        this->defaultUnits = std::move( d.defaultUnits );
+        this->activeUnits = std::move( d.activeUnits );
+        this->m_dataFile = std::move( d.m_dataFile );
+        this->input_path = std::move( d.input_path );
 
-        auto fst = this->keywordList.begin();
-        auto lst = this->keywordList.end();
+        d.keywordList.clear();
+        d.rebuildIndex();
+    }
 
-        this->add( &this->keywordList.back(), fst, lst );
+    void Deck::rebuildIndex() {
+        this->keywordIndex = makeIndex( this->keywordList );
+        this->reset( this->keywordIndex, this->keywordList.begin(), 0, this->keywordList.size() );
+    }
+
+    void Deck::addKeyword( DeckKeyword&& keyword ) {
+        this->keywordIndex->add( keyword.name(), this->keywordList.size() );
+        this->keywordList.push_back( std::move( keyword ) );
+        this->reset( this->keywordIndex, this->keywordList.begin(), 0, this->keywordList.size() );
     }
 
     void Deck::addKeyword( const DeckKeyword& keyword ) {
@@ -235,6 +235,11 @@ const std::vector< double >& DeckItem::getSIDoubleData() const {
     return this->SIdata;
 }
 
+void DeckItem::convertToSI() const {
+    if( this->type == type_tag::fdouble && !this->dimensions.empty() )
+        this->getSIDoubleData();
+}
+
 void DeckItem::push_backDimension( const Dimension& active,
                                     const Dimension& def ) {
     const auto& ds = this->value_ref< double >();
@@ -17,6 +17,10 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <ostream>
 
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
@@ -24,6 +28,74 @@
 
 namespace Opm {
 
+namespace {
+
+    const size_t buffer_limit = 1 << 16;
+
+    const double max_exact_integer = 9007199254740992.0;   // 2^53
+
+    const double powers_of_ten[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+
+    std::string fixed_point(bool negative, std::uint64_t digits, int decimals) {
+        char text[32];
+        char* end = text + sizeof text;
+        char* p = end;
+
+        for (int i = 0; digits > 0 || i <= decimals; i++) {
+            if (i == decimals && decimals > 0)
+                *--p = '.';
+            *--p = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+
+        if (negative)
+            *--p = '-';
+
+        return std::string(p, end);
+    }
+
+
+    /*
+      The shortest text which reads back to the same double. Values in
+      the range of the fixed notation are tried as m / 10^k with
+      increasing k; both m and 10^k are exact doubles, so the division is
+      correctly rounded, and when it gives the value back the text m
+      with k decimals reads back to the value as well. The rest - and
+      the rare values where the rounding of the candidate m misses the
+      shortest text - go through printf() with 15, 16 or 17 digits.
+    */
+    std::string format_double(double value) {
+        const double abs_value = std::fabs(value);
+
+        if (abs_value == 0)
+            return "0";
+
+        if (abs_value >= 1e-4 && abs_value < max_exact_integer) {
+            for (int k = 0; k <= 22 && abs_value * powers_of_ten[k] < max_exact_integer; k++) {
+                const double m = std::nearbyint(abs_value * powers_of_ten[k]);
+                if (m / powers_of_ten[k] == abs_value)
+                    return fixed_point(value < 0, static_cast<std::uint64_t>(m), k);
+            }
+        }
+
+        char text[32];
+        for (int precision = 15; precision < 17; precision++) {
+            std::snprintf(text, sizeof text, "%.*g", precision, value);
+            if (std::strtod(text, nullptr) == value)
+                return text;
+        }
+
+        std::snprintf(text, sizeof text, "%.17g", value);
+        return text;
+    }
+
+}
+
+
     DeckOutput::DeckOutput( std::ostream& s, int precision) :
         os( s ),
         default_count( 0 ),
@@ -34,6 +106,7 @@ namespace Opm {
 
 
     DeckOutput::~DeckOutput() {
+        this->flush();
         this->set_precision(this->org_precision);
     }
 
@@ -43,12 +116,47 @@ namespace Opm {
     }
 
 
+    void DeckOutput::put(const char* s, size_t size) {
+        if (!this->packed) {
+            this->os.write(s, size);
+            return;
+        }
+
+        this->buffer.append(s, size);
+        if (this->buffer.size() >= buffer_limit) {
+            this->os.write(this->buffer.data(), this->buffer.size());
+            this->buffer.clear();
+        }
+    }
+
+
+    void DeckOutput::put(const std::string& s) {
+        this->put(s.data(), s.size());
+    }
+
+
+    void DeckOutput::put(char c) {
+        this->put(&c, 1);
+    }
+
+
+    void DeckOutput::flush() {
+        this->write_run();
+        if (!this->buffer.empty()) {
+            this->os.write(this->buffer.data(), this->buffer.size());
+            this->buffer.clear();
+        }
+    }
+
+
     void DeckOutput::endl() {
-        this->os << std::endl;
+        this->write_run();
+        this->put('\n');
     }
 
     void DeckOutput::write_string(const std::string& s) {
-        this->os << s;
+        this->write_run();
+        this->put(s);
     }
 
 
@@ -57,44 +165,107 @@ namespace Opm {
         if (default_count > 0) {
             write_sep( );
 
-            os << default_count << "*";
+            put( std::to_string(default_count) );
+            put( '*' );
             default_count = 0;
             row_count++;
         }
 
-        write_sep( );
         write_value( value );
+    }
+
+
+    /*
+      In packed mode a number is held back as long as the following
+      numbers are equal to it, and the run is written when it ends.
+    */
+    void DeckOutput::write_packed(const std::string& token, bool repeatable) {
+        if (repeatable && this->run_count > 0 && token == this->run_value) {
+            this->run_count++;
+            return;
+        }
+
+        this->write_run();
+        if (repeatable) {
+            this->run_value = token;
+            this->run_count = 1;
+            return;
+        }
+
+        write_sep( );
+        put( token );
         row_count++;
     }
 
+
+    void DeckOutput::write_run( ) {
+        if (this->run_count == 0)
+            return;
+
+        write_sep( );
+        if (this->run_count > 1) {
+            put( std::to_string(this->run_count) );
+            put( '*' );
+        }
+        put( this->run_value );
+        row_count++;
+        this->run_count = 0;
+    }
+
+
     template <>
     void DeckOutput::write_value( const std::string& value ) {
+        if (this->packed) {
+            this->write_packed("'" + value + "'", false);
+            return;
+        }
+
+        write_sep( );
         this->os << "'" << value << "'";
+        row_count++;
     }
 
     template <>
     void DeckOutput::write_value( const int& value ) {
+        if (this->packed) {
+            this->write_packed(std::to_string(value), true);
+            return;
+        }
+
+        write_sep( );
         this->os << value;
+        row_count++;
     }
 
     template <>
     void DeckOutput::write_value( const double& value ) {
+        if (this->packed) {
+            this->write_packed(format_double(value), true);
+            return;
+        }
+
+        write_sep( );
         this->os << value;
+        row_count++;
     }
 
     void DeckOutput::stash_default( ) {
+        this->write_run();
         this->default_count++;
     }
 
 
     void DeckOutput::start_keyword(const std::string& kw) {
-        this->os << kw << std::endl;
+        this->write_run();
+        this->put(kw);
+        this->put('\n');
     }
 
 
     void DeckOutput::end_keyword(bool add_slash) {
+        this->write_run();
         if (add_slash)
-            this->os << "/" << std::endl;
+            this->put("/\n", 2);
     }
 
 
@@ -105,9 +276,9 @@ namespace Opm {
         }
 
         if (row_count > 0)
-            os << item_sep;
+            put( item_sep );
         else if (record_on)
-            os << record_indent;
+            put( record_indent );
     }
 
     void DeckOutput::start_record( ) {
@@ -118,13 +289,14 @@ namespace Opm {
 
 
     void DeckOutput::split_record() {
-        this->os << std::endl;
+        this->put('\n');
         this->row_count = 0;
     }
 
 
     void DeckOutput::end_record( ) {
-        this->os << " /" << std::endl;
+        this->write_run();
+        this->put(" /\n", 3);
         this->record_on = false;
     }
 
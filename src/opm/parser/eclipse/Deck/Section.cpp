@@ -30,37 +30,46 @@
 
 namespace Opm {
 
-    static bool isSectionDelimiter( const DeckKeyword& keyword ) {
-        const auto& name = keyword.name();
-        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
-                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
-            if( name == x ) return true;
-
-        return false;
-    }
-
-    static std::pair< DeckView::const_iterator, DeckView::const_iterator >
-    find_section( const Deck& deck, const std::string& keyword ) {
-
-        const auto fn = [&keyword]( const DeckKeyword& kw ) {
-            return kw.name() == keyword;
-        };
-
-        auto first = std::find_if( deck.begin(), deck.end(), fn );
+    /*
+      The section starts at the first occurrence of the section keyword and
+      ends at the next section keyword of any kind; both positions are
+      found with binary searches in the deck index.
+    */
+    static std::pair< std::size_t, std::size_t >
+    find_section( const DeckIndex& index, std::size_t deck_size, const std::string& keyword ) {
+        const auto id = index.id( keyword );
+        if( id == DeckIndex::npos )
+            return { 0, 0 };
+
+        const std::size_t first = index.positions( id ).front();
+        std::size_t last = deck_size;
+        std::string last_name;
 
-        if( first == deck.end() )
-            return { first, first };
-
-        auto last = std::find_if( first + 1, deck.end(), isSectionDelimiter );
-
-        if( last != deck.end() && last->name() == keyword )
+        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
+                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } ) {
+            const auto delimiter = index.id( x );
+            if( delimiter == DeckIndex::npos ) continue;
+
+            const auto& positions = index.positions( delimiter );
+            const auto next = std::upper_bound( positions.begin(), positions.end(), first );
+            if( next != positions.end() && *next < last ) {
+                last = *next;
+                last_name = x;
+            }
+        }
+
+        if( last_name == keyword )
             throw std::invalid_argument( std::string( "Deck contains the '" ) + keyword + "' section multiple times" );
 
         return { first, last };
     }
 
     Section::Section( const Deck& deck, const std::string& section )
-        : DeckView( find_section( deck, section ) ),
+        : Section( deck, section, find_section( *deck.keywordIndex, deck.size(), section ) )
+    {}
+
+    Section::Section( const Deck& deck, const std::string& section, std::pair< std::size_t, std::size_t > range )
+        : DeckView( deck.keywordIndex, deck.keywordList.begin(), range.first, range.second ),
           section_name( section ),
           units( deck.getActiveUnitSystem() )
     {}
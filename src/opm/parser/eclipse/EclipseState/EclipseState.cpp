@@ -17,7 +17,10 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <exception>
+#include <memory>
 #include <set>
+#include <utility>
 
 #include <boost/algorithm/string/join.hpp>
 
@@ -37,6 +40,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/InitConfig/InitConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/LoadReport.hpp>
 #include <opm/parser/eclipse/EclipseState/IOConfig/IOConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/ScheduleEnums.hpp>
 #include <opm/parser/eclipse/EclipseState/SimulationConfig/SimulationConfig.hpp>
@@ -50,18 +54,89 @@
 namespace Opm {
 
 
-    EclipseState::EclipseState(const Deck& deck , const ParseContext& parseContext, ErrorGuard& errors) :
-        m_tables(            deck ),
-        m_runspec(           deck ),
-        m_eclipseConfig(     deck, parseContext, errors ),
+namespace {
+
+    /*
+      Build one member of the EclipseState, recording the time used in
+      the report. The returned temporary is elided into the member.
+    */
+    template <typename T, typename Build>
+    T timed(LoadReport* report, const std::string& phase, Build&& build) {
+        LoadReport::Timer timer(report, phase);
+        return build();
+    }
+
+}
+
+    /*
+      The members of the EclipseState which only depend on the deck, and
+      can therefore be built concurrently before the rest of the members.
+      Exceptions are passed on from the worker threads to the caller.
+    */
+    struct EclipseState::DeckComponents {
+        DeckComponents(const Deck& deck, LoadReport* report, bool parallel) {
+            std::exception_ptr tables_error;
+            std::exception_ptr grid_error;
+
+#ifdef _OPENMP
+#pragma omp parallel sections num_threads(2) if (parallel)
+#else
+            static_cast<void>(parallel);
+#endif
+            {
+#ifdef _OPENMP
+#pragma omp section
+#endif
+                {
+                    try {
+                        LoadReport::Timer timer(report, "TableManager");
+                        tables.reset( new TableManager( deck ) );
+                    } catch (...) {
+                        tables_error = std::current_exception();
+                    }
+                }
+#ifdef _OPENMP
+#pragma omp section
+#endif
+                {
+                    try {
+                        LoadReport::Timer timer(report, "EclipseGrid");
+                        grid.reset( new EclipseGrid( deck, nullptr ) );
+                    } catch (...) {
+                        grid_error = std::current_exception();
+                    }
+                }
+            }
+
+            if (tables_error)
+                std::rethrow_exception(tables_error);
+
+            if (grid_error)
+                std::rethrow_exception(grid_error);
+        }
+
+        std::unique_ptr<TableManager> tables;
+        std::unique_ptr<EclipseGrid> grid;
+    };
+
+
+    EclipseState::EclipseState(const Deck& deck , const ParseContext& parseContext, ErrorGuard& errors, DeckComponents&& components, LoadReport* report) :
+        m_tables(            std::move( *components.tables ) ),
+        m_runspec(           timed<Runspec>( report, "Runspec", [&deck] { return Runspec( deck ); } ) ),
+        m_eclipseConfig(     timed<EclipseConfig>( report, "EclipseConfig",
+                                                   [&] { return EclipseConfig( deck, parseContext, errors ); } ) ),
         m_deckUnitSystem(    deck.getActiveUnitSystem() ),
-        m_inputNnc(          deck ),
-        m_inputEditNnc(      deck ),
-        m_inputGrid(         deck, nullptr ),
-        m_eclipseProperties( deck, m_tables, m_inputGrid ),
-        m_simulationConfig(  m_eclipseConfig.getInitConfig().restartRequested(), deck, m_eclipseProperties ),
-        m_transMult(         GridDims(deck), deck, m_eclipseProperties )
+        m_inputNnc(          timed<NNC>( report, "NNC", [&deck] { return NNC( deck ); } ) ),
+        m_inputEditNnc(      timed<EDITNNC>( report, "EDITNNC", [&deck] { return EDITNNC( deck ); } ) ),
+        m_inputGrid(         std::move( *components.grid ) ),
+        m_eclipseProperties( timed<Eclipse3DProperties>( report, "Eclipse3DProperties",
+                                                         [&] { return Eclipse3DProperties( deck, m_tables, m_inputGrid ); } ) ),
+        m_simulationConfig(  timed<SimulationConfig>( report, "SimulationConfig",
+                                                      [&] { return SimulationConfig( m_eclipseConfig.getInitConfig().restartRequested(), deck, m_eclipseProperties ); } ) ),
+        m_transMult(         timed<TransMult>( report, "TransMult",
+                                               [&] { return TransMult( GridDims(deck), deck, m_eclipseProperties ); } ) )
     {
+        LoadReport::Timer timer(report, "Finalize");
         m_inputGrid.resetACTNUM(m_eclipseProperties.getIntGridProperty("ACTNUM").getData().data());
 
         if( this->runspec().phases().size() < 3 )
@@ -80,6 +155,16 @@ namespace Opm {
     }
 
 
+    EclipseState::EclipseState(const Deck& deck , const ParseContext& parseContext, ErrorGuard& errors, LoadReport* report, bool parallel) :
+        EclipseState(deck, parseContext, errors, DeckComponents(deck, report, parallel), report)
+    {}
+
+
+    EclipseState::EclipseState(const Deck& deck , const ParseContext& parseContext, ErrorGuard& errors) :
+        EclipseState(deck, parseContext, errors, nullptr, false)
+    {}
+
+
     template<typename T>
     EclipseState::EclipseState(const Deck& deck, const ParseContext& parseContext, T&& errors) :
         EclipseState(deck, parseContext, errors)
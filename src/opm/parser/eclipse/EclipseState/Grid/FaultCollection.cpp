@@ -43,11 +43,8 @@ namespace Opm {
 
     FaultCollection::FaultCollection(const GRIDSection& gridSection,
                                      const GridDims& grid) {
-        const auto& faultKeywords = gridSection.getKeywordList<ParserKeywords::FAULTS>();
-
-        for (auto keyword_iter = faultKeywords.begin(); keyword_iter != faultKeywords.end(); ++keyword_iter) {
-            const auto& faultsKeyword = *keyword_iter;
-            for (auto iter = faultsKeyword->begin(); iter != faultsKeyword->end(); ++iter) {
+        for (const auto& faultsKeyword : gridSection.occurrences<ParserKeywords::FAULTS>()) {
+            for (auto iter = faultsKeyword.begin(); iter != faultsKeyword.end(); ++iter) {
                 const auto& faultRecord = *iter;
                 const std::string& faultName = faultRecord.getItem(0).get< std::string >(0);
 
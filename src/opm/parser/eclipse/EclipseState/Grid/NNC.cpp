@@ -32,9 +32,7 @@ namespace Opm
 {
     NNC::NNC(const Deck& deck) {
         GridDims gridDims(deck);
-        const auto& nncs = deck.getKeywordList<ParserKeywords::NNC>();
-        for (size_t idx_nnc = 0; idx_nnc<nncs.size(); ++idx_nnc) {
-            const auto& nnc = *nncs[idx_nnc];
+        for (const auto& nnc : deck.occurrences<ParserKeywords::NNC>()) {
             for (size_t i = 0; i < nnc.size(); ++i) {
                 std::array<size_t, 3> ijk1;
                 ijk1[0] = static_cast<size_t>(nnc.getRecord(i).getItem(0).get< int >(0)-1);
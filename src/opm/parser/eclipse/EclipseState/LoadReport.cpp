@@ -0,0 +1,155 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include <opm/parser/eclipse/EclipseState/LoadReport.hpp>
+
+namespace Opm {
+
+    LoadReport::Timer::Timer(LoadReport* report, const std::string& phase) :
+        m_report(report),
+        m_memory(0)
+    {
+        if (m_report) {
+            m_phase = phase;
+            m_memory = LoadReport::residentMemory();
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+
+    LoadReport::Timer::~Timer() {
+        if (!m_report)
+            return;
+
+        const auto end = std::chrono::steady_clock::now();
+        const std::int64_t memory = LoadReport::residentMemory();
+        Phase phase;
+        phase.name = m_phase;
+        phase.start = std::chrono::duration<double>(m_start - m_report->m_start).count();
+        phase.seconds = std::chrono::duration<double>(end - m_start).count();
+        phase.memory = memory - static_cast<std::int64_t>(m_memory);
+        m_report->add(phase);
+    }
+
+
+    LoadReport::LoadReport() :
+        m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+
+    void LoadReport::add(const Phase& phase) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_phases.push_back(phase);
+    }
+
+
+    const std::vector<LoadReport::Phase>& LoadReport::phases() const {
+        return m_phases;
+    }
+
+
+    bool LoadReport::hasPhase(const std::string& name) const {
+        return std::any_of(m_phases.begin(), m_phases.end(),
+                           [&name](const Phase& phase) { return phase.name == name; });
+    }
+
+
+    const LoadReport::Phase& LoadReport::getPhase(const std::string& name) const {
+        const auto iter = std::find_if(m_phases.begin(), m_phases.end(),
+                                       [&name](const Phase& phase) { return phase.name == name; });
+        if (iter == m_phases.end())
+            throw std::invalid_argument("No load phase: " + name);
+
+        return *iter;
+    }
+
+
+    double LoadReport::elapsed() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+
+    double LoadReport::wallTime() const {
+        if (m_phases.empty())
+            return 0;
+
+        double first = m_phases[0].start;
+        double last = m_phases[0].start + m_phases[0].seconds;
+        for (const auto& phase : m_phases) {
+            first = std::min(first, phase.start);
+            last = std::max(last, phase.start + phase.seconds);
+        }
+        return last - first;
+    }
+
+
+    void LoadReport::write(std::ostream& os) const {
+        const auto flags = os.flags();
+        const auto precision = os.precision();
+
+        os << std::left << std::setw(24) << "Phase"
+           << std::right << std::setw(12) << "Start [s]"
+           << std::setw(12) << "Time [s]"
+           << std::setw(14) << "Memory [MB]" << std::endl;
+
+        os << std::fixed;
+        for (const auto& phase : m_phases) {
+            os << std::left << std::setw(24) << phase.name
+               << std::right << std::setprecision(3)
+               << std::setw(12) << phase.start
+               << std::setw(12) << phase.seconds
+               << std::setprecision(1) << std::showpos
+               << std::setw(14) << phase.memory / (1024.0 * 1024.0)
+               << std::noshowpos << std::endl;
+        }
+        os << std::left << std::setw(36) << "Total"
+           << std::right << std::setprecision(3) << std::setw(12) << this->wallTime() << std::endl;
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+
+    std::size_t LoadReport::residentMemory() {
+#ifdef __linux__
+        std::ifstream statm("/proc/self/statm");
+        std::size_t size = 0, resident = 0;
+        if (statm >> size >> resident)
+            return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        return 0;
+    }
+
+
+    std::ostream& operator<<(std::ostream& os, const LoadReport& report) {
+        report.write(os);
+        return os;
+    }
+}
@@ -0,0 +1,164 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/GroupHierarchy.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/GroupTree.hpp>
+
+namespace Opm {
+
+constexpr int GroupHierarchy::NO_PARENT;
+
+GroupHierarchy::GroupHierarchy(const GroupTree& tree) {
+    const std::size_t num_groups = tree.groups.size();
+
+    /*
+      The groups of the GroupTree are sorted on name, so the position in
+      the tree can be used directly as the group index.
+    */
+    this->m_names.reserve(num_groups);
+    for (const auto& node : tree.groups)
+        this->m_names.push_back(node.name);
+
+    this->m_parent.reserve(num_groups);
+    for (const auto& node : tree.groups) {
+        if (node.parent.empty())
+            this->m_parent.push_back(NO_PARENT);
+        else
+            this->m_parent.push_back(static_cast<int>(this->index(node.parent)));
+    }
+
+    this->m_child_offset.assign(num_groups + 1, 0);
+    for (int parent : this->m_parent) {
+        if (parent != NO_PARENT)
+            this->m_child_offset[parent + 1]++;
+    }
+    for (std::size_t g = 0; g < num_groups; g++)
+        this->m_child_offset[g + 1] += this->m_child_offset[g];
+
+    this->m_children.resize(this->m_child_offset.back());
+    {
+        std::vector<std::size_t> pos(this->m_child_offset.begin(), this->m_child_offset.end() - 1);
+        for (std::size_t g = 0; g < num_groups; g++) {
+            const int parent = this->m_parent[g];
+            if (parent != NO_PARENT)
+                this->m_children[pos[parent]++] = g;
+        }
+    }
+
+    this->m_ancestor_offset.reserve(num_groups + 1);
+    this->m_ancestor_offset.push_back(0);
+    for (std::size_t g = 0; g < num_groups; g++) {
+        int current = static_cast<int>(g);
+        while (current != NO_PARENT) {
+            if (this->m_ancestors.size() - this->m_ancestor_offset.back() > num_groups)
+                throw std::invalid_argument("The group tree has a cycle through group: " + this->m_names[g]);
+
+            this->m_ancestors.push_back(current);
+            current = this->m_parent[current];
+        }
+        this->m_ancestor_offset.push_back(this->m_ancestors.size());
+    }
+}
+
+
+std::size_t GroupHierarchy::size() const {
+    return this->m_names.size();
+}
+
+
+bool GroupHierarchy::exists(const std::string& name) const {
+    return std::binary_search(this->m_names.begin(), this->m_names.end(), name);
+}
+
+
+std::size_t GroupHierarchy::index(const std::string& name) const {
+    const auto iter = std::lower_bound(this->m_names.begin(), this->m_names.end(), name);
+    if (iter == this->m_names.end() || *iter != name)
+        throw std::out_of_range("No such group: '" + name + "'");
+
+    return std::distance(this->m_names.begin(), iter);
+}
+
+
+const std::string& GroupHierarchy::name(std::size_t index) const {
+    this->checkIndex(index);
+    return this->m_names[index];
+}
+
+
+int GroupHierarchy::parent(std::size_t index) const {
+    this->checkIndex(index);
+    return this->m_parent[index];
+}
+
+
+GroupHierarchy::Range GroupHierarchy::children(std::size_t index) const {
+    this->checkIndex(index);
+    const auto* data = this->m_children.data();
+    return Range(data + this->m_child_offset[index], data + this->m_child_offset[index + 1]);
+}
+
+
+GroupHierarchy::Range GroupHierarchy::ancestors(std::size_t index) const {
+    this->checkIndex(index);
+    const auto* data = this->m_ancestors.data();
+    return Range(data + this->m_ancestor_offset[index], data + this->m_ancestor_offset[index + 1]);
+}
+
+
+std::vector<std::size_t> GroupHierarchy::descendants(std::size_t index) const {
+    std::vector<std::size_t> groups;
+    std::vector<std::size_t> stack;
+    const auto root_children = this->children(index);
+    stack.assign(root_children.begin(), root_children.end());
+    std::reverse(stack.begin(), stack.end());
+
+    while (!stack.empty()) {
+        const std::size_t group = stack.back();
+        stack.pop_back();
+        groups.push_back(group);
+
+        const auto kids = this->children(group);
+        for (auto iter = kids.end(); iter != kids.begin(); )
+            stack.push_back(*--iter);
+    }
+    return groups;
+}
+
+
+bool GroupHierarchy::operator==(const GroupHierarchy& other) const {
+    return this->m_names == other.m_names
+        && this->m_parent == other.m_parent;
+}
+
+
+bool GroupHierarchy::operator!=(const GroupHierarchy& other) const {
+    return !(*this == other);
+}
+
+
+void GroupHierarchy::checkIndex(std::size_t index) const {
+    if (index >= this->m_names.size())
+        throw std::out_of_range("Group index " + std::to_string(index) + " out of range");
+}
+
+}
@@ -96,9 +96,9 @@ bool GroupTree::exists( const std::string& name ) const {
 }
 
 const std::string& GroupTree::parent( const std::string& name ) const {
-    auto node = std::find( this->groups.begin(), this->groups.end(), name );
+    auto node = std::lower_bound( this->groups.begin(), this->groups.end(), name );
 
-    if( node == this->groups.end() )
+    if( node == this->groups.end() || node->name != name )
         throw std::out_of_range( "No such parent '" + name + "'." );
 
     return node->parent;
@@ -17,11 +17,14 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <exception>
 #include <string>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
 #include <set>
+#include <unordered_map>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -44,6 +47,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/DynamicVector.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Events.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Group.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/GroupHierarchy.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/GroupTree.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/WellSegments.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/updatingConnectionsWithSegments.hpp>
@@ -65,6 +69,131 @@ namespace Opm {
 
     static std::set<std::string> actionx_whitelist = {"WELSPECS","WELOPEN"};
 
+namespace {
+
+    enum class ScheduleKeyword {
+        UNKNOWN,
+        DATES, TSTEP,
+        WELSPECS, WHISTCTL, WCONHIST, WCONPROD, WCONINJE, WCONINJH,
+        WPOLYMER, WSOLVENT, WTRACER, WTEST, WTEMP, WINJTEMP, WPMITAB, WSKPTAB,
+        WGRUPCON, COMPDAT, COMPLUMP, COMPORD, WELSEGS, COMPSEGS,
+        WELOPEN, WELTARG, WPIMULT, WECON, WEFAC, WRFT, WRFTPLT,
+        GRUPTREE, GRUPNET, GCONINJE, GCONPROD, GEFAC,
+        TUNING, MESSAGES, DRSDT, DRVDT, DRSDTR, DRVDTR, VAPPARS,
+        VFPINJ, VFPPROD,
+        GEO_MODIFIER, UNSUPPORTED_GEO_MODIFIER
+    };
+
+    ScheduleKeyword keywordId(const std::string& name) {
+        static const std::unordered_map<std::string, ScheduleKeyword> ids = {
+            {"DATES"    , ScheduleKeyword::DATES},
+            {"TSTEP"    , ScheduleKeyword::TSTEP},
+            {"WELSPECS" , ScheduleKeyword::WELSPECS},
+            {"WHISTCTL" , ScheduleKeyword::WHISTCTL},
+            {"WCONHIST" , ScheduleKeyword::WCONHIST},
+            {"WCONPROD" , ScheduleKeyword::WCONPROD},
+            {"WCONINJE" , ScheduleKeyword::WCONINJE},
+            {"WCONINJH" , ScheduleKeyword::WCONINJH},
+            {"WPOLYMER" , ScheduleKeyword::WPOLYMER},
+            {"WSOLVENT" , ScheduleKeyword::WSOLVENT},
+            {"WTRACER"  , ScheduleKeyword::WTRACER},
+            {"WTEST"    , ScheduleKeyword::WTEST},
+            {"WTEMP"    , ScheduleKeyword::WTEMP},
+            {"WINJTEMP" , ScheduleKeyword::WINJTEMP},
+            {"WPMITAB"  , ScheduleKeyword::WPMITAB},
+            {"WSKPTAB"  , ScheduleKeyword::WSKPTAB},
+            {"WGRUPCON" , ScheduleKeyword::WGRUPCON},
+            {"COMPDAT"  , ScheduleKeyword::COMPDAT},
+            {"COMPLUMP" , ScheduleKeyword::COMPLUMP},
+            {"COMPORD"  , ScheduleKeyword::COMPORD},
+            {"WELSEGS"  , ScheduleKeyword::WELSEGS},
+            {"COMPSEGS" , ScheduleKeyword::COMPSEGS},
+            {"WELOPEN"  , ScheduleKeyword::WELOPEN},
+            {"WELTARG"  , ScheduleKeyword::WELTARG},
+            {"WPIMULT"  , ScheduleKeyword::WPIMULT},
+            {"WECON"    , ScheduleKeyword::WECON},
+            {"WEFAC"    , ScheduleKeyword::WEFAC},
+            {"WRFT"     , ScheduleKeyword::WRFT},
+            {"WRFTPLT"  , ScheduleKeyword::WRFTPLT},
+            {"GRUPTREE" , ScheduleKeyword::GRUPTREE},
+            {"GRUPNET"  , ScheduleKeyword::GRUPNET},
+            {"GCONINJE" , ScheduleKeyword::GCONINJE},
+            {"GCONPROD" , ScheduleKeyword::GCONPROD},
+            {"GEFAC"    , ScheduleKeyword::GEFAC},
+            {"TUNING"   , ScheduleKeyword::TUNING},
+            {"MESSAGES" , ScheduleKeyword::MESSAGES},
+            {"DRSDT"    , ScheduleKeyword::DRSDT},
+            {"DRVDT"    , ScheduleKeyword::DRVDT},
+            {"DRSDTR"   , ScheduleKeyword::DRSDTR},
+            {"DRVDTR"   , ScheduleKeyword::DRVDTR},
+            {"VAPPARS"  , ScheduleKeyword::VAPPARS},
+            {"VFPINJ"   , ScheduleKeyword::VFPINJ},
+            {"VFPPROD"  , ScheduleKeyword::VFPPROD},
+
+            /*
+              The geo modifiers which can be found in the schedule section are
+              only partly supported. The keywords which are supported will be
+              assembled in a per-timestep 'minideck', whereas
+              ParseContext::UNSUPPORTED_SCHEDULE_GEO_MODIFIER will be consulted
+              for the others.
+            */
+            {"MULTFLT"  , ScheduleKeyword::GEO_MODIFIER},
+            {"MULTPV"   , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTX"    , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTX-"   , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTY"    , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTY-"   , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTZ"    , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTZ-"   , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTREGT" , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTR"    , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTR-"   , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTSIG"  , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTSIGV" , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTTHT"  , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER},
+            {"MULTTHT-" , ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER}};
+
+        const auto iter = ids.find( name );
+        if (iter == ids.end())
+            return ScheduleKeyword::UNKNOWN;
+
+        return iter->second;
+    }
+
+}
+
+    /*
+      The SCHEDULE section is processed in two passes. The first pass
+      handles the keywords in deck order: it advances the report steps,
+      creates the wells and groups, handles all the keywords which are not
+      about individual wells and resolves the well name patterns. The
+      records of the well keywords are not applied in the first pass, they
+      are stored as tasks for the wells they apply to.
+
+      The second pass applies the tasks of each well, in deck order, and
+      checks whether all the connections of the well are shut at every
+      report step boundary seen after the well was created. A well keyword
+      only reads and updates the state of the well itself, so the wells are
+      independent in the second pass and are processed in parallel when
+      OpenMP is enabled.
+    */
+    struct Schedule::WellTask {
+        const DeckKeyword* keyword;
+        size_t keywordIdx;
+        size_t step;
+        size_t record;
+        int aux;                // WELSPECS: is the well new, WCONHIST: the WHISTCTL mode
+        ScheduleKeyword id;
+    };
+
+
+    struct Schedule::WellPass {
+        std::vector< std::vector< WellTask > > tasks;
+        std::vector< size_t > created;                               // Index of the WELSPECS keyword creating each well
+        std::vector< std::pair< size_t, size_t > > boundaries;       // (keyword index, report step) of each DATES and TSTEP
+        bool compdat = false;
+    };
+
 
     Schedule::Schedule( const Deck& deck,
                         const EclipseGrid& grid,
@@ -74,6 +203,7 @@ namespace Opm {
                         ErrorGuard& errors) :
         m_timeMap( deck ),
         m_rootGroupTree( this->m_timeMap, GroupTree{} ),
+        m_groupHierarchy( this->m_timeMap, std::shared_ptr< const GroupHierarchy >() ),
         m_oilvaporizationproperties( this->m_timeMap, OilVaporizationProperties(runspec.tabdims().getNumPVTTables()) ),
         m_events( this->m_timeMap ),
         m_modifierDeck( this->m_timeMap, Deck{} ),
@@ -101,6 +231,8 @@ namespace Opm {
 
         if (Section::hasSCHEDULE(deck))
             iterateScheduleSection( parseContext, errors, SCHEDULESection( deck ), grid, eclipseProperties );
+
+        updateGroupHierarchy();
     }
 
 
@@ -170,176 +302,163 @@ namespace Opm {
                                  const DeckKeyword& keyword,
                                  const ParseContext& parseContext,
                                  ErrorGuard& errors,
-                                 const EclipseGrid& grid,
-                                 const Eclipse3DProperties& eclipseProperties,
                                  const UnitSystem& unit_system,
-                                 std::vector<std::pair<const DeckKeyword*, size_t > >& rftProperties) {
-    /*
-      geoModifiers is a list of geo modifiers which can be found in the schedule
-      section. This is only partly supported, support is indicated by the bool
-      value. The keywords which are supported will be assembled in a per-timestep
-      'minideck', whereas ParseContext::UNSUPPORTED_SCHEDULE_GEO_MODIFIER will be
-      consulted for the others.
-    */
+                                 std::vector<std::pair<const DeckKeyword*, size_t > >& rftProperties,
+                                 WellPass& wellPass) {
 
-        const std::map<std::string,bool> geoModifiers = {{"MULTFLT"  , true},
-                                                         {"MULTPV"   , false},
-                                                         {"MULTX"    , false},
-                                                         {"MULTX-"   , false},
-                                                         {"MULTY"    , false},
-                                                         {"MULTY-"   , false},
-                                                         {"MULTZ"    , false},
-                                                         {"MULTZ-"   , false},
-                                                         {"MULTREGT" , false},
-                                                         {"MULTR"    , false},
-                                                         {"MULTR-"   , false},
-                                                         {"MULTSIG"  , false},
-                                                         {"MULTSIGV" , false},
-                                                         {"MULTTHT"  , false},
-                                                         {"MULTTHT-" , false}};
-
-        if (keyword.name() == "DATES") {
-            checkIfAllConnectionsIsShut(currentStep);
+        const auto id = keywordId( keyword.name() );
+        const WellTask task{ &keyword, keywordIdx, currentStep, 0, 0, id };
+
+        switch (id) {
+        case ScheduleKeyword::DATES:
+            wellPass.boundaries.emplace_back( keywordIdx, currentStep );
             currentStep += keyword.size();
-        }
+            break;
 
-        else if (keyword.name() == "TSTEP") {
-            checkIfAllConnectionsIsShut(currentStep);
+        case ScheduleKeyword::TSTEP:
+            wellPass.boundaries.emplace_back( keywordIdx, currentStep );
             currentStep += keyword.getRecord(0).getItem(0).size(); // This is a bit weird API.
-        }
+            break;
 
-        else if (keyword.name() == "WELSPECS")
-            handleWELSPECS( section, keywordIdx, currentStep );
+        case ScheduleKeyword::WELSPECS:
+            handleWELSPECS( section, keywordIdx, currentStep, wellPass );
+            break;
 
-        else if (keyword.name() == "WHISTCTL")
+        case ScheduleKeyword::WHISTCTL:
             handleWHISTCTL(parseContext, errors, keyword);
-
-        else if (keyword.name() == "WCONHIST")
-            handleWCONHIST(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WCONPROD")
-            handleWCONPROD(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WCONINJE")
-            handleWCONINJE(section, keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WPOLYMER")
-            handleWPOLYMER(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WSOLVENT")
-            handleWSOLVENT(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WTRACER")
-            handleWTRACER(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WTEST")
+            break;
+
+        case ScheduleKeyword::WCONHIST: {
+            WellTask history_task = task;
+            history_task.aux = m_controlModeWHISTCTL;
+            addWellTasks(wellPass, history_task, "WELL", true, parseContext, errors);
+            break;
+        }
+
+        case ScheduleKeyword::COMPDAT:
+            addWellTasks(wellPass, task, "WELL", true, parseContext, errors);
+            m_events.addEvent(ScheduleEvents::COMPLETION_CHANGE, currentStep);
+            wellPass.compdat = true;
+            break;
+
+        case ScheduleKeyword::WCONPROD:
+        case ScheduleKeyword::WCONINJE:
+        case ScheduleKeyword::WCONINJH:
+        case ScheduleKeyword::WPOLYMER:
+        case ScheduleKeyword::WSOLVENT:
+        case ScheduleKeyword::WTRACER:
+        case ScheduleKeyword::WTEMP:
+        case ScheduleKeyword::WINJTEMP:
+        case ScheduleKeyword::WPMITAB:
+        case ScheduleKeyword::WSKPTAB:
+        case ScheduleKeyword::WELOPEN:
+        case ScheduleKeyword::WELTARG:
+        case ScheduleKeyword::WECON:
+            addWellTasks(wellPass, task, "WELL", true, parseContext, errors);
+            break;
+
+        case ScheduleKeyword::WEFAC:
+            addWellTasks(wellPass, task, "WELLNAME", true, parseContext, errors);
+            break;
+
+        case ScheduleKeyword::WPIMULT:
+            addWellTasks(wellPass, task, "WELL", false, parseContext, errors);
+            break;
+
+        case ScheduleKeyword::WGRUPCON:
+        case ScheduleKeyword::COMPLUMP:
+            addNamedWellTasks(wellPass, task);
+            break;
+
+        case ScheduleKeyword::WELSEGS:
+        case ScheduleKeyword::COMPSEGS: {
+            const auto& well_name = keyword.getRecord(0).getItem("WELL").getTrimmedString(0);
+            wellPass.tasks[ this->m_wells.get( well_name ).seqIndex() ].push_back( task );
+            break;
+        }
+
+        case ScheduleKeyword::WTEST:
             handleWTEST(keyword, currentStep, parseContext, errors);
+            break;
 
-        else if (keyword.name() == "WTEMP")
-            handleWTEMP(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WPMITAB")
-            handleWPMITAB(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WSKPTAB")
-            handleWSKPTAB(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WINJTEMP")
-            handleWINJTEMP(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WCONINJH")
-            handleWCONINJH(section, keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WGRUPCON")
-            handleWGRUPCON(keyword, currentStep);
-
-        else if (keyword.name() == "COMPDAT")
-            handleCOMPDAT(keyword, currentStep, grid, eclipseProperties, parseContext, errors);
-
-        else if (keyword.name() == "WELSEGS")
-            handleWELSEGS(keyword, currentStep);
-
-        else if (keyword.name() == "COMPSEGS")
-            handleCOMPSEGS(keyword, currentStep, grid);
-
-        else if (keyword.name() == "WELOPEN")
-            handleWELOPEN(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "WELTARG")
-            handleWELTARG(section, keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "GRUPTREE")
+        case ScheduleKeyword::GRUPTREE:
             handleGRUPTREE(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "GRUPNET")
+        case ScheduleKeyword::GRUPNET:
             handleGRUPNET(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "GCONINJE")
+        case ScheduleKeyword::GCONINJE:
             handleGCONINJE(section, keyword, currentStep, parseContext, errors);
+            break;
 
-        else if (keyword.name() == "GCONPROD")
+        case ScheduleKeyword::GCONPROD:
             handleGCONPROD(keyword, currentStep, parseContext, errors);
+            break;
 
-        else if (keyword.name() == "GEFAC")
+        case ScheduleKeyword::GEFAC:
             handleGEFAC(keyword, currentStep, parseContext, errors);
+            break;
 
-        else if (keyword.name() == "TUNING")
+        case ScheduleKeyword::TUNING:
             handleTUNING(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "WRFT")
-            rftProperties.push_back( std::make_pair( &keyword , currentStep ));
-
-        else if (keyword.name() == "WRFTPLT")
+        case ScheduleKeyword::WRFT:
+        case ScheduleKeyword::WRFTPLT:
             rftProperties.push_back( std::make_pair( &keyword , currentStep ));
+            break;
 
-        else if (keyword.name() == "WPIMULT")
-            handleWPIMULT(keyword, currentStep);
-
-        else if (keyword.name() == "COMPORD")
+        case ScheduleKeyword::COMPORD:
             handleCOMPORD(parseContext, errors , keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "COMPLUMP")
-            handleCOMPLUMP(keyword, currentStep);
-
-        else if (keyword.name() == "DRSDT")
+        case ScheduleKeyword::DRSDT:
             handleDRSDT(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "DRVDT")
+        case ScheduleKeyword::DRVDT:
             handleDRVDT(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "DRSDTR")
+        case ScheduleKeyword::DRSDTR:
             handleDRSDTR(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "DRVDTR")
+        case ScheduleKeyword::DRVDTR:
             handleDRVDTR(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "VAPPARS")
+        case ScheduleKeyword::VAPPARS:
             handleVAPPARS(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "WECON")
-            handleWECON(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "MESSAGES")
+        case ScheduleKeyword::MESSAGES:
             handleMESSAGES(keyword, currentStep);
+            break;
 
-        else if (keyword.name() == "WEFAC")
-            handleWEFAC(keyword, currentStep, parseContext, errors);
-
-        else if (keyword.name() == "VFPINJ")
+        case ScheduleKeyword::VFPINJ:
             handleVFPINJ(keyword, unit_system, currentStep);
+            break;
 
-        else if (keyword.name() == "VFPPROD")
+        case ScheduleKeyword::VFPPROD:
             handleVFPPROD(keyword, unit_system, currentStep);
+            break;
 
-        else if (geoModifiers.find( keyword.name() ) != geoModifiers.end()) {
-            bool supported = geoModifiers.at( keyword.name() );
-            if (supported) {
-                this->m_modifierDeck[ currentStep ].addKeyword( keyword );
-                m_events.addEvent( ScheduleEvents::GEO_MODIFIER , currentStep);
-            } else {
-                std::string msg = "OPM does not support grid property modifier " + keyword.name() + " in the Schedule section. Error at report: " + std::to_string( currentStep );
-                parseContext.handleError( ParseContext::UNSUPPORTED_SCHEDULE_GEO_MODIFIER , msg, errors );
-            }
+        case ScheduleKeyword::GEO_MODIFIER:
+            this->m_modifierDeck[ currentStep ].addKeyword( keyword );
+            m_events.addEvent( ScheduleEvents::GEO_MODIFIER , currentStep);
+            break;
+
+        case ScheduleKeyword::UNSUPPORTED_GEO_MODIFIER: {
+            std::string msg = "OPM does not support grid property modifier " + keyword.name() + " in the Schedule section. Error at report: " + std::to_string( currentStep );
+            parseContext.handleError( ParseContext::UNSUPPORTED_SCHEDULE_GEO_MODIFIER , msg, errors );
+            break;
+        }
+
+        case ScheduleKeyword::UNKNOWN:
+            break;
         }
     }
 
@@ -349,37 +468,50 @@ namespace Opm {
         size_t currentStep = 0;
         const auto& unit_system = section.unitSystem();
         std::vector<std::pair< const DeckKeyword* , size_t> > rftProperties;
+        WellPass wellPass;
         size_t keywordIdx = 0;
 
-        while (true) {
-            const auto& keyword = section.getKeyword(keywordIdx);
-            if (keyword.name() == "ACTIONX") {
-                ActionX action(keyword, this->m_timeMap.getStartTime(currentStep + 1));
-                while (true) {
-                    keywordIdx++;
-                    if (keywordIdx == section.size())
-                        throw std::invalid_argument("Invalid ACTIONX section - missing ENDACTIO");
-
-                    const auto& action_keyword = section.getKeyword(keywordIdx);
-                    if (action_keyword.name() == "ENDACTIO")
-                        break;
-
-                    if (actionx_whitelist.find(action_keyword.name()) == actionx_whitelist.end()) {
-                        std::string msg = "The keyword " + action_keyword.name() + " is not supported in a ACTIONX block.";
-                        parseContext.handleError( ParseContext::ACTIONX_ILLEGAL_KEYWORD, msg, errors);
-                    } else
-                        action.addKeyword(action_keyword);
-                }
-                this->actions.add(action);
-            } else
-                this->handleKeyword(currentStep, section, keywordIdx, keyword, parseContext, errors, grid, eclipseProperties, unit_system, rftProperties);
+        try {
+            while (true) {
+                const auto& keyword = section.getKeyword(keywordIdx);
+                if (keyword.name() == "ACTIONX") {
+                    ActionX action(keyword, this->m_timeMap.getStartTime(currentStep + 1));
+                    while (true) {
+                        keywordIdx++;
+                        if (keywordIdx == section.size())
+                            throw std::invalid_argument("Invalid ACTIONX section - missing ENDACTIO");
+
+                        const auto& action_keyword = section.getKeyword(keywordIdx);
+                        if (action_keyword.name() == "ENDACTIO")
+                            break;
+
+                        if (actionx_whitelist.find(action_keyword.name()) == actionx_whitelist.end()) {
+                            std::string msg = "The keyword " + action_keyword.name() + " is not supported in a ACTIONX block.";
+                            parseContext.handleError( ParseContext::ACTIONX_ILLEGAL_KEYWORD, msg, errors);
+                        } else
+                            action.addKeyword(action_keyword);
+                    }
+                    this->actions.add(action);
+                } else
+                    this->handleKeyword(currentStep, section, keywordIdx, keyword, parseContext, errors, unit_system, rftProperties, wellPass);
 
-            keywordIdx++;
-            if (keywordIdx == section.size())
-                break;
+                keywordIdx++;
+                if (keywordIdx == section.size())
+                    break;
+            }
+        } catch (...) {
+            /*
+              The well tasks of the keywords before the failing one are
+              applied first; an error there is the one the keyword by
+              keyword processing of the deck would have run into first.
+            */
+            const auto error = std::current_exception();
+            applyWellTasks( wellPass, unit_system, grid, eclipseProperties );
+            std::rethrow_exception( error );
         }
 
-        checkIfAllConnectionsIsShut(currentStep);
+        wellPass.boundaries.emplace_back( section.size(), currentStep );
+        applyWellTasks( wellPass, unit_system, grid, eclipseProperties );
 
         for (auto rftPair = rftProperties.begin(); rftPair != rftProperties.end(); ++rftPair) {
             const DeckKeyword& keyword = *rftPair->first;
@@ -397,6 +529,272 @@ namespace Opm {
     }
 
 
+    void Schedule::addWellTasks(WellPass& wellPass,
+                                const WellTask& task,
+                                const std::string& wellItem,
+                                bool requireMatch,
+                                const ParseContext& parseContext,
+                                ErrorGuard& errors) {
+        const auto& keyword = *task.keyword;
+        for (size_t recordNr = 0; recordNr < keyword.size(); recordNr++) {
+            const auto& record = keyword.getRecord( recordNr );
+            checkWellRecord( task, record );
+
+            const std::string& wellNamePattern = record.getItem( wellItem ).getTrimmedString(0);
+            const auto wells = getWells( wellNamePattern );
+
+            if (wells.empty() && requireMatch)
+                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
+
+            /*
+              The record is read concurrently by all the wells it applies
+              to, so the lazy conversion to SI units must be done here.
+            */
+            if (wells.size() > 1) {
+                for (const auto& item : record)
+                    item.convertToSI();
+            }
+
+            for (const auto* well : wells) {
+                WellTask well_task = task;
+                well_task.record = recordNr;
+                wellPass.tasks[ well->seqIndex() ].push_back( well_task );
+            }
+        }
+    }
+
+
+    /*
+      Some keywords interpret parts of the record before looking up the
+      wells; that is done here as well to fail on the same errors, in the
+      same order, as when the record is applied directly.
+    */
+    void Schedule::checkWellRecord(const WellTask& task, const DeckRecord& record) const {
+        switch (task.id) {
+        case ScheduleKeyword::WCONHIST:
+        case ScheduleKeyword::WCONPROD:
+            WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0) );
+            break;
+
+        case ScheduleKeyword::WCONINJH:
+            WellInjector::TypeFromString( record.getItem("TYPE").getTrimmedString(0) );
+            record.getItem("RATE").get< double >(0);
+            WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0) );
+            break;
+
+        case ScheduleKeyword::WECON:
+            WellEconProductionLimits{ record };
+            break;
+
+        case ScheduleKeyword::WEFAC:
+            record.getItem("EFFICIENCY_FACTOR").get< double >(0);
+            break;
+
+        case ScheduleKeyword::WELTARG:
+            record.getItem("NEW_VALUE").get< double >(0);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+
+    void Schedule::addNamedWellTasks(WellPass& wellPass, const WellTask& task) {
+        const auto& keyword = *task.keyword;
+        for (size_t recordNr = 0; recordNr < keyword.size(); recordNr++) {
+            const std::string& wellName = keyword.getRecord( recordNr ).getItem("WELL").getTrimmedString(0);
+            const auto& well = this->m_wells.get( wellName );
+
+            WellTask well_task = task;
+            well_task.record = recordNr;
+            wellPass.tasks[ well.seqIndex() ].push_back( well_task );
+        }
+    }
+
+
+    void Schedule::applyWellTasks(const WellPass& wellPass,
+                                  const UnitSystem& unit_system,
+                                  const EclipseGrid& grid,
+                                  const Eclipse3DProperties& eclipseProperties) {
+        /*
+          The grid properties are post processed when they are first
+          accessed; that must be done before COMPDAT is applied to several
+          wells concurrently.
+        */
+        if (wellPass.compdat) {
+            for (const auto& kw : {"PERMX", "PERMY", "PERMZ", "NTG"})
+                eclipseProperties.getDoubleGridProperty( kw ).getData();
+            eclipseProperties.getIntGridProperty( "SATNUM" );
+        }
+
+        const int num_wells = wellPass.tasks.size();
+        std::vector< std::exception_ptr > failures( num_wells );
+        std::vector< size_t > failedKeyword( num_wells, 0 );
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int well_index = 0; well_index < num_wells; well_index++) {
+            try {
+                applyWellTasks(wellPass, well_index, failedKeyword[well_index], unit_system, grid, eclipseProperties);
+            } catch (...) {
+                failures[well_index] = std::current_exception();
+            }
+        }
+
+        /*
+          Report the error which the keyword by keyword processing of the
+          deck would have run into first.
+        */
+        int first = -1;
+        for (int well_index = 0; well_index < num_wells; well_index++) {
+            if (!failures[well_index])
+                continue;
+
+            if (first < 0 || failedKeyword[well_index] < failedKeyword[first])
+                first = well_index;
+        }
+
+        if (first >= 0)
+            std::rethrow_exception( failures[first] );
+    }
+
+
+    void Schedule::applyWellTasks(const WellPass& wellPass,
+                                  size_t wellIndex,
+                                  size_t& keywordIdx,
+                                  const UnitSystem& unit_system,
+                                  const EclipseGrid& grid,
+                                  const Eclipse3DProperties& eclipseProperties) {
+        auto& well = this->m_wells.get( wellIndex );
+        const auto& boundaries = wellPass.boundaries;
+        auto boundary = std::upper_bound( boundaries.begin(), boundaries.end(), wellPass.created[wellIndex],
+                                          [](size_t index, const std::pair<size_t, size_t>& b) { return index < b.first; });
+
+        for (const auto& task : wellPass.tasks[wellIndex]) {
+            for (; boundary != boundaries.end() && boundary->first < task.keywordIdx; ++boundary) {
+                keywordIdx = boundary->first;
+                checkIfAllConnectionsIsShut( well, boundary->second );
+            }
+
+            keywordIdx = task.keywordIdx;
+            applyWellTask( well, task, unit_system, grid, eclipseProperties );
+        }
+
+        for (; boundary != boundaries.end(); ++boundary) {
+            keywordIdx = boundary->first;
+            checkIfAllConnectionsIsShut( well, boundary->second );
+        }
+    }
+
+
+    void Schedule::applyWellTask(Well& well,
+                                 const WellTask& task,
+                                 const UnitSystem& unit_system,
+                                 const EclipseGrid& grid,
+                                 const Eclipse3DProperties& eclipseProperties) {
+        const auto& keyword = *task.keyword;
+        const auto& record = keyword.getRecord( task.record );
+        const size_t currentStep = task.step;
+
+        switch (task.id) {
+        case ScheduleKeyword::WELSPECS:
+            handleWELSPECS( well, record, keyword, currentStep, task.aux != 0 );
+            break;
+
+        case ScheduleKeyword::WCONHIST:
+            handleWCONProducer( well, record, currentStep, false, static_cast<WellProducer::ControlModeEnum>(task.aux) );
+            break;
+
+        case ScheduleKeyword::WCONPROD:
+            handleWCONProducer( well, record, currentStep, true, WellProducer::CMODE_UNDEFINED );
+            break;
+
+        case ScheduleKeyword::WCONINJE:
+            handleWCONINJE( well, record, currentStep, unit_system );
+            break;
+
+        case ScheduleKeyword::WCONINJH:
+            handleWCONINJH( well, record, currentStep, unit_system );
+            break;
+
+        case ScheduleKeyword::WPOLYMER:
+            handleWPOLYMER( well, record, currentStep );
+            break;
+
+        case ScheduleKeyword::WSOLVENT:
+            handleWSOLVENT( well, record, currentStep );
+            break;
+
+        case ScheduleKeyword::WTRACER:
+            handleWTRACER( well, record, currentStep );
+            break;
+
+        case ScheduleKeyword::WTEMP:
+            handleWTEMP( well, record.getItem("TEMP"), currentStep );
+            break;
+
+        case ScheduleKeyword::WINJTEMP:
+            // we do not support the "enthalpy" field yet. how to do this is a more difficult
+            // question.
+            handleWTEMP( well, record.getItem("TEMPERATURE"), currentStep );
+            break;
+
+        case ScheduleKeyword::WPMITAB:
+            handleWPMITAB( well, record, currentStep );
+            break;
+
+        case ScheduleKeyword::WSKPTAB:
+            handleWSKPTAB( well, record, currentStep );
+            break;
+
+        case ScheduleKeyword::WGRUPCON:
+            handleWGRUPCON( well, record, currentStep );
+            break;
+
+        case ScheduleKeyword::COMPDAT:
+            handleCOMPDAT( well, record, currentStep, grid, eclipseProperties );
+            break;
+
+        case ScheduleKeyword::COMPLUMP:
+            well.handleCOMPLUMP( record, currentStep );
+            break;
+
+        case ScheduleKeyword::WELSEGS:
+            well.handleWELSEGS( keyword, currentStep );
+            break;
+
+        case ScheduleKeyword::COMPSEGS:
+            well.handleCOMPSEGS( keyword, grid, currentStep );
+            break;
+
+        case ScheduleKeyword::WELOPEN:
+            handleWELOPEN( well, record, currentStep );
+            break;
+
+        case ScheduleKeyword::WELTARG:
+            handleWELTARG( well, record, currentStep, unit_system );
+            break;
+
+        case ScheduleKeyword::WPIMULT:
+            well.handleWPIMULT( record, currentStep );
+            break;
+
+        case ScheduleKeyword::WECON:
+            well.setEconProductionLimits( currentStep, WellEconProductionLimits( record ) );
+            break;
+
+        case ScheduleKeyword::WEFAC:
+            well.setEfficiencyFactor( currentStep, record.getItem("EFFICIENCY_FACTOR").get< double >(0) );
+            break;
+
+        default:
+            throw std::logic_error("Keyword " + keyword.name() + " can not be applied to a single well");
+        }
+    }
+
+
     void Schedule::checkUnhandledKeywords(const SCHEDULESection& /*section*/) const
     {
     }
@@ -476,7 +874,8 @@ namespace Opm {
 
     void Schedule::handleWELSPECS( const SCHEDULESection& section,
                                    size_t index,
-                                   size_t currentStep ) {
+                                   size_t currentStep,
+                                   WellPass& wellPass ) {
         bool needNewTree = false;
         auto newTree = m_rootGroupTree.get(currentStep);
 
@@ -519,38 +918,15 @@ namespace Opm {
                     }
                 }
                 addWell(wellName, record, currentStep, wellConnectionOrder);
+                wellPass.tasks.emplace_back();
+                wellPass.created.push_back( index );
                 new_well = true;
             }
 
             auto& currentWell = this->m_wells.get( wellName );
+            wellPass.tasks[ currentWell.seqIndex() ].push_back( WellTask{ &keyword, index, currentStep, recordNr, new_well, ScheduleKeyword::WELSPECS } );
 
-            const auto headI = record.getItem( "HEAD_I" ).get< int >( 0 ) - 1;
-            const auto headJ = record.getItem( "HEAD_J" ).get< int >( 0 ) - 1;
-            if (!new_well)
-                currentWell.addEvent( ScheduleEvents::WELL_WELSPECS_UPDATE , currentStep );
-
-            if( currentWell.getHeadI() != headI ) {
-                std::string msg = "HEAD_I changed for well " + currentWell.name();
-                OpmLog::info(Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), msg));
-                currentWell.setHeadI( currentStep, headI );
-            }
-
-            if( currentWell.getHeadJ() != headJ ) {
-                std::string msg = "HEAD_J changed for well " + currentWell.name();
-                OpmLog::info(Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), msg));
-                currentWell.setHeadJ( currentStep, headJ );
-            }
-
-            const auto& refDepthItem = record.getItem( "REF_DEPTH" );
-            double refDepth = refDepthItem.hasValue( 0 )
-                            ? refDepthItem.getSIDouble( 0 )
-                            : -1.0;
-            currentWell.setRefDepth( currentStep, refDepth );
-
-            double drainageRadius = record.getItem( "D_RADIUS" ).getSIDouble(0);
-            currentWell.setDrainageRadius( currentStep, drainageRadius );
-
-            addWellToGroup( this->m_groups.at( groupName ), this->m_wells.get( wellName ), currentStep);
+            addWellToGroup( this->m_groups.at( groupName ), currentWell, currentStep);
             if (handleGroupFromWELSPECS(groupName, newTree))
                 needNewTree = true;
 
@@ -562,6 +938,35 @@ namespace Opm {
         }
     }
 
+
+    void Schedule::handleWELSPECS( Well& well, const DeckRecord& record, const DeckKeyword& keyword, size_t currentStep, bool new_well ) {
+        const auto headI = record.getItem( "HEAD_I" ).get< int >( 0 ) - 1;
+        const auto headJ = record.getItem( "HEAD_J" ).get< int >( 0 ) - 1;
+        if (!new_well)
+            well.addEvent( ScheduleEvents::WELL_WELSPECS_UPDATE , currentStep );
+
+        if( well.getHeadI() != headI ) {
+            std::string msg = "HEAD_I changed for well " + well.name();
+            OpmLog::info(Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), msg));
+            well.setHeadI( currentStep, headI );
+        }
+
+        if( well.getHeadJ() != headJ ) {
+            std::string msg = "HEAD_J changed for well " + well.name();
+            OpmLog::info(Log::fileMessage(keyword.getFileName(), keyword.getLineNumber(), msg));
+            well.setHeadJ( currentStep, headJ );
+        }
+
+        const auto& refDepthItem = record.getItem( "REF_DEPTH" );
+        double refDepth = refDepthItem.hasValue( 0 )
+                        ? refDepthItem.getSIDouble( 0 )
+                        : -1.0;
+        well.setRefDepth( currentStep, refDepth );
+
+        double drainageRadius = record.getItem( "D_RADIUS" ).getSIDouble(0);
+        well.setDrainageRadius( currentStep, drainageRadius );
+    }
+
     void Schedule::handleVAPPARS( const DeckKeyword& keyword, size_t currentStep){
         size_t numPvtRegions = m_runspec.tabdims().getNumPVTTables();
         std::vector<double> vap(numPvtRegions);
@@ -628,261 +1033,165 @@ namespace Opm {
         this->m_oilvaporizationproperties.update( currentStep, ovp );
     }
 
-    void Schedule::handleWCONProducer( const DeckKeyword& keyword, size_t currentStep, bool isPredictionMode, const ParseContext& parseContext, ErrorGuard& errors) {
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern =
-                record.getItem("WELL").getTrimmedString(0);
-
-            const WellCommon::StatusEnum status =
-                WellCommon::StatusFromString(record.getItem("STATUS").getTrimmedString(0));
-
-            auto wells = getWells(wellNamePattern);
-            if (wells.empty())
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-
-            for( auto* well : wells ) {
-                WellProductionProperties properties;
+    void Schedule::handleWCONProducer( Well& well, const DeckRecord& record, size_t currentStep, bool isPredictionMode, WellProducer::ControlModeEnum controlModeWHISTCTL) {
+        const WellCommon::StatusEnum status =
+            WellCommon::StatusFromString(record.getItem("STATUS").getTrimmedString(0));
 
+        WellProductionProperties properties;
 
-                if (isPredictionMode) {
-                    auto addGrupProductionControl = well->isAvailableForGroupControl(currentStep);
-                    properties = WellProductionProperties::prediction( record, addGrupProductionControl );
-                } else {
-                    const WellProductionProperties& prev_properties = well->getProductionProperties(currentStep);
-                    properties = WellProductionProperties::history(prev_properties, record, m_controlModeWHISTCTL);
-                }
+        if (isPredictionMode) {
+            auto addGrupProductionControl = well.isAvailableForGroupControl(currentStep);
+            properties = WellProductionProperties::prediction( record, addGrupProductionControl );
+        } else {
+            const WellProductionProperties& prev_properties = well.getProductionProperties(currentStep);
+            properties = WellProductionProperties::history(prev_properties, record, controlModeWHISTCTL);
+        }
 
-                updateWellStatus( *well , currentStep , status );
-                if (well->setProductionProperties(currentStep, properties))
-                    m_events.addEvent( ScheduleEvents::PRODUCTION_UPDATE , currentStep);
+        updateWellStatus( well , currentStep , status );
+        if (well.setProductionProperties(currentStep, properties))
+            addEvent( ScheduleEvents::PRODUCTION_UPDATE , currentStep);
 
-                if ( !well->getAllowCrossFlow() && !isPredictionMode && (properties.OilRate + properties.WaterRate + properties.GasRate) == 0 ) {
+        if ( !well.getAllowCrossFlow() && !isPredictionMode && (properties.OilRate + properties.WaterRate + properties.GasRate) == 0 ) {
 
-                    std::string msg =
-                            "Well " + well->name() + " is a history matched well with zero rate where crossflow is banned. " +
-                            "This well will be closed at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days";
-                    OpmLog::note(msg);
-                    updateWellStatus( *well, currentStep, WellCommon::StatusEnum::SHUT );
-                }
-            }
+            std::string msg =
+                    "Well " + well.name() + " is a history matched well with zero rate where crossflow is banned. " +
+                    "This well will be closed at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days";
+            OpmLog::note(msg);
+            updateWellStatus( well, currentStep, WellCommon::StatusEnum::SHUT );
         }
     }
 
     void Schedule::updateWellStatus( Well& well, size_t reportStep , WellCommon::StatusEnum status) {
         if( well.setStatus( reportStep, status ) )
-            m_events.addEvent( ScheduleEvents::WELL_STATUS_CHANGE, reportStep );
+            addEvent( ScheduleEvents::WELL_STATUS_CHANGE, reportStep );
     }
 
 
-    void Schedule::handleWCONHIST( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        handleWCONProducer(keyword, currentStep, false, parseContext, errors);
-    }
-
-    void Schedule::handleWCONPROD( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        handleWCONProducer( keyword, currentStep, true, parseContext, errors);
-    }
-
-    void Schedule::handleWPIMULT( const DeckKeyword& keyword, size_t currentStep) {
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-
-            for( auto* well : getWells( wellNamePattern ) )
-                well->handleWPIMULT(record, currentStep);
-        }
+    /*
+      The Events are shared by all wells, and the per-well pass may update
+      them from several threads.
+    */
+    void Schedule::addEvent( ScheduleEvents::Events event, size_t reportStep ) {
+#ifdef _OPENMP
+#pragma omp critical(schedule_events)
+#endif
+        m_events.addEvent( event, reportStep );
     }
 
 
+    void Schedule::handleWCONINJE( Well& well, const DeckRecord& record, size_t currentStep, const UnitSystem& unit_system) {
+        WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem("TYPE").getTrimmedString(0) );
+        WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0));
 
+        updateWellStatus( well , currentStep , status );
+        WellInjectionProperties properties(well.getInjectionPropertiesCopy(currentStep));
 
-    void Schedule::handleWCONINJE( const SCHEDULESection& section, const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+        properties.injectorType = injectorType;
+        properties.predictionMode = true;
 
-            auto wells = getWells(wellNamePattern);
-            if (wells.empty())
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-
-            for( auto* well : wells) {
-                WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem("TYPE").getTrimmedString(0) );
-                WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0));
-
-                updateWellStatus( *well , currentStep , status );
-                WellInjectionProperties properties(well->getInjectionPropertiesCopy(currentStep));
-
-                properties.injectorType = injectorType;
-                properties.predictionMode = true;
-
-                if (!record.getItem("RATE").defaultApplied(0)) {
-                    properties.surfaceInjectionRate = convertInjectionRateToSI(record.getItem("RATE").get< double >(0) , injectorType, section.unitSystem());
-                    properties.addInjectionControl(WellInjector::RATE);
-                } else
-                    properties.dropInjectionControl(WellInjector::RATE);
-
-
-                if (!record.getItem("RESV").defaultApplied(0)) {
-                    properties.reservoirInjectionRate = record.getItem("RESV").getSIDouble(0);
-                    properties.addInjectionControl(WellInjector::RESV);
-                } else
-                    properties.dropInjectionControl(WellInjector::RESV);
+        if (!record.getItem("RATE").defaultApplied(0)) {
+            properties.surfaceInjectionRate = convertInjectionRateToSI(record.getItem("RATE").get< double >(0) , injectorType, unit_system);
+            properties.addInjectionControl(WellInjector::RATE);
+        } else
+            properties.dropInjectionControl(WellInjector::RATE);
 
 
-                if (!record.getItem("THP").defaultApplied(0)) {
-                    properties.THPLimit       = record.getItem("THP").getSIDouble(0);
-                    properties.addInjectionControl(WellInjector::THP);
-                } else
-                    properties.dropInjectionControl(WellInjector::THP);
+        if (!record.getItem("RESV").defaultApplied(0)) {
+            properties.reservoirInjectionRate = record.getItem("RESV").getSIDouble(0);
+            properties.addInjectionControl(WellInjector::RESV);
+        } else
+            properties.dropInjectionControl(WellInjector::RESV);
 
-                properties.VFPTableNumber = record.getItem("VFP_TABLE").get< int >(0);
 
-                /*
-                  There is a sensible default BHP limit defined, so the BHPLimit can be
-                  safely set unconditionally, and we make BHP limit as a constraint based
-                  on that default value. It is not easy to infer from the manual, while the
-                  current behavoir agrees with the behovir of Eclipse when BHPLimit is not
-                  specified while employed during group control.
-                */
-                properties.BHPLimit = record.getItem("BHP").getSIDouble(0);
-                // BHP control should always be there.
-                properties.addInjectionControl(WellInjector::BHP);
+        if (!record.getItem("THP").defaultApplied(0)) {
+            properties.THPLimit       = record.getItem("THP").getSIDouble(0);
+            properties.addInjectionControl(WellInjector::THP);
+        } else
+            properties.dropInjectionControl(WellInjector::THP);
 
-                if (well->isAvailableForGroupControl(currentStep))
-                    properties.addInjectionControl(WellInjector::GRUP);
-                else
-                    properties.dropInjectionControl(WellInjector::GRUP);
-                {
-                    const std::string& cmodeString = record.getItem("CMODE").getTrimmedString(0);
-                    WellInjector::ControlModeEnum controlMode = WellInjector::ControlModeFromString( cmodeString );
-                    if (properties.hasInjectionControl( controlMode))
-                        properties.controlMode = controlMode;
-                    else {
-                        throw std::invalid_argument("Tried to set invalid control: " + cmodeString + " for well: " + wellNamePattern);
-                    }
-                }
+        properties.VFPTableNumber = record.getItem("VFP_TABLE").get< int >(0);
 
-                if (well->setInjectionProperties(currentStep, properties))
-                    m_events.addEvent( ScheduleEvents::INJECTION_UPDATE , currentStep );
-
-                // if the well has zero surface rate limit or reservior rate limit, while does not allow crossflow,
-                // it should be turned off.
-                if ( ! well->getAllowCrossFlow()
-                     && ( (properties.hasInjectionControl(WellInjector::RATE) && properties.surfaceInjectionRate == 0)
-                       || (properties.hasInjectionControl(WellInjector::RESV) && properties.reservoirInjectionRate == 0) ) ) {
-                    std::string msg =
-                            "Well " + well->name() + " is an injector with zero rate where crossflow is banned. " +
-                            "This well will be closed at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days";
-                    OpmLog::note(msg);
-                    updateWellStatus( *well, currentStep, WellCommon::StatusEnum::SHUT );
-                }
+        /*
+          There is a sensible default BHP limit defined, so the BHPLimit can be
+          safely set unconditionally, and we make BHP limit as a constraint based
+          on that default value. It is not easy to infer from the manual, while the
+          current behavoir agrees with the behovir of Eclipse when BHPLimit is not
+          specified while employed during group control.
+        */
+        properties.BHPLimit = record.getItem("BHP").getSIDouble(0);
+        // BHP control should always be there.
+        properties.addInjectionControl(WellInjector::BHP);
+
+        if (well.isAvailableForGroupControl(currentStep))
+            properties.addInjectionControl(WellInjector::GRUP);
+        else
+            properties.dropInjectionControl(WellInjector::GRUP);
+        {
+            const std::string& cmodeString = record.getItem("CMODE").getTrimmedString(0);
+            WellInjector::ControlModeEnum controlMode = WellInjector::ControlModeFromString( cmodeString );
+            if (properties.hasInjectionControl( controlMode))
+                properties.controlMode = controlMode;
+            else {
+                const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+                throw std::invalid_argument("Tried to set invalid control: " + cmodeString + " for well: " + wellNamePattern);
             }
         }
-    }
 
+        if (well.setInjectionProperties(currentStep, properties))
+            addEvent( ScheduleEvents::INJECTION_UPDATE , currentStep );
 
-    void Schedule::handleWPOLYMER( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const auto wells = getWells( wellNamePattern );
-
-            if (wells.empty())
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-
-            for( auto* well : wells) {
-                WellPolymerProperties properties(well->getPolymerPropertiesCopy(currentStep));
-
-                properties.m_polymerConcentration = record.getItem("POLYMER_CONCENTRATION").getSIDouble(0);
-                properties.m_saltConcentration = record.getItem("SALT_CONCENTRATION").getSIDouble(0);
-
-                const auto& group_polymer_item = record.getItem("GROUP_POLYMER_CONCENTRATION");
-                const auto& group_salt_item = record.getItem("GROUP_SALT_CONCENTRATION");
-
-                if (!group_polymer_item.defaultApplied(0)) {
-                    throw std::logic_error("Sorry explicit setting of \'GROUP_POLYMER_CONCENTRATION\' is not supported!");
-                }
-
-                if (!group_salt_item.defaultApplied(0)) {
-                    throw std::logic_error("Sorry explicit setting of \'GROUP_SALT_CONCENTRATION\' is not supported!");
-                }
-                well->setPolymerProperties(currentStep, properties);
-            }
+        // if the well has zero surface rate limit or reservior rate limit, while does not allow crossflow,
+        // it should be turned off.
+        if ( ! well.getAllowCrossFlow()
+             && ( (properties.hasInjectionControl(WellInjector::RATE) && properties.surfaceInjectionRate == 0)
+               || (properties.hasInjectionControl(WellInjector::RESV) && properties.reservoirInjectionRate == 0) ) ) {
+            std::string msg =
+                    "Well " + well.name() + " is an injector with zero rate where crossflow is banned. " +
+                    "This well will be closed at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days";
+            OpmLog::note(msg);
+            updateWellStatus( well, currentStep, WellCommon::StatusEnum::SHUT );
         }
     }
 
 
-    void Schedule::handleWPMITAB( const DeckKeyword& keyword,  const size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
+    void Schedule::handleWPOLYMER( Well& well, const DeckRecord& record, size_t currentStep) {
+        WellPolymerProperties properties(well.getPolymerPropertiesCopy(currentStep));
 
-        for (const auto& record : keyword) {
+        properties.m_polymerConcentration = record.getItem("POLYMER_CONCENTRATION").getSIDouble(0);
+        properties.m_saltConcentration = record.getItem("SALT_CONCENTRATION").getSIDouble(0);
 
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const auto wells = getWells(wellNamePattern);
-
-            if (wells.empty()) {
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-            }
+        const auto& group_polymer_item = record.getItem("GROUP_POLYMER_CONCENTRATION");
+        const auto& group_salt_item = record.getItem("GROUP_SALT_CONCENTRATION");
 
-            for (auto* well : wells) {
-                if (well->isProducer(currentStep) ) {
-                    throw std::logic_error("WPMITAB keyword can not be applied to production well " + well->name() );
-                }
-                WellPolymerProperties properties(well->getPolymerProperties(currentStep));
-                properties.m_plymwinjtable = record.getItem("TABLE_NUMBER").get<int>(0);
-                well->setPolymerProperties(currentStep, properties);
-            }
+        if (!group_polymer_item.defaultApplied(0)) {
+            throw std::logic_error("Sorry explicit setting of \'GROUP_POLYMER_CONCENTRATION\' is not supported!");
         }
-    }
-
-
-    void Schedule::handleWSKPTAB( const DeckKeyword& keyword,  const size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
 
-
-        for (const auto& record : keyword) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const auto wells = getWells(wellNamePattern);
-
-            if (wells.empty()) {
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-            }
-
-            for (auto* well : wells) {
-                if (well->isProducer(currentStep) ) {
-                    throw std::logic_error("WSKPTAB can not be applied to production well " + well->name() );
-                }
-                WellPolymerProperties properties(well->getPolymerProperties(currentStep));
-                properties.m_skprwattable = record.getItem("TABLE_NUMBER_WATER").get<int>(0);
-                properties.m_skprpolytable = record.getItem("TABLE_NUMBER_POLYMER").get<int>(0);
-                well->setPolymerProperties(currentStep, properties);
-            }
+        if (!group_salt_item.defaultApplied(0)) {
+            throw std::logic_error("Sorry explicit setting of \'GROUP_SALT_CONCENTRATION\' is not supported!");
         }
+        well.setPolymerProperties(currentStep, properties);
     }
 
 
-    void Schedule::handleWECON( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            WellEconProductionLimits econ_production_limits(record);
-            const auto wells = getWells( wellNamePattern );
-
-            if (wells.empty())
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-
-            for( auto* well : wells ) {
-                well->setEconProductionLimits(currentStep, econ_production_limits);
-            }
+    void Schedule::handleWPMITAB( Well& well, const DeckRecord& record, const size_t currentStep) {
+        if (well.isProducer(currentStep) ) {
+            throw std::logic_error("WPMITAB keyword can not be applied to production well " + well.name() );
         }
+        WellPolymerProperties properties(well.getPolymerProperties(currentStep));
+        properties.m_plymwinjtable = record.getItem("TABLE_NUMBER").get<int>(0);
+        well.setPolymerProperties(currentStep, properties);
     }
 
-    void Schedule::handleWEFAC( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELLNAME").getTrimmedString(0);
-            const double& efficiencyFactor = record.getItem("EFFICIENCY_FACTOR").get< double >(0);
-            const auto wells = getWells( wellNamePattern );
 
-            if (wells.empty())
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-
-            for( auto* well : wells ) {
-                well->setEfficiencyFactor(currentStep, efficiencyFactor);
-            }
+    void Schedule::handleWSKPTAB( Well& well, const DeckRecord& record, const size_t currentStep) {
+        if (well.isProducer(currentStep) ) {
+            throw std::logic_error("WSKPTAB can not be applied to production well " + well.name() );
         }
+        WellPolymerProperties properties(well.getPolymerProperties(currentStep));
+        properties.m_skprwattable = record.getItem("TABLE_NUMBER_WATER").get<int>(0);
+        properties.m_skprpolytable = record.getItem("TABLE_NUMBER_POLYMER").get<int>(0);
+        well.setPolymerProperties(currentStep, properties);
     }
 
 
@@ -910,163 +1219,87 @@ namespace Opm {
         this->wtest_config.update(currentStep, new_config);
     }
 
-    void Schedule::handleWSOLVENT( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const auto wells = getWells( wellNamePattern );
-
-            if (wells.empty())
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-
-            for( auto* well : wells) {
-                WellInjectionProperties injectionProperties = well->getInjectionProperties( currentStep );
-                if (well->isInjector( currentStep ) && injectionProperties.injectorType == WellInjector::GAS) {
-                    double fraction = record.getItem("SOLVENT_FRACTION").get< double >(0);
-                    well->setSolventFraction(currentStep, fraction);
-                } else {
-                    throw std::invalid_argument("WSOLVENT keyword can only be applied to Gas injectors");
-                }
-            }
+    void Schedule::handleWSOLVENT( Well& well, const DeckRecord& record, size_t currentStep) {
+        WellInjectionProperties injectionProperties = well.getInjectionProperties( currentStep );
+        if (well.isInjector( currentStep ) && injectionProperties.injectorType == WellInjector::GAS) {
+            double fraction = record.getItem("SOLVENT_FRACTION").get< double >(0);
+            well.setSolventFraction(currentStep, fraction);
+        } else {
+            throw std::invalid_argument("WSOLVENT keyword can only be applied to Gas injectors");
         }
     }
 
-    void Schedule::handleWTRACER( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const auto wells = getWells( wellNamePattern );
-
-            if (wells.empty())
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
-
-            for( auto* well : wells) {
-                WellTracerProperties wellTracerProperties = well->getTracerProperties( currentStep );
-                double tracerConcentration = record.getItem("CONCENTRATION").get< double >(0);
-                const std::string& tracerName = record.getItem("TRACER").getTrimmedString(0);
-                wellTracerProperties.setConcentration(tracerName, tracerConcentration);
-                well->setTracerProperties(currentStep, wellTracerProperties);
-
-            }
-        }
+    void Schedule::handleWTRACER( Well& well, const DeckRecord& record, size_t currentStep) {
+        WellTracerProperties wellTracerProperties = well.getTracerProperties( currentStep );
+        double tracerConcentration = record.getItem("CONCENTRATION").get< double >(0);
+        const std::string& tracerName = record.getItem("TRACER").getTrimmedString(0);
+        wellTracerProperties.setConcentration(tracerName, tracerConcentration);
+        well.setTracerProperties(currentStep, wellTracerProperties);
     }
 
-    void Schedule::handleWTEMP( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            auto wells = getWells( wellNamePattern );
-
-            if (wells.empty())
-                invalidNamePattern( wellNamePattern, parseContext, errors, keyword);
-
-            for (auto* well : wells) {
-                // TODO: Is this the right approach? Setting the well temperature only
-                // has an effect on injectors, but specifying it for producers won't hurt
-                // and wells can also switch their injector/producer status. Note that
-                // modifying the injector properties for producer wells currently leads
-                // to a very weird segmentation fault downstream. For now, let's take the
-                // water route.
-                if (well->isInjector(currentStep)) {
-                    WellInjectionProperties injectionProperties = well->getInjectionProperties(currentStep);
-                    injectionProperties.temperature = record.getItem("TEMP").getSIDouble(0);
-                    well->setInjectionProperties(currentStep, injectionProperties);
-                }
-            }
+    /*
+      Used for both WTEMP and WINJTEMP; the item is the temperature item of
+      the keyword.
+    */
+    void Schedule::handleWTEMP( Well& well, const DeckItem& temperature, size_t currentStep) {
+        // TODO: Is this the right approach? Setting the well temperature only
+        // has an effect on injectors, but specifying it for producers won't hurt
+        // and wells can also switch their injector/producer status. Note that
+        // modifying the injector properties for producer wells currently leads
+        // to a very weird segmentation fault downstream. For now, let's take the
+        // water route.
+        if (well.isInjector(currentStep)) {
+            WellInjectionProperties injectionProperties = well.getInjectionProperties(currentStep);
+            injectionProperties.temperature = temperature.getSIDouble(0);
+            well.setInjectionProperties(currentStep, injectionProperties);
         }
     }
 
-    void Schedule::handleWINJTEMP( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        // we do not support the "enthalpy" field yet. how to do this is a more difficult
-        // question.
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            auto wells = getWells( wellNamePattern );
+    void Schedule::handleWCONINJH( Well& well, const DeckRecord& record, size_t currentStep, const UnitSystem& unit_system) {
+        // convert injection rates to SI
+        WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem("TYPE").getTrimmedString(0));
+        double injectionRate = record.getItem("RATE").get< double >(0);
+        injectionRate = convertInjectionRateToSI(injectionRate, injectorType, unit_system);
 
-            if (wells.empty())
-                invalidNamePattern( wellNamePattern, parseContext, errors, keyword);
-
-            for (auto* well : wells) {
-                // TODO: Is this the right approach? Setting the well temperature only
-                // has an effect on injectors, but specifying it for producers won't hurt
-                // and wells can also switch their injector/producer status. Note that
-                // modifying the injector properties for producer wells currently leads
-                // to a very weird segmentation fault downstream. For now, let's take the
-                // water route.
-                if (well->isInjector(currentStep)) {
-                    WellInjectionProperties injectionProperties = well->getInjectionProperties(currentStep);
-                    injectionProperties.temperature = record.getItem("TEMPERATURE").getSIDouble(0);
-                    well->setInjectionProperties(currentStep, injectionProperties);
-                }
-            }
-        }
-    }
-
-    void Schedule::handleWCONINJH( const SCHEDULESection& section,  const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
-        for( const auto& record : keyword ) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
+        WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0));
 
-            // convert injection rates to SI
-            WellInjector::TypeEnum injectorType = WellInjector::TypeFromString( record.getItem("TYPE").getTrimmedString(0));
-            double injectionRate = record.getItem("RATE").get< double >(0);
-            injectionRate = convertInjectionRateToSI(injectionRate, injectorType, section.unitSystem());
+        updateWellStatus( well, currentStep, status );
+        WellInjectionProperties properties(well.getInjectionPropertiesCopy(currentStep));
 
-            WellCommon::StatusEnum status = WellCommon::StatusFromString( record.getItem("STATUS").getTrimmedString(0));
+        properties.injectorType = injectorType;
 
-            auto wells = getWells( wellNamePattern );
-
-            if (wells.empty())
-                invalidNamePattern( wellNamePattern, parseContext, errors, keyword);
-
-            for (auto* well : wells) {
-                updateWellStatus( *well, currentStep, status );
-                WellInjectionProperties properties(well->getInjectionPropertiesCopy(currentStep));
-
-                properties.injectorType = injectorType;
-
-                const std::string& cmodeString = record.getItem("CMODE").getTrimmedString(0);
-                WellInjector::ControlModeEnum controlMode = WellInjector::ControlModeFromString( cmodeString );
-                if (!record.getItem("RATE").defaultApplied(0)) {
-                    properties.surfaceInjectionRate = injectionRate;
-                    properties.addInjectionControl(controlMode);
-                    properties.controlMode = controlMode;
-                }
-                properties.predictionMode = false;
-
-                if ( record.getItem( "BHP" ).hasValue(0) )
-                    properties.BHPH = record.getItem("BHP").getSIDouble(0);
-                if ( record.getItem( "THP" ).hasValue(0) )
-                    properties.THPH = record.getItem("THP").getSIDouble(0);
-
-                const int VFPTableNumber = record.getItem("VFP_TABLE").get< int >(0);
-                if (VFPTableNumber > 0) {
-                    properties.VFPTableNumber = VFPTableNumber;
-                }
+        const std::string& cmodeString = record.getItem("CMODE").getTrimmedString(0);
+        WellInjector::ControlModeEnum controlMode = WellInjector::ControlModeFromString( cmodeString );
+        if (!record.getItem("RATE").defaultApplied(0)) {
+            properties.surfaceInjectionRate = injectionRate;
+            properties.addInjectionControl(controlMode);
+            properties.controlMode = controlMode;
+        }
+        properties.predictionMode = false;
 
-                if (well->setInjectionProperties(currentStep, properties))
-                    m_events.addEvent( ScheduleEvents::INJECTION_UPDATE , currentStep );
+        if ( record.getItem( "BHP" ).hasValue(0) )
+            properties.BHPH = record.getItem("BHP").getSIDouble(0);
+        if ( record.getItem( "THP" ).hasValue(0) )
+            properties.THPH = record.getItem("THP").getSIDouble(0);
 
-                if ( ! well->getAllowCrossFlow() && (injectionRate == 0) ) {
-                    std::string msg =
-                            "Well " + well->name() + " is an injector with zero rate where crossflow is banned. " +
-                            "This well will be closed at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days";
-                    OpmLog::note(msg);
-                    updateWellStatus( *well, currentStep, WellCommon::StatusEnum::SHUT );
-                }
-            }
+        const int VFPTableNumber = record.getItem("VFP_TABLE").get< int >(0);
+        if (VFPTableNumber > 0) {
+            properties.VFPTableNumber = VFPTableNumber;
         }
-    }
 
-    void Schedule::handleCOMPLUMP( const DeckKeyword& keyword,
-                                   size_t timestep ) {
+        if (well.setInjectionProperties(currentStep, properties))
+            addEvent( ScheduleEvents::INJECTION_UPDATE , currentStep );
 
-        for( const auto& record : keyword ) {
-            const std::string& well_name = record.getItem("WELL").getTrimmedString(0);
-            auto& well = this->m_wells.get(well_name);
-            well.handleCOMPLUMP(record, timestep);
+        if ( ! well.getAllowCrossFlow() && (injectionRate == 0) ) {
+            std::string msg =
+                    "Well " + well.name() + " is an injector with zero rate where crossflow is banned. " +
+                    "This well will be closed at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days";
+            OpmLog::note(msg);
+            updateWellStatus( well, currentStep, WellCommon::StatusEnum::SHUT );
         }
     }
 
-    void Schedule::handleWELOPEN( const DeckKeyword& keyword, size_t currentStep, const ParseContext& parseContext, ErrorGuard& errors) {
+    void Schedule::handleWELOPEN( Well& well, const DeckRecord& record, size_t currentStep) {
 
         auto all_defaulted = []( const DeckRecord& rec ) {
             auto defaulted = []( const DeckItem& item ) {
@@ -1078,42 +1311,30 @@ namespace Opm {
 
         constexpr auto open = WellCommon::StatusEnum::OPEN;
 
-        for( const auto& record : keyword ) {
-            const auto& wellNamePattern = record.getItem( "WELL" ).getTrimmedString(0);
-            const auto& status_str = record.getItem( "STATUS" ).getTrimmedString( 0 );
-
-            auto wells = getWells( wellNamePattern );
+        const auto& status_str = record.getItem( "STATUS" ).getTrimmedString( 0 );
 
-            if (wells.empty())
-                invalidNamePattern( wellNamePattern, parseContext, errors, keyword);
-
-            /* if all records are defaulted or just the status is set, only
-             * well status is updated
-             */
-            if( all_defaulted( record ) ) {
-                const auto well_status = WellCommon::StatusFromString( status_str );
-                for( auto* well : wells ) {
-                    if( well_status == open && !well->canOpen(currentStep) ) {
-                        auto days = m_timeMap.getTimePassedUntil( currentStep ) / (60 * 60 * 24);
-                        std::string msg = "Well " + well->name()
-                            + " where crossflow is banned has zero total rate."
-                            + " This well is prevented from opening at "
-                            + std::to_string( days ) + " days";
-                        OpmLog::note(msg);
-                    } else {
-                        this->updateWellStatus( *well, currentStep, well_status );
-                    }
-                }
-
-                continue;
+        /* if all records are defaulted or just the status is set, only
+         * well status is updated
+         */
+        if( all_defaulted( record ) ) {
+            const auto well_status = WellCommon::StatusFromString( status_str );
+            if( well_status == open && !well.canOpen(currentStep) ) {
+                auto days = m_timeMap.getTimePassedUntil( currentStep ) / (60 * 60 * 24);
+                std::string msg = "Well " + well.name()
+                    + " where crossflow is banned has zero total rate."
+                    + " This well is prevented from opening at "
+                    + std::to_string( days ) + " days";
+                OpmLog::note(msg);
+            } else {
+                this->updateWellStatus( well, currentStep, well_status );
             }
 
-            for( auto* well : wells ) {
-                const auto comp_status = WellCompletion::StateEnumFromString( status_str );
-                well->handleWELOPEN(record, currentStep, comp_status);
-                m_events.addEvent( ScheduleEvents::COMPLETION_CHANGE, currentStep );
-            }
+            return;
         }
+
+        const auto comp_status = WellCompletion::StateEnumFromString( status_str );
+        well.handleWELOPEN(record, currentStep, comp_status);
+        addEvent( ScheduleEvents::COMPLETION_CHANGE, currentStep );
     }
 
     /*
@@ -1128,123 +1349,109 @@ namespace Opm {
       WCONxxxx keyword).
     */
 
-    void Schedule::handleWELTARG( const SCHEDULESection& section ,
-                                  const DeckKeyword& keyword,
+    void Schedule::handleWELTARG( Well& well,
+                                  const DeckRecord& record,
                                   size_t currentStep,
-                                  const ParseContext& parseContext, ErrorGuard& errors) {
-        Opm::UnitSystem unitSystem = section.unitSystem();
+                                  const UnitSystem& unitSystem) {
         double siFactorL = unitSystem.parse("LiquidSurfaceVolume/Time").getSIScaling();
         double siFactorG = unitSystem.parse("GasSurfaceVolume/Time").getSIScaling();
         double siFactorP = unitSystem.parse("Pressure").getSIScaling();
 
-        for( const auto& record : keyword ) {
-
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            const std::string& cMode = record.getItem("CMODE").getTrimmedString(0);
-            double newValue = record.getItem("NEW_VALUE").get< double >(0);
-
-            const auto wells = getWells( wellNamePattern );
-
-            if( wells.empty() )
-                invalidNamePattern( wellNamePattern, parseContext, errors, keyword);
+        const std::string& cMode = record.getItem("CMODE").getTrimmedString(0);
+        double newValue = record.getItem("NEW_VALUE").get< double >(0);
 
-            for( auto* well : wells ) {
-                if(well->isProducer(currentStep)){
-                    WellProductionProperties prop = well->getProductionPropertiesCopy(currentStep);
+        if(well.isProducer(currentStep)){
+            WellProductionProperties prop = well.getProductionPropertiesCopy(currentStep);
 
-                    if (cMode == "ORAT"){
-                        prop.OilRate = newValue * siFactorL;
-                    }
-                    else if (cMode == "WRAT"){
-                        prop.WaterRate = newValue * siFactorL;
-                    }
-                    else if (cMode == "GRAT"){
-                        prop.GasRate = newValue * siFactorG;
-                    }
-                    else if (cMode == "LRAT"){
-                        prop.LiquidRate = newValue * siFactorL;
-                    }
-                    else if (cMode == "RESV"){
-                        prop.ResVRate = newValue * siFactorL;
-                    }
-                    else if (cMode == "BHP"){
-                        prop.BHPLimit = newValue * siFactorP;
-                        /* For wells controlled by WCONHIST the BHP value given by the
-                           WCHONHIST keyword can not be used to control the well - i.e BHP
-                           control is not natively available - however when BHP has been
-                           specified with WELTARG we can enable BHP control.
-                        */
-                        if (prop.predictionMode == false)
-                            prop.addProductionControl(WellProducer::BHP);
-                    }
-                    else if (cMode == "THP"){
-                        prop.THPLimit = newValue * siFactorP;
-                    }
-                    else if (cMode == "VFP"){
-                        prop.VFPTableNumber = static_cast<int> (newValue);
-                    }
-                    else if (cMode == "GUID"){
-                        well->setGuideRate(currentStep, newValue);
-                    }
-                    else{
-                        throw std::invalid_argument("Invalid keyword (MODE) supplied");
-                    }
+            if (cMode == "ORAT"){
+                prop.OilRate = newValue * siFactorL;
+            }
+            else if (cMode == "WRAT"){
+                prop.WaterRate = newValue * siFactorL;
+            }
+            else if (cMode == "GRAT"){
+                prop.GasRate = newValue * siFactorG;
+            }
+            else if (cMode == "LRAT"){
+                prop.LiquidRate = newValue * siFactorL;
+            }
+            else if (cMode == "RESV"){
+                prop.ResVRate = newValue * siFactorL;
+            }
+            else if (cMode == "BHP"){
+                prop.BHPLimit = newValue * siFactorP;
+                /* For wells controlled by WCONHIST the BHP value given by the
+                   WCHONHIST keyword can not be used to control the well - i.e BHP
+                   control is not natively available - however when BHP has been
+                   specified with WELTARG we can enable BHP control.
+                */
+                if (prop.predictionMode == false)
+                    prop.addProductionControl(WellProducer::BHP);
+            }
+            else if (cMode == "THP"){
+                prop.THPLimit = newValue * siFactorP;
+            }
+            else if (cMode == "VFP"){
+                prop.VFPTableNumber = static_cast<int> (newValue);
+            }
+            else if (cMode == "GUID"){
+                well.setGuideRate(currentStep, newValue);
+            }
+            else{
+                throw std::invalid_argument("Invalid keyword (MODE) supplied");
+            }
 
-                    well->setProductionProperties(currentStep, prop);
+            well.setProductionProperties(currentStep, prop);
+        }else{
+            WellInjectionProperties prop = well.getInjectionPropertiesCopy(currentStep);
+            if (cMode == "BHP"){
+                prop.BHPLimit = newValue * siFactorP;
+                /* For wells controlled by WCONINJH the BHP value given by the
+                   WCHONINJH keyword can not be used to control the well - i.e BHP
+                   control is not natively available - however when BHP has been
+                   specified with WELTARG we can enable BHP control.
+                */
+                if (prop.predictionMode == false)
+                    prop.addInjectionControl(WellInjector::BHP);
+            }
+            else if (cMode == "ORAT"){
+                if(prop.injectorType == WellInjector::TypeEnum::OIL){
+                    prop.surfaceInjectionRate = newValue * siFactorL;
                 }else{
-                    WellInjectionProperties prop = well->getInjectionPropertiesCopy(currentStep);
-                    if (cMode == "BHP"){
-                        prop.BHPLimit = newValue * siFactorP;
-                        /* For wells controlled by WCONINJH the BHP value given by the
-                           WCHONINJH keyword can not be used to control the well - i.e BHP
-                           control is not natively available - however when BHP has been
-                           specified with WELTARG we can enable BHP control.
-                        */
-                        if (prop.predictionMode == false)
-                            prop.addInjectionControl(WellInjector::BHP);
-                    }
-                    else if (cMode == "ORAT"){
-                        if(prop.injectorType == WellInjector::TypeEnum::OIL){
-                            prop.surfaceInjectionRate = newValue * siFactorL;
-                        }else{
-                             std::invalid_argument("Well type must be OIL to set the oil rate");
-                        }
-                    }
-                    else if (cMode == "WRAT"){
-                        if(prop.injectorType == WellInjector::TypeEnum::WATER){
-                            prop.surfaceInjectionRate = newValue * siFactorL;
-                        }else{
-                             std::invalid_argument("Well type must be WATER to set the water rate");
-                        }
-                    }
-                    else if (cMode == "GRAT"){
-                        if(prop.injectorType == WellInjector::TypeEnum::GAS){
-                            prop.surfaceInjectionRate = newValue * siFactorG;
-                        }else{
-                            std::invalid_argument("Well type must be GAS to set the gas rate");
-                        }
-                    }
-                    else if (cMode == "THP"){
-                        prop.THPLimit = newValue * siFactorP;
-                    }
-                    else if (cMode == "VFP"){
-                        prop.VFPTableNumber = static_cast<int> (newValue);
-                    }
-                    else if (cMode == "GUID"){
-                        well->setGuideRate(currentStep, newValue);
-                    }
-                    else if (cMode == "RESV"){
-                        prop.reservoirInjectionRate = newValue * siFactorL;
-                    }
-                    else{
-                        throw std::invalid_argument("Invalid keyword (MODE) supplied");
-                    }
-
-                    well->setInjectionProperties(currentStep, prop);
+                     std::invalid_argument("Well type must be OIL to set the oil rate");
+                }
+            }
+            else if (cMode == "WRAT"){
+                if(prop.injectorType == WellInjector::TypeEnum::WATER){
+                    prop.surfaceInjectionRate = newValue * siFactorL;
+                }else{
+                     std::invalid_argument("Well type must be WATER to set the water rate");
+                }
+            }
+            else if (cMode == "GRAT"){
+                if(prop.injectorType == WellInjector::TypeEnum::GAS){
+                    prop.surfaceInjectionRate = newValue * siFactorG;
+                }else{
+                    std::invalid_argument("Well type must be GAS to set the gas rate");
                 }
-
-
             }
+            else if (cMode == "THP"){
+                prop.THPLimit = newValue * siFactorP;
+            }
+            else if (cMode == "VFP"){
+                prop.VFPTableNumber = static_cast<int> (newValue);
+            }
+            else if (cMode == "GUID"){
+                well.setGuideRate(currentStep, newValue);
+            }
+            else if (cMode == "RESV"){
+                prop.reservoirInjectionRate = newValue * siFactorL;
+            }
+            else{
+                throw std::invalid_argument("Invalid keyword (MODE) supplied");
+            }
+
+            well.setInjectionProperties(currentStep, prop);
         }
     }
 
@@ -1488,63 +1695,34 @@ namespace Opm {
         }
     }
 
-    void Schedule::handleCOMPDAT( const DeckKeyword& keyword, size_t currentStep, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties, const ParseContext& parseContext, ErrorGuard& errors) {
-        for (const auto& record : keyword) {
-            const std::string& wellNamePattern = record.getItem("WELL").getTrimmedString(0);
-            auto wells = getWells(wellNamePattern);
-            if (wells.empty())
-                invalidNamePattern(wellNamePattern, parseContext, errors, keyword);
+    void Schedule::handleCOMPDAT( Well& well, const DeckRecord& record, size_t currentStep, const EclipseGrid& grid, const Eclipse3DProperties& eclipseProperties) {
+        well.handleCOMPDAT(currentStep, record, grid, eclipseProperties);
 
-            for (auto* well : wells) {
-                well->handleCOMPDAT(currentStep, record, grid, eclipseProperties);
-
-                if (well->getConnections( currentStep ).allConnectionsShut()) {
-                    std::string msg =
-                        "All completions in well " + well->name() + " is shut at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days. \n" +
-                        "The well is therefore also shut.";
-                    OpmLog::note(msg);
-                    updateWellStatus( *well, currentStep, WellCommon::StatusEnum::SHUT);
-                }
-            }
+        if (well.getConnections( currentStep ).allConnectionsShut()) {
+            std::string msg =
+                "All completions in well " + well.name() + " is shut at " + std::to_string ( m_timeMap.getTimePassedUntil(currentStep) / (60*60*24) ) + " days. \n" +
+                "The well is therefore also shut.";
+            OpmLog::note(msg);
+            updateWellStatus( well, currentStep, WellCommon::StatusEnum::SHUT);
         }
-        m_events.addEvent(ScheduleEvents::COMPLETION_CHANGE, currentStep);
     }
 
 
+    void Schedule::handleWGRUPCON( Well& well, const DeckRecord& record, size_t currentStep) {
+        bool availableForGroupControl = convertEclipseStringToBool(record.getItem("GROUP_CONTROLLED").getTrimmedString(0));
+        well.setAvailableForGroupControl(currentStep, availableForGroupControl);
 
+        well.setGuideRate(currentStep, record.getItem("GUIDE_RATE").get< double >(0));
 
-    void Schedule::handleWELSEGS( const DeckKeyword& keyword, size_t currentStep) {
-        const auto& record1 = keyword.getRecord(0);
-        auto& well = this->m_wells.get(record1.getItem("WELL").getTrimmedString(0));
-        well.handleWELSEGS(keyword, currentStep);WellSegments newSegmentset;
-    }
+        if (!record.getItem("PHASE").defaultApplied(0)) {
+            std::string guideRatePhase = record.getItem("PHASE").getTrimmedString(0);
+            well.setGuideRatePhase(currentStep, GuideRate::GuideRatePhaseEnumFromString(guideRatePhase));
+        } else
+            well.setGuideRatePhase(currentStep, GuideRate::UNDEFINED);
 
-    void Schedule::handleCOMPSEGS( const DeckKeyword& keyword, size_t currentStep, const EclipseGrid& grid) {
-        const auto& record1 = keyword.getRecord(0);
-        const std::string& well_name = record1.getItem("WELL").getTrimmedString(0);
-        auto& well = this->m_wells.get( well_name );
-        well.handleCOMPSEGS(keyword, grid, currentStep);
+        well.setGuideRateScalingFactor(currentStep, record.getItem("SCALING_FACTOR").get< double >(0));
     }
 
-    void Schedule::handleWGRUPCON( const DeckKeyword& keyword, size_t currentStep) {
-        for( const auto& record : keyword ) {
-            const std::string& wellName = record.getItem("WELL").getTrimmedString(0);
-            auto& well = this->m_wells.get( wellName );
-
-            bool availableForGroupControl = convertEclipseStringToBool(record.getItem("GROUP_CONTROLLED").getTrimmedString(0));
-            well.setAvailableForGroupControl(currentStep, availableForGroupControl);
-
-            well.setGuideRate(currentStep, record.getItem("GUIDE_RATE").get< double >(0));
-
-            if (!record.getItem("PHASE").defaultApplied(0)) {
-                std::string guideRatePhase = record.getItem("PHASE").getTrimmedString(0);
-                well.setGuideRatePhase(currentStep, GuideRate::GuideRatePhaseEnumFromString(guideRatePhase));
-            } else
-                well.setGuideRatePhase(currentStep, GuideRate::UNDEFINED);
-
-            well.setGuideRateScalingFactor(currentStep, record.getItem("SCALING_FACTOR").get< double >(0));
-        }
-    }
 
     void Schedule::handleGRUPTREE( const DeckKeyword& keyword, size_t currentStep) {
         const auto& currentTree = m_rootGroupTree.get(currentStep);
@@ -1624,6 +1802,26 @@ namespace Opm {
         return m_rootGroupTree.get(timeStep);
     }
 
+    const GroupHierarchy& Schedule::getGroupHierarchy(size_t timeStep) const {
+        return *m_groupHierarchy.get(timeStep);
+    }
+
+    /*
+      The group tree typically changes at only a few of the report steps,
+      the compiled GroupHierarchy is therefore shared between all the
+      consecutive report steps with an equal GroupTree.
+    */
+    void Schedule::updateGroupHierarchy() {
+        std::shared_ptr< const GroupHierarchy > current;
+        for (size_t timeStep = 0; timeStep < m_timeMap.size(); timeStep++) {
+            const auto& tree = m_rootGroupTree.get(timeStep);
+            if (!current || (timeStep > 0 && tree != m_rootGroupTree.get(timeStep - 1)))
+                current = std::make_shared< const GroupHierarchy >( tree );
+
+            m_groupHierarchy.update_elm(timeStep, current);
+        }
+    }
+
     void Schedule::addWell(const std::string& wellName, const DeckRecord& record, size_t timeStep, WellCompletion::CompletionOrderEnum wellConnectionOrder) {
         // We change from eclipse's 1 - n, to a 0 - n-1 solution
         int headI = record.getItem("HEAD_I").get< int >(0) - 1;
@@ -1671,6 +1869,7 @@ namespace Opm {
                   wellConnectionOrder, allowCrossFlow, automaticShutIn);
 
         m_wells.insert( wellName, well );
+        m_wellNameIndex.insert( wellName, wseqIndex );
         m_events.addEvent( ScheduleEvents::NEW_WELL , timeStep );
     }
 
@@ -1691,80 +1890,69 @@ namespace Opm {
     }
 
     /*
-      This will recursively go all the way down through the group tree
-      until the well leaf-nodes are encountered.
+      This will go all the way down through the group tree until the well
+      leaf-nodes are encountered; the traversal is done on the integer
+      indices of the GroupHierarchy of the report step.
     */
     std::vector< const Well* > Schedule::getWells(const std::string& group_name, size_t timeStep) const {
         if (!hasGroup(group_name))
             throw std::invalid_argument("No such group: " + group_name);
-        {
-            const auto& group = getGroup( group_name );
-            std::vector<const Well*> wells;
 
-            if (group.hasBeenDefined( timeStep )) {
-                const GroupTree& group_tree = getGroupTree( timeStep );
-                const auto& child_groups = group_tree.children( group_name );
+        std::vector<const Well*> wells;
+        if (!getGroup( group_name ).hasBeenDefined( timeStep ))
+            return wells;
 
-                if (child_groups.size()) {
-                    for (const auto& child : child_groups) {
-                        const auto& child_wells = getWells( child, timeStep );
-                        wells.insert( wells.end() , child_wells.begin() , child_wells.end());
-                    }
-                } else {
-                    for (const auto& well_name : group.getWells( timeStep )) {
-                        wells.push_back( getWell( well_name ));
-                    }
-                }
+        const auto& hierarchy = getGroupHierarchy( timeStep );
+        std::vector< size_t > stack = { hierarchy.index( group_name ) };
+        while (!stack.empty()) {
+            const size_t group_index = stack.back();
+            stack.pop_back();
+
+            const auto& group = getGroup( hierarchy.name( group_index ) );
+            if (!group.hasBeenDefined( timeStep ))
+                continue;
+
+            const auto children = hierarchy.children( group_index );
+            if (children.empty()) {
+                for (const auto& well_name : group.getWells( timeStep ))
+                    wells.push_back( getWell( well_name ));
+            } else {
+                for (auto iter = children.end(); iter != children.begin(); )
+                    stack.push_back( *--iter );
             }
-            return wells;
         }
+        return wells;
     }
 
     std::vector< const Group* > Schedule::getChildGroups(const std::string& group_name, size_t timeStep) const {
         if (!hasGroup(group_name))
             throw std::invalid_argument("No such group: " + group_name);
-        {
-            const auto& group = getGroup( group_name );
-	    std::vector<const Group*> child_groups;
-
-            if (group.hasBeenDefined( timeStep )) {
-                const GroupTree& group_tree = getGroupTree( timeStep );
-                const auto& ch_grps = group_tree.children( group_name );
-		//for (const std::string& group_name : ch_grps) {
-		for ( auto it = ch_grps.begin() ; it != ch_grps.end(); it++) {
-                        child_groups.push_back( &getGroup(*it));
-                    }
-	    }
-	    return child_groups;
-	}
+
+        std::vector<const Group*> child_groups;
+        if (getGroup( group_name ).hasBeenDefined( timeStep )) {
+            const auto& hierarchy = getGroupHierarchy( timeStep );
+            for (size_t child : hierarchy.children( hierarchy.index( group_name )))
+                child_groups.push_back( &getGroup( hierarchy.name( child )));
+        }
+        return child_groups;
     }
 
-        std::vector< const Well* > Schedule::getChildWells(const std::string& group_name, size_t timeStep) const {
+    std::vector< const Well* > Schedule::getChildWells(const std::string& group_name, size_t timeStep) const {
         if (!hasGroup(group_name))
             throw std::invalid_argument("No such group: " + group_name);
-        {
-            const auto& group = getGroup( group_name );
-            std::vector<const Well*> wells;
-
-            if (group.hasBeenDefined( timeStep )) {
-                const GroupTree& group_tree = getGroupTree( timeStep );
-                const auto& child_groups = group_tree.children( group_name );
-
-                if (!child_groups.size()) {
-                    //for (const auto& well_name : group.getWells( timeStep )) {
-		    const auto& ch_wells = group.getWells( timeStep );
-                    for (auto it= ch_wells.begin(); it != ch_wells.end(); it++) {		      
-                        wells.push_back( getWell( *it ));
-                    }
-                }
+
+        const auto& group = getGroup( group_name );
+        std::vector< const Well* > wells;
+        if (group.hasBeenDefined( timeStep )) {
+            const auto& hierarchy = getGroupHierarchy( timeStep );
+            if (hierarchy.children( hierarchy.index( group_name )).empty()) {
+                for (const auto& well_name : group.getWells( timeStep ))
+                    wells.push_back( getWell( well_name ));
             }
-            return wells;
         }
+        return wells;
     }
 
-    
-    
-    
     std::vector< const Well* > Schedule::getWells(size_t timeStep) const {
         if (timeStep >= m_timeMap.size()) {
             throw std::invalid_argument("Timestep to large");
@@ -1823,6 +2011,13 @@ namespace Opm {
         }
 
         std::vector< Well* > wells;
+        if( NamePatternIndex::isPrefixPattern( wellNamePattern ) ) {
+            for( const auto index : m_wellNameIndex.match( wellNamePattern ) )
+                wells.push_back( std::addressof( m_wells.get( index ) ) );
+
+            return wells;
+        }
+
         for( auto& well : this->m_wells ) {
             if( Well::wellNameInWellNamePattern( well.name(), wellNamePattern ) ) {
                 wells.push_back( std::addressof( well ) );
@@ -1835,6 +2030,7 @@ namespace Opm {
     void Schedule::addGroup(const std::string& groupName, size_t timeStep) {
 	const size_t gseqIndex = m_groups.size(); 
         m_groups.insert( groupName, Group { groupName, gseqIndex, m_timeMap, timeStep } );
+        m_groupNameIndex.insert( groupName, gseqIndex );
         m_events.addEvent( ScheduleEvents::NEW_GROUP , timeStep );
     }
 
@@ -1875,6 +2071,13 @@ namespace Opm {
         }
 
         std::vector< Group* > groups;
+        if( NamePatternIndex::isPrefixPattern( groupNamePattern ) ) {
+            for( const auto index : m_groupNameIndex.match( groupNamePattern ) )
+                groups.push_back( std::addressof( m_groups.get( index ) ) );
+
+            return groups;
+        }
+
         for( auto& group : this->m_groups ) {
             if( Group::groupNameInGroupNamePattern( group.name(), groupNamePattern ) ) {
                 groups.push_back( std::addressof( group ) );
@@ -2003,12 +2206,10 @@ namespace Opm {
         return false;
     }
 
-    void Schedule::checkIfAllConnectionsIsShut(size_t timestep) {
-        for( auto& well : this->m_wells ) {
-            const auto& completions = well.getConnections(timestep);
-            if( completions.allConnectionsShut() )
-                this->updateWellStatus( well, timestep, WellCommon::StatusEnum::SHUT);
-        }
+    void Schedule::checkIfAllConnectionsIsShut(Well& well, size_t timestep) {
+        const auto& completions = well.getConnections(timestep);
+        if( completions.allConnectionsShut() )
+            this->updateWellStatus( well, timestep, WellCommon::StatusEnum::SHUT);
     }
 
 
@@ -18,76 +18,175 @@
 */
 
 
+#include <algorithm>
+#include <stdexcept>
+
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 
 namespace Opm{
+
+    const std::size_t SummaryState::npos = static_cast<std::size_t>(-1);
+
+
+    SummaryState::const_iterator::const_iterator(const SummaryState& state_arg, std::size_t slot_arg) :
+        state(&state_arg),
+        slot(slot_arg)
+    {
+        this->skip_undefined();
+    }
+
+    SummaryState::const_iterator::value_type SummaryState::const_iterator::operator*() const {
+        return value_type(this->state->keys[this->slot], this->state->values[this->slot]);
+    }
+
+    SummaryState::const_iterator& SummaryState::const_iterator::operator++() {
+        this->slot++;
+        this->skip_undefined();
+        return *this;
+    }
+
+    bool SummaryState::const_iterator::operator==(const const_iterator& other) const {
+        return this->slot == other.slot;
+    }
+
+    bool SummaryState::const_iterator::operator!=(const const_iterator& other) const {
+        return this->slot != other.slot;
+    }
+
+    void SummaryState::const_iterator::skip_undefined() {
+        while (this->slot < this->state->defined.size() && !this->state->defined[this->slot])
+            this->slot++;
+    }
+
+
     void SummaryState::add(const ecl::smspec_node& node, double value) {
-        if (node.get_var_type() == ECL_SMSPEC_WELL_VAR)
-            this->add_well_var(node.get_wgname(),
-                               node.get_keyword(),
-                               value);
-        else
-            this->add(node.get_gen_key1(), value);
+        this->set(this->add_key(node), value);
     }
 
     void SummaryState::add(const std::string& key, double value) {
-        this->values[key] = value;
+        this->set(this->add_key(key), value);
     }
 
 
     bool SummaryState::has(const std::string& key) const {
-        return (this->values.find(key) != this->values.end());
+        const auto slot = this->index(key);
+        return slot != npos && this->defined[slot];
     }
 
 
     double SummaryState::get(const std::string& key) const {
-        const auto iter = this->values.find(key);
-        if (iter == this->values.end())
+        const auto slot = this->index(key);
+        if (slot == npos || !this->defined[slot])
             throw std::out_of_range("No such key: " + key);
 
-        return iter->second;
+        return this->values[slot];
     }
 
     void SummaryState::add_well_var(const std::string& well, const std::string& var, double value) {
-        this->add(var + ":" + well, value);
-        this->well_values[var][well] = value;
+        this->set(this->add_well_key(well, var), value);
     }
 
     bool SummaryState::has_well_var(const std::string& well, const std::string& var) const {
-        const auto& var_iter = this->well_values.find(var);
-        if (var_iter == this->well_values.end())
+        const auto& var_iter = this->well_slots.find(var);
+        if (var_iter == this->well_slots.end())
             return false;
 
         const auto& well_iter = var_iter->second.find(well);
         if (well_iter == var_iter->second.end())
             return false;
 
-        return true;
+        return this->defined[well_iter->second];
     }
 
     double SummaryState::get_well_var(const std::string& well, const std::string& var) const {
-        return this->well_values.at(var).at(well);
+        const auto slot = this->well_slots.at(var).at(well);
+        if (!this->defined[slot])
+            throw std::out_of_range("No value for " + var + ":" + well);
+
+        return this->values[slot];
+    }
+
+
+    std::size_t SummaryState::add_key(const std::string& key) {
+        const auto pair = this->slots.emplace(key, this->keys.size());
+        if (pair.second) {
+            this->keys.push_back(key);
+            this->values.push_back(0);
+            this->defined.push_back(false);
+        }
+        return pair.first->second;
+    }
+
+    std::size_t SummaryState::add_key(const ecl::smspec_node& node) {
+        if (node.get_var_type() == ECL_SMSPEC_WELL_VAR)
+            return this->add_well_key(node.get_wgname(), node.get_keyword());
+
+        return this->add_key(node.get_gen_key1());
+    }
+
+    std::size_t SummaryState::add_well_key(const std::string& well, const std::string& var) {
+        const auto slot = this->add_key(var + ":" + well);
+        this->well_slots[var][well] = slot;
+        return slot;
+    }
+
+    std::size_t SummaryState::index(const std::string& key) const {
+        const auto iter = this->slots.find(key);
+        if (iter == this->slots.end())
+            return npos;
+
+        return iter->second;
+    }
+
+    const std::string& SummaryState::key(std::size_t slot) const {
+        return this->keys.at(slot);
+    }
+
+    void SummaryState::set(std::size_t slot, double value) {
+        this->values.at(slot) = value;
+        this->defined[slot] = true;
+    }
+
+    bool SummaryState::has(std::size_t slot) const {
+        return slot < this->defined.size() && this->defined[slot];
+    }
+
+    double SummaryState::get(std::size_t slot) const {
+        if (!this->has(slot))
+            throw std::out_of_range("No value in summary slot: " + std::to_string(slot));
+
+        return this->values[slot];
+    }
+
+    std::size_t SummaryState::num_slots() const {
+        return this->keys.size();
+    }
+
+    void SummaryState::clear_values() {
+        std::fill(this->defined.begin(), this->defined.end(), false);
     }
 
 
     SummaryState::const_iterator SummaryState::begin() const {
-        return this->values.begin();
+        return const_iterator(*this, 0);
     }
 
 
     SummaryState::const_iterator SummaryState::end() const {
-        return this->values.end();
+        return const_iterator(*this, this->keys.size());
     }
 
 
     std::vector<std::string> SummaryState::wells(const std::string& var) const {
-        const auto& var_iter = this->well_values.find(var);
-        if (var_iter == this->well_values.end())
+        const auto& var_iter = this->well_slots.find(var);
+        if (var_iter == this->well_slots.end())
             return {};
 
         std::vector<std::string> wells;
-        for (const auto& pair : var_iter->second)
-            wells.push_back(pair.first);
+        for (const auto& pair : var_iter->second) {
+            if (this->defined[pair.second])
+                wells.push_back(pair.first);
+        }
         return wells;
     }
 
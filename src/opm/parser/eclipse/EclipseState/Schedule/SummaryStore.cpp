@@ -0,0 +1,374 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryStore.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const unsigned char constant_chunk = 0;
+    const unsigned char xor_chunk = 1;
+
+    std::uint64_t to_bits(double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        return bits;
+    }
+
+    double from_bits(std::uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof value);
+        return value;
+    }
+
+    /*
+      A chunk of equal values is packed as the tag and the value. Otherwise
+      every value is packed as the xor with the previous value: a header
+      byte with the number of leading and trailing zero bytes of the xor,
+      followed by the bytes between them.
+    */
+    std::vector<unsigned char> pack(const std::vector<double>& values) {
+        std::vector<unsigned char> packed;
+        const auto first = to_bits(values.front());
+        const bool constant = std::all_of(values.begin(), values.end(),
+                                          [first](double v) { return to_bits(v) == first; });
+
+        packed.push_back(constant ? constant_chunk : xor_chunk);
+        if (constant) {
+            for (int b = 0; b < 8; b++)
+                packed.push_back(static_cast<unsigned char>(first >> (8 * b)));
+            return packed;
+        }
+
+        std::uint64_t prev = 0;
+        for (const auto v : values) {
+            const auto bits = to_bits(v);
+            const auto x = bits ^ prev;
+            prev = bits;
+
+            int lead = 0;
+            while (lead < 8 && ((x >> (8 * (7 - lead))) & 0xff) == 0)
+                lead++;
+
+            int trail = 0;
+            if (lead < 8) {
+                while (((x >> (8 * trail)) & 0xff) == 0)
+                    trail++;
+            }
+
+            packed.push_back(static_cast<unsigned char>((lead << 4) | trail));
+            for (int b = trail; b < 8 - lead; b++)
+                packed.push_back(static_cast<unsigned char>(x >> (8 * b)));
+        }
+        return packed;
+    }
+
+    double constant_value(const std::vector<unsigned char>& packed) {
+        std::uint64_t bits = 0;
+        for (int b = 0; b < 8; b++)
+            bits |= static_cast<std::uint64_t>(packed[1 + b]) << (8 * b);
+        return from_bits(bits);
+    }
+
+    /* Apply the xor of the next value at pos to prev. */
+    void next_value(const std::vector<unsigned char>& packed, std::size_t& pos, std::uint64_t& prev) {
+        const int lead = packed[pos] >> 4;
+        const int trail = packed[pos] & 0x0f;
+        pos++;
+
+        std::uint64_t x = 0;
+        for (int b = trail; b < 8 - lead; b++)
+            x |= static_cast<std::uint64_t>(packed[pos++]) << (8 * b);
+
+        prev ^= x;
+    }
+
+    void unpack(const std::vector<unsigned char>& packed, std::size_t count, double* values) {
+        if (packed[0] == constant_chunk) {
+            std::fill(values, values + count, constant_value(packed));
+            return;
+        }
+
+        std::size_t pos = 1;
+        std::uint64_t prev = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            next_value(packed, pos, prev);
+            values[i] = from_bits(prev);
+        }
+    }
+
+    /*
+      The value at index of a packed chunk; the values after it are not
+      unpacked.
+    */
+    double unpack_value(const std::vector<unsigned char>& packed, std::size_t index) {
+        if (packed[0] == constant_chunk)
+            return constant_value(packed);
+
+        std::size_t pos = 1;
+        std::uint64_t prev = 0;
+        for (std::size_t i = 0; i <= index; i++)
+            next_value(packed, pos, prev);
+
+        return from_bits(prev);
+    }
+
+}
+
+
+const std::size_t SummaryStore::npos = static_cast<std::size_t>(-1);
+
+
+SummaryStore::SummaryStore(std::size_t chunk_rows_arg, bool compress_arg) :
+    rows_per_chunk(chunk_rows_arg),
+    compress(compress_arg)
+{
+    if (this->rows_per_chunk == 0)
+        throw std::invalid_argument("The chunks of the SummaryStore must hold at least one row");
+}
+
+
+void SummaryStore::append(int report_step, double secs_elapsed, const SummaryState& st) {
+    if (st.num_slots() < this->keys.size())
+        throw std::invalid_argument("The SummaryStore has " + std::to_string(this->keys.size())
+                                    + " columns but the SummaryState only " + std::to_string(st.num_slots())
+                                    + " keys - the store must be fed from one state");
+
+    if (!this->time_column.empty() && secs_elapsed < this->time_column.back())
+        throw std::invalid_argument("The elapsed time " + std::to_string(secs_elapsed)
+                                    + " precedes the last row of the SummaryStore");
+
+    for (std::size_t slot = this->keys.size(); slot < st.num_slots(); slot++)
+        this->add_column(st.key(slot));
+
+    const bool new_chunk = this->num_rows() % this->rows_per_chunk == 0;
+    for (std::size_t column = 0; column < this->keys.size(); column++) {
+        auto& column_chunks = this->chunks[column];
+        if (new_chunk) {
+            if (!column_chunks.empty())
+                this->seal(column_chunks.back());
+
+            column_chunks.emplace_back();
+            column_chunks.back().values.reserve(this->rows_per_chunk);
+        }
+
+        const double value = st.has(column) ? st.get(column) : std::numeric_limits<double>::quiet_NaN();
+        column_chunks.back().values.push_back(value);
+    }
+
+    this->time_column.push_back(secs_elapsed);
+    this->step_column.push_back(report_step);
+}
+
+
+/*
+  A column which is added after the first row is filled with NaN for the
+  existing rows; the full chunks of NaN are sealed at once.
+*/
+void SummaryStore::add_column(const std::string& key) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    const auto rows = this->num_rows();
+
+    this->columns.emplace(key, this->keys.size());
+    this->keys.push_back(key);
+    this->chunks.emplace_back();
+
+    auto& column_chunks = this->chunks.back();
+    for (std::size_t row = 0; row < rows; row += this->rows_per_chunk) {
+        column_chunks.emplace_back();
+        auto& chunk = column_chunks.back();
+        chunk.values.reserve(this->rows_per_chunk);
+        chunk.values.assign(std::min(this->rows_per_chunk, rows - row), nan);
+
+        if (chunk.values.size() == this->rows_per_chunk)
+            this->seal(chunk);
+    }
+}
+
+
+/*
+  A full chunk is packed when compression is enabled, and if that makes
+  it smaller.
+*/
+void SummaryStore::seal(Chunk& chunk) const {
+    if (!this->compress || chunk.values.empty())
+        return;
+
+    auto packed = pack(chunk.values);
+    if (packed.size() >= chunk.values.size() * sizeof(double))
+        return;
+
+    packed.shrink_to_fit();
+    chunk.packed.swap(packed);
+    std::vector<double>().swap(chunk.values);
+}
+
+
+const double* SummaryStore::chunk_values(const Chunk& chunk, std::vector<double>& buffer) const {
+    if (chunk.packed.empty())
+        return chunk.values.data();
+
+    buffer.resize(this->rows_per_chunk);
+    unpack(chunk.packed, this->rows_per_chunk, buffer.data());
+    return buffer.data();
+}
+
+
+std::size_t SummaryStore::num_rows() const {
+    return this->time_column.size();
+}
+
+
+std::size_t SummaryStore::num_columns() const {
+    return this->keys.size();
+}
+
+
+std::size_t SummaryStore::chunk_rows() const {
+    return this->rows_per_chunk;
+}
+
+
+std::size_t SummaryStore::index(const std::string& key) const {
+    const auto iter = this->columns.find(key);
+    if (iter == this->columns.end())
+        return npos;
+
+    return iter->second;
+}
+
+
+std::size_t SummaryStore::column_index(const std::string& key) const {
+    const auto column = this->index(key);
+    if (column == npos)
+        throw std::out_of_range("No such summary vector: " + key);
+
+    return column;
+}
+
+
+const std::string& SummaryStore::key(std::size_t column) const {
+    return this->keys.at(column);
+}
+
+
+bool SummaryStore::has(const std::string& key) const {
+    return this->index(key) != npos;
+}
+
+
+const std::vector<double>& SummaryStore::times() const {
+    return this->time_column;
+}
+
+
+const std::vector<int>& SummaryStore::report_steps() const {
+    return this->step_column;
+}
+
+
+std::pair<std::size_t, std::size_t> SummaryStore::rows(double first_time, double last_time) const {
+    const auto begin = this->time_column.begin();
+    const std::size_t first = std::lower_bound(begin, this->time_column.end(), first_time) - begin;
+    const std::size_t last = std::upper_bound(begin, this->time_column.end(), last_time) - begin;
+
+    return { first, std::max(first, last) };
+}
+
+
+double SummaryStore::get(std::size_t column, std::size_t row) const {
+    if (column >= this->num_columns() || row >= this->num_rows())
+        throw std::out_of_range("No value in column " + std::to_string(column) + " row " + std::to_string(row)
+                                + " of the SummaryStore");
+
+    const auto& chunk = this->chunks[column][row / this->rows_per_chunk];
+    const auto offset = row % this->rows_per_chunk;
+    if (chunk.packed.empty())
+        return chunk.values[offset];
+
+    return unpack_value(chunk.packed, offset);
+}
+
+
+double SummaryStore::get(const std::string& key, std::size_t row) const {
+    return this->get(this->column_index(key), row);
+}
+
+
+std::vector<double> SummaryStore::get(std::size_t column, std::size_t first_row, std::size_t last_row) const {
+    if (column >= this->num_columns() || first_row > last_row || last_row > this->num_rows())
+        throw std::out_of_range("No rows [" + std::to_string(first_row) + ", " + std::to_string(last_row)
+                                + ") in column " + std::to_string(column) + " of the SummaryStore");
+
+    std::vector<double> result;
+    result.reserve(last_row - first_row);
+
+    std::vector<double> buffer;
+    std::size_t row = first_row;
+    while (row < last_row) {
+        const auto chunk_index = row / this->rows_per_chunk;
+        const auto chunk_end = std::min(last_row, (chunk_index + 1) * this->rows_per_chunk);
+        const auto* values = this->chunk_values(this->chunks[column][chunk_index], buffer);
+
+        result.insert(result.end(),
+                      values + row % this->rows_per_chunk,
+                      values + (chunk_end - chunk_index * this->rows_per_chunk));
+        row = chunk_end;
+    }
+    return result;
+}
+
+
+std::vector<double> SummaryStore::get(const std::string& key, std::size_t first_row, std::size_t last_row) const {
+    return this->get(this->column_index(key), first_row, last_row);
+}
+
+
+void SummaryStore::export_table(const Visitor& visitor) const {
+    std::vector<double> buffer;
+    for (std::size_t column = 0; column < this->num_columns(); column++) {
+        const auto& column_chunks = this->chunks[column];
+        for (std::size_t chunk_index = 0; chunk_index < column_chunks.size(); chunk_index++) {
+            const auto& chunk = column_chunks[chunk_index];
+            const std::size_t count = chunk.packed.empty() ? chunk.values.size() : this->rows_per_chunk;
+
+            visitor(column, chunk_index * this->rows_per_chunk, this->chunk_values(chunk, buffer), count);
+        }
+    }
+}
+
+
+std::size_t SummaryStore::memory_usage() const {
+    std::size_t bytes = 0;
+    for (const auto& column_chunks : this->chunks) {
+        for (const auto& chunk : column_chunks)
+            bytes += chunk.values.capacity() * sizeof(double) + chunk.packed.capacity();
+    }
+    return bytes;
+}
+
+}
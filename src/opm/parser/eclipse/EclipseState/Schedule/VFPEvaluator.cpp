@@ -0,0 +1,396 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
+
+
+namespace Opm {
+
+namespace {
+
+    /*
+      Location of a coordinate on one axis: the lower end of the
+      interval, the relative position in the interval and the inverse
+      interval length. For an axis with a single point the coordinate is
+      always mapped to that point, and the upper interval end coincides
+      with the lower.
+    */
+    struct InterpData {
+        std::size_t index = 0;
+        double factor = 0.0;
+        double inv_dx = 0.0;
+        bool single = true;
+    };
+
+
+    bool inInterval(const std::vector<double>& axis, std::size_t i, double x) {
+        const std::size_t last = axis.size() - 2;
+        return (i == 0 || axis[i] <= x) && (i == last || x < axis[i + 1]);
+    }
+
+
+    InterpData findInterval(const std::vector<double>& axis, double x, std::size_t& hint) {
+        InterpData interp;
+        if (axis.size() == 1) {
+            hint = 0;
+            return interp;
+        }
+
+        const std::size_t last = axis.size() - 2;
+        std::size_t i = std::min(hint, last);
+        if (!inInterval(axis, i, x)) {
+            if (i < last && inInterval(axis, i + 1, x))
+                i += 1;
+            else if (i > 0 && inInterval(axis, i - 1, x))
+                i -= 1;
+            else {
+                const auto upper = std::upper_bound(axis.begin(), axis.end(), x);
+                const std::size_t pos = upper - axis.begin();
+                i = (pos == 0) ? 0 : std::min(pos - 1, last);
+            }
+        }
+
+        const double dx = axis[i + 1] - axis[i];
+        interp.index = i;
+        interp.inv_dx = 1.0 / dx;
+        interp.factor = (x - axis[i]) * interp.inv_dx;
+        interp.single = false;
+        hint = i;
+        return interp;
+    }
+
+
+    InterpData fixedPoint(std::size_t index) {
+        InterpData interp;
+        interp.index = index;
+        return interp;
+    }
+
+
+    /*
+      Multilinear interpolation in N dimensions, including the partial
+      derivatives with respect to each of the coordinates. The values at
+      the 2^N corners of the hypercube containing the coordinate are
+      gathered, with bit d of the corner number selecting the lower or
+      upper end of the interval in dimension d, and reduced by linear
+      interpolation one dimension at a time. The derivative with respect
+      to dimension d is the interval slope, which is carried through the
+      reduction of the remaining dimensions.
+    */
+    template <std::size_t N>
+    double interpolate(const std::vector<double>& data,
+                       const std::array<std::size_t, N>& strides,
+                       const std::array<InterpData, N>& interp,
+                       std::array<double, N>& deriv) {
+        const std::size_t num_corners = std::size_t(1) << N;
+        std::array<std::size_t, num_corners> offset;
+        offset[0] = 0;
+        for (std::size_t d = 0; d < N; d++)
+            offset[0] += interp[d].index * strides[d];
+
+        for (std::size_t d = 0; d < N; d++) {
+            const std::size_t width = std::size_t(1) << d;
+            const std::size_t step = interp[d].single ? 0 : strides[d];
+            for (std::size_t c = 0; c < width; c++)
+                offset[c + width] = offset[c] + step;
+        }
+
+        std::array<double, num_corners> value;
+        for (std::size_t c = 0; c < num_corners; c++)
+            value[c] = data[offset[c]];
+
+        std::array<std::array<double, num_corners / 2>, N> slope;
+        std::size_t n = num_corners;
+        for (std::size_t d = 0; d < N; d++) {
+            const std::size_t half = n / 2;
+            const double t = interp[d].factor;
+            for (std::size_t k = 0; k < d; k++) {
+                auto& sk = slope[k];
+                for (std::size_t i = 0; i < half; i++)
+                    sk[i] = sk[2*i] + t * (sk[2*i + 1] - sk[2*i]);
+            }
+
+            auto& sd = slope[d];
+            for (std::size_t i = 0; i < half; i++) {
+                const double diff = value[2*i + 1] - value[2*i];
+                sd[i] = diff * interp[d].inv_dx;
+                value[i] = value[2*i] + t * diff;
+            }
+            n = half;
+        }
+
+        for (std::size_t d = 0; d < N; d++)
+            deriv[d] = slope[d][0];
+
+        return value[0];
+    }
+
+
+    /*
+      Find the thp value giving the bottom hole pressure bhp, given the
+      bhp values at each of the thp axis points.
+    */
+    double invertTHP(const std::vector<double>& thp_axis,
+                     const std::vector<double>& bhp_values,
+                     double bhp,
+                     std::size_t& hint) {
+        const std::size_t nthp = thp_axis.size();
+        if (nthp == 1)
+            return thp_axis[0];
+
+        std::size_t i;
+        if (bhp <= bhp_values.front())
+            i = 0;
+        else if (bhp >= bhp_values.back())
+            i = nthp - 2;
+        else {
+            i = 0;
+            while (i < nthp - 2 && !(bhp_values[i] <= bhp && bhp <= bhp_values[i + 1]))
+                i++;
+        }
+        hint = i;
+
+        const double dbhp = bhp_values[i + 1] - bhp_values[i];
+        if (dbhp == 0.0)
+            return thp_axis[i];
+
+        const double factor = (bhp - bhp_values[i]) / dbhp;
+        return thp_axis[i] + factor * (thp_axis[i + 1] - thp_axis[i]);
+    }
+
+
+    void checkAxis(const std::vector<double>& axis, std::size_t extent, const std::string& name) {
+        if (axis.empty())
+            throw std::invalid_argument("VFP table " + name + " axis is empty");
+
+        if (axis.size() != extent)
+            throw std::invalid_argument("VFP table " + name + " axis does not match table dimensions");
+
+        if (!std::is_sorted(axis.begin(), axis.end()))
+            throw std::invalid_argument("VFP table " + name + " axis is not sorted");
+    }
+
+}
+
+
+    /*
+      The VFPPROD data is stored as table[thp][wfr][gfr][alq][flo]; the
+      flat data array uses the same ordering.
+    */
+    VFPProdEvaluator::VFPProdEvaluator(const VFPProdTable& table) :
+        m_table_num( table.getTableNum() ),
+        m_axes( {{ table.getFloAxis(), table.getTHPAxis(), table.getWFRAxis(), table.getGFRAxis(), table.getALQAxis() }} )
+    {
+        const auto& data = table.getTable();
+        checkAxis(m_axes[0], data.shape()[4], "FLO");
+        checkAxis(m_axes[1], data.shape()[0], "THP");
+        checkAxis(m_axes[2], data.shape()[1], "WFR");
+        checkAxis(m_axes[3], data.shape()[2], "GFR");
+        checkAxis(m_axes[4], data.shape()[3], "ALQ");
+
+        m_strides[0] = 1;
+        m_strides[4] = m_strides[0] * m_axes[0].size();
+        m_strides[3] = m_strides[4] * m_axes[4].size();
+        m_strides[2] = m_strides[3] * m_axes[3].size();
+        m_strides[1] = m_strides[2] * m_axes[2].size();
+
+        m_data.assign(data.data(), data.data() + data.num_elements());
+    }
+
+
+    VFPEvaluation VFPProdEvaluator::bhp(double flo, double thp_arg, double wfr, double gfr, double alq, VFPHint* hint) const {
+        VFPHint local_hint;
+        auto& index = (hint == nullptr) ? local_hint.index : hint->index;
+        const std::array<InterpData, 5> interp = {{ findInterval(m_axes[0], flo, index[0]),
+                                                    findInterval(m_axes[1], thp_arg, index[1]),
+                                                    findInterval(m_axes[2], wfr, index[2]),
+                                                    findInterval(m_axes[3], gfr, index[3]),
+                                                    findInterval(m_axes[4], alq, index[4]) }};
+        std::array<double, 5> deriv;
+        VFPEvaluation result;
+        result.value = interpolate<5>(m_data, m_strides, interp, deriv);
+        result.dflo = deriv[0];
+        result.dthp = deriv[1];
+        result.dwfr = deriv[2];
+        result.dgfr = deriv[3];
+        result.dalq = deriv[4];
+        return result;
+    }
+
+
+    double VFPProdEvaluator::thp(double flo, double wfr, double gfr, double alq, double bhp_arg, VFPHint* hint) const {
+        VFPHint local_hint;
+        auto& index = (hint == nullptr) ? local_hint.index : hint->index;
+        const auto& thp_axis = m_axes[1];
+        std::array<InterpData, 5> interp = {{ findInterval(m_axes[0], flo, index[0]),
+                                              InterpData(),
+                                              findInterval(m_axes[2], wfr, index[2]),
+                                              findInterval(m_axes[3], gfr, index[3]),
+                                              findInterval(m_axes[4], alq, index[4]) }};
+
+        std::array<double, 5> deriv;
+        std::vector<double> bhp_values(thp_axis.size());
+        for (std::size_t t = 0; t < thp_axis.size(); t++) {
+            interp[1] = fixedPoint(t);
+            bhp_values[t] = interpolate<5>(m_data, m_strides, interp, deriv);
+        }
+
+        return invertTHP(thp_axis, bhp_values, bhp_arg, index[1]);
+    }
+
+
+    void VFPProdEvaluator::bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& results, std::vector<VFPHint>& hints) const {
+        if (!hints.empty() && hints.size() != points.size())
+            throw std::invalid_argument("The number of hints must match the number of points");
+
+        const bool use_hints = !hints.empty();
+        results.resize(points.size());
+        const std::ptrdiff_t num_points = points.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_points > 4096)
+#endif
+        for (std::ptrdiff_t i = 0; i < num_points; i++) {
+            const auto& p = points[i];
+            results[i] = this->bhp(p.flo, p.thp, p.wfr, p.gfr, p.alq, use_hints ? &hints[i] : nullptr);
+        }
+    }
+
+
+    void VFPProdEvaluator::bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& results) const {
+        std::vector<VFPHint> hints;
+        this->bhp(points, results, hints);
+    }
+
+
+    void VFPProdEvaluator::thp(const std::vector<Point>& points, const std::vector<double>& bhp_values, std::vector<double>& results) const {
+        if (bhp_values.size() != points.size())
+            throw std::invalid_argument("The number of bhp values must match the number of points");
+
+        results.resize(points.size());
+        const std::ptrdiff_t num_points = points.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_points > 1024)
+#endif
+        for (std::ptrdiff_t i = 0; i < num_points; i++) {
+            const auto& p = points[i];
+            results[i] = this->thp(p.flo, p.wfr, p.gfr, p.alq, bhp_values[i]);
+        }
+    }
+
+
+    /*
+      The VFPINJ data is stored as table[thp][flo].
+    */
+    VFPInjEvaluator::VFPInjEvaluator(const VFPInjTable& table) :
+        m_table_num( table.getTableNum() ),
+        m_axes( {{ table.getFloAxis(), table.getTHPAxis() }} )
+    {
+        const auto& data = table.getTable();
+        checkAxis(m_axes[0], data.shape()[1], "FLO");
+        checkAxis(m_axes[1], data.shape()[0], "THP");
+
+        m_strides[0] = 1;
+        m_strides[1] = m_axes[0].size();
+
+        m_data.assign(data.data(), data.data() + data.num_elements());
+    }
+
+
+    VFPEvaluation VFPInjEvaluator::bhp(double flo, double thp_arg, VFPHint* hint) const {
+        VFPHint local_hint;
+        auto& index = (hint == nullptr) ? local_hint.index : hint->index;
+        const std::array<InterpData, 2> interp = {{ findInterval(m_axes[0], flo, index[0]),
+                                                    findInterval(m_axes[1], thp_arg, index[1]) }};
+        std::array<double, 2> deriv;
+        VFPEvaluation result;
+        result.value = interpolate<2>(m_data, m_strides, interp, deriv);
+        result.dflo = deriv[0];
+        result.dthp = deriv[1];
+        return result;
+    }
+
+
+    double VFPInjEvaluator::thp(double flo, double bhp_arg, VFPHint* hint) const {
+        VFPHint local_hint;
+        auto& index = (hint == nullptr) ? local_hint.index : hint->index;
+        const auto& thp_axis = m_axes[1];
+        std::array<InterpData, 2> interp = {{ findInterval(m_axes[0], flo, index[0]),
+                                              InterpData() }};
+
+        std::array<double, 2> deriv;
+        std::vector<double> bhp_values(thp_axis.size());
+        for (std::size_t t = 0; t < thp_axis.size(); t++) {
+            interp[1] = fixedPoint(t);
+            bhp_values[t] = interpolate<2>(m_data, m_strides, interp, deriv);
+        }
+
+        return invertTHP(thp_axis, bhp_values, bhp_arg, index[1]);
+    }
+
+
+    void VFPInjEvaluator::bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& results, std::vector<VFPHint>& hints) const {
+        if (!hints.empty() && hints.size() != points.size())
+            throw std::invalid_argument("The number of hints must match the number of points");
+
+        const bool use_hints = !hints.empty();
+        results.resize(points.size());
+        const std::ptrdiff_t num_points = points.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_points > 4096)
+#endif
+        for (std::ptrdiff_t i = 0; i < num_points; i++) {
+            const auto& p = points[i];
+            results[i] = this->bhp(p.flo, p.thp, use_hints ? &hints[i] : nullptr);
+        }
+    }
+
+
+    void VFPInjEvaluator::bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& results) const {
+        std::vector<VFPHint> hints;
+        this->bhp(points, results, hints);
+    }
+
+
+    void VFPInjEvaluator::thp(const std::vector<Point>& points, const std::vector<double>& bhp_values, std::vector<double>& results) const {
+        if (bhp_values.size() != points.size())
+            throw std::invalid_argument("The number of bhp values must match the number of points");
+
+        results.resize(points.size());
+        const std::ptrdiff_t num_points = points.size();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_points > 1024)
+#endif
+        for (std::ptrdiff_t i = 0; i < num_points; i++) {
+            const auto& p = points[i];
+            results[i] = this->thp(p.flo, bhp_values[i]);
+        }
+    }
+
+}
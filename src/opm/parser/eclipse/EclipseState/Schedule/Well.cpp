@@ -583,6 +583,10 @@ namespace Opm {
         return new WellConnections( this->m_headI[time_step], this->m_headJ[time_step]);
     }
 
+    WellConnections * Well::copyWellConnections(size_t time_step) {
+        return new WellConnections( this->getConnections(time_step), this->m_headI[time_step], this->m_headJ[time_step]);
+    }
+
     void Well::updateWellConnections(size_t time_step, WellConnections * new_set ){
         if( getWellConnectionOrdering() == WellCompletion::TRACK) {
             const auto headI = this->m_headI[ time_step ];
@@ -667,16 +671,15 @@ namespace Opm {
             return true;
         };
 
-        WellConnections * new_connections = this->newWellConnections(time_step);
         const int complnum = record.getItem("N").get<int>(0);
         if (complnum <= 0)
             throw std::invalid_argument("Completion number must be >= 1. COMPLNUM=" + std::to_string(complnum) + "is invalid");
 
-        for (auto c : this->getConnections(time_step)) {
-            if (match(c))
-                c.setComplnum( complnum );
-
-            new_connections->add(c);
+        WellConnections * new_connections = this->copyWellConnections(time_step);
+        for (size_t ic = 0; ic < new_connections->size(); ic++) {
+            const auto& c = new_connections->get(ic);
+            if (match(c) && c.complnum() != complnum)
+                new_connections->getMutable(ic).setComplnum( complnum );
         }
         this->updateWellConnections(time_step, new_connections);
     }
@@ -693,13 +696,11 @@ namespace Opm {
             return true;
         };
 
-        WellConnections * new_connections = this->newWellConnections(time_step);
-
-        for (auto c : this->getConnections(time_step)) {
-            if (match(c))
-                c.setState( status );
-
-            new_connections->add(c);
+        WellConnections * new_connections = this->copyWellConnections(time_step);
+        for (size_t ic = 0; ic < new_connections->size(); ic++) {
+            const auto& c = new_connections->get(ic);
+            if (match(c) && c.state() != status)
+                new_connections->getMutable(ic).setState( status );
         }
 
         this->updateWellConnections(time_step, new_connections);
@@ -742,14 +743,12 @@ namespace Opm {
             return true;
         };
 
-        WellConnections * new_connections = this->newWellConnections(time_step);
+        WellConnections * new_connections = this->copyWellConnections(time_step);
         double wellPi = record.getItem("WELLPI").get< double >(0);
 
-        for (auto c : this->getConnections(time_step)) {
-            if (match(c))
-                c.scaleWellPi( wellPi );
-
-            new_connections->add(c);
+        for (size_t ic = 0; ic < new_connections->size(); ic++) {
+            if (match(new_connections->get(ic)))
+                new_connections->getMutable(ic).scaleWellPi( wellPi );
         }
 
         this->updateWellConnections(time_step, new_connections);
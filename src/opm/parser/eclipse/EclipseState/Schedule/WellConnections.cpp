@@ -17,10 +17,13 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <limits>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 #include <opm/parser/eclipse/Units/Units.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
@@ -133,6 +136,16 @@ namespace {
         }
     }
 
+
+
+    WellConnections::WellConnections(const WellConnections& src, int headIArg, int headJArg) :
+        headI(headIArg),
+        headJ(headJArg),
+        m_size(src.m_size),
+        m_chunks(src.m_chunks)
+    {
+    }
+
     void WellConnections::addConnection(int i, int j , int k ,
                                         int complnum,
                                         double depth,
@@ -172,7 +185,7 @@ namespace {
 					const double segDistEnd,
 					const bool defaultSatTabId)
     {
-        int complnum = -(this->m_connections.size() + 1);
+        int complnum = -(this->m_size + 1);
         this->addConnection(i,
                             j,
                             k,
@@ -291,13 +304,13 @@ namespace {
 
 
         CF_done:
-            auto prev = std::find_if( this->m_connections.begin(),
-                                      this->m_connections.end(),
-                                      same_ijk );
+            auto prev_iter = std::find_if( this->begin(),
+                                           this->end(),
+                                           same_ijk );
 	    // Only add connection for active grid cells
             if (grid.cellActive(I, J, k)) {
-		if (prev == this->m_connections.end()) {
-		    std::size_t noConn = this->m_connections.size();
+		if (prev_iter == this->end()) {
+		    std::size_t noConn = this->m_size;
 		    totNC = noConn+1;
 		    this->addConnection(I,J,k,
                                     grid.getCellDepth( I,J,k ),
@@ -312,6 +325,7 @@ namespace {
 				    noConn, 0., 0., defaultSatTable);
 		} 
 		else {
+		    Connection * prev = &this->getMutable( prev_iter.pos );
 		    std::size_t noConn = prev->getSeqIndex();
 		    // The complnum value carries over; the rest of the state is fully specified by
 		    // the current COMPDAT keyword.
@@ -344,7 +358,7 @@ namespace {
 
 
     size_t WellConnections::size() const {
-        return m_connections.size();
+        return this->m_size;
     }
 
     const Connection& WellConnections::get(size_t index) const {
@@ -352,7 +366,33 @@ namespace {
     }
 
     const Connection& WellConnections::operator[](size_t index) const {
-        return this->m_connections.at(index);
+        if (index >= this->m_size)
+            throw std::out_of_range("Connection index " + std::to_string(index) + " out of range");
+
+        return (*this->m_chunks[index / chunkSize])[index % chunkSize];
+    }
+
+
+    Connection& WellConnections::getMutable(size_t index) {
+        if (index >= this->m_size)
+            throw std::out_of_range("Connection index " + std::to_string(index) + " out of range");
+
+        auto& chunk = this->m_chunks[index / chunkSize];
+        if (chunk.use_count() > 1)
+            chunk = std::make_shared< Chunk >( *chunk );
+
+        return (*chunk)[index % chunkSize];
+    }
+
+
+    std::size_t WellConnections::sharedChunks(const WellConnections& other) const {
+        std::size_t shared = 0;
+        const auto num_chunks = std::min(this->m_chunks.size(), other.m_chunks.size());
+        for (std::size_t ic = 0; ic < num_chunks; ++ic) {
+            if (this->m_chunks[ic] == other.m_chunks[ic])
+                shared++;
+        }
+        return shared;
     }
 
 
@@ -369,7 +409,7 @@ namespace {
     Connection& WellConnections::getFromIJK(const int i, const int j, const int k) {
       for (size_t ic = 0; ic < size(); ++ic) {
         if (get(ic).sameCoordinate(i, j, k)) {
-          return this->m_connections[ic];
+          return this->getMutable(ic);
         }
       }
       throw std::runtime_error(" the connection is not found! \n ");
@@ -377,7 +417,14 @@ namespace {
 
 
     void WellConnections::add( Connection connection ) {
-        m_connections.emplace_back( connection );
+        if (this->m_size % chunkSize == 0) {
+            this->m_chunks.push_back( std::make_shared< Chunk >() );
+            this->m_chunks.back()->reserve( chunkSize );
+        } else if (this->m_chunks.back().use_count() > 1)
+            this->m_chunks.back() = std::make_shared< Chunk >( *this->m_chunks.back() );
+
+        this->m_chunks.back()->emplace_back( connection );
+        this->m_size++;
     }
 
     bool WellConnections::allConnectionsShut( ) const {
@@ -385,8 +432,8 @@ namespace {
             return c.state() == WellCompletion::StateEnum::SHUT;
         };
 
-        return std::all_of( this->m_connections.begin(),
-                            this->m_connections.end(),
+        return std::all_of( this->begin(),
+                            this->end(),
                             shut );
     }
 
@@ -394,14 +441,14 @@ namespace {
 
     void WellConnections::orderConnections(size_t well_i, size_t well_j)
     {
-        if (m_connections.empty()) {
+        if (this->m_size == 0) {
             return;
         }
 
         // Find the first connection and swap it into the 0-position.
         const double surface_z = 0.0;
         size_t first_index = findClosestConnection(well_i, well_j, surface_z, 0);
-        std::swap(m_connections[first_index], m_connections[0]);
+        this->swapConnections(first_index, 0);
 
         // Repeat for remaining connections.
         //
@@ -409,25 +456,34 @@ namespace {
         // O(n^2) algorithm. However, it should be acceptable since
         // the expected number of connections is fairly low (< 100).
 
-        if( this->m_connections.empty() ) return;
-
-        for (size_t pos = 1; pos < m_connections.size() - 1; ++pos) {
-            const auto& prev = m_connections[pos - 1];
+        for (size_t pos = 1; pos < this->m_size - 1; ++pos) {
+            const auto& prev = this->get(pos - 1);
             const double prevz = prev.depth();
             size_t next_index = findClosestConnection(prev.getI(), prev.getJ(), prevz, pos);
-            std::swap(m_connections[next_index], m_connections[pos]);
+            this->swapConnections(next_index, pos);
         }
     }
 
 
 
+    // An already ordered connection set is left untouched, so that it
+    // keeps sharing its chunks with the connection set it was copied from.
+    void WellConnections::swapConnections(size_t index1, size_t index2) {
+        if (index1 == index2)
+            return;
+
+        std::swap(this->getMutable(index1), this->getMutable(index2));
+    }
+
+
+
     size_t WellConnections::findClosestConnection(int oi, int oj, double oz, size_t start_pos)
     {
         size_t closest = std::numeric_limits<size_t>::max();
         int min_ijdist2 = std::numeric_limits<int>::max();
         double min_zdiff = std::numeric_limits<double>::max();
-        for (size_t pos = start_pos; pos < m_connections.size(); ++pos) {
-            const auto& connection = m_connections[ pos ];
+        for (size_t pos = start_pos; pos < this->m_size; ++pos) {
+            const auto& connection = this->get( pos );
 
             const double depth = connection.depth();
             const int ci = connection.getI();
@@ -461,9 +517,15 @@ namespace {
 
 
     void WellConnections::filter(const EclipseGrid& grid) {
-        auto new_end = std::remove_if(m_connections.begin(),
-                                      m_connections.end(),
-                                      [&grid](const Connection& c) { return !grid.cellActive(c.getI(), c.getJ(), c.getK()); });
-        m_connections.erase(new_end, m_connections.end());
+        auto inactive = [&grid](const Connection& c) { return !grid.cellActive(c.getI(), c.getJ(), c.getK()); };
+        if (std::none_of(this->begin(), this->end(), inactive))
+            return;
+
+        WellConnections active(this->headI, this->headJ);
+        for (const auto& c : *this) {
+            if (!inactive(c))
+                active.add(c);
+        }
+        *this = std::move(active);
     }
 }
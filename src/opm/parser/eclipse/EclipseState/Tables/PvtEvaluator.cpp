@@ -0,0 +1,475 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Tables/FlatTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtgTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtoTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtxTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableContainer.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+      Tables with more nodes than this are searched with bisection;
+      smaller tables - which is the common case for PVT tables - are
+      searched by counting the nodes at or below the argument.
+    */
+    const size_t max_linear_search = 32;
+
+
+    /*
+      The node at or below arg, i.e. the start of the interval containing
+      arg. Arguments below the first node map to node 0, and arguments at
+      or above the last node map to the last node.
+    */
+    size_t findNode(const double* args, size_t n, double arg) {
+        if (n > max_linear_search) {
+            const size_t pos = std::upper_bound(args, args + n, arg) - args;
+            return (pos == 0) ? 0 : pos - 1;
+        }
+
+        size_t node = 0;
+        for (size_t k = 1; k < n; k++)
+            node += (arg >= args[k]);
+
+        return node;
+    }
+
+
+    void findNodes(const double* args, size_t n, const std::vector<double>& x, std::vector<size_t>& nodes) {
+        const size_t size = x.size();
+        nodes.assign(size, 0);
+        if (n > max_linear_search) {
+            for (size_t j = 0; j < size; j++)
+                nodes[j] = findNode(args, n, x[j]);
+            return;
+        }
+
+        for (size_t k = 1; k < n; k++) {
+            const double node_arg = args[k];
+            for (size_t j = 0; j < size; j++)
+                nodes[j] += (x[j] >= node_arg);
+        }
+    }
+
+
+    /*
+      Evaluate a table stored as node values and interval slopes. The
+      slope of the last node is zero, so arguments beyond the last node
+      evaluate to the last value; arguments below the first node are
+      clamped explicitly.
+    */
+    double evalNode(const double* args, const double* values, const double* slopes, size_t node, double arg, double* derivative) {
+        const double x = std::max(arg, args[0]);
+        if (derivative)
+            *derivative = (arg >= args[0]) ? slopes[node] : 0.0;
+
+        return values[node] + slopes[node] * (x - args[node]);
+    }
+
+
+    double evalTable(const double* args, const double* values, const double* slopes, size_t n, double arg, double* derivative) {
+        return evalNode(args, values, slopes, findNode(args, n, arg), arg, derivative);
+    }
+
+
+    /*
+      Append the rows of table to the flat arrays, ordered by increasing
+      argument value.
+    */
+    void appendTable(const SimpleTable& table,
+                     std::vector<double>& args,
+                     std::vector<std::vector<double>>& values,
+                     std::vector<std::vector<double>>& slopes) {
+        const size_t num_rows = table.numRows();
+        if (num_rows == 0)
+            throw std::invalid_argument("Can not compile an empty table");
+
+        const auto& arg_column = table.getColumn(0);
+        bool increasing = true;
+        bool decreasing = true;
+        for (size_t row = 1; row < num_rows; row++) {
+            increasing = increasing && (arg_column[row] > arg_column[row - 1]);
+            decreasing = decreasing && (arg_column[row] < arg_column[row - 1]);
+        }
+        if (!increasing && !decreasing)
+            throw std::invalid_argument("The argument column " + arg_column.name() + " must be strictly monotone");
+
+        auto row_index = [=](size_t r) { return increasing ? r : num_rows - 1 - r; };
+
+        const size_t offset = args.size();
+        for (size_t r = 0; r < num_rows; r++)
+            args.push_back(arg_column[row_index(r)]);
+
+        values.resize(table.numColumns());
+        slopes.resize(table.numColumns());
+        for (size_t c = 0; c < table.numColumns(); c++) {
+            const auto& column = table.getColumn(c);
+            for (size_t r = 0; r < num_rows; r++)
+                values[c].push_back(column[row_index(r)]);
+
+            for (size_t r = 0; r + 1 < num_rows; r++) {
+                const size_t i = offset + r;
+                slopes[c].push_back((values[c][i + 1] - values[c][i]) / (args[i + 1] - args[i]));
+            }
+            slopes[c].push_back(0.0);
+        }
+    }
+
+
+    size_t columnIndex(const std::vector<std::string>& names, const std::string& name) {
+        const auto iter = std::find(names.begin(), names.end(), name);
+        if (iter == names.end())
+            throw std::invalid_argument("No such column: " + name);
+
+        return iter - names.begin();
+    }
+
+
+    std::vector<std::string> columnNames(const SimpleTable& table) {
+        std::vector<std::string> names;
+        for (size_t c = 0; c < table.numColumns(); c++)
+            names.push_back(table.getColumn(c).name());
+
+        return names;
+    }
+
+
+    void checkSize(const std::vector<double>& args1, const std::vector<double>& args2) {
+        if (args1.size() != args2.size())
+            throw std::invalid_argument("The argument vectors must have the same size");
+    }
+}
+
+
+    CompiledPvtTable::CompiledPvtTable(const SimpleTable& table) :
+        m_names( columnNames(table) )
+    {
+        appendTable(table, m_args, m_values, m_slopes);
+    }
+
+
+    size_t CompiledPvtTable::numRows() const {
+        return m_args.size();
+    }
+
+
+    size_t CompiledPvtTable::numColumns() const {
+        return m_names.size();
+    }
+
+
+    size_t CompiledPvtTable::column(const std::string& name) const {
+        return columnIndex(m_names, name);
+    }
+
+
+    double CompiledPvtTable::evaluate(size_t column, double arg) const {
+        return evalTable(m_args.data(), m_values.at(column).data(), m_slopes[column].data(), m_args.size(), arg, nullptr);
+    }
+
+
+    double CompiledPvtTable::evaluate(size_t column, double arg, double& derivative) const {
+        return evalTable(m_args.data(), m_values.at(column).data(), m_slopes[column].data(), m_args.size(), arg, &derivative);
+    }
+
+
+    void CompiledPvtTable::evaluate(size_t column, const std::vector<double>& args, std::vector<double>& values) const {
+        const double* node_args = m_args.data();
+        const double* node_values = m_values.at(column).data();
+        const double* node_slopes = m_slopes[column].data();
+        std::vector<size_t> nodes;
+        findNodes(node_args, m_args.size(), args, nodes);
+
+        values.resize(args.size());
+        for (size_t j = 0; j < args.size(); j++)
+            values[j] = evalNode(node_args, node_values, node_slopes, nodes[j], args[j], nullptr);
+    }
+
+
+    void CompiledPvtTable::evaluate(size_t column, const std::vector<double>& args, std::vector<double>& values, std::vector<double>& derivatives) const {
+        const double* node_args = m_args.data();
+        const double* node_values = m_values.at(column).data();
+        const double* node_slopes = m_slopes[column].data();
+        std::vector<size_t> nodes;
+        findNodes(node_args, m_args.size(), args, nodes);
+
+        values.resize(args.size());
+        derivatives.resize(args.size());
+        for (size_t j = 0; j < args.size(); j++)
+            values[j] = evalNode(node_args, node_values, node_slopes, nodes[j], args[j], &derivatives[j]);
+    }
+
+    /*****************************************************************/
+
+    CompiledPvtxTable::CompiledPvtxTable(const PvtxTable& table) :
+        m_names( columnNames(table.getUnderSaturatedTable(0)) ),
+        m_saturated( table.getSaturatedTable() )
+    {
+        for (size_t index = 0; index < table.size(); index++) {
+            m_outer.push_back(table.getArgValue(index));
+            m_offsets.push_back(m_inner.size());
+            appendTable(table.getUnderSaturatedTable(index), m_inner, m_values, m_slopes);
+        }
+        m_offsets.push_back(m_inner.size());
+    }
+
+
+    size_t CompiledPvtxTable::size() const {
+        return m_outer.size();
+    }
+
+
+    size_t CompiledPvtxTable::column(const std::string& name) const {
+        return columnIndex(m_names, name);
+    }
+
+
+    const CompiledPvtTable& CompiledPvtxTable::getSaturatedTable() const {
+        return m_saturated;
+    }
+
+
+    /*
+      Linear interpolation in the outer argument between the values of the
+      undersaturated tables on either side; the outer argument is clamped
+      to the range of the outer nodes.
+    */
+    double CompiledPvtxTable::evaluate(size_t column, double outerArg, double innerArg, double* dOuter, double* dInner) const {
+        const auto& values = m_values.at(column);
+        const auto& slopes = m_slopes[column];
+        auto inner = [&](size_t index, double* derivative) {
+            const size_t offset = m_offsets[index];
+            return evalTable(&m_inner[offset], &values[offset], &slopes[offset],
+                             m_offsets[index + 1] - offset, innerArg, derivative);
+        };
+
+        const size_t node = findNode(m_outer.data(), m_outer.size(), outerArg);
+        if (node + 1 == m_outer.size() || outerArg < m_outer[0]) {
+            if (dOuter)
+                *dOuter = 0.0;
+            return inner(node, dInner);
+        }
+
+        double d1, d2;
+        const double dx = m_outer[node + 1] - m_outer[node];
+        const double weight = (outerArg - m_outer[node]) / dx;
+        const double value1 = inner(node, &d1);
+        const double value2 = inner(node + 1, &d2);
+        if (dOuter)
+            *dOuter = (value2 - value1) / dx;
+        if (dInner)
+            *dInner = d1 + weight * (d2 - d1);
+
+        return value1 + weight * (value2 - value1);
+    }
+
+
+    double CompiledPvtxTable::evaluate(size_t column, double outerArg, double innerArg) const {
+        return this->evaluate(column, outerArg, innerArg, nullptr, nullptr);
+    }
+
+
+    double CompiledPvtxTable::evaluate(size_t column, double outerArg, double innerArg, double& dOuter, double& dInner) const {
+        return this->evaluate(column, outerArg, innerArg, &dOuter, &dInner);
+    }
+
+
+    void CompiledPvtxTable::evaluate(size_t column,
+                                     const std::vector<double>& outerArgs,
+                                     const std::vector<double>& innerArgs,
+                                     std::vector<double>& values) const {
+        checkSize(outerArgs, innerArgs);
+        values.resize(outerArgs.size());
+        for (size_t j = 0; j < outerArgs.size(); j++)
+            values[j] = this->evaluate(column, outerArgs[j], innerArgs[j], nullptr, nullptr);
+    }
+
+
+    void CompiledPvtxTable::evaluate(size_t column,
+                                     const std::vector<double>& outerArgs,
+                                     const std::vector<double>& innerArgs,
+                                     std::vector<double>& values,
+                                     std::vector<double>& dOuter,
+                                     std::vector<double>& dInner) const {
+        checkSize(outerArgs, innerArgs);
+        values.resize(outerArgs.size());
+        dOuter.resize(outerArgs.size());
+        dInner.resize(outerArgs.size());
+        for (size_t j = 0; j < outerArgs.size(); j++)
+            values[j] = this->evaluate(column, outerArgs[j], innerArgs[j], &dOuter[j], &dInner[j]);
+    }
+
+    /*****************************************************************/
+
+    CompiledPvtwTable::CompiledPvtwTable(const PvtwTable& table) {
+        for (const auto& record : table) {
+            m_refPressure.push_back(record.reference_pressure);
+            m_volumeFactor.push_back(record.volume_factor);
+            m_compressibility.push_back(record.compressibility);
+            m_viscosity.push_back(record.viscosity);
+            m_viscosibility.push_back(record.viscosibility);
+        }
+    }
+
+
+    size_t CompiledPvtwTable::size() const {
+        return m_refPressure.size();
+    }
+
+
+    struct CompiledPvtwTable::PvtwCoefficients {
+        double p_ref;
+        double b_ref;
+        double c;
+        double mu_ref;
+        double c_y;
+
+        double bw(double p, double& dbw) const {
+            const double x = c * (p - p_ref);
+            const double d = 1 + x * (1 + 0.5 * x);
+            dbw = -b_ref * c * (1 + x) / (d * d);
+            return b_ref / d;
+        }
+
+        double muw(double p, double& dmuw) const {
+            const double x = c * (p - p_ref);
+            const double y = c_y * (p - p_ref);
+            const double n = 1 + x * (1 + 0.5 * x);
+            const double d = 1 + y * (1 + 0.5 * y);
+            dmuw = mu_ref * (c * (1 + x) * d - n * c_y * (1 + y)) / (d * d);
+            return mu_ref * n / d;
+        }
+    };
+
+
+    CompiledPvtwTable::PvtwCoefficients CompiledPvtwTable::coefficients(size_t region) const {
+        return { m_refPressure.at(region), m_volumeFactor[region],
+                 m_compressibility[region], m_viscosity[region],
+                 m_compressibility[region] - m_viscosibility[region] };
+    }
+
+
+    double CompiledPvtwTable::formationVolumeFactor(size_t region, double pressure, double& derivative) const {
+        return this->coefficients(region).bw(pressure, derivative);
+    }
+
+
+    double CompiledPvtwTable::formationVolumeFactor(size_t region, double pressure) const {
+        double derivative;
+        return this->formationVolumeFactor(region, pressure, derivative);
+    }
+
+
+    double CompiledPvtwTable::viscosity(size_t region, double pressure, double& derivative) const {
+        return this->coefficients(region).muw(pressure, derivative);
+    }
+
+
+    double CompiledPvtwTable::viscosity(size_t region, double pressure) const {
+        double derivative;
+        return this->viscosity(region, pressure, derivative);
+    }
+
+
+    void CompiledPvtwTable::formationVolumeFactor(size_t region, const std::vector<double>& pressure, std::vector<double>& values, std::vector<double>& derivatives) const {
+        const auto coeff = this->coefficients(region);
+        values.resize(pressure.size());
+        derivatives.resize(pressure.size());
+        for (size_t j = 0; j < pressure.size(); j++)
+            values[j] = coeff.bw(pressure[j], derivatives[j]);
+    }
+
+
+    void CompiledPvtwTable::formationVolumeFactor(size_t region, const std::vector<double>& pressure, std::vector<double>& values) const {
+        std::vector<double> derivatives;
+        this->formationVolumeFactor(region, pressure, values, derivatives);
+    }
+
+
+    void CompiledPvtwTable::viscosity(size_t region, const std::vector<double>& pressure, std::vector<double>& values, std::vector<double>& derivatives) const {
+        const auto coeff = this->coefficients(region);
+        values.resize(pressure.size());
+        derivatives.resize(pressure.size());
+        for (size_t j = 0; j < pressure.size(); j++)
+            values[j] = coeff.muw(pressure[j], derivatives[j]);
+    }
+
+
+    void CompiledPvtwTable::viscosity(size_t region, const std::vector<double>& pressure, std::vector<double>& values) const {
+        std::vector<double> derivatives;
+        this->viscosity(region, pressure, values, derivatives);
+    }
+
+    /*****************************************************************/
+
+    CompiledPvtTables::CompiledPvtTables(const TableManager& tables) :
+        m_pvtw( tables.getPvtwTable() )
+    {
+        for (const auto& table : tables.getPvtoTables())
+            m_pvto.emplace_back(table);
+
+        for (const auto& table : tables.getPvtgTables())
+            m_pvtg.emplace_back(table);
+
+        const auto& pvdo = tables.getPvdoTables();
+        for (size_t index = 0; index < pvdo.size(); index++)
+            m_pvdo.emplace_back(pvdo.getTable(index));
+
+        const auto& pvdg = tables.getPvdgTables();
+        for (size_t index = 0; index < pvdg.size(); index++)
+            m_pvdg.emplace_back(pvdg.getTable(index));
+    }
+
+
+    const std::vector<CompiledPvtxTable>& CompiledPvtTables::getPvtoTables() const {
+        return m_pvto;
+    }
+
+
+    const std::vector<CompiledPvtxTable>& CompiledPvtTables::getPvtgTables() const {
+        return m_pvtg;
+    }
+
+
+    const std::vector<CompiledPvtTable>& CompiledPvtTables::getPvdoTables() const {
+        return m_pvdo;
+    }
+
+
+    const std::vector<CompiledPvtTable>& CompiledPvtTables::getPvdgTables() const {
+        return m_pvdg;
+    }
+
+
+    const CompiledPvtwTable& CompiledPvtTables::getPvtwTable() const {
+        return m_pvtw;
+    }
+}
@@ -27,7 +27,8 @@
 namespace Opm {
 
     TableColumn::TableColumn(const ColumnSchema& schema) :
-        m_schema( schema )
+        m_schema( schema ),
+        m_name( schema.name() )
     {
         m_defaultCount = 0;
     }
@@ -41,6 +41,7 @@
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Parser/ParserProfile.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawEnums.hpp>
@@ -207,8 +208,8 @@ void InputStack::push( std::string&& input, boost::filesystem::path p ) {
 
 class ParserState {
     public:
-        ParserState( const ParseContext&, ErrorGuard& );
-        ParserState( const ParseContext&, ErrorGuard&, boost::filesystem::path );
+        ParserState( const ParseContext&, ErrorGuard&, ParserProfile* );
+        ParserState( const ParseContext&, ErrorGuard&, ParserProfile*, boost::filesystem::path );
 
         void loadString( const std::string& );
         void loadFile( const boost::filesystem::path& );
@@ -240,6 +241,7 @@ class ParserState {
         Deck deck;
         const ParseContext& parseContext;
         ErrorGuard& errors;
+        ParserProfile* profile;
         bool unknown_keyword = false;
 };
 
@@ -274,22 +276,28 @@ void ParserState::closeFile() {
     this->input_stack.pop();
 }
 
-ParserState::ParserState(const ParseContext& __parseContext, ErrorGuard& errors) :
+ParserState::ParserState(const ParseContext& __parseContext, ErrorGuard& errors, ParserProfile* profile) :
     parseContext( __parseContext ),
-    errors( errors )
+    errors( errors ),
+    profile( profile )
 {}
 
 ParserState::ParserState( const ParseContext& context,
                           ErrorGuard& errors,
+                          ParserProfile* profile,
                           boost::filesystem::path p ) :
     rootPath( boost::filesystem::canonical( p ).parent_path() ),
     parseContext( context ),
-    errors( errors )
+    errors( errors ),
+    profile( profile )
 {
     openRootFile( p );
 }
 
 void ParserState::loadString(const std::string& input) {
+    if( this->profile )
+        this->profile->addFile( "", input.size() );
+
     this->input_stack.push( clean( input + "\n" ) );
 }
 
@@ -335,6 +343,9 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
         throw std::runtime_error( "Error when reading input file '"
                                 + inputFileCanonical.string() + "'" );
 
+    if( this->profile )
+        this->profile->addFile( inputFileCanonical.string(), readc );
+
     this->input_stack.push( clean( buffer ), inputFileCanonical );
 }
 
@@ -547,16 +558,34 @@ bool tryParseKeyword( ParserState& parserState, const Parser& parser ) {
     return false;
 }
 
+void profileRawKeyword( ParserProfile& profile, const RawKeyword& rawKeyword, const ParserProfile::Sample& tokenize ) {
+    const auto& name = rawKeyword.getKeywordName();
+    const auto& file = rawKeyword.getFilename();
+    profile.add( name, file, ParserProfile::Stage::Tokenize, tokenize );
+
+    size_t tokens = 0;
+    size_t bytes = 0;
+    for( const auto& record : rawKeyword ) {
+        tokens += record.size();
+        bytes += record.getRecordString().size();
+    }
+    profile.addKeyword( name, file, rawKeyword.size(), tokens, bytes );
+}
+
 bool parseState( ParserState& parserState, const Parser& parser ) {
 
     while( !parserState.done() ) {
 
         parserState.rawKeyword.reset();
 
+        const ParserProfile::Sample tokenize( parserState.profile );
         const bool streamOK = tryParseKeyword( parserState, parser );
         if( !parserState.rawKeyword && !streamOK )
             continue;
 
+        if( parserState.profile )
+            profileRawKeyword( *parserState.profile, *parserState.rawKeyword, tokenize );
+
         if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::end)
             return true;
 
@@ -588,7 +617,12 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
             const auto& kwname = parserState.rawKeyword->getKeywordName();
             const auto* parserKeyword = parser.getParserKeywordFromDeckName( kwname );
             try {
-                parserState.deck.addKeyword( parserKeyword->parse( parserState.parseContext, parserState.errors, parserState.rawKeyword ) );
+                auto deckKeyword = parserKeyword->parse( parserState.parseContext, parserState.errors, parserState.rawKeyword, parserState.profile );
+
+                const ParserProfile::Sample add( parserState.profile );
+                parserState.deck.addKeyword( std::move( deckKeyword ) );
+                if( parserState.profile )
+                    parserState.profile->add( kwname, parserState.rawKeyword->getFilename(), ParserProfile::Stage::AddKeyword, add );
             } catch (const std::exception& exc) {
                 /*
                   This catch-all of parsing errors is to be able to write a good
@@ -685,7 +719,11 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     }
 
     Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext, ErrorGuard& errors) const {
-        ParserState parserState( parseContext, errors, dataFileName );
+        return this->parseFile( dataFileName, parseContext, errors, nullptr );
+    }
+
+    Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext, ErrorGuard& errors, ParserProfile* profile) const {
+        ParserState parserState( parseContext, errors, profile, dataFileName );
         parseState( parserState, *this );
         applyUnitsToDeck( parserState.deck );
 
@@ -701,7 +739,11 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
 
 
     Deck Parser::parseString(const std::string &data, const ParseContext& parseContext, ErrorGuard& errors) const {
-        ParserState parserState( parseContext, errors );
+        return this->parseString( data, parseContext, errors, nullptr );
+    }
+
+    Deck Parser::parseString(const std::string &data, const ParseContext& parseContext, ErrorGuard& errors, ParserProfile* profile) const {
+        ParserState parserState( parseContext, errors, profile );
         parserState.loadString( data );
 
         parseState( parserState, *this );
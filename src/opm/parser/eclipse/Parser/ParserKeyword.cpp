@@ -29,6 +29,7 @@
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/Parser/ParserConst.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Parser/ParserProfile.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
@@ -479,10 +480,15 @@ void set_dimensions( ParserItem& item,
 
     DeckKeyword ParserKeyword::parse(const ParseContext& parseContext,
                                      ErrorGuard& errors,
-                                     std::shared_ptr< RawKeyword > rawKeyword) const {
+                                     std::shared_ptr< RawKeyword > rawKeyword,
+                                     ParserProfile* profile) const {
         if( !rawKeyword->isFinished() )
             throw std::invalid_argument("Tried to create a deck keyword from an incomplete raw keyword " + rawKeyword->getKeywordName());
 
+        const ParserProfile::Sample total( profile );
+        double scan_seconds = 0;
+        size_t scan_allocations = 0;
+
         DeckKeyword keyword( rawKeyword->getKeywordName() );
         keyword.setLocation( rawKeyword->getFilename(), rawKeyword->getLineNR() );
         keyword.setDataKeyword( isDataKeyword() );
@@ -492,7 +498,12 @@ void set_dimensions( ParserItem& item,
             if( m_records.size() == 0 && rawRecord.size() > 0 )
                 throw std::invalid_argument("Missing item information " + rawKeyword->getKeywordName());
 
-            keyword.addRecord( getRecord( record_nr ).parse( parseContext, errors, rawRecord ) );
+            const ParserProfile::Sample scan( profile );
+            auto record = getRecord( record_nr ).parse( parseContext, errors, rawRecord );
+            scan_seconds += scan.seconds();
+            scan_allocations += scan.allocations();
+
+            keyword.addRecord( std::move( record ) );
             record_nr++;
         }
 
@@ -507,6 +518,14 @@ void set_dimensions( ParserItem& item,
         if (this->m_keywordSizeType == UNKNOWN)
             keyword.setFixedSize( );
 
+        if (profile) {
+            const auto& name = rawKeyword->getKeywordName();
+            const auto& file = rawKeyword->getFilename();
+            profile->add( name, file, ParserProfile::Stage::Scan, scan_seconds, scan_allocations );
+            profile->add( name, file, ParserProfile::Stage::Keyword,
+                          total.seconds() - scan_seconds, total.allocations() - scan_allocations );
+        }
+
         return keyword;
     }
 
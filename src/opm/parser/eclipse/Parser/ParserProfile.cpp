@@ -0,0 +1,219 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <opm/parser/eclipse/Parser/ParserProfile.hpp>
+
+namespace Opm {
+
+    constexpr std::size_t ParserProfile::num_stages;
+
+
+    double ParserProfile::Cost::totalSeconds() const {
+        double sum = 0;
+        for (double s : this->seconds)
+            sum += s;
+        return sum;
+    }
+
+
+    std::size_t ParserProfile::Cost::totalAllocations() const {
+        std::size_t sum = 0;
+        for (std::size_t a : this->allocations)
+            sum += a;
+        return sum;
+    }
+
+
+    ParserProfile::Cost& ParserProfile::Cost::operator+=(const Cost& other) {
+        this->count += other.count;
+        this->records += other.records;
+        this->tokens += other.tokens;
+        this->bytes += other.bytes;
+        for (std::size_t stage = 0; stage < num_stages; stage++) {
+            this->seconds[stage] += other.seconds[stage];
+            this->allocations[stage] += other.allocations[stage];
+        }
+        return *this;
+    }
+
+
+    ParserProfile::Sample::Sample(const ParserProfile* profile) :
+        m_profile(profile)
+    {
+        if (m_profile) {
+            m_allocations = m_profile->allocationCount();
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+
+    double ParserProfile::Sample::seconds() const {
+        if (!m_profile)
+            return 0;
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+
+    std::size_t ParserProfile::Sample::allocations() const {
+        if (!m_profile)
+            return 0;
+
+        return m_profile->allocationCount() - m_allocations;
+    }
+
+
+    void ParserProfile::setAllocationCounter(std::function<std::size_t()> counter) {
+        m_allocationCounter = std::move(counter);
+    }
+
+
+    std::size_t ParserProfile::allocationCount() const {
+        return m_allocationCounter ? m_allocationCounter() : 0;
+    }
+
+
+    void ParserProfile::add(const std::string& keyword, const std::string& file, Stage stage, const Sample& sample) {
+        this->add(keyword, file, stage, sample.seconds(), sample.allocations());
+    }
+
+
+    void ParserProfile::add(const std::string& keyword, const std::string& file, Stage stage, double seconds, std::size_t allocations) {
+        const auto index = static_cast<std::size_t>(stage);
+        for (auto* cost : { &m_keywords[keyword], &m_files[file] }) {
+            cost->seconds[index] += seconds;
+            cost->allocations[index] += allocations;
+        }
+    }
+
+
+    void ParserProfile::addKeyword(const std::string& keyword, const std::string& file, std::size_t records, std::size_t tokens, std::size_t bytes) {
+        for (auto* cost : { &m_keywords[keyword], &m_files[file] }) {
+            cost->count += 1;
+            cost->records += records;
+            cost->tokens += tokens;
+        }
+        m_keywords[keyword].bytes += bytes;
+    }
+
+
+    void ParserProfile::addFile(const std::string& file, std::size_t bytes) {
+        m_files[file].bytes += bytes;
+    }
+
+
+    const std::map<std::string, ParserProfile::Cost>& ParserProfile::keywords() const {
+        return m_keywords;
+    }
+
+
+    const std::map<std::string, ParserProfile::Cost>& ParserProfile::files() const {
+        return m_files;
+    }
+
+
+    ParserProfile::Cost ParserProfile::total() const {
+        Cost sum;
+        for (const auto& pair : m_keywords)
+            sum += pair.second;
+        return sum;
+    }
+
+
+    const std::string& ParserProfile::stageName(Stage stage) {
+        static const std::string names[num_stages] = { "Tokenize", "Scan", "Keyword", "AddKeyword" };
+        return names[static_cast<std::size_t>(stage)];
+    }
+
+
+namespace {
+
+    void writeHeader(std::ostream& os, const std::string& first) {
+        os << std::left << std::setw(24) << first << std::right
+           << std::setw(8) << "Count"
+           << std::setw(10) << "Records"
+           << std::setw(12) << "Tokens"
+           << std::setw(10) << "KB";
+        for (std::size_t stage = 0; stage < ParserProfile::num_stages; stage++)
+            os << std::setw(12) << ParserProfile::stageName(static_cast<ParserProfile::Stage>(stage));
+        os << std::setw(12) << "Total [ms]"
+           << std::setw(14) << "Records/s"
+           << std::setw(12) << "Allocs" << std::endl;
+    }
+
+
+    void writeCost(std::ostream& os, const std::string& name, const ParserProfile::Cost& cost) {
+        const double total = cost.totalSeconds();
+        os << std::left << std::setw(24) << name << std::right
+           << std::setw(8) << cost.count
+           << std::setw(10) << cost.records
+           << std::setw(12) << cost.tokens
+           << std::setprecision(1) << std::setw(10) << cost.bytes / 1024.0
+           << std::setprecision(3);
+        for (double seconds : cost.seconds)
+            os << std::setw(12) << 1000 * seconds;
+        os << std::setw(12) << 1000 * total
+           << std::setprecision(0) << std::setw(14) << (total > 0 ? cost.records / total : 0.0)
+           << std::setw(12) << cost.totalAllocations() << std::endl;
+    }
+
+}
+
+
+    void ParserProfile::write(std::ostream& os, std::size_t max_keywords) const {
+        const auto flags = os.flags();
+        const auto precision = os.precision();
+        os << std::fixed;
+
+        std::vector<std::pair<std::string, Cost>> keywords(m_keywords.begin(), m_keywords.end());
+        std::sort(keywords.begin(), keywords.end(),
+                  [](const std::pair<std::string, Cost>& a, const std::pair<std::string, Cost>& b) {
+                      return a.second.totalSeconds() > b.second.totalSeconds();
+                  });
+
+        writeHeader(os, "Keyword");
+        for (std::size_t kw = 0; kw < std::min(max_keywords, keywords.size()); kw++)
+            writeCost(os, keywords[kw].first, keywords[kw].second);
+        writeCost(os, "Total", this->total());
+
+        os << std::endl;
+        writeHeader(os, "File");
+        for (const auto& pair : m_files) {
+            auto name = pair.first.empty() ? std::string("(string)") : pair.first;
+            if (name.size() > 23)
+                name = "..." + name.substr(name.size() - 20);
+            writeCost(os, name, pair.second);
+        }
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+
+    std::ostream& operator<<(std::ostream& os, const ParserProfile& profile) {
+        profile.write(os);
+        return os;
+    }
+}
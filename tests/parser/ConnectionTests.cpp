@@ -120,6 +120,36 @@ BOOST_AUTO_TEST_CASE(AddCompletionCopy) {
 }
 
 
+BOOST_AUTO_TEST_CASE(CopyOnWriteSharesChunks) {
+    Opm::WellCompletion::DirectionEnum dir = Opm::WellCompletion::DirectionEnum::Z;
+    Opm::WellConnections completionSet(1,1);
+    for (int k = 0; k < 200; k++)
+        completionSet.add( Opm::Connection( 1,1,k, k + 1, 0.0, Opm::WellCompletion::OPEN , 99.88, 355.113, 0.25, 0.0, 0.0, 0, dir,0,0., 0., true) );
+
+    Opm::WellConnections copy(completionSet, 2, 2);
+    BOOST_CHECK_EQUAL( 200U , copy.size() );
+    BOOST_CHECK( copy == completionSet );
+    BOOST_CHECK_EQUAL( 4U , copy.sharedChunks( completionSet ));
+
+    copy.getMutable(100).setState( Opm::WellCompletion::SHUT );
+    BOOST_CHECK_EQUAL( 3U , copy.sharedChunks( completionSet ));
+    BOOST_CHECK_EQUAL( Opm::WellCompletion::SHUT , copy.get(100).state() );
+    BOOST_CHECK_EQUAL( Opm::WellCompletion::OPEN , completionSet.get(100).state() );
+    BOOST_CHECK( copy != completionSet );
+
+    copy.add( Opm::Connection( 1,1,200, 201, 0.0, Opm::WellCompletion::OPEN , 99.88, 355.113, 0.25, 0.0, 0.0, 0, dir,0,0., 0., true) );
+    BOOST_CHECK_EQUAL( 201U , copy.size() );
+    BOOST_CHECK_EQUAL( 200U , completionSet.size() );
+    BOOST_CHECK_EQUAL( 2U , copy.sharedChunks( completionSet ));
+    BOOST_CHECK_THROW( completionSet.get(200) , std::out_of_range );
+
+    int k = 0;
+    for (const auto& c : copy)
+        BOOST_CHECK_EQUAL( k++ , c.getK() );
+    BOOST_CHECK_EQUAL( 201 , k );
+}
+
+
 BOOST_AUTO_TEST_CASE(ActiveCompletions) {
     Opm::EclipseGrid grid(10,20,20);
     Opm::WellCompletion::DirectionEnum dir = Opm::WellCompletion::DirectionEnum::Z;
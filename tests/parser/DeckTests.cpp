@@ -18,6 +18,7 @@
  */
 
 
+#include <iomanip>
 #include <stdexcept>
 #include <sstream>
 
@@ -25,11 +26,13 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <opm/common/utility/MessageBuffer.hpp>
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
@@ -164,6 +167,26 @@ BOOST_AUTO_TEST_CASE(keywordList_getbyindex_correctkeywordreturned) {
     BOOST_CHECK_EQUAL("TRULSX", deck.getKeyword(2).name());
 }
 
+BOOST_AUTO_TEST_CASE(copy_and_move_keep_index) {
+    Deck deck;
+    deck.addKeyword( DeckKeyword( "BKW" ) );
+    deck.addKeyword( DeckKeyword( "CKW" ) );
+    deck.addKeyword( DeckKeyword( "BKW" ) );
+
+    Deck copy( deck );
+    copy.addKeyword( DeckKeyword( "BKW" ) );
+    BOOST_CHECK_EQUAL( 2U, deck.count( "BKW" ) );
+    BOOST_CHECK_EQUAL( 3U, copy.count( "BKW" ) );
+    BOOST_CHECK_EQUAL( &copy.getKeyword( 2 ), &copy.getKeyword( "BKW", 1 ) );
+
+    Deck moved( std::move( copy ) );
+    BOOST_CHECK_EQUAL( 4U, moved.size() );
+    BOOST_CHECK_EQUAL( 3U, moved.count( "BKW" ) );
+    BOOST_CHECK_EQUAL( &moved.getKeyword( 3 ), &moved.getKeyword( "BKW" ) );
+    BOOST_CHECK_EQUAL( 0U, copy.size() );
+    BOOST_CHECK( !copy.hasKeyword( "BKW" ) );
+}
+
 BOOST_AUTO_TEST_CASE(set_and_get_data_file) {
     Deck deck;
     BOOST_CHECK_EQUAL("", deck.getDataFile());
@@ -690,6 +713,71 @@ BOOST_AUTO_TEST_CASE(RecordWrite) {
 }
 
 
+BOOST_AUTO_TEST_CASE(DeckOutputPacked) {
+    std::stringstream s;
+    {
+        DeckOutput out(s);
+        out.packed = true;
+        out.columns = 4;
+
+        out.start_keyword("KEYWORD");
+        out.start_record();
+        for (int i = 0; i < 3; i++)
+            out.write<double>(1);
+        out.write<int>(1);
+        out.write<double>(2.5);
+        out.write<double>(2.5);
+        out.stash_default( );
+        out.write<double>(0.1);
+        out.write<double>(1.0 / 3);
+        out.write<double>(-1e-20);
+        out.write<std::string>("NO");
+        out.write<std::string>("NO");
+        out.write<int>(7);
+        out.stash_default( );
+        out.end_record();
+        out.end_keyword(true);
+
+        BOOST_CHECK_EQUAL( s.str(), "" );
+    }
+
+    BOOST_CHECK_EQUAL( s.str(),
+                       "KEYWORD\n"
+                       "   4*1 2*2.5 1* 0.1\n"
+                       "   0.3333333333333333 -1e-20 'NO' 'NO'\n"
+                       "   7 /\n"
+                       "/\n");
+}
+
+
+BOOST_AUTO_TEST_CASE(DeckOutputPackedRoundTrip) {
+    std::stringstream deckData;
+    deckData << std::setprecision(17) << "RUNSPEC\nDIMENS\n 10 10 3 /\nOIL\nWATER\n"
+             << "GRID\nDX\n300*100 /\nDY\n300*100 /\nDZ\n300*10 /\nTOPS\n100*5000 /\n"
+             << "PORO\n";
+    for (int i = 0; i < 300; i++)
+        deckData << (i % 7 < 4 ? 0.25 : 0.1 + i / 3000.0 + 1e-13 * i) << "\n";
+    deckData << "/\nPERMX\n100*100 100*250.5 100*1e-3 /\n";
+
+    Parser parser;
+    const auto deck = parser.parseString( deckData.str() );
+
+    std::stringstream packed;
+    {
+        DeckOutput out(packed);
+        out.packed = true;
+        deck.write(out);
+    }
+    const auto copy = parser.parseString( packed.str() );
+
+    BOOST_CHECK_LT( packed.str().size(), deckData.str().size() );
+    BOOST_CHECK( packed.str().find("100*250.5") != std::string::npos );
+    BOOST_CHECK_EQUAL( deck.size(), copy.size() );
+    for (size_t index = 0; index < deck.size(); index++)
+        BOOST_CHECK( deck.getKeyword(index).equal( copy.getKeyword(index), false, false ) );
+}
+
+
 BOOST_AUTO_TEST_CASE(DeckItemEqual) {
     DeckItem item1("TEST1" , int());
     DeckItem item2("TEST2" , int());
@@ -722,3 +810,69 @@ BOOST_AUTO_TEST_CASE(DeckItemEqual) {
     BOOST_CHECK( item3.equal( item5 , false, true ));
     BOOST_CHECK( !item3.equal( item5 , false, false ));
 }
+
+
+BOOST_AUTO_TEST_CASE(PackUnpack) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "FIELD\n"
+        "DIMENS\n"
+        " 10 10 3 /\n"
+        "OIL\n"
+        "WATER\n"
+        "START\n"
+        "1 JAN 2018 /\n"
+        "GRID\n"
+        "DX\n"
+        "300*100 /\n"
+        "DY\n"
+        "300*100 /\n"
+        "DZ\n"
+        "300*10 /\n"
+        "TOPS\n"
+        "100*5000 /\n"
+        "PORO\n"
+        "300*0.25 /\n"
+        "PERMX\n"
+        "300*100 /\n"
+        "SCHEDULE\n"
+        "WELSPECS\n"
+        " 'P1' 'G1' 5 5 1* 'OIL' /\n"
+        "/\n"
+        "COMPDAT\n"
+        " 'P1' 5 5 1 3 'OPEN' 1* 1* 0.5 /\n"
+        "/\n"
+        "WCONPROD\n"
+        " 'P1' 'OPEN' 'ORAT' 1000 4* 500 /\n"
+        "/\n"
+        "TSTEP\n"
+        " 10 20 /\n";
+
+    Parser parser;
+    auto deck = parser.parseString( deckData );
+    deck.setDataFile( "/path/to/CASE.DATA" );
+
+    MessageBuffer buffer;
+    deck.pack( buffer );
+
+    Deck copy;
+    MessageBuffer received( buffer.bytes() );
+    copy.unpack( received );
+    BOOST_CHECK_EQUAL( 0U, received.remaining() );
+    BOOST_CHECK_EQUAL( deck.size(), copy.size() );
+    BOOST_CHECK_EQUAL( "/path/to", copy.getInputPath() );
+    BOOST_CHECK( deck.getActiveUnitSystem() == copy.getActiveUnitSystem() );
+    BOOST_CHECK( copy.getActiveUnitSystem().getType() == UnitSystem::UnitType::UNIT_TYPE_FIELD );
+    for (size_t index = 0; index < deck.size(); index++) {
+        const auto& keyword = deck.getKeyword( index );
+        const auto& other = copy.getKeyword( index );
+        BOOST_CHECK( keyword.equal( other, true, false ) );
+        BOOST_CHECK_EQUAL( keyword.getLineNumber(), other.getLineNumber() );
+    }
+
+    BOOST_CHECK_EQUAL( 1U, copy.count( "WELSPECS" ) );
+    BOOST_CHECK_EQUAL( 300U, copy.getKeyword( "PORO" ).getSIDoubleData().size() );
+    BOOST_CHECK_EQUAL( deck.getKeyword( "DZ" ).getSIDoubleData()[0], copy.getKeyword( "DZ" ).getSIDoubleData()[0] );
+
+    BOOST_CHECK_THROW( copy.unpack( buffer ), std::invalid_argument );
+}
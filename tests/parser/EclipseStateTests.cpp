@@ -19,6 +19,7 @@ along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 #define BOOST_TEST_MODULE EclipseStateTests
@@ -33,6 +34,7 @@ along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 #include <opm/parser/eclipse/EclipseState/SimulationConfig/SimulationConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/LoadReport.hpp>
 #include <opm/parser/eclipse/EclipseState/checkDeck.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
@@ -317,6 +319,80 @@ BOOST_AUTO_TEST_CASE(GetFaults) {
 }
 
 
+BOOST_AUTO_TEST_CASE(ConstructionReport) {
+    auto deck = createDeck();
+    ParseContext parseContext;
+    ErrorGuard errors;
+    LoadReport report;
+    EclipseState state( deck, parseContext, errors, &report, true );
+    EclipseState reference( deck );
+
+    for (const auto& phase : {"TableManager", "EclipseGrid", "Runspec", "EclipseConfig",
+                              "Eclipse3DProperties", "SimulationConfig", "TransMult", "Finalize"}) {
+        BOOST_CHECK( report.hasPhase( phase ) );
+        BOOST_CHECK( report.getPhase( phase ).seconds >= 0 );
+    }
+    BOOST_CHECK_THROW( report.getPhase( "NoSuchPhase" ), std::invalid_argument );
+    BOOST_CHECK( report.wallTime() <= report.elapsed() );
+
+    BOOST_CHECK_EQUAL( reference.getInputGrid().getCartesianSize(), state.getInputGrid().getCartesianSize() );
+    BOOST_CHECK_EQUAL( reference.getTitle(), state.getTitle() );
+    BOOST_CHECK_EQUAL( reference.getFaults().size(), state.getFaults().size() );
+    BOOST_CHECK_EQUAL( 0.25, state.getTransMult().getMultiplier( 4, 3, 0, FaceDir::XMinus ) );
+
+    std::stringstream ss;
+    ss << report;
+    BOOST_CHECK( ss.str().find( "Eclipse3DProperties" ) != std::string::npos );
+}
+
+
+BOOST_AUTO_TEST_CASE(ConstructionErrorsReachCaller) {
+    const std::string runspec = "RUNSPEC\n"
+                                "DIMENS\n"
+                                " 2 2 2 /\n"
+                                "TABDIMS\n"
+                                " 1* 1 /\n"
+                                "OIL\n";
+    const std::string grid = "GRID\n"
+                             "DX\n"
+                             "8*0.25 /\n"
+                             "DY\n"
+                             "8*0.25 /\n"
+                             "DZ\n"
+                             "8*0.25 /\n"
+                             "TOPS\n"
+                             "4*0.25 /\n";
+    /* No DZ and TOPS - the EclipseGrid can not be built. */
+    const std::string broken_grid = "GRID\n"
+                                    "DX\n"
+                                    "8*0.25 /\n"
+                                    "DY\n"
+                                    "8*0.25 /\n";
+    /* The volume factor of PVCDO can not be defaulted - the TableManager throws. */
+    const std::string broken_props = "PROPS\n"
+                                     "PVCDO\n"
+                                     " 3600 1* 1.6e-5 0.88 0.0 /\n";
+
+    Parser parser;
+    const auto good_deck = parser.parseString( runspec + grid );
+    const auto grid_deck = parser.parseString( runspec + broken_grid );
+    const auto table_deck = parser.parseString( runspec + grid + broken_props );
+    const auto both_deck = parser.parseString( runspec + broken_grid + broken_props );
+
+    for (const bool parallel : { false, true }) {
+        ParseContext parseContext;
+        ErrorGuard errors;
+        LoadReport report;
+
+        BOOST_CHECK_NO_THROW( EclipseState( good_deck, parseContext, errors, &report, parallel ) );
+        BOOST_CHECK_THROW( EclipseState( grid_deck, parseContext, errors, &report, parallel ), std::invalid_argument );
+        BOOST_CHECK_THROW( EclipseState( table_deck, parseContext, errors, &report, parallel ), std::invalid_argument );
+        BOOST_CHECK_THROW( EclipseState( both_deck, parseContext, errors, nullptr, parallel ), std::invalid_argument );
+        errors.clear();
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(FaceTransMults) {
     auto deck = createDeckNoFaults();
     EclipseState state(deck);
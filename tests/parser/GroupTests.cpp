@@ -33,6 +33,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Group.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/GroupHierarchy.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 
 using namespace Opm;
@@ -396,6 +397,56 @@ BOOST_AUTO_TEST_CASE(UpdateTree_AddFieldNode_Throws) {
     BOOST_CHECK_THROW(tree.update("FIELD"), std::invalid_argument );
 }
 
+BOOST_AUTO_TEST_CASE(GroupHierarchy_FromTree) {
+    GroupTree tree;
+    tree.update("PLATFORM");
+    tree.update("PG2", "PLATFORM");
+    tree.update("PG1", "PLATFORM");
+    tree.update("CG1", "PG1");
+    tree.update("CG2", "PG1");
+    tree.update("CG3", "PG2");
+
+    const GroupHierarchy hierarchy( tree );
+    BOOST_CHECK_EQUAL( 7U, hierarchy.size() );
+    BOOST_CHECK( hierarchy.exists( "PG1" ) );
+    BOOST_CHECK( !hierarchy.exists( "NO_SUCH_GROUP" ) );
+    BOOST_CHECK_THROW( hierarchy.index( "NO_SUCH_GROUP" ), std::out_of_range );
+    BOOST_CHECK_THROW( hierarchy.name( hierarchy.size() ), std::out_of_range );
+
+    const auto field = hierarchy.index( "FIELD" );
+    BOOST_CHECK_EQUAL( GroupHierarchy::NO_PARENT, hierarchy.parent( field ) );
+    BOOST_CHECK_EQUAL( 1U, hierarchy.ancestors( field ).size() );
+
+    for( size_t g = 0; g < hierarchy.size(); g++ ) {
+        const auto& name = hierarchy.name( g );
+        BOOST_CHECK_EQUAL( g, hierarchy.index( name ) );
+        if( g != field )
+            BOOST_CHECK_EQUAL( tree.parent( name ), hierarchy.name( hierarchy.parent( g ) ) );
+
+        std::vector< std::string > children;
+        for( size_t child : hierarchy.children( g ) )
+            children.push_back( hierarchy.name( child ) );
+        const auto expected = tree.children( name );
+        BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(), children.begin(), children.end() );
+
+        const auto ancestors = hierarchy.ancestors( g );
+        BOOST_CHECK_EQUAL( g, ancestors[0] );
+        BOOST_CHECK_EQUAL( field, ancestors[ancestors.size() - 1] );
+        for( size_t a = 1; a < ancestors.size(); a++ )
+            BOOST_CHECK_EQUAL( hierarchy.parent( ancestors[a - 1] ), static_cast< int >( ancestors[a] ) );
+    }
+
+    std::vector< std::string > below_platform;
+    for( size_t g : hierarchy.descendants( hierarchy.index( "PLATFORM" ) ) )
+        below_platform.push_back( hierarchy.name( g ) );
+    const std::vector< std::string > expected = { "PG1", "CG1", "CG2", "PG2", "CG3" };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(), below_platform.begin(), below_platform.end() );
+
+    BOOST_CHECK( hierarchy == GroupHierarchy( tree ) );
+    tree.update( "CG3", "PG1" );
+    BOOST_CHECK( hierarchy != GroupHierarchy( tree ) );
+}
+
 BOOST_AUTO_TEST_CASE(createDeckWithGRUPNET) {
         Opm::Parser parser;
         std::string input =
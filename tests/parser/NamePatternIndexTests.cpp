@@ -0,0 +1,71 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE NamePatternIndexTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Util/NamePatternIndex.hpp>
+
+
+BOOST_AUTO_TEST_CASE( prefix_pattern ) {
+    BOOST_CHECK( Opm::NamePatternIndex::isPrefixPattern("PROD*"));
+    BOOST_CHECK( Opm::NamePatternIndex::isPrefixPattern("*"));
+    BOOST_CHECK( !Opm::NamePatternIndex::isPrefixPattern("PROD"));
+    BOOST_CHECK( !Opm::NamePatternIndex::isPrefixPattern(""));
+    BOOST_CHECK( !Opm::NamePatternIndex::isPrefixPattern("P?OD*"));
+    BOOST_CHECK( !Opm::NamePatternIndex::isPrefixPattern("P[AB]*"));
+    BOOST_CHECK( !Opm::NamePatternIndex::isPrefixPattern("*PROD*"));
+}
+
+
+BOOST_AUTO_TEST_CASE( match_in_insertion_order ) {
+    Opm::NamePatternIndex index;
+    index.insert("PROD2", 0);
+    index.insert("INJ1",  1);
+    index.insert("PROD1", 2);
+    index.insert("PRO",   3);
+
+    const std::vector<std::size_t> prod = {0, 2};
+    const auto& m1 = index.match("PROD*");
+    BOOST_CHECK_EQUAL_COLLECTIONS( m1.begin(), m1.end(), prod.begin(), prod.end());
+
+    const std::vector<std::size_t> pro = {0, 2, 3};
+    const auto& m2 = index.match("PRO*");
+    BOOST_CHECK_EQUAL_COLLECTIONS( m2.begin(), m2.end(), pro.begin(), pro.end());
+
+    const std::vector<std::size_t> all = {0, 1, 2, 3};
+    const auto& m3 = index.match("*");
+    BOOST_CHECK_EQUAL_COLLECTIONS( m3.begin(), m3.end(), all.begin(), all.end());
+
+    BOOST_CHECK( index.match("X*").empty());
+}
+
+
+BOOST_AUTO_TEST_CASE( insert_invalidates_cache ) {
+    Opm::NamePatternIndex index;
+    index.insert("W1", 0);
+    BOOST_CHECK_EQUAL( index.match("W*").size(), 1U);
+
+    index.insert("W2", 1);
+    BOOST_CHECK_EQUAL( index.match("W*").size(), 2U);
+    BOOST_CHECK_EQUAL( index.size(), 2U);
+}
@@ -27,6 +27,7 @@
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
+#include <opm/parser/eclipse/Parser/ParserProfile.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
@@ -2059,3 +2060,54 @@ DENSITY
         BOOST_CHECK_CLOSE( pbub.getSIDouble( 0 ), 6.515545642044100e+06, 1.0e-10 );
     }
 }
+
+
+BOOST_AUTO_TEST_CASE(ParserProfileAttributesKeywords) {
+    const std::string input = R"(
+RUNSPEC
+DIMENS
+  2 2 1 /
+GRID
+PORO
+  0.1 0.2 0.3 0.4 /
+PERMX
+  4*100 /
+)";
+
+    Parser parser;
+    ParseContext parseContext;
+    ErrorGuard errors;
+    ParserProfile profile;
+    std::size_t counter = 0;
+    profile.setAllocationCounter([&counter]() { return counter++; });
+
+    const auto deck = parser.parseString(input, parseContext, errors, &profile);
+    BOOST_CHECK_EQUAL(deck.size(), parser.parseString(input).size());
+
+    const auto& keywords = profile.keywords();
+    BOOST_CHECK_EQUAL(keywords.size(), 5U);
+    for (const auto& name : {"RUNSPEC", "DIMENS", "GRID", "PORO", "PERMX"})
+        BOOST_CHECK_EQUAL(keywords.count(name), 1U);
+
+    const auto& dimens = keywords.at("DIMENS");
+    BOOST_CHECK_EQUAL(dimens.count, 1U);
+    BOOST_CHECK_EQUAL(dimens.records, 1U);
+    BOOST_CHECK_EQUAL(dimens.tokens, 3U);
+
+    const auto& poro = keywords.at("PORO");
+    BOOST_CHECK_EQUAL(poro.tokens, 4U);
+    BOOST_CHECK(poro.bytes > 0);
+    for (double seconds : poro.seconds)
+        BOOST_CHECK(seconds >= 0);
+    BOOST_CHECK(poro.totalAllocations() > 0);
+
+    const auto& files = profile.files();
+    BOOST_CHECK_EQUAL(files.size(), 1U);
+    BOOST_CHECK_EQUAL(files.at("").bytes, input.size());
+    BOOST_CHECK_EQUAL(files.at("").count, 5U);
+    BOOST_CHECK_EQUAL(profile.total().count, 5U);
+
+    std::stringstream ss;
+    ss << profile;
+    BOOST_CHECK(ss.str().find("PERMX") != std::string::npos);
+}
@@ -0,0 +1,279 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE PvtEvaluatorTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/FlatTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtgTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/PvtoTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/SimpleTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableContainer.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    TableManager makeTables() {
+        const char* deckData =
+            "TABDIMS\n"
+            "1 1 /\n"
+            "\n"
+            "PVTO\n"
+            " 10   50  1.10  1.5\n"
+            "     100  1.08  1.7\n"
+            "     200  1.05  2.0 /\n"
+            " 30  100  1.20  1.2\n"
+            "     150  1.18  1.3 /\n"
+            " 60  180  1.30  1.0\n"
+            "     250  1.27  1.1\n"
+            "     300  1.25  1.3 /\n"
+            "/\n"
+            "\n"
+            "PVTG\n"
+            " 50   0.0010  0.020  0.015\n"
+            "      0.0005  0.021  0.016\n"
+            "      0.0     0.022  0.017 /\n"
+            " 150  0.0020  0.008  0.020\n"
+            "      0.0     0.009  0.021 /\n"
+            "/\n"
+            "\n"
+            "PVDO\n"
+            " 50   1.10  1.0\n"
+            " 100  1.05  1.2\n"
+            " 300  1.01  1.6 /\n"
+            "\n"
+            "PVDG\n"
+            " 50   0.020  0.015\n"
+            " 150  0.008  0.020\n"
+            " 250  0.005  0.025 /\n"
+            "\n"
+            "PVTW\n"
+            " 200  1.02  4.0E-05  0.5  1.0E-05 /\n";
+
+        Parser parser;
+        return TableManager( parser.parseString(deckData) );
+    }
+
+
+    /*
+      Points covering the range [first, last] of a table argument,
+      including points on the nodes and outside the range.
+    */
+    std::vector<double> samplePoints(const std::vector<double>& nodes) {
+        const double first = nodes.front();
+        const double last = nodes.back();
+        const double width = last - first;
+        std::vector<double> points = nodes;
+        for (int i = -5; i <= 25; i++)
+            points.push_back(first + width * i / 20.0);
+
+        return points;
+    }
+
+
+    std::vector<double> argValues(const SimpleTable& table) {
+        const auto& column = table.getColumn(0);
+        return std::vector<double>(column.begin(), column.end());
+    }
+
+
+    std::vector<double> outerValues(const PvtxTable& table) {
+        std::vector<double> values;
+        for (size_t index = 0; index < table.size(); index++)
+            values.push_back(table.getArgValue(index));
+
+        return values;
+    }
+
+
+    void checkSimpleTable(const SimpleTable& table, const CompiledPvtTable& compiled) {
+        BOOST_CHECK_EQUAL( table.numRows(), compiled.numRows() );
+        BOOST_CHECK_EQUAL( table.numColumns(), compiled.numColumns() );
+
+        const auto args = samplePoints(argValues(table));
+        for (size_t c = 1; c < table.numColumns(); c++) {
+            const std::string& name = table.getColumn(c).name();
+            const size_t column = compiled.column(name);
+            BOOST_CHECK_EQUAL( c, column );
+
+            std::vector<double> values, values2, derivatives;
+            compiled.evaluate(column, args, values);
+            compiled.evaluate(column, args, values2, derivatives);
+            for (size_t j = 0; j < args.size(); j++) {
+                double derivative;
+                const double value = compiled.evaluate(column, args[j], derivative);
+                BOOST_CHECK_CLOSE( table.evaluate(name, args[j]), value, 1e-10 );
+                BOOST_CHECK_EQUAL( value, values[j] );
+                BOOST_CHECK_EQUAL( value, values2[j] );
+                BOOST_CHECK_EQUAL( derivative, derivatives[j] );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( SimpleTables ) {
+    const auto tables = makeTables();
+    const CompiledPvtTables compiled(tables);
+
+    BOOST_CHECK_EQUAL( 1U, compiled.getPvdoTables().size() );
+    BOOST_CHECK_EQUAL( 1U, compiled.getPvdgTables().size() );
+    checkSimpleTable( tables.getPvdoTables().getTable(0), compiled.getPvdoTables()[0] );
+    checkSimpleTable( tables.getPvdgTables().getTable(0), compiled.getPvdgTables()[0] );
+    BOOST_CHECK_THROW( compiled.getPvdoTables()[0].column("NO_SUCH_COLUMN"), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE( SimpleTableDerivatives ) {
+    const auto tables = makeTables();
+    const auto& table = tables.getPvdoTables().getTable(0);
+    const CompiledPvtTable compiled(table);
+    const size_t bo = compiled.column("BO");
+    const auto nodes = argValues(table);
+
+    double derivative;
+    const double mid = 0.5 * (nodes[0] + nodes[1]);
+    compiled.evaluate(bo, mid, derivative);
+    BOOST_CHECK_CLOSE( (table.getColumn(1)[1] - table.getColumn(1)[0]) / (nodes[1] - nodes[0]), derivative, 1e-10 );
+
+    compiled.evaluate(bo, nodes.front() - 1, derivative);
+    BOOST_CHECK_EQUAL( 0, derivative );
+    compiled.evaluate(bo, nodes.back() + 1, derivative);
+    BOOST_CHECK_EQUAL( 0, derivative );
+}
+
+
+BOOST_AUTO_TEST_CASE( PvtxTables ) {
+    const auto tables = makeTables();
+    const CompiledPvtTables compiled(tables);
+
+    const std::vector<const PvtxTable*> source = { &tables.getPvtoTables()[0], &tables.getPvtgTables()[0] };
+    const std::vector<const CompiledPvtxTable*> target = { &compiled.getPvtoTables()[0], &compiled.getPvtgTables()[0] };
+    for (size_t t = 0; t < source.size(); t++) {
+        const auto& table = *source[t];
+        const auto& compiledTable = *target[t];
+        BOOST_CHECK_EQUAL( table.size(), compiledTable.size() );
+        checkSimpleTable( table.getSaturatedTable(), compiledTable.getSaturatedTable() );
+
+        const auto outer = samplePoints(outerValues(table));
+        std::vector<double> inner;
+        for (size_t index = 0; index < table.size(); index++) {
+            for (double arg : samplePoints(argValues(table.getUnderSaturatedTable(index))))
+                inner.push_back(arg);
+        }
+
+        const auto& first = table.getUnderSaturatedTable(0);
+        for (size_t c = 1; c < first.numColumns(); c++) {
+            const std::string& name = first.getColumn(c).name();
+            const size_t column = compiledTable.column(name);
+
+            std::vector<double> outerArgs, innerArgs;
+            for (double o : outer) {
+                for (double i : inner) {
+                    outerArgs.push_back(o);
+                    innerArgs.push_back(i);
+                }
+            }
+
+            std::vector<double> values, values2, dOuter, dInner;
+            compiledTable.evaluate(column, outerArgs, innerArgs, values);
+            compiledTable.evaluate(column, outerArgs, innerArgs, values2, dOuter, dInner);
+            for (size_t j = 0; j < outerArgs.size(); j++) {
+                const double value = compiledTable.evaluate(column, outerArgs[j], innerArgs[j]);
+                BOOST_CHECK_CLOSE( table.evaluate(name, outerArgs[j], innerArgs[j]), value, 1e-10 );
+                BOOST_CHECK_EQUAL( value, values[j] );
+                BOOST_CHECK_EQUAL( value, values2[j] );
+            }
+        }
+        BOOST_CHECK_THROW( compiledTable.evaluate(0, {1.0, 2.0}, {1.0}, inner), std::invalid_argument );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( PvtxDerivatives ) {
+    const auto tables = makeTables();
+    const auto& table = tables.getPvtoTables()[0];
+    const CompiledPvtxTable compiled(table);
+    const size_t bo = compiled.column("BO");
+    const auto outer = outerValues(table);
+
+    /*
+      Inside the table the derivatives are the slopes of a bilinear
+      function, and a central difference with a step inside the
+      interval is exact.
+    */
+    const double rs = 0.5 * (outer[0] + outer[1]);
+    const double p = table.getUnderSaturatedTable(0).getColumn(0)[1] * 1.01;
+    const double h = 1e-3 * (outer[1] - outer[0]);
+    const double hp = 1e-6 * p;
+
+    double dOuter, dInner;
+    compiled.evaluate(bo, rs, p, dOuter, dInner);
+    const double fdOuter = (compiled.evaluate(bo, rs + h, p) - compiled.evaluate(bo, rs - h, p)) / (2 * h);
+    const double fdInner = (compiled.evaluate(bo, rs, p + hp) - compiled.evaluate(bo, rs, p - hp)) / (2 * hp);
+    BOOST_CHECK_CLOSE( fdOuter, dOuter, 1e-4 );
+    BOOST_CHECK_CLOSE( fdInner, dInner, 1e-4 );
+
+    compiled.evaluate(bo, outer.back() * 2, p, dOuter, dInner);
+    BOOST_CHECK_EQUAL( 0, dOuter );
+}
+
+
+BOOST_AUTO_TEST_CASE( Pvtw ) {
+    const auto tables = makeTables();
+    const CompiledPvtTables compiled(tables);
+    const auto& pvtw = compiled.getPvtwTable();
+    const auto& record = tables.getPvtwTable()[0];
+    BOOST_CHECK_EQUAL( 1U, pvtw.size() );
+
+    std::vector<double> pressure;
+    for (int i = 0; i <= 10; i++)
+        pressure.push_back(record.reference_pressure * (0.5 + 0.1 * i));
+
+    std::vector<double> bw, dbw, muw, dmuw;
+    pvtw.formationVolumeFactor(0, pressure, bw, dbw);
+    pvtw.viscosity(0, pressure, muw, dmuw);
+    for (size_t j = 0; j < pressure.size(); j++) {
+        const double x = record.compressibility * (pressure[j] - record.reference_pressure);
+        const double y = (record.compressibility - record.viscosibility) * (pressure[j] - record.reference_pressure);
+        const double expected_bw = record.volume_factor / (1 + x + x*x/2);
+        const double expected_muw = record.viscosity * (1 + x + x*x/2) / (1 + y + y*y/2);
+        BOOST_CHECK_CLOSE( expected_bw, bw[j], 1e-10 );
+        BOOST_CHECK_CLOSE( expected_muw, muw[j], 1e-10 );
+        BOOST_CHECK_EQUAL( bw[j], pvtw.formationVolumeFactor(0, pressure[j]) );
+        BOOST_CHECK_EQUAL( muw[j], pvtw.viscosity(0, pressure[j]) );
+
+        const double h = 1e-4 * record.reference_pressure;
+        const double fd_bw = (pvtw.formationVolumeFactor(0, pressure[j] + h) - pvtw.formationVolumeFactor(0, pressure[j] - h)) / (2 * h);
+        const double fd_muw = (pvtw.viscosity(0, pressure[j] + h) - pvtw.viscosity(0, pressure[j] - h)) / (2 * h);
+        BOOST_CHECK_CLOSE( fd_bw, dbw[j], 1e-4 );
+        BOOST_CHECK_CLOSE( fd_muw, dmuw[j], 1e-4 );
+    }
+
+    BOOST_CHECK_THROW( pvtw.viscosity(1, 100.0), std::out_of_range );
+}
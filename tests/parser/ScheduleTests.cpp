@@ -17,8 +17,10 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 #define BOOST_TEST_MODULE ScheduleTests
@@ -26,6 +28,10 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
@@ -40,6 +46,8 @@
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Units/Dimension.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
@@ -382,6 +390,299 @@ BOOST_AUTO_TEST_CASE(CreateScheduleDeckWellsOrderedGRUPTREE) {
 }
 
 
+BOOST_AUTO_TEST_CASE(GroupHierarchySharedBetweenSteps) {
+    Opm::Parser parser;
+    std::string input =
+            "START             -- 0 \n"
+            "10 MAI 2007 / \n"
+            "SCHEDULE\n"
+            "GRUPTREE\n"
+            "  PG1 PLATFORM /\n"
+            "  CG1  PG1 /\n"
+            "/\n"
+            "WELSPECS\n"
+            "     \'W_1\'        \'CG1\'   30   37  3.33       \'OIL\'  7* /   \n"
+            "/\n"
+            "TSTEP\n"
+            "10 10 /\n"
+            "GRUPTREE\n"
+            "  CG1  PLATFORM /\n"
+            "/\n"
+            "TSTEP\n"
+            "10 /\n";
+
+    auto deck = parser.parseString(input);
+    EclipseGrid grid(100,100,100);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule schedule(deck, grid , eclipseProperties, runspec);
+
+    BOOST_CHECK_EQUAL( &schedule.getGroupHierarchy(0), &schedule.getGroupHierarchy(1) );
+    BOOST_CHECK( &schedule.getGroupHierarchy(1) != &schedule.getGroupHierarchy(2) );
+    BOOST_CHECK_EQUAL( &schedule.getGroupHierarchy(2), &schedule.getGroupHierarchy(3) );
+
+    const auto& before = schedule.getGroupHierarchy(0);
+    const auto& after = schedule.getGroupHierarchy(3);
+    BOOST_CHECK_EQUAL( "PG1", before.name( before.parent( before.index( "CG1" ))));
+    BOOST_CHECK_EQUAL( "PLATFORM", after.name( after.parent( after.index( "CG1" ))));
+    BOOST_CHECK_EQUAL( 4U, before.ancestors( before.index( "CG1" )).size() );
+    BOOST_CHECK_EQUAL( 3U, after.ancestors( after.index( "CG1" )).size() );
+
+    BOOST_CHECK_EQUAL( 1U, schedule.getWells( "PG1", 0 ).size() );
+    BOOST_CHECK_EQUAL( 0U, schedule.getWells( "PG1", 3 ).size() );
+    BOOST_CHECK_EQUAL( 1U, schedule.getWells( "PLATFORM", 3 ).size() );
+    BOOST_CHECK_EQUAL( 2U, schedule.getChildGroups( "PLATFORM", 3 ).size() );
+}
+
+BOOST_AUTO_TEST_CASE(WellKeywordsAppliedInDeckOrder) {
+    Opm::Parser parser;
+    std::string input =
+            "START             -- 0 \n"
+            "19 JUN 2007 / \n"
+            "SCHEDULE\n"
+            "WELSPECS\n"
+            "    'W_1'     'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "    'W_2'     'OP'   1   1 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "/\n"
+            "COMPDAT\n"
+            " 'W_1'  9  9   1   1 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+            " 'W_2'  1  1   1   1 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+            "/\n"
+            "WCONHIST\n"
+            " 'W*' 'OPEN' 'ORAT' 100 / \n"
+            "/\n"
+            "WELOPEN\n"
+            " 'W_1' 'SHUT' / \n"
+            "/\n"
+            "TSTEP             -- 1\n"
+            "10 /\n"
+            "WCONHIST\n"
+            " 'W_2' 'SHUT' 'ORAT' 100 / \n"
+            "/\n"
+            "WELOPEN\n"
+            " 'W_2' 'OPEN' / \n"
+            "/\n"
+            "WEFAC\n"
+            "   'W*' 0.5 / \n"
+            "/\n"
+            "WELSPECS\n"
+            "    'W_3'     'OP'   5   5 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "/\n"
+            "COMPDAT\n"
+            " 'W_3'  5  5   1   1 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'X'  22.100 / \n"
+            "/\n"
+            "TSTEP             -- 2\n"
+            "10 /\n"
+            "WELOPEN\n"
+            " 'W_2' 'SHUT' 1 1 1 / \n"
+            "/\n"
+            ;
+
+    auto deck = parser.parseString(input);
+    EclipseGrid grid(10,10,10);
+    TableManager table ( deck );
+    Eclipse3DProperties eclipseProperties ( deck , table, grid);
+    Runspec runspec (deck);
+    Schedule schedule(deck, grid , eclipseProperties, runspec);
+    const auto* well_1 = schedule.getWell("W_1");
+    const auto* well_2 = schedule.getWell("W_2");
+    const auto* well_3 = schedule.getWell("W_3");
+
+    // The keywords for one well are applied in deck order
+    BOOST_CHECK_EQUAL( WellCommon::SHUT, well_1->getStatus(0) );
+    BOOST_CHECK_EQUAL( WellCommon::OPEN, well_2->getStatus(0) );
+    BOOST_CHECK_EQUAL( WellCommon::OPEN, well_2->getStatus(1) );
+
+    // A well name pattern only matches the wells defined so far
+    BOOST_CHECK_EQUAL( 0.5, well_1->getEfficiencyFactor(1) );
+    BOOST_CHECK_EQUAL( 0.5, well_2->getEfficiencyFactor(1) );
+    BOOST_CHECK_EQUAL( 1.0, well_3->getEfficiencyFactor(1) );
+
+    // The well is shut at the end of the report step where all connections are shut
+    BOOST_CHECK_EQUAL( WellCommon::SHUT, well_2->getStatus(2) );
+    BOOST_CHECK_EQUAL( WellCommon::SHUT, well_1->getStatus(2) );
+}
+
+namespace {
+
+    /*
+      The state of all the wells at every report step, as text; the rates
+      are in SI units.
+    */
+    std::string wellStates(const Schedule& schedule) {
+        std::ostringstream os;
+        for (const auto* well : schedule.getWells()) {
+            for (size_t step = 0; step < schedule.getTimeMap().size(); step++) {
+                os << well->name() << " " << step << ":";
+                if (!well->hasBeenDefined(step)) {
+                    os << " -\n";
+                    continue;
+                }
+
+                os << " " << well->getGroupName(step)
+                   << " " << WellCommon::Status2String(well->getStatus(step))
+                   << " " << (well->isProducer(step) ? "P" : "I");
+                if (well->isProducer(step)) {
+                    const auto& prod = well->getProductionProperties(step);
+                    os << " " << WellProducer::ControlMode2String(prod.controlMode) << " " << prod.OilRate << " " << prod.LiquidRate;
+                } else {
+                    const auto& inj = well->getInjectionProperties(step);
+                    os << " " << WellInjector::ControlMode2String(inj.controlMode) << " " << inj.surfaceInjectionRate;
+                }
+
+                for (const auto& connection : well->getConnections(step))
+                    os << " " << connection.getI() << "," << connection.getJ() << "," << connection.getK()
+                       << "=" << WellCompletion::StateEnum2String(connection.state());
+                os << "\n";
+            }
+        }
+        return os.str();
+    }
+
+    Schedule makeSchedule(const Deck& deck, const ParseContext& parseContext = ParseContext()) {
+        EclipseGrid grid(10,10,10);
+        TableManager table ( deck );
+        Eclipse3DProperties eclipseProperties ( deck , table, grid);
+        Runspec runspec (deck);
+        ErrorGuard errors;
+        return Schedule(deck, grid , eclipseProperties, runspec, parseContext, errors);
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(WellKeywordsMatchDeckOrderProcessing) {
+    Opm::Parser parser;
+    std::string input =
+            "START             -- 0 \n"
+            "19 JUN 2007 / \n"
+            "SCHEDULE\n"
+            "WELSPECS\n"
+            "    'P1'  'G1'  1  1 1*  'OIL' / \n"
+            "    'P2'  'G1'  2  2 1*  'OIL' / \n"
+            "    'I1'  'G2'  5  5 1*  'WATER' / \n"
+            "/\n"
+            "COMPDAT\n"
+            " 'P*'  0  0  1  3 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'Z'  22.100 / \n"
+            " 'I1'  5  5  2  4 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'Z'  22.100 / \n"
+            "/\n"
+            "WCONPROD\n"
+            " 'P*' 'OPEN' 'ORAT' 1000 / \n"
+            "/\n"
+            "WCONINJE\n"
+            " 'I1' 'WATER' 'OPEN' 'RATE' 500 / \n"
+            "/\n"
+            "DATES             -- 1\n"
+            " 1 JUL 2007 / \n"
+            "/\n"
+            "WELOPEN\n"
+            " 'P1' 'SHUT' / \n"
+            " 'P2' 'SHUT' 2* 2 / \n"
+            "/\n"
+            "WCONPROD\n"
+            " 'P*' 'OPEN' 'LRAT' 1* 1* 1* 800 / \n"
+            "/\n"
+            "WELSPECS\n"
+            "    'P3'  'G1'  8  8 1*  'OIL' / \n"
+            "/\n"
+            "COMPDAT\n"
+            " 'P3'  8  8  1  1 'OPEN' 1*   32.948   0.311  3047.839 1*  1*  'Z'  22.100 / \n"
+            "/\n"
+            "WCONPROD\n"
+            " 'P*' 'OPEN' 'ORAT' 700 / \n"
+            "/\n"
+            "TSTEP             -- 2\n"
+            "10 /\n"
+            "WELOPEN\n"
+            " 'P*' 'OPEN' / \n"
+            " 'P2' 'SHUT' 2* 3 / \n"
+            " 'P3' 'SHUT' 2* 1 / \n"
+            "/\n"
+            "WCONINJE\n"
+            " 'I*' 'WATER' 'SHUT' 'RATE' 300 / \n"
+            "/\n"
+            "TSTEP             -- 3\n"
+            "10 /\n"
+            ;
+
+    const auto schedule = makeSchedule( parser.parseString(input) );
+    /* The states from applying the keywords one by one, in deck order. */
+    const std::string expected =
+        "P1 0: G1 OPEN P ORAT 0.0115741 0 0,0,0=OPEN 0,0,1=OPEN 0,0,2=OPEN\n"
+        "P1 1: G1 OPEN P ORAT 0.00810185 0 0,0,0=OPEN 0,0,1=OPEN 0,0,2=OPEN\n"
+        "P1 2: G1 OPEN P ORAT 0.00810185 0 0,0,0=OPEN 0,0,1=OPEN 0,0,2=OPEN\n"
+        "P1 3: G1 OPEN P ORAT 0.00810185 0 0,0,0=OPEN 0,0,1=OPEN 0,0,2=OPEN\n"
+        "P2 0: G1 OPEN P ORAT 0.0115741 0 1,1,0=OPEN 1,1,1=OPEN 1,1,2=OPEN\n"
+        "P2 1: G1 OPEN P ORAT 0.00810185 0 1,1,0=OPEN 1,1,1=SHUT 1,1,2=OPEN\n"
+        "P2 2: G1 OPEN P ORAT 0.00810185 0 1,1,0=OPEN 1,1,1=SHUT 1,1,2=SHUT\n"
+        "P2 3: G1 OPEN P ORAT 0.00810185 0 1,1,0=OPEN 1,1,1=SHUT 1,1,2=SHUT\n"
+        "I1 0: G2 OPEN I RATE 0.00578704 4,4,1=OPEN 4,4,2=OPEN 4,4,3=OPEN\n"
+        "I1 1: G2 OPEN I RATE 0.00578704 4,4,1=OPEN 4,4,2=OPEN 4,4,3=OPEN\n"
+        "I1 2: G2 SHUT I RATE 0.00347222 4,4,1=OPEN 4,4,2=OPEN 4,4,3=OPEN\n"
+        "I1 3: G2 SHUT I RATE 0.00347222 4,4,1=OPEN 4,4,2=OPEN 4,4,3=OPEN\n"
+        "P3 0: -\n"
+        "P3 1: G1 OPEN P ORAT 0.00810185 0 7,7,0=OPEN\n"
+        "P3 2: G1 SHUT P ORAT 0.00810185 0 7,7,0=SHUT\n"
+        "P3 3: G1 SHUT P ORAT 0.00810185 0 7,7,0=SHUT\n";
+
+    BOOST_CHECK_EQUAL( wellStates( schedule ), expected );
+
+#ifdef _OPENMP
+    /* The wells are processed in parallel; the result must not depend on the number of threads. */
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads( 1 );
+    const auto serial = makeSchedule( parser.parseString(input) );
+    omp_set_num_threads( std::max( threads, 4 ) );
+    const auto parallel = makeSchedule( parser.parseString(input) );
+    omp_set_num_threads( threads );
+    BOOST_CHECK_EQUAL( wellStates( serial ), wellStates( parallel ) );
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(WellKeywordErrorsInDeckOrder) {
+    Opm::Parser parser;
+    const std::string header =
+            "START             -- 0 \n"
+            "19 JUN 2007 / \n"
+            "SCHEDULE\n"
+            "WELSPECS\n"
+            "    'W_1'     'OP'   9   9 1*     'OIL' 1*      1*  1*   1*  1*   1*  1*  / \n"
+            "/\n";
+    const std::string bad_status =
+            "WELOPEN\n"
+            " 'W_1' 'FOO' / \n"
+            "/\n";
+    const std::string geo_modifier =
+            "MULTX\n"
+            " 1000*0.5 / \n";
+    const std::string bad_pattern =
+            "WCONPROD\n"
+            " 'X*' 'OPEN' 'ORAT' 1000 / \n"
+            "/\n";
+
+    ParseContext parseContext;
+    parseContext.update( ParseContext::UNSUPPORTED_SCHEDULE_GEO_MODIFIER, InputError::THROW_EXCEPTION );
+    parseContext.update( ParseContext::SCHEDULE_INVALID_NAME, InputError::THROW_EXCEPTION );
+
+    const auto message = [&](const std::string& input) -> std::string {
+        try {
+            makeSchedule( parser.parseString(input), parseContext );
+        } catch (const std::invalid_argument& e) {
+            return e.what();
+        }
+        return "";
+    };
+
+    /*
+      The well keywords are applied after the other keywords, but the
+      error reported is the first one in deck order.
+    */
+    BOOST_CHECK( message( header + bad_status + geo_modifier ).find( "FOO" ) != std::string::npos );
+    BOOST_CHECK( message( header + bad_status + bad_pattern ).find( "FOO" ) != std::string::npos );
+    BOOST_CHECK( message( header + geo_modifier + bad_status ).find( "MULTX" ) != std::string::npos );
+    BOOST_CHECK( message( header + bad_pattern + bad_status ).find( "X*" ) != std::string::npos );
+}
+
 BOOST_AUTO_TEST_CASE(CreateScheduleDeckWithStart) {
     auto deck = createDeck();
     EclipseGrid grid(10,10,10);
@@ -74,6 +74,46 @@ BOOST_AUTO_TEST_CASE(IteratorTest) {
     BOOST_CHECK_EQUAL(3, numberOfItems);
 }
 
+BOOST_AUTO_TEST_CASE(SectionOccurrences) {
+    Deck deck;
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+    deck.addKeyword( DeckKeyword( "RUNSPEC" ) );
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+    deck.addKeyword( DeckKeyword( "OTHER" ) );
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+    deck.addKeyword( DeckKeyword( "GRID" ) );
+    deck.addKeyword( DeckKeyword( "TEST" ) );
+
+    const Section runspec( deck, "RUNSPEC" );
+    const Section grid( deck, "GRID" );
+
+    BOOST_CHECK_EQUAL( 4U, runspec.size() );
+    BOOST_CHECK_EQUAL( 2U, runspec.count( "TEST" ) );
+    BOOST_CHECK_EQUAL( 1U, grid.count( "TEST" ) );
+    BOOST_CHECK_EQUAL( 0U, grid.count( "OTHER" ) );
+    BOOST_CHECK_EQUAL( 0U, runspec.count( "MISSING" ) );
+
+    const auto occurrences = runspec.occurrences( "TEST" );
+    BOOST_CHECK_EQUAL( 2U, occurrences.size() );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( 2 ), &occurrences.at( 0 ) );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( 4 ), &occurrences.back() );
+    BOOST_CHECK_THROW( occurrences.at( 2 ), std::out_of_range );
+
+    BOOST_CHECK( runspec.hasKeyword( deck.getKeyword( 2 ) ) );
+    BOOST_CHECK( !runspec.hasKeyword( deck.getKeyword( 0 ) ) );
+    BOOST_CHECK_EQUAL( &deck.getKeyword( 6 ), &grid.getKeyword( "TEST" ) );
+    BOOST_CHECK_EQUAL( "OTHER", runspec.getKeyword( 2 ).name() );
+    BOOST_CHECK_THROW( grid.getKeyword( 2 ), std::out_of_range );
+    BOOST_CHECK_THROW( grid.getKeyword( "OTHER" ), std::invalid_argument );
+
+    size_t num_test = 0;
+    for( const auto& kw : deck.occurrences( "TEST" ) ) {
+        BOOST_CHECK_EQUAL( "TEST", kw.name() );
+        num_test++;
+    }
+    BOOST_CHECK_EQUAL( 4U, num_test );
+}
+
 BOOST_AUTO_TEST_CASE(RUNSPECSection_EmptyDeck) {
     Deck deck;
     BOOST_REQUIRE_NO_THROW(RUNSPECSection section(deck));
@@ -0,0 +1,178 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE SummaryStoreTests
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryStore.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    /*
+      A constant, a smooth and a step function in time; the smooth one
+      does not pack well, the two others do.
+    */
+    void fill(SummaryStore& store, SummaryState& st, std::size_t rows) {
+        for (std::size_t row = 0; row < rows; row++) {
+            st.add("FOPR", 100.0);
+            st.add("WWCT:OP_1", std::sin(0.01 * row));
+            st.add("WBHP:OP_1", 200.0 + static_cast<double>(row / 50));
+            store.append(static_cast<int>(row / 10), 86400.0 * row, st);
+        }
+    }
+
+}
+
+
+BOOST_AUTO_TEST_CASE(AppendAndQuery) {
+    SummaryState st;
+    SummaryStore store(16);
+    fill(store, st, 1000);
+
+    BOOST_CHECK_EQUAL(store.num_rows(), 1000U);
+    BOOST_CHECK_EQUAL(store.num_columns(), 3U);
+    BOOST_CHECK_EQUAL(store.key(1), "WWCT:OP_1");
+    BOOST_CHECK(store.index("WWCT:OP_1") == 1U);
+    BOOST_CHECK(store.index("FGOR") == SummaryStore::npos);
+    BOOST_CHECK(!store.has("FGOR"));
+    BOOST_CHECK_EQUAL(store.report_steps()[999], 99);
+
+    for (std::size_t row = 0; row < 1000; row++) {
+        BOOST_CHECK_EQUAL(store.get("FOPR", row), 100.0);
+        BOOST_CHECK_EQUAL(store.get("WWCT:OP_1", row), std::sin(0.01 * row));
+        BOOST_CHECK_EQUAL(store.get(2, row), 200.0 + static_cast<double>(row / 50));
+    }
+
+    const auto range = store.rows(86400.0 * 10.5, 86400.0 * 40);
+    BOOST_CHECK_EQUAL(range.first, 11U);
+    BOOST_CHECK_EQUAL(range.second, 41U);
+
+    const auto wwct = store.get("WWCT:OP_1", range.first, range.second);
+    BOOST_CHECK_EQUAL(wwct.size(), 30U);
+    for (std::size_t i = 0; i < wwct.size(); i++)
+        BOOST_CHECK_EQUAL(wwct[i], std::sin(0.01 * (range.first + i)));
+
+    const auto empty = store.rows(86400.0 * 2000, 86400.0 * 3000);
+    BOOST_CHECK_EQUAL(empty.first, empty.second);
+    BOOST_CHECK(store.get("FOPR", empty.first, empty.second).empty());
+
+    BOOST_CHECK_THROW(store.get("FGOR", 0), std::out_of_range);
+    BOOST_CHECK_THROW(store.get("FOPR", 1000), std::out_of_range);
+    BOOST_CHECK_THROW(store.get("FOPR", 10, 1001), std::out_of_range);
+    BOOST_CHECK_THROW(store.append(0, 0.0, st), std::invalid_argument);
+    BOOST_CHECK_THROW(store.append(0, 86400.0 * 1000, SummaryState()), std::invalid_argument);
+    BOOST_CHECK_THROW(SummaryStore(0), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE(Compression) {
+    SummaryState st1, st2;
+    SummaryStore packed(16);
+    SummaryStore plain(16, false);
+    fill(packed, st1, 1000);
+    fill(plain, st2, 1000);
+
+    BOOST_CHECK(packed.memory_usage() < plain.memory_usage() / 2);
+    for (std::size_t column = 0; column < 3; column++) {
+        const auto p = packed.get(column, 0, 1000);
+        const auto u = plain.get(column, 0, 1000);
+        BOOST_CHECK(p == u);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(LateColumns) {
+    SummaryState st;
+    SummaryStore store(4);
+    st.add("FOPR", 1.0);
+    for (std::size_t row = 0; row < 10; row++)
+        store.append(1, row, st);
+
+    /* A registered key without a value is stored as NaN. */
+    st.add_key("FGPR");
+    st.add("FWPR", 2.0);
+    store.append(2, 10, st);
+
+    BOOST_CHECK_EQUAL(store.num_columns(), 3U);
+    const auto fwpr = store.get("FWPR", 0, 11);
+    for (std::size_t row = 0; row < 10; row++)
+        BOOST_CHECK(std::isnan(fwpr[row]));
+    BOOST_CHECK_EQUAL(fwpr[10], 2.0);
+    BOOST_CHECK(std::isnan(store.get("FGPR", 10)));
+    BOOST_CHECK_EQUAL(store.get("FOPR", 10), 1.0);
+
+    /* A value which is not set again for a row is NaN, not carried forward. */
+    st.clear_values();
+    st.add("FOPR", 3.0);
+    store.append(3, 11, st);
+    BOOST_CHECK(std::isnan(store.get("FWPR", 11)));
+    BOOST_CHECK_EQUAL(store.get("FOPR", 11), 3.0);
+}
+
+
+BOOST_AUTO_TEST_CASE(SingleValues) {
+    SummaryState st;
+    SummaryStore store(16);
+    fill(store, st, 100);
+
+    for (std::size_t column = 0; column < store.num_columns(); column++) {
+        const auto values = store.get(column, 0, store.num_rows());
+        for (std::size_t row = 0; row < store.num_rows(); row++)
+            BOOST_CHECK_EQUAL(store.get(column, row), values[row]);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ExportTable) {
+    SummaryState st;
+    SummaryStore store(16, false);
+    fill(store, st, 100);
+
+    std::vector<std::vector<double>> table(store.num_columns(), std::vector<double>(store.num_rows()));
+    std::size_t chunks = 0;
+    store.export_table([&](std::size_t column, std::size_t first_row, const double* values, std::size_t count) {
+        chunks++;
+        for (std::size_t i = 0; i < count; i++)
+            table[column][first_row + i] = values[i];
+    });
+
+    BOOST_CHECK_EQUAL(chunks, 3U * 7U);
+    for (std::size_t column = 0; column < store.num_columns(); column++)
+        BOOST_CHECK(table[column] == store.get(column, 0, store.num_rows()));
+
+    SummaryStore packed(16);
+    SummaryState st2;
+    fill(packed, st2, 100);
+
+    std::vector<double> fopr;
+    packed.export_table([&](std::size_t column, std::size_t, const double* values, std::size_t count) {
+        if (column == 0)
+            fopr.insert(fopr.end(), values, values + count);
+    });
+    BOOST_CHECK(fopr == std::vector<double>(100, 100.0));
+}
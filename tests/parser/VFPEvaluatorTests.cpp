@@ -0,0 +1,179 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE VFPEvaluatorTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPEvaluator.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
+
+namespace {
+
+    /*
+      Multilinear interpolation reproduces a multilinear function exactly,
+      also when extrapolating.
+    */
+    double prodFunc(double flo, double thp, double wfr, double gfr, double alq) {
+        return 1 + 2*flo + 3*thp + 5*wfr + 7*gfr + 11*alq + 0.5*flo*thp;
+    }
+
+    double injFunc(double flo, double thp) {
+        return 10 + 2*flo + 3*thp + 0.25*flo*thp;
+    }
+
+    Opm::VFPProdTable makeProdTable() {
+        std::vector<double> flo = {1, 2, 4, 8, 16};
+        std::vector<double> thp = {10, 20, 40};
+        std::vector<double> wfr = {0, 0.5};
+        std::vector<double> gfr = {100};
+        std::vector<double> alq = {0, 1, 3};
+
+        Opm::VFPProdTable::extents shape;
+        shape[0] = thp.size();
+        shape[1] = wfr.size();
+        shape[2] = gfr.size();
+        shape[3] = alq.size();
+        shape[4] = flo.size();
+        Opm::VFPProdTable::array_type data(shape);
+        for (std::size_t t = 0; t < thp.size(); t++)
+            for (std::size_t w = 0; w < wfr.size(); w++)
+                for (std::size_t g = 0; g < gfr.size(); g++)
+                    for (std::size_t a = 0; a < alq.size(); a++)
+                        for (std::size_t f = 0; f < flo.size(); f++)
+                            data[t][w][g][a][f] = prodFunc(flo[f], thp[t], wfr[w], gfr[g], alq[a]);
+
+        return Opm::VFPProdTable(1, 1000.0,
+                                 Opm::VFPProdTable::FLO_OIL,
+                                 Opm::VFPProdTable::WFR_WCT,
+                                 Opm::VFPProdTable::GFR_GOR,
+                                 Opm::VFPProdTable::ALQ_UNDEF,
+                                 flo, thp, wfr, gfr, alq, data);
+    }
+
+    Opm::VFPInjTable makeInjTable() {
+        std::vector<double> flo = {0, 10, 100};
+        std::vector<double> thp = {5, 50};
+
+        Opm::VFPInjTable::extents shape;
+        shape[0] = thp.size();
+        shape[1] = flo.size();
+        Opm::VFPInjTable::array_type data(shape);
+        for (std::size_t t = 0; t < thp.size(); t++)
+            for (std::size_t f = 0; f < flo.size(); f++)
+                data[t][f] = injFunc(flo[f], thp[t]);
+
+        return Opm::VFPInjTable(2, 1000.0, Opm::VFPInjTable::FLO_WAT, flo, thp, data);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( prod_bhp ) {
+    const auto table = makeProdTable();
+    const Opm::VFPProdEvaluator eval(table);
+    BOOST_CHECK_EQUAL( 1, eval.getTableNum() );
+
+    // Table node, interior, and extrapolated below and above the axes.
+    const std::vector<Opm::VFPProdEvaluator::Point> points = {{ {2, 20, 0.5, 100, 1},
+                                                                 {3, 15, 0.25, 100, 2},
+                                                                 {0.5, 5, -0.5, 90, -1},
+                                                                 {20, 50, 1.0, 150, 4} }};
+    for (const auto& p : points) {
+        const auto result = eval.bhp(p.flo, p.thp, p.wfr, p.gfr, p.alq);
+        BOOST_CHECK_CLOSE( prodFunc(p.flo, p.thp, p.wfr, 100, p.alq), result.value, 1e-10 );
+        BOOST_CHECK_CLOSE( 2 + 0.5*p.thp, result.dflo, 1e-10 );
+        BOOST_CHECK_CLOSE( 3 + 0.5*p.flo, result.dthp, 1e-10 );
+        BOOST_CHECK_CLOSE( 5, result.dwfr, 1e-10 );
+        BOOST_CHECK_EQUAL( 0, result.dgfr );
+        BOOST_CHECK_CLOSE( 11, result.dalq, 1e-10 );
+    }
+
+    std::vector<Opm::VFPEvaluation> results;
+    eval.bhp(points, results);
+    BOOST_CHECK_EQUAL( points.size(), results.size() );
+    for (std::size_t i = 0; i < points.size(); i++) {
+        const auto& p = points[i];
+        BOOST_CHECK_CLOSE( prodFunc(p.flo, p.thp, p.wfr, 100, p.alq), results[i].value, 1e-10 );
+    }
+
+    std::vector<Opm::VFPHint> hints(1);
+    BOOST_CHECK_THROW( eval.bhp(points, results, hints), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE( prod_hint ) {
+    const auto table = makeProdTable();
+    const Opm::VFPProdEvaluator eval(table);
+
+    Opm::VFPHint hint;
+    for (double flo = 0.5; flo < 20; flo += 0.75) {
+        for (double thp : {45.0, 12.0, 30.0}) {
+            const auto hinted = eval.bhp(flo, thp, 0.1, 100, 2, &hint);
+            const auto plain = eval.bhp(flo, thp, 0.1, 100, 2);
+            BOOST_CHECK_EQUAL( plain.value, hinted.value );
+            BOOST_CHECK_EQUAL( plain.dflo, hinted.dflo );
+            BOOST_CHECK_EQUAL( plain.dthp, hinted.dthp );
+        }
+    }
+
+    const auto& flo_axis = table.getFloAxis();
+    BOOST_CHECK_EQUAL( flo_axis.size() - 2, hint.index[0] );
+}
+
+
+BOOST_AUTO_TEST_CASE( prod_thp ) {
+    const auto table = makeProdTable();
+    const Opm::VFPProdEvaluator eval(table);
+
+    for (double thp : {5.0, 10.0, 17.5, 40.0, 60.0}) {
+        const double flo = 3;
+        const double bhp = prodFunc(flo, thp, 0.25, 100, 1);
+        BOOST_CHECK_CLOSE( thp, eval.thp(flo, 0.25, 100, 1, bhp), 1e-10 );
+    }
+
+    const std::vector<Opm::VFPProdEvaluator::Point> points = {{ {3, 0, 0.25, 100, 1},
+                                                                 {6, 0, 0.0, 100, 0} }};
+    const std::vector<double> bhp = { prodFunc(3, 25, 0.25, 100, 1), prodFunc(6, 12, 0.0, 100, 0) };
+    std::vector<double> thp;
+    eval.thp(points, bhp, thp);
+    BOOST_CHECK_CLOSE( 25, thp[0], 1e-10 );
+    BOOST_CHECK_CLOSE( 12, thp[1], 1e-10 );
+}
+
+
+BOOST_AUTO_TEST_CASE( inj ) {
+    const auto table = makeInjTable();
+    const Opm::VFPInjEvaluator eval(table);
+
+    Opm::VFPHint hint;
+    for (double flo : {-5.0, 0.0, 5.0, 50.0, 150.0}) {
+        for (double thp : {1.0, 20.0, 70.0}) {
+            const auto result = eval.bhp(flo, thp, &hint);
+            BOOST_CHECK_CLOSE( injFunc(flo, thp), result.value, 1e-10 );
+            BOOST_CHECK_CLOSE( 2 + 0.25*thp, result.dflo, 1e-10 );
+            BOOST_CHECK_CLOSE( 3 + 0.25*flo, result.dthp, 1e-10 );
+            BOOST_CHECK_EQUAL( 0, result.dwfr );
+
+            BOOST_CHECK_CLOSE( thp, eval.thp(flo, result.value), 1e-8 );
+        }
+    }
+}
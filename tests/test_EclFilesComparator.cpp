@@ -21,7 +21,28 @@
 #define BOOST_TEST_MODULE EclFilesComparatorTest
 
 #include <boost/test/unit_test.hpp>
+#include <examples/test_util/DeviationStatistics.hpp>
 #include <examples/test_util/EclFilesComparator.hpp>
+#include <examples/test_util/EclRegressionTest.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <ert/ecl/ecl_util.h>
+#include <ert/ecl/EclKW.hpp>
+#include <ert/ecl/FortIO.hpp>
+#include <ert/util/test_work_area.h>
+
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 BOOST_AUTO_TEST_CASE(deviation) {
     double a = 1;
@@ -66,3 +87,173 @@ BOOST_AUTO_TEST_CASE(average) {
 
     BOOST_CHECK_CLOSE(avg, 13.0/4, tol);
 }
+
+
+
+BOOST_AUTO_TEST_CASE(deviationStatistics) {
+    DeviationStatistics stats1, stats2;
+    const double tol = 1.0e-14;
+
+    stats1.add(ECLFilesComparator::calculateDeviations(1, 3));
+    stats1.add(ECLFilesComparator::calculateDeviations(0, 4));
+    stats2.add(ECLFilesComparator::calculateDeviations(2, 2));
+    stats2.add(ECLFilesComparator::calculateDeviations(0, 0));
+    stats1.merge(stats2);
+
+    BOOST_CHECK_EQUAL(stats1.numAbs, 3U);
+    BOOST_CHECK_EQUAL(stats1.numRel, 2U);
+    BOOST_CHECK_CLOSE(stats1.averageAbs(), 2.0, tol);
+    BOOST_CHECK_CLOSE(stats1.averageRel(), 1.0/3, tol);
+    BOOST_CHECK_EQUAL(stats1.maxAbs, 4.0);
+    BOOST_CHECK_CLOSE(stats1.maxRel, 2.0/3, tol);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(topDeviations) {
+    TopDeviations top1(2), top2(2);
+
+    for (size_t cell = 0; cell < 5; ++cell) {
+        DeviationRecord record;
+        record.cell = cell;
+        record.dev.abs = cell;
+        record.dev.rel = 0.1*cell;
+        (cell % 2 == 0 ? top1 : top2).add(record);
+    }
+
+    BOOST_CHECK_EQUAL(top1.size(), 2U);
+    Deviation dev;
+    dev.abs = 1;
+    dev.rel = 0.1;
+    BOOST_CHECK(!top1.accepts(dev));
+    dev.abs = 10;
+    dev.rel = 1.0;
+    BOOST_CHECK(top1.accepts(dev));
+
+    top1.merge(top2);
+    const auto sorted = top1.sorted();
+
+    BOOST_CHECK_EQUAL(sorted.size(), 2U);
+    BOOST_CHECK_EQUAL(sorted[0].cell, 4U);
+    BOOST_CHECK_EQUAL(sorted[1].cell, 3U);
+
+    TopDeviations none(0);
+    none.add(sorted[0]);
+    BOOST_CHECK(none.empty());
+}
+
+
+
+
+namespace {
+
+    /*
+      Two INIT files with a float keyword spanning several blocks of the
+      streaming comparison, and a keyword with two occurrences where
+      negative values are not allowed.
+    */
+    const std::size_t numValues = 3*65536 + 100;
+    const std::vector<std::size_t> failingCells = {150000, 70000, 7, 196700};
+
+    void writeCase(const std::string& basename, bool perturbed) {
+        Opm::EclipseGrid grid(2, 2, 2);
+        grid.save(basename + ".EGRID", Opm::UnitSystem::UnitType::UNIT_TYPE_METRIC);
+
+        std::vector<float> poro(numValues, 0.25f);
+        std::vector<float> pressure(numValues);
+        for (std::size_t cell = 0; cell < numValues; ++cell)
+            pressure[cell] = 100 + cell % 7;
+
+        ERT::FortIO fortio(basename + ".INIT", std::fstream::out);
+        ERT::EclKW<float>("PRESSURE", pressure).fwrite(fortio);
+        if (perturbed) {
+            // Deviations within the tolerances.
+            for (std::size_t cell = 0; cell < numValues; cell += 1000)
+                poro[cell] = 0.2502f;
+
+            const std::vector<float> failing = {0.5f, 0.35f, 0.3f, 0.26f};
+            for (std::size_t i = 0; i < failingCells.size(); ++i)
+                poro[failingCells[i]] = failing[i];
+
+            pressure[5] = -10;
+            pressure[131072] = -10;
+        }
+        ERT::EclKW<float>("PORO", poro).fwrite(fortio);
+        ERT::EclKW<float>("PRESSURE", pressure).fwrite(fortio);
+    }
+
+    double printedValue(const std::string& output, const std::string& label) {
+        const auto pos = output.find(label + " = ");
+        BOOST_REQUIRE(pos != std::string::npos);
+        return std::stod(output.substr(pos + label.size() + 3));
+    }
+
+    std::string serialResults(const std::string& keyword, std::size_t& num_errors) {
+        ECLRegressionTest test(ECL_INIT_FILE, "CASE1", "CASE2", 1.0e-3, 1.0e-3);
+        test.throwOnErrors(false);
+
+        std::ostringstream output;
+        auto* cout_buffer = std::cout.rdbuf(output.rdbuf());
+        test.resultsForKeyword(keyword);
+        std::cout.rdbuf(cout_buffer);
+
+        num_errors = test.getNoErrors();
+        return output.str();
+    }
+
+}
+
+
+
+BOOST_AUTO_TEST_CASE(streamingMatchesSerial) {
+    test_work_area_type * work_area = test_work_area_alloc("test_EclFilesComparator");
+#ifdef _OPENMP
+    omp_set_num_threads(4);
+#endif
+
+    writeCase("CASE1", false);
+    writeCase("CASE2", true);
+
+    ECLRegressionTest streaming(ECL_INIT_FILE, "CASE1", "CASE2", 1.0e-3, 1.0e-3);
+    streaming.throwOnErrors(false);
+    streaming.setStreaming(true);
+    streaming.setMaxReportedDeviations(10);
+    streaming.results();
+
+    const auto& statistics = streaming.getKeywordStatistics();
+    BOOST_REQUIRE_EQUAL(statistics.size(), 2U);
+    const double tol = 1.0e-3;
+
+    std::size_t serial_errors = 0;
+    for (const std::string keyword : {"PORO", "PRESSURE"}) {
+        std::size_t num_errors = 0;
+        const std::string output = serialResults(keyword, num_errors);
+        serial_errors += num_errors;
+
+        const DeviationStatistics& stats = statistics.at(keyword);
+        BOOST_CHECK_CLOSE(stats.averageAbs(), printedValue(output, "Average absolute deviation"), tol);
+        BOOST_CHECK_CLOSE(stats.averageRel(), printedValue(output, "Average relative deviation"), tol);
+    }
+
+    // Every value which exceeds the tolerances, or is negative, is counted.
+    BOOST_CHECK_EQUAL(serial_errors, 6U);
+    BOOST_CHECK_EQUAL(streaming.getNoErrors(), serial_errors);
+
+    const DeviationStatistics& poro = statistics.at("PORO");
+    BOOST_CHECK_EQUAL(poro.numFailures, failingCells.size());
+    BOOST_CHECK_EQUAL(poro.numAbs, numValues);
+    BOOST_CHECK_EQUAL(poro.maxAbs, 0.25);
+    BOOST_CHECK_EQUAL(poro.maxRel, 0.5);
+    BOOST_CHECK_EQUAL(statistics.at("PRESSURE").numNegative, 2U);
+    BOOST_CHECK_EQUAL(statistics.at("PRESSURE").numFailures, 0U);
+
+    // The largest deviations of all threads, merged and ranked.
+    const auto top = streaming.getTopDeviations().sorted();
+    BOOST_REQUIRE_EQUAL(top.size(), failingCells.size());
+    for (std::size_t i = 0; i < top.size(); ++i) {
+        BOOST_CHECK_EQUAL(top[i].keyword, "PORO");
+        BOOST_CHECK_EQUAL(top[i].cell, failingCells[i]);
+    }
+
+    test_work_area_free(work_area);
+}
@@ -0,0 +1,375 @@
+/*
+  Copyright 2018 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE FortranWriter
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/output/eclipse/FortranWriter.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+    using File = std::unique_ptr<std::FILE, int(*)(std::FILE*)>;
+
+    File tmpFile() {
+        return File(std::tmpfile(), &std::fclose);
+    }
+
+    std::vector<unsigned char> contents(std::FILE* stream) {
+        std::fflush(stream);
+        std::rewind(stream);
+
+        std::vector<unsigned char> bytes;
+        int c;
+        while ((c = std::fgetc(stream)) != EOF)
+            bytes.push_back(static_cast<unsigned char>(c));
+        return bytes;
+    }
+
+    class Reader {
+    public:
+        explicit Reader(std::vector<unsigned char> bytes_arg) :
+            bytes(std::move(bytes_arg))
+        {}
+
+        std::uint32_t u32() {
+            std::uint32_t v = 0;
+            for (int i = 0; i < 4; i++)
+                v = (v << 8) | bytes.at(pos++);
+            return v;
+        }
+
+        int i32() { return static_cast<int>(u32()); }
+
+        float f32() {
+            const auto bits = u32();
+            float v;
+            std::memcpy(&v, &bits, sizeof v);
+            return v;
+        }
+
+        double f64() {
+            const std::uint64_t hi = u32();
+            const std::uint64_t bits = (hi << 32) | u32();
+            double v;
+            std::memcpy(&v, &bits, sizeof v);
+            return v;
+        }
+
+        std::string str(std::size_t n) {
+            std::string s(bytes.begin() + pos, bytes.begin() + pos + n);
+            pos += n;
+            return s;
+        }
+
+        void header(const std::string& name, int size, const std::string& type) {
+            BOOST_CHECK_EQUAL(i32(), 16);
+            BOOST_CHECK_EQUAL(str(8), name);
+            BOOST_CHECK_EQUAL(i32(), size);
+            BOOST_CHECK_EQUAL(str(4), type);
+            BOOST_CHECK_EQUAL(i32(), 16);
+        }
+
+        bool done() const { return pos == bytes.size(); }
+
+    private:
+        std::vector<unsigned char> bytes;
+        std::size_t pos = 0;
+    };
+
+
+    /*
+      The formatted output of libecl, i.e. ecl_kw_fwrite_header() and
+      ecl_kw_fwrite_data_formatted() with __fprintf_scientific().
+    */
+    std::string scientific(const char* fmt, double x) {
+        double pow_x = std::ceil(std::log10(std::fabs(x)));
+        double arg_x = x / std::pow(10.0, pow_x);
+        if (x != 0.0) {
+            if (std::fabs(arg_x) == 1.0) {
+                arg_x *= 0.10;
+                pow_x += 1;
+            }
+        } else {
+            arg_x = 0.0;
+            pow_x = 0.0;
+        }
+
+        char text[64];
+        std::snprintf(text, sizeof text, fmt, arg_x, static_cast<int>(pow_x));
+        return text;
+    }
+
+    template <typename T>
+    std::string libeclFormatted(const std::string& keyword, const std::string& type, const std::vector<T>& data) {
+        const std::size_t columns = std::is_same<T, int>::value ? 6 : (std::is_same<T, float>::value ? 4 : 3);
+        char text[64];
+        std::snprintf(text, sizeof text, " '%-8s' %11d '%-4s'\n", keyword.c_str(), static_cast<int>(data.size()), type.c_str());
+
+        std::string expected = text;
+        for (std::size_t i = 0; i < data.size(); i++) {
+            if (std::is_same<T, int>::value) {
+                std::snprintf(text, sizeof text, " %11d", static_cast<int>(data[i]));
+                expected += text;
+            } else if (std::is_same<T, float>::value)
+                expected += scientific("  %11.8fE%+03d", data[i]);
+            else
+                expected += scientific("  %17.14fD%+03d", data[i]);
+
+            if (i % 1000 % columns == columns - 1 || i % 1000 == 999 || i == data.size() - 1)
+                expected += "\n";
+        }
+        return expected;
+    }
+
+    std::string text(std::FILE* stream) {
+        const auto bytes = contents(stream);
+        return std::string(bytes.begin(), bytes.end());
+    }
+
+}
+
+
+BOOST_AUTO_TEST_CASE(IntegerRecords) {
+    auto file = tmpFile();
+    Opm::out::FortranWriter writer(file.get(), 2);
+
+    std::vector<int> data(2500);
+    for (std::size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<int>(i) - 100;
+
+    writer.write("INTDATA", data);
+    writer.writeMessage("STARTSOL");
+
+    Reader reader(contents(file.get()));
+    reader.header("INTDATA ", 2500, "INTE");
+    for (std::size_t block = 0; block < 3; block++) {
+        const int n = block < 2 ? 1000 : 500;
+        BOOST_CHECK_EQUAL(reader.i32(), 4 * n);
+        for (int i = 0; i < n; i++)
+            BOOST_CHECK_EQUAL(reader.i32(), data[block * 1000 + i]);
+        BOOST_CHECK_EQUAL(reader.i32(), 4 * n);
+    }
+    reader.header("STARTSOL", 0, "MESS");
+    BOOST_CHECK(reader.done());
+    BOOST_CHECK_EQUAL(writer.bytesWritten(), 2 * 24 + 3 * 8 + 4 * 2500);
+}
+
+
+BOOST_AUTO_TEST_CASE(ConvertedCells) {
+    auto file = tmpFile();
+    Opm::out::FortranWriter writer(file.get());
+    const std::vector<double> data = { 1, 2, 3, 4, 5, 6 };
+    const std::vector<int> cells = { 1, 3, 4 };
+    const Opm::out::FortranWriter::Conversion conversion(10, 0.5);
+
+    writer.writeCells("PORO", data, cells, false, conversion);
+    writer.writeCells("PRESSURE", data, cells, true);
+    writer.writeMasked("PORV", data, cells, conversion);
+    writer.write("EMPTY", std::vector<double>{});
+
+    Reader reader(contents(file.get()));
+    reader.header("PORO    ", 3, "REAL");
+    BOOST_CHECK_EQUAL(reader.i32(), 12);
+    BOOST_CHECK_EQUAL(reader.f32(), 20.5f);
+    BOOST_CHECK_EQUAL(reader.f32(), 40.5f);
+    BOOST_CHECK_EQUAL(reader.f32(), 50.5f);
+    BOOST_CHECK_EQUAL(reader.i32(), 12);
+
+    reader.header("PRESSURE", 3, "DOUB");
+    BOOST_CHECK_EQUAL(reader.i32(), 24);
+    BOOST_CHECK_EQUAL(reader.f64(), 2.0);
+    BOOST_CHECK_EQUAL(reader.f64(), 4.0);
+    BOOST_CHECK_EQUAL(reader.f64(), 5.0);
+    BOOST_CHECK_EQUAL(reader.i32(), 24);
+
+    reader.header("PORV    ", 6, "REAL");
+    BOOST_CHECK_EQUAL(reader.i32(), 24);
+    for (float expected : { 0.0f, 20.5f, 0.0f, 40.5f, 50.5f, 0.0f })
+        BOOST_CHECK_EQUAL(reader.f32(), expected);
+    BOOST_CHECK_EQUAL(reader.i32(), 24);
+
+    reader.header("EMPTY   ", 0, "REAL");
+    BOOST_CHECK(reader.done());
+}
+
+
+BOOST_AUTO_TEST_CASE(UnitConversion) {
+    const auto units = Opm::UnitSystem::newFIELD();
+    const Opm::out::FortranWriter::Conversion conversion(units, Opm::UnitSystem::measure::pressure);
+
+    const double si = 1.0e7;
+    BOOST_CHECK_CLOSE(conversion.scale * si + conversion.offset,
+                      units.from_si(Opm::UnitSystem::measure::pressure, si), 1e-10);
+}
+
+
+BOOST_AUTO_TEST_CASE(UnitConversionMatchesVectorConversion) {
+    const auto units = Opm::UnitSystem::newFIELD();
+    std::vector<double> data = { 0.0, -0.0, 1.0, -1.0, 1.0e5, 1.0e7 / 3, 2.5e7, 1.0e-310, 101325.0, 293.15, 1.0e300 };
+    for (std::size_t i = 0; i < 2000; i++)
+        data.push_back(1.0e5 * (1.0 + i / 7.0) + i * 1.0e-3);
+
+    for (const auto measure : { Opm::UnitSystem::measure::pressure,
+                                Opm::UnitSystem::measure::temperature,
+                                Opm::UnitSystem::measure::identity }) {
+        /* The conversion of the vector, and the narrowing to float, of the libecl path. */
+        auto converted = data;
+        units.from_si(measure, converted);
+        const std::vector<float> reference_float(converted.begin(), converted.end());
+
+        auto reference = tmpFile();
+        Opm::out::FortranWriter reference_writer(reference.get());
+        reference_writer.write("DATA", reference_float);
+        reference_writer.write("DATA", converted, true);
+
+        auto file = tmpFile();
+        Opm::out::FortranWriter writer(file.get());
+        const Opm::out::FortranWriter::Conversion conversion(units, measure);
+        writer.write("DATA", data, false, conversion);
+        writer.write("DATA", data, true, conversion);
+
+        BOOST_CHECK(contents(file.get()) == contents(reference.get()));
+    }
+
+    /* The default conversion writes the values unchanged, -0 included. */
+    auto file = tmpFile();
+    Opm::out::FortranWriter writer(file.get());
+    writer.write("DATA", std::vector<double>{ -0.0 }, true);
+
+    Reader reader(contents(file.get()));
+    reader.header("DATA    ", 1, "DOUB");
+    BOOST_CHECK_EQUAL(reader.i32(), 8);
+    BOOST_CHECK(std::signbit(reader.f64()));
+}
+
+
+BOOST_AUTO_TEST_CASE(InvalidKeyword) {
+    auto file = tmpFile();
+    Opm::out::FortranWriter writer(file.get());
+
+    BOOST_CHECK_THROW(writer.write("TOOLONGNAME", std::vector<int>{ 1 }), std::invalid_argument);
+    BOOST_CHECK_THROW(Opm::out::FortranWriter(nullptr), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE(FormattedMatchesLibecl) {
+    std::vector<int> ints(2003);
+    std::vector<float> floats(2003);
+    std::vector<double> doubles(2003);
+    for (std::size_t i = 0; i < ints.size(); i++) {
+        const double sign = (i % 3 == 0) ? -1.0 : 1.0;
+        ints[i] = static_cast<int>(i * i * 7919) * (i % 2 == 0 ? 1 : -1);
+        floats[i] = static_cast<float>(sign * (i + 0.25) * std::pow(10.0, static_cast<int>(i % 41) - 20));
+        doubles[i] = sign * (i + 0.375) * std::pow(10.0, static_cast<int>(i % 201) - 100);
+    }
+    ints[1] = std::numeric_limits<int>::min();
+    ints[2] = std::numeric_limits<int>::max();
+    for (double x : { 0.0, 1.0, 10.0, 1000.0, -0.1, 0.5, 1e-5, 123.456e15, 0.999999999 }) {
+        floats.push_back(static_cast<float>(x));
+        doubles.push_back(x);
+    }
+
+    auto file = tmpFile();
+    Opm::out::FortranWriter writer(file.get(), Opm::out::FortranWriter::Format::Formatted, 1);
+    writer.write("INTS", ints);
+    writer.write("FLOATS", floats);
+    writer.write("DOUBLES", doubles, true);
+    writer.writeMessage("ENDSOL");
+
+    const auto expected = libeclFormatted("INTS", "INTE", ints)
+        + libeclFormatted("FLOATS", "REAL", floats)
+        + libeclFormatted("DOUBLES", "DOUB", doubles)
+        + " 'ENDSOL  '           0 'MESS'\n";
+
+    const auto actual = text(file.get());
+    BOOST_CHECK_EQUAL(actual.size(), writer.bytesWritten());
+    BOOST_CHECK(actual == expected);
+}
+
+
+BOOST_AUTO_TEST_CASE(FormattedEdgeValuesMatchLibecl) {
+    const double dbl_max = std::numeric_limits<double>::max();
+    const double dbl_min = std::numeric_limits<double>::min();
+    const double dbl_denorm = std::numeric_limits<double>::denorm_min();
+    const float flt_max = std::numeric_limits<float>::max();
+    const float flt_min = std::numeric_limits<float>::min();
+    const float flt_denorm = std::numeric_limits<float>::denorm_min();
+
+    /*
+      Negative zero, denormals, the limits and values next to a power of
+      ten, where the mantissa rounds up to 1.0 or the exponent is off by
+      one in log10().
+    */
+    std::vector<double> doubles = { -0.0, 0.0, dbl_denorm, -dbl_denorm, 1.0e-310, -3.3e-320, dbl_min, dbl_max, -dbl_max,
+                                    0.125, -0.375, 1.0e22, 1.0e23, 1.0e-22, 1.0e-23, 5.0e-324, 9.5, 0.95 };
+    for (const double x : { 1.0, 10.0, 1000.0, 1.0e5, 1.0e15, 1.0e22, 1.0e-5, 0.1, 1.0e-300 }) {
+        doubles.push_back(std::nextafter(x, 0.0));
+        doubles.push_back(-std::nextafter(x, 2 * x));
+        doubles.push_back(x * (1 - 1.0e-15));
+        doubles.push_back(x * (1 + 4.0e-15));
+    }
+
+    std::vector<float> floats = { -0.0f, 0.0f, flt_denorm, -flt_denorm, 1.0e-40f, flt_min, flt_max, -flt_max,
+                                  0.123456785f, 9.5f, 0.95f };
+    for (const float x : { 1.0f, 10.0f, 1000.0f, 1.0e5f, 1.0e-5f, 0.1f, 1.0e30f }) {
+        floats.push_back(std::nextafter(x, 0.0f));
+        floats.push_back(-std::nextafter(x, 2 * x));
+        floats.push_back(x * (1 - 1.0e-7f));
+        floats.push_back(x * (1 + 2.0e-7f));
+    }
+
+    auto file = tmpFile();
+    Opm::out::FortranWriter writer(file.get(), Opm::out::FortranWriter::Format::Formatted);
+    writer.write("FLOATS", floats);
+    writer.write("DOUBLES", doubles, true);
+
+    const auto expected = libeclFormatted("FLOATS", "REAL", floats)
+        + libeclFormatted("DOUBLES", "DOUB", doubles);
+    BOOST_CHECK_EQUAL(text(file.get()), expected);
+}
+
+
+BOOST_AUTO_TEST_CASE(FormattedCells) {
+    auto file = tmpFile();
+    Opm::out::FortranWriter writer(file.get(), Opm::out::FortranWriter::Format::Formatted);
+    const std::vector<double> data = { 1, 2, 3, 4, 5, 6 };
+    const std::vector<int> cells = { 1, 3, 4 };
+
+    writer.writeMasked("PORV", data, cells, { 10, 0.5 });
+    writer.writeCells("PRESSURE", data, cells, true);
+
+    BOOST_CHECK_EQUAL(text(file.get()),
+                      " 'PORV    '           6 'REAL'\n"
+                      "   0.00000000E+00   0.20500000E+02   0.00000000E+00   0.40500000E+02\n"
+                      "   0.50500000E+02   0.00000000E+00\n"
+                      " 'PRESSURE'           3 'DOUB'\n"
+                      "   0.20000000000000D+01   0.40000000000000D+01   0.50000000000000D+01\n");
+}
@@ -260,3 +260,61 @@ BOOST_AUTO_TEST_CASE(test_RFT2) {
     }
     test_work_area_free( test_area );
 }
+
+
+BOOST_AUTO_TEST_CASE(test_RFT_missing_connection_data) {
+    std::string eclipse_data_filename    = "testrft.DATA";
+    test_work_area_type * test_area = test_work_area_alloc("test_RFT");
+    test_work_area_copy_file( test_area, eclipse_data_filename.c_str() );
+
+    auto deck = Parser().parseFile( eclipse_data_filename );
+    auto eclipseState = EclipseState(deck);
+    {
+        const auto& grid = eclipseState.getInputGrid();
+        const auto numCells = grid.getCartesianSize( );
+        Schedule schedule(deck, eclipseState);
+        SummaryConfig summary_config( deck, schedule, eclipseState.getTableManager( ));
+        EclipseIO eclipseWriter( eclipseState, grid, schedule, summary_config );
+        time_t start_time = schedule.posixStartTime();
+        time_t step_time = ecl_util_make_date(10, 10, 2008 );
+
+        data::Rates r1;
+        r1.set( data::Rates::opt::oil, 4.12 );
+
+        // No data for the connection in cell 9 9 2 of OP_1; the
+        // connection is left out of the RFT node.
+        std::vector<Opm::data::Connection> well1_comps;
+        for (size_t i = 0; i < 9; ++i) {
+            if (i != 1)
+                well1_comps.push_back( { grid.getGlobalIndex(8,8,i) ,r1, 0.0 , 0.0, (double)i, 0.1*i,0.2*i, 1.2e3} );
+        }
+
+        Opm::data::Solution solution = createBlackoilState(2, numCells);
+        Opm::data::Wells wells;
+
+        using SegRes = decltype(wells["w"].segments);
+
+        wells["OP_1"] = { r1, 1.0, 1.1, 3.1, 1, well1_comps, SegRes{} };
+        wells["OP_2"] = { r1, 1.0, 1.1, 3.2, 1, {}, SegRes{} };
+
+        RestartValue restart_value(solution, wells);
+
+        eclipseWriter.writeTimeStep( 2,
+                                     false,
+                                     step_time - start_time,
+                                     restart_value,
+                                     {},
+                                     {},
+                                     {});
+
+        // The file is flushed after every report step.
+        std::shared_ptr<ecl_rft_file_type> rft_file( ecl_rft_file_alloc( "TESTRFT.RFT" ), ecl_rft_file_free );
+        BOOST_CHECK_EQUAL( 1, ecl_rft_file_get_size( rft_file.get() ));
+
+        ecl_rft_node_type * ecl_rft_node = ecl_rft_file_get_well_time_rft(rft_file.get() , "OP_1" , step_time);
+        BOOST_CHECK( ecl_rft_node_lookup_ijk(ecl_rft_node, 8, 8, 0) != NULL );
+        BOOST_CHECK( ecl_rft_node_lookup_ijk(ecl_rft_node, 8, 8, 1) == NULL );
+        BOOST_CHECK( ecl_rft_node_lookup_ijk(ecl_rft_node, 8, 8, 2) != NULL );
+    }
+    test_work_area_free( test_area );
+}
@@ -23,6 +23,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <opm/output/eclipse/EclipseIO.hpp>
+#include <opm/output/eclipse/LazyRestartValue.hpp>
 #include <opm/output/eclipse/RestartIO.hpp>
 #include <opm/output/eclipse/RestartValue.hpp>
 #include <opm/output/data/Cells.hpp>
@@ -206,7 +207,7 @@ std::ostream& operator<<( std::ostream& stream, const Connection& c ) {
 }
 
 std::ostream& operator<<( std::ostream& stream,
-                          const std::map< std::string, Well >& m ) {
+                          const WellRates& m ) {
     stream << "\n";
 
     for( const auto& p : m ) {
@@ -266,6 +267,18 @@ bool operator==( const Well& lhs, const Well& rhs ) {
     return true;
 }
 
+bool operator==( const WellRates& lhs, const WellRates& rhs ) {
+    BOOST_CHECK_EQUAL( lhs.size(), rhs.size() );
+
+    for( const auto& p : lhs ) {
+        BOOST_CHECK_EQUAL( rhs.count( p.first ), 1U );
+        if( rhs.count( p.first ) == 1 )
+            BOOST_CHECK( p.second == rhs.at( p.first ) );
+    }
+
+    return lhs.size() == rhs.size();
+}
+
 }
 
 
@@ -556,6 +569,46 @@ BOOST_AUTO_TEST_CASE(ECL_FORMATTED) {
 
 
 
+BOOST_AUTO_TEST_CASE(WellInsertionOrder) {
+    Setup setup("FIRST_SIM.DATA");
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart");
+    {
+        const auto num_cells = setup.grid.getNumActive( );
+        const auto wells = mkWells();
+        auto sumState = sim_state();
+
+        /*
+          The data::Wells iterate in insertion order; the restart file is
+          written in the order of the schedule wells, whatever order the
+          simulator added the wells in.
+        */
+        data::Wells reversed;
+        for (auto itr = wells.end(); itr != wells.begin(); ) {
+            --itr;
+            reversed.emplace( itr->first, itr->second );
+        }
+        BOOST_CHECK( reversed.begin()->first != wells.begin()->first );
+
+        RestartIO::save("ORDERED.UNRST", 1, 100, RestartValue( mkSolution( num_cells ), wells ),
+                        setup.es, setup.grid, setup.schedule, sumState, true);
+        RestartIO::save("REVERSED.UNRST", 1, 100, RestartValue( mkSolution( num_cells ), reversed ),
+                        setup.es, setup.grid, setup.schedule, sumState, true);
+
+        ecl_file_type * ordered = ecl_file_open( "ORDERED.UNRST", 0 );
+        ecl_file_type * other = ecl_file_open( "REVERSED.UNRST", 0 );
+        BOOST_CHECK( ecl_file_has_kw( ordered, "OPM_XWEL" ) );
+        BOOST_REQUIRE_EQUAL( ecl_file_get_size( ordered ), ecl_file_get_size( other ) );
+        for (int i = 0; i < ecl_file_get_size( ordered ); i++)
+            BOOST_CHECK( ecl_kw_equal( ecl_file_iget_kw( ordered, i ), ecl_file_iget_kw( other, i ) ) );
+
+        ecl_file_close( ordered );
+        ecl_file_close( other );
+    }
+    test_work_area_free(test_area);
+}
+
+
+
 void compare_equal( const RestartValue& fst,
                     const RestartValue& snd ,
                     const std::vector<RestartKey>& keys) {
@@ -706,6 +759,57 @@ BOOST_AUTO_TEST_CASE(ExtraData_content) {
 }
 
 
+BOOST_AUTO_TEST_CASE(LazyLoad) {
+    Setup setup("FIRST_SIM.DATA");
+    test_work_area_type * test_area = test_work_area_alloc("test_Restart");
+    {
+        const std::vector<RestartKey> keys {{"PRESSURE" , UnitSystem::measure::pressure},
+                                            {"SWAT" , UnitSystem::measure::identity},
+                                            {"TEMP" , UnitSystem::measure::temperature},
+                                            {"NO" , UnitSystem::measure::identity, false}};
+        const auto num_cells = setup.grid.getNumActive( );
+        const auto sumState = sim_state();
+
+        RestartIO::save("FILE.UNRST", 1 ,
+                        100,
+                        RestartValue( mkSolution( num_cells ), mkWells() ),
+                        setup.es,
+                        setup.grid,
+                        setup.schedule,
+                        sumState);
+
+        BOOST_CHECK_THROW( RestartIO::LazyRestartValue( "FILE.UNRST" , 1 ,
+                                                        {{"NOT-THIS", UnitSystem::measure::identity, true}},
+                                                        setup.es, setup.grid , setup.schedule) , std::runtime_error );
+
+        const auto eager = RestartIO::load( "FILE.UNRST" , 1 , keys, setup.es, setup.grid , setup.schedule );
+        const RestartIO::LazyRestartValue lazy( "FILE.UNRST" , 1 , keys, setup.es, setup.grid , setup.schedule );
+
+        BOOST_CHECK( lazy.has( "PRESSURE" ));
+        BOOST_CHECK( !lazy.has( "NO" ));
+        BOOST_CHECK_THROW( lazy.data( "NO" ), std::invalid_argument );
+        BOOST_CHECK_EQUAL( lazy.keys().size(), 3U );
+
+        // Subset access does not decode the full vector.
+        const std::vector<int> cells { 0, 17, static_cast<int>(num_cells) - 1 };
+        const auto swat = lazy.data( "SWAT", cells );
+        BOOST_CHECK( !lazy.loaded( "SWAT" ));
+        for (size_t i = 0; i < cells.size(); i++)
+            BOOST_CHECK_CLOSE( swat[i], eager.solution.data( "SWAT" )[cells[i]], 1e-5 );
+
+        BOOST_CHECK_THROW( lazy.data( "SWAT", { static_cast<int>(num_cells) } ), std::out_of_range );
+
+        const auto& pressure = lazy.data( "PRESSURE" );
+        BOOST_CHECK( lazy.loaded( "PRESSURE" ));
+        BOOST_CHECK( !lazy.loaded( "TEMP" ));
+        BOOST_CHECK_EQUAL( pressure.size(), num_cells );
+
+        compare( eager, lazy.toRestartValue(), { keys.begin(), keys.begin() + 3 } );
+    }
+    test_work_area_free(test_area);
+}
+
+
 BOOST_AUTO_TEST_CASE(STORE_THPRES) {
     Setup setup("FIRST_SIM_THPRES.DATA");
     test_work_area_type * test_area = test_work_area_alloc("test_Restart_THPRES");
@@ -24,7 +24,9 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include <cstddef>
+#include <cstdlib>
 #include <exception>
+#include <new>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -33,6 +35,7 @@
 #include <ert/util/util.h>
 #include <ert/util/test_work_area.h>
 
+#include <opm/output/data/Solution.hpp>
 #include <opm/output/data/Wells.hpp>
 #include <opm/output/eclipse/Summary.hpp>
 
@@ -55,8 +58,24 @@ namespace {
     {
        return unit::cubic(unit::meter) / unit::day;
     }
+
+    // Number of calls to operator new in the test program, for the
+    // tests of the allocations made by add_timestep().
+    std::size_t allocation_count = 0;
 } // Anonymous
 
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
 namespace SegmentResultHelpers {
     data::Well prod01_results();
     data::Well inje01_results();
@@ -1105,6 +1124,46 @@ BOOST_AUTO_TEST_CASE(BLOCK_VARIABLES) {
 
 
 
+BOOST_AUTO_TEST_CASE(BLOCK_VARIABLES_FROM_SOLUTION) {
+    setup cfg( "block_solution" );
+
+    std::vector<double> pressure( cfg.grid.getNumActive() );
+    for (size_t i = 0; i < pressure.size(); i++)
+        pressure[i] = 1.0e5 * (cfg.grid.getGlobalIndex( i ) + 1);
+
+    data::Solution solution;
+    solution.insert( "PRESSURE", UnitSystem::measure::pressure, pressure, data::TargetType::RESTART_SOLUTION );
+    solution.insert( "SWAT", UnitSystem::measure::identity,
+                     std::vector<double>( cfg.grid.getNumActive(), 0.25 ), data::TargetType::RESTART_SOLUTION );
+
+    // A value passed in block_values takes precedence over the solution.
+    std::map<std::pair<std::string, int>, double> block_values;
+    block_values[std::make_pair("BSWAT", 1)] = 0.75;
+    block_values[std::make_pair("BPR", 1)] = 42.0e5;
+
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    writer.add_timestep( 1, 1 * day, cfg.es, cfg.schedule, cfg.wells, solution, {}, {}, block_values );
+    writer.add_timestep( 2, 2 * day, cfg.es, cfg.schedule, cfg.wells, solution, {}, {}, {} );
+    writer.write();
+
+    auto res = readsum( cfg.name );
+    const auto* resp = res.get();
+
+    UnitSystem units( UnitSystem::UnitType::UNIT_TYPE_METRIC );
+    for (size_t r=2; r <= 10; r++) {
+        std::string bpr_key   = "BPR:1,1,"   + std::to_string( r );
+        BOOST_CHECK_CLOSE( 1.0e5 * ((r - 1) * 100 + 1),
+                           units.to_si( UnitSystem::measure::pressure , ecl_sum_get_general_var( resp, 1, bpr_key.c_str())) , 1e-5);
+    }
+
+    BOOST_CHECK_CLOSE( 42.0 , ecl_sum_get_general_var( resp, 1, "BPR:1,1,1") , 1e-5);
+    BOOST_CHECK_CLOSE( 1.0 , ecl_sum_get_general_var( resp, 2, "BPR:1,1,1") , 1e-5);
+    BOOST_CHECK_CLOSE( 0.75 , ecl_sum_get_general_var( resp, 1, "BSWAT:1,1,1") , 1e-5);
+    BOOST_CHECK_CLOSE( 0.25 , ecl_sum_get_general_var( resp, 2, "BSWAT:1,1,1") , 1e-5);
+}
+
+
+
 /*
   The SummaryConfig.require3DField( ) implementation is slightly ugly:
 
@@ -1156,6 +1215,41 @@ BOOST_AUTO_TEST_CASE(MISC) {
 }
 
 
+BOOST_AUTO_TEST_CASE(well_insertion_order) {
+    setup cfg( "test_well_order");
+
+    /*
+      The data::Wells iterate in insertion order, but the summary vectors
+      are evaluated for the schedule wells, so the order the simulator
+      added the wells in does not matter.
+    */
+    data::Wells reversed;
+    for (auto itr = cfg.wells.end(); itr != cfg.wells.begin(); ) {
+        --itr;
+        reversed.emplace( itr->first, itr->second );
+    }
+    BOOST_CHECK( reversed.begin()->first != cfg.wells.begin()->first );
+
+    out::Summary ordered( cfg.es, cfg.config, cfg.grid, cfg.schedule , "ORDERED" );
+    out::Summary other( cfg.es, cfg.config, cfg.grid, cfg.schedule , "REVERSED" );
+    for (int step = 0; step < 3; step++) {
+        ordered.add_timestep( step, step * day, cfg.es, cfg.schedule, cfg.wells ,  {});
+        other.add_timestep( step, step * day, cfg.es, cfg.schedule, reversed ,  {});
+    }
+
+    const auto& st1 = ordered.get_restart_vectors();
+    const auto& st2 = other.get_restart_vectors();
+    BOOST_CHECK( st1.num_slots() > 0 );
+    BOOST_REQUIRE_EQUAL( st1.num_slots(), st2.num_slots() );
+    for (std::size_t slot = 0; slot < st1.num_slots(); slot++) {
+        BOOST_CHECK_EQUAL( st1.key( slot ), st2.key( slot ) );
+        BOOST_CHECK_EQUAL( st1.has( slot ), st2.has( slot ) );
+        if (st1.has( slot ))
+            BOOST_CHECK_EQUAL( st1.get( slot ), st2.get( slot ) );
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(EXTRA) {
     setup cfg( "test_extra");
 
@@ -1343,6 +1437,125 @@ BOOST_AUTO_TEST_CASE(Test_SummaryState) {
     BOOST_CHECK_EQUAL(std::count(wwct_wells.begin(), wwct_wells.end(), "OP2"), 1);
 }
 
+BOOST_AUTO_TEST_CASE(Test_SummaryState_Slots) {
+    Opm::SummaryState st;
+    const auto fopt = st.add_key("FOPT");
+    const auto wwct = st.add_well_key("OP1", "WWCT");
+
+    BOOST_CHECK_EQUAL(st.num_slots(), 2U);
+    BOOST_CHECK_EQUAL(st.index("FOPT"), fopt);
+    BOOST_CHECK_EQUAL(st.index("WWCT:OP1"), wwct);
+    BOOST_CHECK_EQUAL(st.index("NO_SUCH_KEY"), Opm::SummaryState::npos);
+    BOOST_CHECK_EQUAL(st.key(wwct), "WWCT:OP1");
+
+    // Registered keys have no value before it is set.
+    BOOST_CHECK(!st.has("FOPT"));
+    BOOST_CHECK(!st.has(fopt));
+    BOOST_CHECK(!st.has_well_var("OP1", "WWCT"));
+    BOOST_CHECK_THROW(st.get(fopt), std::out_of_range);
+    BOOST_CHECK_EQUAL(std::distance(st.begin(), st.end()), 0);
+
+    st.set(fopt, 100);
+    st.add_well_var("OP1", "WWCT", 0.5);
+    BOOST_CHECK_EQUAL(st.get("FOPT"), 100);
+    BOOST_CHECK_EQUAL(st.get(wwct), 0.5);
+    BOOST_CHECK_EQUAL(st.add_key("FOPT"), fopt);
+    BOOST_CHECK_EQUAL(st.num_slots(), 2U);
+
+    std::size_t count = 0;
+    for (const auto& pair : st) {
+        BOOST_CHECK_EQUAL(pair.second, st.get(pair.first));
+        count++;
+    }
+    BOOST_CHECK_EQUAL(count, 2U);
+
+    st.clear_values();
+    BOOST_CHECK(!st.has(fopt));
+    BOOST_CHECK(!st.has_well_var("OP1", "WWCT"));
+    BOOST_CHECK_EQUAL(st.num_slots(), 2U);
+    BOOST_CHECK_EQUAL(st.index("FOPT"), fopt);
+    BOOST_CHECK_EQUAL(std::distance(st.begin(), st.end()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(values_not_carried_over) {
+    setup cfg( "test_values_not_carried_over" );
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+
+    std::map<std::string, std::vector<double>> region_values;
+    region_values["RPR"] = std::vector<double>( 10, 1.0 );
+
+    writer.add_timestep( 1, 1 * day, cfg.es, cfg.schedule, cfg.wells, {}, region_values );
+    BOOST_CHECK( writer.get_restart_vectors().has( "RPR:1" ) );
+
+    /* RPR is not passed in the second step, and has no value there. */
+    writer.add_timestep( 2, 2 * day, cfg.es, cfg.schedule, cfg.wells, {} );
+    const auto& st = writer.get_restart_vectors();
+    BOOST_CHECK( !st.has( "RPR:1" ) );
+
+    /* The cumulative totals still accumulate over the steps. */
+    BOOST_CHECK_CLOSE( st.get( "WOPT:W_1" ), 2 * st.get( "WOPR:W_1" ), 1e-5 );
+}
+
+BOOST_AUTO_TEST_CASE(substeps_reuse_scratch) {
+    setup cfg( "test_substeps" );
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    const data::Solution solution;
+    const std::map<std::string, double> single_values;
+    BOOST_CHECK_EQUAL( writer.scratch_rebuilds(), 0U );
+
+    writer.add_timestep( 1, 0.5 * day, cfg.es, cfg.schedule, cfg.wells, {} );
+    BOOST_CHECK_EQUAL( writer.scratch_rebuilds(), 1U );
+
+    /*
+      The evaluation of a substep does not allocate; the remaining
+      allocations of add_timestep() are those of the libecl time step.
+    */
+    const auto allocations = allocation_count;
+    writer.eval( 1, 0.75 * day, cfg.es, cfg.schedule, cfg.wells, solution, single_values );
+    BOOST_CHECK_EQUAL( allocation_count - allocations, 0U );
+    BOOST_CHECK_CLOSE( writer.get_restart_vectors().get( "WOPT:W_1" ),
+                       0.75 * writer.get_restart_vectors().get( "WOPR:W_1" ), 1e-5 );
+
+    writer.add_timestep( 1, 1 * day, cfg.es, cfg.schedule, cfg.wells, {} );
+    BOOST_CHECK_EQUAL( writer.scratch_rebuilds(), 1U );
+
+    writer.add_timestep( 2, 2 * day, cfg.es, cfg.schedule, cfg.wells, {} );
+    BOOST_CHECK_EQUAL( writer.scratch_rebuilds(), 2U );
+
+    /* A schedule modified in place is looked up again. */
+    writer.schedule_changed();
+    writer.add_timestep( 2, 2.5 * day, cfg.es, cfg.schedule, cfg.wells, {} );
+    BOOST_CHECK_EQUAL( writer.scratch_rebuilds(), 3U );
+}
+
+BOOST_AUTO_TEST_CASE(store_rows) {
+    setup cfg( "test_store_rows" );
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    writer.add_timestep( 1, 1 * day, cfg.es, cfg.schedule, cfg.wells, {} );
+    BOOST_CHECK_EQUAL( writer.get_store().num_rows(), 0U );
+
+    writer.enable_store( 2 );
+    for (int step = 1; step <= 5; step++)
+        writer.add_timestep( step, (step + 1) * day, cfg.es, cfg.schedule, cfg.wells, {} );
+
+    const auto& store = writer.get_store();
+    const auto& st = writer.get_restart_vectors();
+    BOOST_CHECK_EQUAL( store.num_rows(), 5U );
+    BOOST_CHECK_EQUAL( store.num_columns(), st.num_slots() );
+    BOOST_CHECK_EQUAL( store.times().back(), 6 * day );
+    BOOST_CHECK_EQUAL( store.report_steps().back(), 5 );
+
+    /* The last row holds the restart vectors, the cumulatives grow by a day of rates. */
+    BOOST_CHECK_EQUAL( store.get( "WOPR:W_1", 4 ), st.get( "WOPR:W_1" ) );
+    const auto wopt = store.get( "WOPT:W_1", 0, store.num_rows() );
+    for (std::size_t row = 1; row < wopt.size(); row++)
+        BOOST_CHECK_CLOSE( wopt[row] - wopt[row - 1], store.get( "WOPR:W_1", row ), 1e-5 );
+
+    const auto range = store.rows( 3 * day, 4 * day );
+    BOOST_CHECK_EQUAL( range.first, 1U );
+    BOOST_CHECK_EQUAL( range.second, 3U );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // ####################################################################
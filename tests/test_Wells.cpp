@@ -24,6 +24,7 @@
 
 #include <stdexcept>
 
+#include <opm/common/utility/MessageBuffer.hpp>
 #include <opm/output/data/Wells.hpp>
 
 using namespace Opm;
@@ -123,3 +124,93 @@ BOOST_AUTO_TEST_CASE(get_completions) {
     BOOST_CHECK_EQUAL( 0.0, wellRates.get("OP_2" , 10000 , data::Rates::opt::wat) );
     BOOST_CHECK_EQUAL( 26.41 , wellRates.get( "OP_2" , 188 , data::Rates::opt::wat));
 }
+
+BOOST_AUTO_TEST_CASE(find_connection) {
+    data::Rates rc;
+    rc.set( data::Rates::opt::wat, 1.0 );
+
+    data::Well w;
+    w.rates = rc;
+    w.bhp = 1.0;
+    w.thp = 2.0;
+    w.temperature = 3.0;
+    w.control = 1;
+    for (std::size_t i = 0; i < 10; ++i)
+        w.connections.push_back( { 100 + 7 * i, rc, double( i ), 0.0, 0.0, 0.0, 0.0, 0.0 } );
+
+    BOOST_CHECK( w.find_connection( 99 ) == nullptr );
+    BOOST_CHECK_EQUAL( w.find_connection( 121 ), &w.connections[ 3 ] );
+    BOOST_CHECK_EQUAL( w.find_connection( 121 )->pressure, 3.0 );
+
+    /* The index follows the vector when it grows or is reordered. */
+    w.connections.push_back( { 5, rc, 10.0, 0.0, 0.0, 0.0, 0.0, 0.0 } );
+    BOOST_CHECK_EQUAL( w.find_connection( 5 )->pressure, 10.0 );
+    std::swap( w.connections[ 0 ], w.connections[ 3 ] );
+    BOOST_CHECK_EQUAL( w.find_connection( 121 ), &w.connections[ 0 ] );
+    BOOST_CHECK_EQUAL( w.find_connection( 100 ), &w.connections[ 3 ] );
+
+    /* Misses do not rebuild the index. */
+    const auto builds = w.connection_index.num_builds();
+    for (std::size_t i = 0; i < 100; ++i)
+        BOOST_CHECK( w.find_connection( 1000 + i ) == nullptr );
+    BOOST_CHECK_EQUAL( w.connection_index.num_builds(), builds );
+
+    /*
+      A hit on a position which now holds another cell rebuilds the
+      index; otherwise clear() must be called after overwriting a
+      connection in place.
+    */
+    w.connections[ 4 ] = { 7, rc, 11.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    BOOST_CHECK( w.find_connection( 128 ) == nullptr );
+    BOOST_CHECK_EQUAL( w.connection_index.num_builds(), builds + 1 );
+    BOOST_CHECK_EQUAL( w.find_connection( 7 ), &w.connections[ 4 ] );
+
+    w.connections[ 5 ].index = 8;
+    w.connection_index.clear();
+    BOOST_CHECK_EQUAL( w.find_connection( 8 )->pressure, 5.0 );
+
+    /* A copy looks up its own connections. */
+    const data::Well copy = w;
+    BOOST_CHECK_EQUAL( copy.find_connection( 121 ), &copy.connections[ 0 ] );
+
+    w.find_connection( 114 )->pressure = 42.0;
+    BOOST_CHECK_EQUAL( w.connections[ 2 ].pressure, 42.0 );
+    BOOST_CHECK_EQUAL( copy.connections[ 2 ].pressure, 2.0 );
+}
+
+BOOST_AUTO_TEST_CASE(well_slots) {
+    data::Wells wells;
+    for (const auto* name : { "PROD", "INJ", "OBS" }) {
+        auto& well = wells[ name ];
+        well.bhp = wells.size();
+        well.connections.push_back( { wells.size(), {}, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } );
+    }
+
+    /* The wells are in insertion order, not in alphabetical order. */
+    BOOST_CHECK_EQUAL( wells.begin()->first, "PROD" );
+    BOOST_CHECK_EQUAL( wells.slot( "OBS" ), 2U );
+    BOOST_CHECK( wells.slot( "NO_SUCH_WELL" ) == data::Wells::npos );
+    BOOST_CHECK_EQUAL( wells.at_slot( 1 ).first, "INJ" );
+    BOOST_CHECK( !wells.emplace( "INJ", data::Well{} ).second );
+    BOOST_CHECK_THROW( wells.at( "NO_SUCH_WELL" ), std::out_of_range );
+
+    BOOST_CHECK_EQUAL( wells.erase( "PROD" ), 1U );
+    BOOST_CHECK_EQUAL( wells.erase( "PROD" ), 0U );
+    BOOST_CHECK_EQUAL( wells.slot( "OBS" ), 1U );
+    BOOST_CHECK_EQUAL( wells.at( "OBS" ).bhp, 3.0 );
+
+    Opm::MessageBuffer buffer;
+    wells.write( buffer );
+
+    data::Wells copy;
+    copy.read( buffer );
+    BOOST_CHECK_EQUAL( copy.size(), 2U );
+    BOOST_CHECK_EQUAL( copy.slot( "INJ" ), 0U );
+    BOOST_CHECK_EQUAL( copy.at( "INJ" ).bhp, 2.0 );
+    BOOST_CHECK( copy.at( "OBS" ).find_connection( 3 ) != nullptr );
+
+    copy = wells;
+    copy[ "NEW" ].bhp = 4.0;
+    BOOST_CHECK_EQUAL( copy.size(), 3U );
+    BOOST_CHECK_EQUAL( wells.size(), 2U );
+}
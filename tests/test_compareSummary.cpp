@@ -37,6 +37,27 @@ BOOST_AUTO_TEST_CASE(deviation){
 }
 
 
+BOOST_AUTO_TEST_CASE(timeAlignment) {
+    const std::vector<double> time1 = {0, 1, 2, 3};
+    const std::vector<double> time2 = {0, 0.5, 1, 2.5, 3};
+
+    const std::vector<size_t> same = SummaryComparator::alignTimeAxes(time1, time1);
+    const std::vector<size_t> expectSame = {0, 1, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(same.begin(), same.end(), expectSame.begin(), expectSame.end());
+
+    // Steps missing in the check vector use the next (upper) check step.
+    const std::vector<size_t> finer = SummaryComparator::alignTimeAxes(time1, time2);
+    const std::vector<size_t> expectFiner = {0, 2, 3, 4};
+    BOOST_CHECK_EQUAL_COLLECTIONS(finer.begin(), finer.end(), expectFiner.begin(), expectFiner.end());
+
+    // Reference steps after the end of the check vector use the last check step.
+    const std::vector<double> time3 = {0, 1};
+    const std::vector<size_t> shorter = SummaryComparator::alignTimeAxes(time1, time3);
+    const std::vector<size_t> expectShorter = {0, 1, 1, 1};
+    BOOST_CHECK_EQUAL_COLLECTIONS(shorter.begin(), shorter.end(), expectShorter.begin(), expectShorter.end());
+}
+
+
 BOOST_AUTO_TEST_CASE(area) {
     double width1 = 0;
     double width2 = 2;
@@ -22,7 +22,9 @@
 #define BOOST_TEST_MODULE RegionCache
 #include <boost/test/unit_test.hpp>
 
+#include <set>
 #include <stdexcept>
+#include <string>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -60,4 +62,15 @@ BOOST_AUTO_TEST_CASE(create) {
             BOOST_CHECK_EQUAL( pair.second , grid.activeIndex( 0,0,0));
         }
     }
+
+    /* The connections of a well are consecutive within a region. */
+    for (int region = 1; region <= 3; region++) {
+        const auto& connections = rc.connections( region );
+        std::set<std::string> seen;
+        for (std::size_t i = 0; i < connections.size(); i++) {
+            if (i > 0 && connections[i].first == connections[i - 1].first)
+                continue;
+            BOOST_CHECK( seen.insert( connections[i].first ).second );
+        }
+    }
 }